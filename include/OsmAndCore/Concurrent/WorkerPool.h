@@ -2,6 +2,7 @@
 #define _OSMAND_CORE_CONCURRENT_WORKER_POOL_H_
 
 #include <OsmAndCore/stdlib_common.h>
+#include <functional>
 
 #include <OsmAndCore/QtExtensions.h>
 #include <QRunnable>
@@ -24,7 +25,25 @@ namespace OsmAnd
             {
                 FIFO,
                 LIFO,
-                Random
+                Random,
+
+                // Runnable with highest priority is taken first, among equal ones - latest enqueued
+                ByPriority
+            };
+
+            // Returns new priority of runnable that is still waiting in queue
+            typedef std::function<float (QRunnable* const runnable, const float priority)> PriorityEvaluator;
+
+            struct OSMAND_CORE_API Statistics
+            {
+                Statistics();
+
+                unsigned int queueSize;
+                unsigned int maxQueueSize;
+                unsigned int startedRunnables;
+                unsigned int coalescedRunnables;
+                float totalWaitTime;
+                float maxWaitTime;
             };
 
         private:
@@ -43,9 +62,13 @@ namespace OsmAnd
 
             bool waitForDone(const int msecs = -1) const;
 
-            void enqueue(QRunnable* const runnable);
+            void enqueue(QRunnable* const runnable, const float priority = 0.0f);
             bool dequeue(QRunnable* const runnable);
             void dequeueAll();
+            void reprioritize(const PriorityEvaluator evaluator);
+
+            // Wait times are measured from enqueue to start, in seconds
+            Statistics getStatistics(const bool reset = false) const;
 
             void reset();
         };
@@ -8,6 +8,7 @@
 #include <QHash>
 #include <QList>
 #include <QVariant>
+#include <QStringList>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/MemoryCommon.h>
@@ -36,6 +37,9 @@ namespace OsmAnd
         QList<ObfPoiCategoryId> categories;
         QString nativeName;
         QHash<QString, QString> localizedNames;
+        // Native name followed by localized ones as search by name that found object compared them. Empty when
+        // names were compared case-insensitively as-is, see ObfFile::NameNormalization
+        QStringList normalizedNames;
         ObfObjectId id;
         QHash<int, QVariant> values;
 
@@ -9,16 +9,19 @@
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/PrivateImplementation.h>
 #include <OsmAndCore/Data/ObfSectionInfo.h>
 
 namespace OsmAnd
 {
     class ObfAddressSectionReader_P;
 
+    class ObfAddressSectionInfo_P;
     class OSMAND_CORE_API ObfAddressSectionInfo : public ObfSectionInfo
     {
         Q_DISABLE_COPY_AND_MOVE(ObfAddressSectionInfo)
     private:
+        PrivateImplementation<ObfAddressSectionInfo_P> _p;
     protected:
     public:
         ObfAddressSectionInfo(const std::shared_ptr<const ObfInfo>& container);
@@ -6,6 +6,7 @@
 
 #include <OsmAndCore/QtExtensions.h>
 #include <QList>
+#include <QVector>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
@@ -33,6 +34,38 @@ namespace OsmAnd
             std::function<bool(const std::shared_ptr<const OsmAnd::StreetIntersection>& streetIntersection)>
             IntersectionVisitorFunction;
 
+        // Nearest objects to some point, any of them may be missing if there's none close enough
+        struct OSMAND_CORE_API ReverseGeocodingResult Q_DECL_FINAL
+        {
+            ReverseGeocodingResult();
+            ~ReverseGeocodingResult();
+
+            std::shared_ptr<const Building> building;
+            double buildingDistance;
+            std::shared_ptr<const Street> street;
+            double streetDistance;
+            // Settlement (city, town or village), postcodes are not taken into account
+            std::shared_ptr<const StreetGroup> streetGroup;
+            double streetGroupDistance;
+        };
+
+        struct OSMAND_CORE_API HierarchyCacheStatistics Q_DECL_FINAL
+        {
+            HierarchyCacheStatistics();
+            ~HierarchyCacheStatistics();
+
+            uint64_t hits;
+            uint64_t misses;
+            // Entries that were decoded along with their parent, before being requested
+            uint64_t prefetchedEntries;
+
+            unsigned int entriesCount;
+            size_t usedBytes;
+            size_t capacityInBytes;
+
+            float getHitRate() const;
+        };
+
     private:
         ObfAddressSectionReader();
         ~ObfAddressSectionReader();
@@ -80,7 +113,27 @@ namespace OsmAnd
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter = fullObfAddressStreetGroupTypesMask(),
             const bool includeStreets = true,
             const ObfAddressSectionReader::VisitorFunction visitor = nullptr,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            const unsigned int maxEditDistance = 0);
+
+        // Objects of section are indexed on first call. Objects of outResults are replaced only by closer ones,
+        // so same results can be passed for all sections. Distances are in meters.
+        static void reverseGeocode(
+            const std::shared_ptr<const ObfReader>& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            const QVector<PointI>& positions31,
+            QVector<ReverseGeocodingResult>& outResults,
+            const double maxDistance,
             const std::shared_ptr<const IQueryController>& queryController = nullptr);
+
+        // Street groups, streets, buildings and intersections decoded by load*() methods are kept in cache shared
+        // by all readers, up to given estimated size. Loading streets of small street group also decodes their
+        // buildings and intersections, and loading buildings of street also decodes its intersections and vice
+        // versa. Disabled (zero capacity) by default.
+        static size_t getHierarchyCacheCapacity();
+        static void setHierarchyCacheCapacity(const size_t capacityInBytes);
+        static HierarchyCacheStatistics getHierarchyCacheStatistics();
+        static void clearHierarchyCache();
     };
 }
 
@@ -14,6 +14,8 @@ namespace OsmAnd
 {
     class ObfInfo;
     class ObfReader_P;
+    class ObfIndexedStringTable;
+    struct ObfNameNormalizer;
 
     class ObfFile_P;
     class OSMAND_CORE_API ObfFile
@@ -31,7 +33,35 @@ namespace OsmAnd
         const uint64_t fileSize;
         const std::shared_ptr<const ObfInfo>& obfInfo;
 
+        // When enabled, name indexes of address and POI sections are read once and kept in memory,
+        // so searches by name don't decode them from file again. Disabled by default.
+        static bool isResidentNameIndexEnabled();
+        static void setResidentNameIndexEnabled(const bool enabled);
+
+        // When enabled, POI sections build posting lists of their data boxes by category on first query
+        // with categories filter, so such queries don't scan tiles tree. Disabled by default.
+        static bool isPoiCategoryIndexEnabled();
+        static void setPoiCategoryIndexEnabled(const bool enabled);
+
+        // How names and queries are normalized before being compared by searches by name. Each mode includes
+        // previous ones. Resident name indexes keep keys normalized the way they were when index was read,
+        // and objects found by name carry names normalized by search, so mode can't be changed once first
+        // search by name started: setNameNormalization() returns false then. CaseFolding by default.
+        enum class NameNormalization
+        {
+            CaseFolding,
+            StripAccentsAndDiacritics,
+            TransliterateToLatin,
+        };
+        static NameNormalization getNameNormalization();
+        static bool setNameNormalization(const NameNormalization normalization);
+
+    private:
+        static NameNormalization lockNameNormalization();
+
     friend class OsmAnd::ObfReader_P;
+    friend class OsmAnd::ObfIndexedStringTable;
+    friend struct OsmAnd::ObfNameNormalizer;
     };
 }
 
@@ -6,6 +6,9 @@
 
 #include <OsmAndCore/QtExtensions.h>
 #include <QSet>
+#include <QList>
+#include <QVector>
+#include <QMutex>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
@@ -19,12 +22,58 @@ namespace OsmAnd
     class ObfPoiSectionInfo;
     class Amenity;
     class IQueryController;
+    namespace ObfPoiSectionReader_Metrics
+    {
+        struct Metric_loadAmenities;
+    }
 
     class OSMAND_CORE_API ObfPoiSectionReader
     {
     public:
         typedef std::function<bool(const std::shared_ptr<const OsmAnd::Amenity>& amenity)> VisitorFunction;
 
+        // Keeps up to limit amenities nearest to point that were offered to it. Same collector can be shared by
+        // scans of several sections running concurrently, so each of them stops as soon as it can't offer
+        // anything nearer than what is already collected.
+        class OSMAND_CORE_API NearestAmenitiesCollector Q_DECL_FINAL
+        {
+            Q_DISABLE_COPY_AND_MOVE(NearestAmenitiesCollector);
+        public:
+            struct OSMAND_CORE_API Entry
+            {
+                Entry();
+                ~Entry();
+
+                std::shared_ptr<const OsmAnd::Amenity> amenity;
+                double distance;
+            };
+
+        private:
+            mutable QMutex _mutex;
+
+            // Max-heap by distance, farthest entry on top
+            QVector<Entry> _entries;
+            double _maxDistance;
+
+            static bool isNearer(const Entry& l, const Entry& r);
+        protected:
+        public:
+            NearestAmenitiesCollector(const PointI& point31, const unsigned int limit, const double maxDistance);
+            ~NearestAmenitiesCollector();
+
+            const PointI point31;
+            const unsigned int limit;
+            const double maxDistance;
+
+            // Distance (in meters) beyond which nothing can be collected anymore
+            double getMaxDistance() const;
+
+            bool offer(const std::shared_ptr<const OsmAnd::Amenity>& amenity, const double distance);
+
+            // Collected entries ordered from nearest to farthest
+            QList<Entry> getEntries() const;
+        };
+
     private:
         ObfPoiSectionReader();
         ~ObfPoiSectionReader();
@@ -51,6 +100,17 @@ namespace OsmAnd
             const AreaI* const bbox31 = nullptr,
             const QSet<ObfPoiCategoryId>* const categoriesFilter = nullptr,
             const ObfPoiSectionReader::VisitorFunction visitor = nullptr,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric = nullptr);
+
+        static void loadNearestAmenities(
+            const std::shared_ptr<const ObfReader>& reader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section,
+            NearestAmenitiesCollector& collector,
+            const ZoomLevel minZoom = MinZoomLevel,
+            const ZoomLevel maxZoom = MaxZoomLevel,
+            const AreaI* const bbox31 = nullptr,
+            const QSet<ObfPoiCategoryId>* const categoriesFilter = nullptr,
             const std::shared_ptr<const IQueryController>& queryController = nullptr);
 
         static void scanAmenitiesByName(
@@ -63,7 +123,8 @@ namespace OsmAnd
             const AreaI* const bbox31 = nullptr,
             const QSet<ObfPoiCategoryId>* const categoriesFilter = nullptr,
             const ObfPoiSectionReader::VisitorFunction visitor = nullptr,
-            const std::shared_ptr<const IQueryController>& queryController = nullptr);
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            const unsigned int maxEditDistance = 0);
     };
 }
 
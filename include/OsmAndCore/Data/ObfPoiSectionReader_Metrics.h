@@ -0,0 +1,52 @@
+#ifndef _OSMAND_CORE_OBF_POI_SECTION_READER_METRICS_H_
+#define _OSMAND_CORE_OBF_POI_SECTION_READER_METRICS_H_
+
+#include <OsmAndCore/stdlib_common.h>
+#include <functional>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <QString>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/Metrics.h>
+
+namespace OsmAnd
+{
+    namespace ObfPoiSectionReader_Metrics
+    {
+#define OsmAnd__ObfPoiSectionReader_Metrics__Metric_loadAmenities__FIELDS(FIELD_ACTION)         \
+        /* Number of tile boxes visited while scanning tiles tree */                            \
+        FIELD_ACTION(unsigned int, visitedBoxes, "");                                           \
+                                                                                                \
+        /* Number of data boxes selected by category index posting lists */                     \
+        FIELD_ACTION(unsigned int, dataBoxesFromCategoryIndex, "");                             \
+                                                                                                \
+        /* Number of data boxes read */                                                         \
+        FIELD_ACTION(unsigned int, dataBoxesRead, "");                                          \
+                                                                                                \
+        /* Number of decoded amenities */                                                       \
+        FIELD_ACTION(unsigned int, decodedAmenities, "");                                       \
+                                                                                                \
+        /* Number of returned amenities */                                                      \
+        FIELD_ACTION(unsigned int, returnedAmenities, "");                                      \
+                                                                                                \
+        /* Elapsed time for selecting data boxes (in seconds) */                                \
+        FIELD_ACTION(float, elapsedTimeForBoxes, "s");                                          \
+                                                                                                \
+        /* Elapsed time for reading data boxes (in seconds) */                                  \
+        FIELD_ACTION(float, elapsedTimeForDataBoxes, "s");
+
+        struct OSMAND_CORE_API Metric_loadAmenities : public Metric
+        {
+            Metric_loadAmenities();
+            virtual ~Metric_loadAmenities();
+            virtual void reset();
+
+            OsmAnd__ObfPoiSectionReader_Metrics__Metric_loadAmenities__FIELDS(EMIT_METRIC_FIELD);
+
+            virtual QString toString(const bool shortFormat = false, const QString& prefix = QString::null) const;
+        };
+    }
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_POI_SECTION_READER_METRICS_H_)
@@ -6,6 +6,7 @@
 #include <OsmAndCore/QtExtensions.h>
 #include <QString>
 #include <QHash>
+#include <QStringList>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
@@ -30,6 +31,9 @@ namespace OsmAnd
         ObfObjectId id;
         QString nativeName;
         QHash<QString, QString> localizedNames;
+        // Native name followed by localized ones as search by name that found object compared them. Empty when
+        // names were compared case-insensitively as-is, see ObfFile::NameNormalization
+        QStringList normalizedNames;
         PointI position31;
         uint32_t offset;
         uint32_t firstBuildingInnerOffset;
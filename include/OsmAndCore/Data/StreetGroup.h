@@ -6,6 +6,7 @@
 #include <OsmAndCore/QtExtensions.h>
 #include <QString>
 #include <QHash>
+#include <QStringList>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/Common.h>
@@ -32,6 +33,9 @@ namespace OsmAnd
         ObfAddressStreetGroupSubtype subtype;
         QString nativeName;
         QHash<QString, QString> localizedNames;
+        // Native name followed by localized ones as search by name that found object compared them. Empty when
+        // names were compared case-insensitively as-is, see ObfFile::NameNormalization
+        QStringList normalizedNames;
         PointI position31;
         uint32_t dataOffset;
     };
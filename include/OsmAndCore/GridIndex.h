@@ -0,0 +1,363 @@
+#ifndef _OSMAND_CORE_GRID_INDEX_H_
+#define _OSMAND_CORE_GRID_INDEX_H_
+
+#include <OsmAndCore/stdlib_common.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <functional>
+#include <limits>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QList>
+#include <QVector>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/QuadTree.h>
+
+namespace OsmAnd
+{
+    // Uniform grid over fixed root area. Has same semantics as QuadTree, but stores entries in single
+    // contiguous array and each cell as contiguous array of entry indices. Entries are prefiltered by
+    // their AABBs before exact (possibly OOBB) tests. Entries that cross root area border are
+    // registered in border cells.
+    template<typename ELEMENT_TYPE, typename COORD_TYPE>
+    class GridIndex
+    {
+    public:
+        typedef COORD_TYPE CoordType;
+        typedef GridIndex<ELEMENT_TYPE, COORD_TYPE> GridIndexT;
+        typedef QuadTree<ELEMENT_TYPE, COORD_TYPE> QuadTreeT;
+        typedef Area<COORD_TYPE> AreaT;
+        typedef OOBB<COORD_TYPE> OOBBT;
+        typedef Point<COORD_TYPE> PointT;
+        typedef typename QuadTreeT::BBoxType BBoxType;
+        typedef typename QuadTreeT::BBox BBox;
+        typedef typename QuadTreeT::Acceptor Acceptor;
+
+    private:
+        struct Entry
+        {
+            BBox bbox;
+            AreaT aabb;
+            ELEMENT_TYPE element;
+            int firstColumn;
+            int firstRow;
+            int lastColumn;
+            int lastRow;
+            bool isRemoved;
+        };
+
+        struct CellsRange
+        {
+            int firstColumn;
+            int firstRow;
+            int lastColumn;
+            int lastRow;
+        };
+
+        AreaT _rootArea;
+        int64_t _cellSize;
+        int _columnsCount;
+        int _rowsCount;
+        QVector<Entry> _entries;
+        QVector< QVector<int> > _cells;
+
+        static inline AreaT getAABB(const BBox& bbox)
+        {
+            if (bbox.type == BBoxType::AABB)
+                return bbox.asAABB;
+            else /* if (bbox.type == BBoxType::OOBB) */
+                return bbox.asOOBB.aabb();
+        }
+
+        static inline bool contains(const BBox& which, const BBox& what)
+        {
+            if (which.type == BBoxType::AABB)
+                return what.isContainedBy(which.asAABB);
+            else /* if (which.type == BBoxType::OOBB) */
+                return what.isContainedBy(which.asOOBB);
+        }
+
+        static inline bool intersects(const BBox& which, const BBox& what)
+        {
+            if (which.type == BBoxType::AABB)
+                return what.isIntersectedBy(which.asAABB);
+            else /* if (which.type == BBoxType::OOBB) */
+                return what.isIntersectedBy(which.asOOBB);
+        }
+
+        static inline bool contains(const BBox& which, const PointT& what)
+        {
+            if (which.type == BBoxType::AABB)
+                return which.asAABB.contains(what);
+            else /* if (which.type == BBoxType::OOBB) */
+                return which.asOOBB.contains(what);
+        }
+
+        inline int getColumn(const COORD_TYPE x) const
+        {
+            const auto column = (static_cast<int64_t>(x) - static_cast<int64_t>(_rootArea.left())) / _cellSize;
+            return static_cast<int>(qBound<int64_t>(0, column, _columnsCount - 1));
+        }
+
+        inline int getRow(const COORD_TYPE y) const
+        {
+            const auto row = (static_cast<int64_t>(y) - static_cast<int64_t>(_rootArea.top())) / _cellSize;
+            return static_cast<int>(qBound<int64_t>(0, row, _rowsCount - 1));
+        }
+
+        inline CellsRange getCellsRange(const AreaT& aabb) const
+        {
+            CellsRange range;
+            range.firstColumn = getColumn(aabb.left());
+            range.firstRow = getRow(aabb.top());
+            range.lastColumn = getColumn(aabb.right());
+            range.lastRow = getRow(aabb.bottom());
+            return range;
+        }
+
+        // Visits every entry that shares at least one cell with given range exactly once:
+        // entry is reported only in first cell of intersection of its range and given range
+        template<typename VISITOR>
+        inline bool visit(const CellsRange& range, const AreaT& aabb, const VISITOR visitor) const
+        {
+            for (auto row = range.firstRow; row <= range.lastRow; row++)
+            {
+                for (auto column = range.firstColumn; column <= range.lastColumn; column++)
+                {
+                    for (const auto entryIndex : constOf(_cells[row * _columnsCount + column]))
+                    {
+                        const auto& entry = _entries[entryIndex];
+                        if (qMax(entry.firstColumn, range.firstColumn) != column ||
+                            qMax(entry.firstRow, range.firstRow) != row)
+                        {
+                            continue;
+                        }
+                        if (!entry.aabb.intersects(aabb))
+                            continue;
+
+                        if (visitor(entry))
+                            return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+    public:
+        inline GridIndex(
+            const AreaT& rootArea_ = AreaT(0, 0, 1, 1),
+            const COORD_TYPE cellSize_ = 1)
+            : _rootArea(rootArea_)
+            , _cellSize(qMax<int64_t>(cellSize_, 1))
+        {
+            const auto width = static_cast<int64_t>(_rootArea.right()) - static_cast<int64_t>(_rootArea.left()) + 1;
+            const auto height = static_cast<int64_t>(_rootArea.bottom()) - static_cast<int64_t>(_rootArea.top()) + 1;
+            _columnsCount = static_cast<int>(qMax<int64_t>((width + _cellSize - 1) / _cellSize, 1));
+            _rowsCount = static_cast<int>(qMax<int64_t>((height + _cellSize - 1) / _cellSize, 1));
+            _cells.resize(_columnsCount * _rowsCount);
+        }
+
+        virtual ~GridIndex()
+        {
+        }
+
+        inline AreaT getRootArea() const
+        {
+            return _rootArea;
+        }
+
+        inline const AreaT& rootArea() const
+        {
+            return _rootArea;
+        }
+
+        inline COORD_TYPE cellSize() const
+        {
+            return static_cast<COORD_TYPE>(_cellSize);
+        }
+
+        inline bool insert(const ELEMENT_TYPE& element, const BBox& bbox, const bool strict = false)
+        {
+            // Check if root area can hold entire element
+            if (!bbox.isContainedBy(_rootArea))
+            {
+                if (strict)
+                    return false;
+                if (!bbox.intersects(_rootArea))
+                    return false;
+            }
+
+            Entry entry;
+            entry.bbox = bbox;
+            entry.aabb = getAABB(bbox);
+            entry.element = element;
+            entry.isRemoved = false;
+            const auto range = getCellsRange(entry.aabb);
+            entry.firstColumn = range.firstColumn;
+            entry.firstRow = range.firstRow;
+            entry.lastColumn = range.lastColumn;
+            entry.lastRow = range.lastRow;
+
+            const auto entryIndex = _entries.size();
+            _entries.push_back(qMove(entry));
+            for (auto row = range.firstRow; row <= range.lastRow; row++)
+            {
+                for (auto column = range.firstColumn; column <= range.lastColumn; column++)
+                    _cells[row * _columnsCount + column].push_back(entryIndex);
+            }
+
+            return true;
+        }
+
+        template<class ITERATOR_TYPE>
+        inline int insertFrom(
+            const ITERATOR_TYPE& itBegin,
+            const ITERATOR_TYPE& itEnd,
+            const std::function<bool(const ELEMENT_TYPE& item, BBox& outBbox)> obtainBBox,
+            const bool strict = false)
+        {
+            int insertedCount = 0;
+
+            for (auto itItem = itBegin; itItem != itEnd; ++itItem)
+            {
+                const auto& item = *itItem;
+                BBox bbox;
+                if (!obtainBBox(item, bbox))
+                    continue;
+
+                if (insert(item, bbox, strict))
+                    insertedCount++;
+            }
+
+            return insertedCount;
+        }
+
+        template<class CONTAINER_TYPE>
+        inline int insertFrom(
+            const CONTAINER_TYPE& container,
+            const std::function<bool(const ELEMENT_TYPE& item, BBox& outBbox)> obtainBBox,
+            const bool strict = false)
+        {
+            return insertFrom(std::begin(container), std::end(container), obtainBBox, strict);
+        }
+
+        inline void get(QList<ELEMENT_TYPE>& outResults, const Acceptor acceptor = nullptr) const
+        {
+            for (const auto& entry : constOf(_entries))
+            {
+                if (entry.isRemoved)
+                    continue;
+
+                if (!acceptor || acceptor(entry.element, entry.bbox))
+                    outResults.push_back(entry.element);
+            }
+        }
+
+        inline void query(
+            const BBox& bbox,
+            QList<ELEMENT_TYPE>& outResults,
+            const bool strict = false,
+            const Acceptor acceptor = nullptr) const
+        {
+            // Same as in QuadTree, nothing is found by bbox that is not related to root area at all
+            if (!bbox.isContainedBy(_rootArea))
+            {
+                if (strict)
+                    return;
+                if (!bbox.intersects(_rootArea))
+                    return;
+            }
+
+            const auto aabb = getAABB(bbox);
+            visit(getCellsRange(aabb), aabb,
+                [&bbox, &outResults, strict, &acceptor]
+                (const Entry& entry) -> bool
+                {
+                    if (contains(bbox, entry.bbox) || (!strict && intersects(bbox, entry.bbox)))
+                    {
+                        if (!acceptor || acceptor(entry.element, entry.bbox))
+                            outResults.push_back(entry.element);
+                    }
+                    return false;
+                });
+        }
+
+        inline bool test(const BBox& bbox, const bool strict = false, const Acceptor acceptor = nullptr) const
+        {
+            if (!bbox.isContainedBy(_rootArea))
+            {
+                if (strict)
+                    return false;
+                if (!bbox.intersects(_rootArea))
+                    return false;
+            }
+
+            const auto aabb = getAABB(bbox);
+            return visit(getCellsRange(aabb), aabb,
+                [&bbox, strict, &acceptor]
+                (const Entry& entry) -> bool
+                {
+                    if (contains(bbox, entry.bbox) || (!strict && intersects(bbox, entry.bbox)))
+                        return !acceptor || acceptor(entry.element, entry.bbox);
+                    return false;
+                });
+        }
+
+        inline void select(const PointT& point, QList<ELEMENT_TYPE>& outResults, const Acceptor acceptor = nullptr) const
+        {
+            if (!_rootArea.contains(point))
+                return;
+
+            const auto& cell = _cells[getRow(point.y) * _columnsCount + getColumn(point.x)];
+            for (const auto entryIndex : constOf(cell))
+            {
+                const auto& entry = _entries[entryIndex];
+                if (!entry.aabb.contains(point) || !contains(entry.bbox, point))
+                    continue;
+
+                if (!acceptor || acceptor(entry.element, entry.bbox))
+                    outResults.push_back(entry.element);
+            }
+        }
+
+        inline bool removeOne(const ELEMENT_TYPE& element, const BBox& bbox)
+        {
+            auto removedEntryIndex = -1;
+            const auto range = getCellsRange(getAABB(bbox));
+            for (auto row = range.firstRow; row <= range.lastRow && removedEntryIndex < 0; row++)
+            {
+                for (auto column = range.firstColumn; column <= range.lastColumn && removedEntryIndex < 0; column++)
+                {
+                    for (const auto entryIndex : constOf(_cells[row * _columnsCount + column]))
+                    {
+                        if (_entries[entryIndex].element != element)
+                            continue;
+
+                        removedEntryIndex = entryIndex;
+                        break;
+                    }
+                }
+            }
+            if (removedEntryIndex < 0)
+                return false;
+
+            // Unregister entry from all cells it was registered in
+            auto& entry = _entries[removedEntryIndex];
+            for (auto row = entry.firstRow; row <= entry.lastRow; row++)
+            {
+                for (auto column = entry.firstColumn; column <= entry.lastColumn; column++)
+                    _cells[row * _columnsCount + column].removeOne(removedEntryIndex);
+            }
+            entry.isRemoved = true;
+            entry.element = ELEMENT_TYPE();
+
+            return true;
+        }
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_GRID_INDEX_H_)
@@ -24,6 +24,10 @@ namespace OsmAnd
         OSMAND_CORE_API QVector<int> OSMAND_CORE_CALL getTextWrapping(const QString& input, const int maxCharsPerLine);
         OSMAND_CORE_API QVector<QStringRef> OSMAND_CORE_CALL getTextWrappingRefs(const QString& input, const int maxCharsPerLine);
         OSMAND_CORE_API QStringList OSMAND_CORE_CALL wrapText(const QString& input, const int maxCharsPerLine);
+        OSMAND_CORE_API QString OSMAND_CORE_CALL convertToVisualOrderAndWrap(
+            const QString& input,
+            const int maxCharsPerLine,
+            QVector<int>& outLineStartIndices);
         OSMAND_CORE_API QString OSMAND_CORE_CALL stripAccentsAndDiacritics(const QString& input);
     }
 }
@@ -20,6 +20,20 @@ namespace OsmAnd
 
         float referenceTileSizeOnScreenInPixels;
 
+        // If enabled, symbols accepted by last full placement are re-plotted on next frames instead of all
+        // published symbols, until zoom, rotation, viewport or published symbols change, or map is moved
+        // by more than given distance on screen
+        bool incrementalSymbolsPlacement;
+        float incrementalSymbolsPlacementMaxShiftInPixels;
+
+        // Screen-space index used to test symbols for intersections
+        enum class SymbolsIntersectionsIndex
+        {
+            QuadTree,
+            Grid,
+        };
+        SymbolsIntersectionsIndex symbolsIntersectionsIndex;
+
         virtual void copyTo(MapRendererConfiguration& other) const;
         virtual std::shared_ptr<MapRendererConfiguration> createCopy() const;
 
@@ -17,6 +17,13 @@ namespace OsmAnd
     namespace AtlasMapRenderer_Metrics
     {
 #define OsmAnd__AtlasMapRenderer_Metrics__Metric_renderFrame__FIELDS(FIELD_ACTION)                              \
+        /* Resources uploaded to GPU since previous frame */                                                    \
+        FIELD_ACTION(float, elapsedTimeForResourcesUpload, "s");                                                \
+        FIELD_ACTION(unsigned int, resourcesUploaded, "");                                                      \
+        FIELD_ACTION(unsigned int, resourcesUploadedSize, "KB");                                                \
+        FIELD_ACTION(unsigned int, resourcesUploadsDeferred, "");                                               \
+        FIELD_ACTION(unsigned int, resourcesUploadStalls, "");                                                  \
+                                                                                                                \
         /* Time elapsed for sky stage */                                                                        \
         FIELD_ACTION(float, elapsedTimeForSkyStage, "s");                                                       \
                                                                                                                 \
@@ -26,6 +33,8 @@ namespace OsmAnd
         /* Time elapsed for symbols stage */                                                                    \
         FIELD_ACTION(float, elapsedTimeForSymbolsStage, "s");                                                   \
         FIELD_ACTION(float, elapsedTimeForPreparingSymbols, "s");                                               \
+        FIELD_ACTION(unsigned int, fullSymbolsPlacements, "");                                                  \
+        FIELD_ACTION(unsigned int, incrementalSymbolsPlacements, "");                                           \
         FIELD_ACTION(float, elapsedTimeForPublishingPreparedSymbols, "s");                                      \
         FIELD_ACTION(float, elapsedTimeForObtainingRenderableSymbols, "s");                                     \
         FIELD_ACTION(float, elapsedTimeForObtainingRenderableSymbolsWithLock, "s");                             \
@@ -62,6 +71,7 @@ namespace OsmAnd
         FIELD_ACTION(unsigned int, onPathSymbolsRendered, "");                                                  \
         FIELD_ACTION(float, elapsedTimeForOnSurfaceSymbolsRendering, "s");                                      \
         FIELD_ACTION(unsigned int, onSurfaceSymbolsRendered, "");                                               \
+        FIELD_ACTION(unsigned int, symbolTexturesBound, "");                                                    \
                                                                                                                 \
         /* Time elapsed for debug stage */                                                                      \
         FIELD_ACTION(float, elapsedTimeForDebugStage, "s");                                                     \
@@ -30,6 +30,7 @@ namespace OsmAnd
     class IMapTiledSymbolsProvider;
     class IMapKeyedSymbolsProvider;
     class MapSymbol;
+    class MapRendererFrameTelemetry;
     namespace IMapRenderer_Metrics
     {
         struct Metric_update;
@@ -123,6 +124,8 @@ namespace OsmAnd
         virtual std::shared_ptr<MapRendererDebugSettings> getDebugSettings() const = 0;
         virtual void setDebugSettings(const std::shared_ptr<const MapRendererDebugSettings>& debugSettings) = 0;
 
+        virtual std::shared_ptr<MapRendererFrameTelemetry> getFrameTelemetry() const = 0;
+
         virtual ZoomLevel getMinZoomLevel() const = 0;
         virtual ZoomLevel getMaxZoomLevel() const = 0;
 
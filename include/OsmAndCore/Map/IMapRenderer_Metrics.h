@@ -22,7 +22,17 @@ namespace OsmAnd
         FIELD_ACTION(float, elapsedTimeForUpdatesProcessing, "s");                      \
                                                                                         \
         /* Time elapsed to process all scheduled calls in render thread */              \
-        FIELD_ACTION(float, elapsedTimeForRenderThreadDispatcher, "s");
+        FIELD_ACTION(float, elapsedTimeForRenderThreadDispatcher, "s");                 \
+                                                                                        \
+        /* Memory occupied by resources */                                              \
+        FIELD_ACTION(unsigned int, resourcesCpuMemoryUsage, "KB");                      \
+        FIELD_ACTION(unsigned int, resourcesGpuMemoryUsage, "KB");                      \
+                                                                                        \
+        /* Resources evicted to fit into memory budget since previous update */         \
+        FIELD_ACTION(unsigned int, resourcesEvictedByMemoryBudget, "");                 \
+                                                                                        \
+        /* Symbols that reused resource in GPU uploaded for identical bitmap */         \
+        FIELD_ACTION(unsigned int, symbolResourcesSharedInGPU, "");
         struct OSMAND_CORE_API Metric_update : public Metric
         {
             Metric_update();
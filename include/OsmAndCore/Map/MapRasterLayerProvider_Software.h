@@ -23,8 +23,17 @@ namespace OsmAnd
     public:
         MapRasterLayerProvider_Software(
             const std::shared_ptr<MapPrimitivesProvider>& primitivesProvider,
-            const bool fillBackground = true);
+            const bool fillBackground = true,
+            const unsigned int rasterizationBandsCount = 1);
         virtual ~MapRasterLayerProvider_Software();
+
+        // Number of horizontal bands tile is split into to be rasterized concurrently.
+        // Bands are never made smaller than MapRasterLayerProvider_Software::MinimalBandHeight pixels
+        const unsigned int rasterizationBandsCount;
+
+        enum {
+            MinimalBandHeight = 256,
+        };
     };
 }
 
@@ -15,6 +15,15 @@ namespace OsmAnd
     namespace MapRasterizer_Metrics
     {
 #define OsmAnd__MapRasterizer_Metrics__Metric_rasterize__FIELDS(FIELD_ACTION)       \
+        /* Number of primitives that were drawn */                                  \
+        FIELD_ACTION(unsigned int, drawnPrimitives, "");                            \
+                                                                                    \
+        /* Number of primitives that were merged into path of previous primitive */ \
+        FIELD_ACTION(unsigned int, batchedPrimitives, "");                          \
+                                                                                    \
+        /* Number of path draw calls */                                             \
+        FIELD_ACTION(unsigned int, drawCalls, "");                                  \
+                                                                                    \
         /* Total elapsed time */                                                    \
         FIELD_ACTION(float, elapsedTime, "s");
         struct OSMAND_CORE_API Metric_rasterize : public Metric
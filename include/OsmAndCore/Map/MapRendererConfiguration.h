@@ -26,6 +26,22 @@ namespace OsmAnd
         bool limitTextureColorDepthBy16bits;
         bool paletteTexturesAllowed;
 
+        // Limits of memory (in bytes) occupied by resources of all types and by resources of each type,
+        // in CPU and in GPU. Zero means no limit.
+        size_t resourcesCpuMemoryBudget;
+        size_t resourcesGpuMemoryBudget;
+        size_t mapLayersCpuMemoryBudget;
+        size_t mapLayersGpuMemoryBudget;
+        size_t elevationDataCpuMemoryBudget;
+        size_t elevationDataGpuMemoryBudget;
+        size_t symbolsCpuMemoryBudget;
+        size_t symbolsGpuMemoryBudget;
+
+        // Limits of resources upload to GPU per frame, when uploads are done by render thread. Time is in seconds,
+        // size is in bytes. Zero means no limit, but at least one resource is uploaded each frame anyways.
+        float resourcesUploadTimeBudget;
+        size_t resourcesUploadBytesBudget;
+
         virtual void copyTo(MapRendererConfiguration& other) const;
         virtual std::shared_ptr<MapRendererConfiguration> createCopy() const;
     };
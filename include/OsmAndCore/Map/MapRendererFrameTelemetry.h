@@ -0,0 +1,132 @@
+#ifndef _OSMAND_CORE_MAP_RENDERER_FRAME_TELEMETRY_H_
+#define _OSMAND_CORE_MAP_RENDERER_FRAME_TELEMETRY_H_
+
+#include <OsmAndCore/stdlib_common.h>
+#include <array>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QAtomicInt>
+#include <QString>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+
+namespace OsmAnd
+{
+    // Continuously running collector of frame timings. Durations of each stage are put into logarithmic
+    // histograms that cover last WindowsCount*FramesPerWindow frames, so percentiles reflect recent frames only.
+    // Recording is done from render thread only and is lock-free, snapshots can be taken from any thread
+    // (snapshot taken while window is being rotated may be slightly inconsistent).
+    class OSMAND_CORE_API MapRendererFrameTelemetry Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(MapRendererFrameTelemetry);
+
+    public:
+        enum class Stage : unsigned int
+        {
+            Frame = 0,
+            Sky,
+            MapLayers,
+            Symbols,
+            Debug,
+            ResourcesUpload,
+        };
+        enum
+        {
+            StagesCount = static_cast<unsigned int>(Stage::ResourcesUpload) + 1,
+        };
+
+        // Bucket 0 holds durations below MinBucketDuration microseconds, each next bucket is 2^(1/BucketsPerOctave)
+        // times wider, last bucket holds everything that is longer.
+        enum
+        {
+            MinBucketDuration = 10,
+            BucketsPerOctave = 4,
+            BucketsCount = 64,
+            WindowsCount = 4,
+            FramesPerWindow = 64,
+        };
+
+        // Intervals between frames longer than this (in microseconds) are treated as idle renderer
+        enum
+        {
+            MaxFrameInterval = 1000000,
+        };
+
+        struct OSMAND_CORE_API StageSnapshot Q_DECL_FINAL
+        {
+            StageSnapshot();
+
+            // All durations are in seconds
+            unsigned int samplesCount;
+            float mean;
+            float p50;
+            float p90;
+            float p99;
+            float max;
+        };
+
+        struct OSMAND_CORE_API Snapshot Q_DECL_FINAL
+        {
+            Snapshot();
+
+            float targetFps;
+            float fps;
+            unsigned int framesCount;
+            unsigned int droppedFrames;
+            unsigned int totalFramesCount;
+            unsigned int totalDroppedFrames;
+            std::array<StageSnapshot, StagesCount> stages;
+
+            QString toString() const;
+        };
+
+    private:
+        struct Window
+        {
+            std::array<std::array<QAtomicInt, BucketsCount>, StagesCount> buckets;
+            std::array<QAtomicInt, StagesCount> samplesCount;
+            std::array<QAtomicInt, StagesCount> totalDuration;
+            std::array<QAtomicInt, StagesCount> maxDuration;
+            QAtomicInt framesCount;
+            QAtomicInt droppedFrames;
+            QAtomicInt intervalsCount;
+            QAtomicInt intervalsDuration;
+        };
+
+        std::array<Window, WindowsCount> _windows;
+        QAtomicInt _currentWindowIndex;
+        QAtomicInt _totalFramesCount;
+        QAtomicInt _totalDroppedFrames;
+        QAtomicInt _enabled;
+        QAtomicInt _targetFrameInterval;
+        std::chrono::high_resolution_clock::time_point _lastFrameStart;
+        bool _lastFrameStartValid;
+
+        void resetWindow(Window& window);
+        static unsigned int getBucketIndex(const int duration);
+        static float getBucketDuration(const unsigned int bucketIndex);
+    protected:
+    public:
+        MapRendererFrameTelemetry(const float targetFps = 60.0f);
+        ~MapRendererFrameTelemetry();
+
+        bool isEnabled() const;
+        void setEnabled(const bool enabled);
+
+        float getTargetFps() const;
+        void setTargetFps(const float targetFps);
+
+        // Called by renderer on render thread
+        void beginFrame();
+        void recordStage(const Stage stage, const float elapsedTime);
+        void endFrame(const float elapsedTime);
+
+        float getCurrentFps() const;
+        Snapshot getSnapshot() const;
+        void reset();
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_MAP_RENDERER_FRAME_TELEMETRY_H_)
@@ -0,0 +1,472 @@
+#ifndef _OSMAND_CORE_MAP_SYMBOLS_PLACEMENT_H_
+#define _OSMAND_CORE_MAP_SYMBOLS_PLACEMENT_H_
+
+#include <OsmAndCore/stdlib_common.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QString>
+#include <QSet>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QLinkedList>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/Common.h>
+#include <OsmAndCore/QtCommon.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/QuadTree.h>
+#include <OsmAndCore/Stopwatch.h>
+#include <OsmAndCore/Map/MapCommonTypes.h>
+#include <OsmAndCore/Map/MapSymbol.h>
+#include <OsmAndCore/Map/MapSymbolsGroup.h>
+#include <OsmAndCore/Map/MapSymbolIntersectionClassesRegistry.h>
+#include <OsmAndCore/Map/AtlasMapRendererConfiguration.h>
+
+namespace OsmAnd
+{
+    // Part of symbols placement that doesn't depend on GPU: decides which symbols, already projected
+    // on screen, survive visibility, intersection and min-distance-to-same-content checks and presentation
+    // modes of their groups. Renderer runs same Placer, so placement can be benchmarked without it.
+    struct OSMAND_CORE_API MapSymbolsPlacement Q_DECL_FINAL
+    {
+        typedef QuadTree<int, AreaI::CoordType>::BBox BBox;
+        typedef AtlasMapRendererConfiguration::SymbolsIntersectionsIndex IndexType;
+
+        enum class Check
+        {
+            Visibility,
+            IntersectionWithOtherSymbols,
+            MinDistanceToSameContent,
+            AddToIntersections,
+        };
+
+        struct GroupInstanceSymbol
+        {
+            const void* symbolPtr;
+            MapSymbol::ContentClass contentClass;
+        };
+
+        // Each candidate is a distinct symbol. Group instance consists of all candidates with same group and
+        // instance, in order they are given, and presentation mode of its first candidate applies to it.
+        struct OSMAND_CORE_API Candidate
+        {
+            Candidate();
+
+            const void* groupPtr;
+            const void* groupInstancePtr;
+            MapSymbolsGroup::PresentationMode presentationMode;
+            MapSymbol::ContentClass contentClass;
+            bool checkIntersectionsWithinGroup;
+            QSet<MapSymbolIntersectionClassId> intersectsWithClasses;
+            QString content;
+            float minDistance;
+            BBox visibleBBox;
+            BBox intersectionBBox;
+        };
+
+        struct OSMAND_CORE_API Result
+        {
+            Result();
+
+            QVector<int> acceptedCandidates;
+            unsigned int rejectedByVisibility;
+            unsigned int rejectedByIntersection;
+            unsigned int rejectedByMinDistance;
+            unsigned int rejectedByIndex;
+            unsigned int discardedByPresentationMode;
+            float elapsedTime;
+        };
+
+        // Checks if tested symbol should be rejected when intersecting other symbol
+        static inline bool intersectionApplies(
+            const bool checkIntersectionsWithinGroup,
+            const void* const symbolGroupPtr,
+            const void* const symbolGroupInstancePtr,
+            const QSet<MapSymbolIntersectionClassId>& symbolIntersectsWithClasses,
+            const bool symbolIntersectsWithAnyClass,
+            const void* const otherSymbolGroupPtr,
+            const void* const otherSymbolGroupInstancePtr,
+            const QSet<MapSymbolIntersectionClassId>& otherSymbolIntersectsWithClasses,
+            const MapSymbolIntersectionClassId anyClass)
+        {
+            // Symbols never intersect anything inside own group (different instances are treated as different groups)
+            if (!checkIntersectionsWithinGroup &&
+                symbolGroupPtr == otherSymbolGroupPtr &&
+                symbolGroupInstancePtr == otherSymbolGroupInstancePtr)
+            {
+                return false;
+            }
+
+            // Special case: tested symbol intersects any other symbol with at least 1 any class
+            if (symbolIntersectsWithAnyClass && !otherSymbolIntersectsWithClasses.isEmpty())
+                return true;
+
+            // Special case: other symbol intersects tested symbol with at least 1 any class (which is true already)
+            if (otherSymbolIntersectsWithClasses.contains(anyClass))
+                return true;
+
+            // General case:
+            return !(symbolIntersectsWithClasses & otherSymbolIntersectsWithClasses).isEmpty();
+        }
+
+        // Checks if tested symbol should be rejected when other symbol is closer than min distance
+        static inline bool sameContentApplies(
+            const void* const symbolGroupPtr,
+            const void* const symbolGroupInstancePtr,
+            const QString& symbolContent,
+            const void* const otherSymbolGroupPtr,
+            const void* const otherSymbolGroupInstancePtr,
+            const QString& otherSymbolContent)
+        {
+            if (symbolGroupPtr == otherSymbolGroupPtr && symbolGroupInstancePtr == otherSymbolGroupInstancePtr)
+                return false;
+
+            return (otherSymbolContent == symbolContent);
+        }
+
+        // Plots symbols into index in order of importance (most important first) and then discards symbols of
+        // group instances that don't satisfy presentation mode of their group. Entries of index are described
+        // by DELEGATE, that has to provide:
+        //  - const void* getGroupPtr(const ENTRY&) const, nullptr if symbol has no group
+        //  - const void* getGroupInstancePtr(const ENTRY&) const
+        //  - const void* getSymbolPtr(const ENTRY&) const
+        //  - MapSymbol::ContentClass getContentClass(const ENTRY&) const
+        //  - bool checksIntersectionsWithinGroup(const ENTRY&) const
+        //  - const QSet<MapSymbolIntersectionClassId>& getIntersectsWithClasses(const ENTRY&) const
+        //  - QString getContent(const ENTRY&) const
+        //  - float getMinDistance(const ENTRY&) const
+        //  - const BBox& getVisibleBBox(const ENTRY&) const
+        //  - const BBox& getIntersectionBBox(const ENTRY&) const
+        //  - bool obtainGroupInstance(const ENTRY&, MapSymbolsGroup::PresentationMode&, QList<GroupInstanceSymbol>&)
+        //    const, that describes group instance of entry and returns false if it has to be discarded entirely
+        //  - bool isCheckEnabled(const Check) const
+        //  - bool isTimingEnabled() const
+        //  - void onChecked(const ENTRY&, const Check, const bool passed, const float elapsedTime) const
+        //  - void onDiscarded(const ENTRY&) const
+        template<typename ENTRY, typename INDEX, typename DELEGATE>
+        class Placer Q_DECL_FINAL
+        {
+        public:
+            typedef typename INDEX::BBox BBox;
+            typedef QLinkedList<ENTRY> PlottedEntries;
+
+        private:
+            struct PlottedEntryRef
+            {
+                typename PlottedEntries::iterator iterator;
+                ENTRY entry;
+                bool isInIndex;
+            };
+            typedef QList<PlottedEntryRef> GroupInstanceRefs;
+            typedef QHash<const void*, GroupInstanceRefs> GroupInstancesRefs;
+
+            INDEX& _index;
+            const DELEGATE& _delegate;
+            const bool _keepDiscardedInIndex;
+            PlottedEntries _plottedEntries;
+            QHash<const void*, GroupInstancesRefs> _plottedEntriesByGroupAndInstance;
+
+            void discard(const PlottedEntryRef& entryRef)
+            {
+                _delegate.onDiscarded(entryRef.entry);
+
+                if (entryRef.isInIndex && !_keepDiscardedInIndex)
+                {
+                    const auto removed = _index.removeOne(entryRef.entry, _delegate.getIntersectionBBox(entryRef.entry));
+                    assert(removed);
+                    Q_UNUSED(removed);
+                }
+                _plottedEntries.erase(entryRef.iterator);
+            }
+
+            template<typename ACCEPTOR>
+            void discardIf(GroupInstanceRefs& groupInstanceRefs, const ACCEPTOR acceptor)
+            {
+                auto itEntryRef = mutableIteratorOf(groupInstanceRefs);
+                while (itEntryRef.hasNext())
+                {
+                    const auto& entryRef = itEntryRef.next();
+                    if (!acceptor(entryRef.entry))
+                        continue;
+
+                    discard(entryRef);
+                    itEntryRef.remove();
+                }
+            }
+
+            bool isPlotted(const GroupInstanceRefs& groupInstanceRefs, const void* const symbolPtr) const
+            {
+                for (const auto& entryRef : constOf(groupInstanceRefs))
+                {
+                    if (_delegate.getSymbolPtr(entryRef.entry) == symbolPtr)
+                        return true;
+                }
+                return false;
+            }
+
+            void addToPlotted(const ENTRY& entry, const bool isInIndex)
+            {
+                PlottedEntryRef entryRef;
+                entryRef.iterator = _plottedEntries.insert(_plottedEntries.end(), entry);
+                entryRef.entry = entry;
+                entryRef.isInIndex = isInIndex;
+                _plottedEntriesByGroupAndInstance[_delegate.getGroupPtr(entry)][_delegate.getGroupInstancePtr(entry)]
+                    .push_back(entryRef);
+            }
+
+            void applyPresentationMode(GroupInstanceRefs& groupInstanceRefs)
+            {
+                const auto alwaysTrue =
+                    []
+                    (const ENTRY& entry) -> bool
+                    {
+                        return true;
+                    };
+
+                MapSymbolsGroup::PresentationMode presentationMode;
+                QList<GroupInstanceSymbol> symbols;
+                if (!_delegate.obtainGroupInstance(groupInstanceRefs.first().entry, presentationMode, symbols))
+                {
+                    discardIf(groupInstanceRefs, alwaysTrue);
+                    return;
+                }
+
+                // Just skip all rules
+                if (presentationMode.isSet(MapSymbolsGroup::PresentationModeFlag::ShowAnything))
+                    return;
+
+                // Rule: show all symbols or no symbols
+                if (presentationMode.isSet(MapSymbolsGroup::PresentationModeFlag::ShowAllOrNothing))
+                {
+                    if (symbols.size() != groupInstanceRefs.size())
+                    {
+                        discardIf(groupInstanceRefs, alwaysTrue);
+                        return;
+                    }
+                }
+
+                // Rule: if there's icon, icon must always be visible. Otherwise discard entire group
+                if (presentationMode.isSet(MapSymbolsGroup::PresentationModeFlag::ShowNoneIfIconIsNotShown))
+                {
+                    for (const auto& symbol : constOf(symbols))
+                    {
+                        if (symbol.contentClass != MapSymbol::ContentClass::Icon)
+                            continue;
+
+                        if (!isPlotted(groupInstanceRefs, symbol.symbolPtr))
+                        {
+                            discardIf(groupInstanceRefs, alwaysTrue);
+                            return;
+                        }
+                        break;
+                    }
+                }
+
+                // Rule: if at least one caption was not shown, discard all other captions
+                if (presentationMode.isSet(MapSymbolsGroup::PresentationModeFlag::ShowAllCaptionsOrNoCaptions))
+                {
+                    auto captionsCount = 0;
+                    for (const auto& symbol : constOf(symbols))
+                    {
+                        if (symbol.contentClass == MapSymbol::ContentClass::Caption)
+                            captionsCount++;
+                    }
+
+                    auto captionsPlotted = 0;
+                    for (const auto& entryRef : constOf(groupInstanceRefs))
+                    {
+                        if (_delegate.getContentClass(entryRef.entry) == MapSymbol::ContentClass::Caption)
+                            captionsPlotted++;
+                    }
+
+                    if (captionsCount > 0 && captionsCount != captionsPlotted)
+                    {
+                        const auto& delegate = _delegate;
+                        discardIf(groupInstanceRefs,
+                            [&delegate]
+                            (const ENTRY& entry) -> bool
+                            {
+                                return delegate.getContentClass(entry) == MapSymbol::ContentClass::Caption;
+                            });
+                        if (groupInstanceRefs.isEmpty())
+                            return;
+                    }
+                }
+
+                // Rule: show anything until first map symbol from group was not plotted
+                if (presentationMode.isSet(MapSymbolsGroup::PresentationModeFlag::ShowAnythingUntilFirstGap))
+                {
+                    QSet<const void*> discardedSymbols;
+                    for (const auto& symbol : constOf(symbols))
+                    {
+                        if (discardedSymbols.isEmpty() && isPlotted(groupInstanceRefs, symbol.symbolPtr))
+                            continue;
+
+                        // In case this symbol was not plotted, discard all remaining symbol including this
+                        discardedSymbols.insert(symbol.symbolPtr);
+                    }
+
+                    if (!discardedSymbols.isEmpty())
+                    {
+                        const auto& delegate = _delegate;
+                        discardIf(groupInstanceRefs,
+                            [&delegate, &discardedSymbols]
+                            (const ENTRY& entry) -> bool
+                            {
+                                return discardedSymbols.contains(delegate.getSymbolPtr(entry));
+                            });
+                    }
+                }
+            }
+        public:
+            // Entries that were discarded by presentation mode are kept in index only for debugging purposes
+            Placer(INDEX& index, const DELEGATE& delegate, const bool keepDiscardedInIndex = false)
+                : _index(index)
+                , _delegate(delegate)
+                , _keepDiscardedInIndex(keepDiscardedInIndex)
+            {
+            }
+
+            // Returns true if entry passed all checks and was plotted
+            bool plot(const ENTRY& entry)
+            {
+                // Visibility
+                {
+                    Stopwatch stopwatch(_delegate.isTimingEnabled());
+
+                    const auto& visibleBBox = _delegate.getVisibleBBox(entry);
+                    const auto& rootArea = _index.rootArea();
+                    const auto mayBeVisible =
+                        visibleBBox.isContainedBy(rootArea) ||
+                        visibleBBox.isIntersectedBy(rootArea) ||
+                        visibleBBox.contains(rootArea);
+
+                    _delegate.onChecked(entry, Check::Visibility, mayBeVisible, stopwatch.elapsed());
+                    if (!mayBeVisible)
+                        return false;
+                }
+
+                const auto& intersectsWithClasses = _delegate.getIntersectsWithClasses(entry);
+                const auto& intersectionBBox = _delegate.getIntersectionBBox(entry);
+                const auto groupPtr = _delegate.getGroupPtr(entry);
+                const auto groupInstancePtr = _delegate.getGroupInstancePtr(entry);
+                const auto& delegate = _delegate;
+
+                // Intersections with other symbols
+                if (!intersectsWithClasses.isEmpty() && _delegate.isCheckEnabled(Check::IntersectionWithOtherSymbols))
+                {
+                    Stopwatch stopwatch(_delegate.isTimingEnabled());
+
+                    const auto checkIntersectionsWithinGroup = _delegate.checksIntersectionsWithinGroup(entry);
+                    const auto anyClass = MapSymbolIntersectionClassesRegistry::globalInstance().anyClass;
+                    const auto intersectsWithAnyClass = intersectsWithClasses.contains(anyClass);
+                    const auto intersects = _index.test(intersectionBBox, false,
+                        [&delegate, &intersectsWithClasses, checkIntersectionsWithinGroup, groupPtr, groupInstancePtr,
+                            intersectsWithAnyClass, anyClass]
+                        (const ENTRY& otherEntry, const BBox& otherBBox) -> bool
+                        {
+                            return intersectionApplies(
+                                checkIntersectionsWithinGroup,
+                                groupPtr,
+                                groupInstancePtr,
+                                intersectsWithClasses,
+                                intersectsWithAnyClass,
+                                delegate.getGroupPtr(otherEntry),
+                                delegate.getGroupInstancePtr(otherEntry),
+                                delegate.getIntersectsWithClasses(otherEntry),
+                                anyClass);
+                        });
+
+                    _delegate.onChecked(entry, Check::IntersectionWithOtherSymbols, !intersects, stopwatch.elapsed());
+                    if (intersects)
+                        return false;
+                }
+
+                // Min distance to same content
+                const auto minDistance = _delegate.getMinDistance(entry);
+                const auto content = _delegate.getContent(entry);
+                if (minDistance > 0.0f && !content.isNull() && _delegate.isCheckEnabled(Check::MinDistanceToSameContent))
+                {
+                    Stopwatch stopwatch(_delegate.isTimingEnabled());
+
+                    const auto hasSimilarContent = _index.test(intersectionBBox.getEnlargedBy(minDistance), false,
+                        [&delegate, &content, groupPtr, groupInstancePtr]
+                        (const ENTRY& otherEntry, const BBox& otherBBox) -> bool
+                        {
+                            return sameContentApplies(
+                                groupPtr,
+                                groupInstancePtr,
+                                content,
+                                delegate.getGroupPtr(otherEntry),
+                                delegate.getGroupInstancePtr(otherEntry),
+                                delegate.getContent(otherEntry));
+                        });
+
+                    _delegate.onChecked(entry, Check::MinDistanceToSameContent, !hasSimilarContent, stopwatch.elapsed());
+                    if (hasSimilarContent)
+                        return false;
+                }
+
+                // Symbols without intersection classes are transparent for other symbols
+                auto isInIndex = false;
+                if (!intersectsWithClasses.isEmpty() && _delegate.isCheckEnabled(Check::AddToIntersections))
+                {
+                    Stopwatch stopwatch(_delegate.isTimingEnabled());
+
+                    const auto inserted = _index.insert(entry, intersectionBBox);
+
+                    _delegate.onChecked(entry, Check::AddToIntersections, inserted, stopwatch.elapsed());
+                    if (!inserted)
+                        return false;
+                    isInIndex = true;
+                }
+
+                addToPlotted(entry, isInIndex);
+
+                return true;
+            }
+
+            // Plots entry that doesn't take part in intersections (e.g. symbol on surface of map) without any checks,
+            // it's still subject to presentation mode of its group
+            void plotWithoutChecks(const ENTRY& entry)
+            {
+                addToPlotted(entry, false);
+            }
+
+            // Each instance of group is treated as separate group
+            void applyPresentationModes()
+            {
+                for (auto& groupInstancesRefs : _plottedEntriesByGroupAndInstance)
+                {
+                    for (auto& groupInstanceRefs : groupInstancesRefs)
+                    {
+                        if (!groupInstanceRefs.isEmpty())
+                            applyPresentationMode(groupInstanceRefs);
+                    }
+                }
+                _plottedEntriesByGroupAndInstance.clear();
+            }
+
+            // Plotted entries in order they were plotted
+            const PlottedEntries& getPlottedEntries() const
+            {
+                return _plottedEntries;
+            }
+        };
+
+        // Places candidates in given order (most important first) within viewport
+        static Result place(
+            const AreaI& viewport,
+            const QList<Candidate>& candidates,
+            const IndexType indexType = IndexType::QuadTree);
+
+        // Depth of quad tree (and size of grid cells) is chosen so that smallest node is at least 64 pixels
+        static unsigned int getIndexDepth(const AreaI& viewport);
+        static AreaI::CoordType getIndexCellSize(const AreaI& viewport, const unsigned int depth);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_MAP_SYMBOLS_PLACEMENT_H_)
@@ -7,6 +7,7 @@
 
 #include <OsmAndCore/QtExtensions.h>
 #include <QList>
+#include <QVector>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
@@ -88,6 +89,16 @@ namespace OsmAnd
             const AreaI* const bbox31 = nullptr,
             const QHash<QString, QStringList>* const categoriesFilter = nullptr,
             const ObfPoiSectionReader::VisitorFunction visitor = nullptr,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric = nullptr);
+        // Sections are scanned from nearest to farthest one, and scan stops once collector has all amenities
+        // that are nearer than remaining sections
+        bool loadNearestAmenities(
+            ObfPoiSectionReader::NearestAmenitiesCollector& collector,
+            const ZoomLevel minZoom = MinZoomLevel,
+            const ZoomLevel maxZoom = MaxZoomLevel,
+            const AreaI* const bbox31 = nullptr,
+            const QHash<QString, QStringList>* const categoriesFilter = nullptr,
             const std::shared_ptr<const IQueryController>& queryController = nullptr);
         bool scanAmenitiesByName(
             const QString& query,
@@ -97,7 +108,8 @@ namespace OsmAnd
             const AreaI* const bbox31 = nullptr,
             const QHash<QString, QStringList>* const categoriesFilter = nullptr,
             const ObfPoiSectionReader::VisitorFunction visitor = nullptr,
-            const std::shared_ptr<const IQueryController>& queryController = nullptr);
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            const unsigned int maxEditDistance = 0);
 
         bool scanAddressesByName(
             const QString& query,
@@ -106,7 +118,8 @@ namespace OsmAnd
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter = fullObfAddressStreetGroupTypesMask(),
             const bool includeStreets = true,
             const ObfAddressSectionReader::VisitorFunction visitor = nullptr,
-            const std::shared_ptr<const IQueryController>& queryController = nullptr);
+            const std::shared_ptr<const IQueryController>& queryController = nullptr,
+            const unsigned int maxEditDistance = 0);
 
         bool loadStreetGroups(
             QList< std::shared_ptr<const StreetGroup> >* resultOut = nullptr,
@@ -135,6 +148,19 @@ namespace OsmAnd
             const AreaI* const bbox31 = nullptr,
             const ObfAddressSectionReader::IntersectionVisitorFunction visitor = nullptr,
             const std::shared_ptr<const IQueryController>& queryController = nullptr);
+
+        // Finds nearest building, street and settlement within maxDistance meters. Address sections are indexed
+        // on first use, so batch of positions (e.g. points of GPS track) is better resolved in one call.
+        bool reverseGeocode(
+            const PointI& position31,
+            ObfAddressSectionReader::ReverseGeocodingResult& outResult,
+            const double maxDistance = 1000.0,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr);
+        bool reverseGeocode(
+            const QVector<PointI>& positions31,
+            QVector<ObfAddressSectionReader::ReverseGeocodingResult>& outResults,
+            const double maxDistance = 1000.0,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr);
     };
 }
 
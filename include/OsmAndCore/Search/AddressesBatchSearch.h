@@ -0,0 +1,106 @@
+#ifndef _OSMAND_CORE_ADDRESSES_BATCH_SEARCH_H_
+#define _OSMAND_CORE_ADDRESSES_BATCH_SEARCH_H_
+
+#include <OsmAndCore/stdlib_common.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <QString>
+#include <QList>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/IObfsCollection.h>
+#include <OsmAndCore/Search/BaseSearch.h>
+
+class QThreadPool;
+
+namespace OsmAnd
+{
+    class Address;
+    class Building;
+
+    // Geocodes many addresses at once. Queries are grouped by region (bbox, zoom levels and address filters)
+    // and by first characters of normalized name. Name index of each section is scanned once per group, with
+    // common prefix of names of the group, and each query of group takes addresses that match its whole name
+    // from that scan. Buildings of each street are loaded once per group too. Groups are processed by tasks of
+    // thread pool, each of them with own readers, and callback is invoked from worker threads, one call at a time.
+    // Source filter can't be compared, so the one of first query of group is used. Typos are not tolerated,
+    // since candidates of name with typos are not found by its prefix.
+    class OSMAND_CORE_API AddressesBatchSearch Q_DECL_FINAL : public BaseSearch
+    {
+        Q_DISABLE_COPY_AND_MOVE(AddressesBatchSearch);
+    public:
+        enum
+        {
+            GroupingPrefixLength = 3,
+        };
+
+        struct OSMAND_CORE_API Criteria : public BaseSearch::Criteria
+        {
+            Criteria();
+            virtual ~Criteria();
+
+            QString name;
+            // When set, each street that matches name is resolved to its buildings with that number. Street
+            // that has no such building is returned alone.
+            QString houseNumber;
+            ObfAddressStreetGroupTypesMask streetGroupTypesMask;
+            bool includeStreets;
+        };
+
+        struct OSMAND_CORE_API ResultEntry : public IResultEntry
+        {
+            ResultEntry();
+            virtual ~ResultEntry();
+
+            // Index of query in batch
+            int queryIndex;
+            std::shared_ptr<const Address> address;
+            std::shared_ptr<const Building> building;
+        };
+
+        // Times of stages are sums over all workers, in seconds
+        struct OSMAND_CORE_API Statistics
+        {
+            Statistics();
+            ~Statistics();
+
+            unsigned int queriesCount;
+            unsigned int groupsCount;
+            unsigned int nameScansCount;
+            unsigned int candidatesCount;
+            unsigned int resultsCount;
+
+            float elapsedTime;
+            float elapsedTimeForGrouping;
+            float elapsedTimeForNameScans;
+            float elapsedTimeForMatching;
+            float elapsedTimeForBuildings;
+
+            float getQueriesPerSecond() const;
+            QString toString(const QString& prefix = QString::null) const;
+        };
+
+    private:
+        QThreadPool* const _threadPool;
+    protected:
+    public:
+        AddressesBatchSearch(
+            const std::shared_ptr<const IObfsCollection>& obfsCollection,
+            QThreadPool* const threadPool = nullptr);
+        virtual ~AddressesBatchSearch();
+
+        // Batch of single query
+        virtual void performSearch(
+            const ISearch::Criteria& criteria,
+            const NewResultEntryCallback newResultEntryCallback,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr) const;
+
+        Statistics performBatchSearch(
+            const QList<Criteria>& queries,
+            const NewResultEntryCallback newResultEntryCallback,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr) const;
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_ADDRESSES_BATCH_SEARCH_H_)
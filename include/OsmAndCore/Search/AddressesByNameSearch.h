@@ -25,6 +25,8 @@ namespace OsmAnd
             virtual ~Criteria();
 
             QString name;
+            // Allows up to that many typos in name (at most 2)
+            unsigned int maxEditDistance;
             ObfAddressStreetGroupTypesMask streetGroupTypesMask;
             bool includeStreets;
         };
@@ -39,6 +41,10 @@ namespace OsmAnd
 
     private:
     protected:
+        virtual std::shared_ptr<const ISearch::Criteria> copyCriteria(const ISearch::Criteria& criteria) const;
+        virtual std::shared_ptr<const IResultEntry> copyResultEntry(const IResultEntry& resultEntry) const;
+        virtual bool isNarrowing(const ISearch::Criteria& criteria, const ISearch::Criteria& previousCriteria) const;
+        virtual ResultEntryFilter createResultEntryFilter(const ISearch::Criteria& criteria) const;
     public:
         AddressesByNameSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection);
         virtual ~AddressesByNameSearch();
@@ -8,13 +8,20 @@
 #include <QHash>
 
 #include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/Nullable.h>
 #include <OsmAndCore/IObfsCollection.h>
 #include <OsmAndCore/Search/BaseSearch.h>
 
+class QThreadPool;
+
 namespace OsmAnd
 {
     class Amenity;
 
+    // Finds all amenities inside bbox, or, if reference point is given, only resultsLimit amenities nearest to it.
+    // Nearest amenities are searched in all OBFs at once (each file by separate task of thread pool) and are
+    // reported from nearest to farthest once search is complete.
     class OSMAND_CORE_API AmenitiesInAreaSearch Q_DECL_FINAL : public BaseSearch
     {
         Q_DISABLE_COPY_AND_MOVE(AmenitiesInAreaSearch);
@@ -25,6 +32,11 @@ namespace OsmAnd
             virtual ~Criteria();
 
             QHash<QString, QStringList> categoriesFilter;
+
+            Nullable<PointI> referencePoint31;
+            unsigned int resultsLimit;
+            // In meters
+            double maxDistance;
         };
 
         struct OSMAND_CORE_API ResultEntry : public IResultEntry
@@ -33,12 +45,22 @@ namespace OsmAnd
             virtual ~ResultEntry();
 
             std::shared_ptr<const Amenity> amenity;
+            // Distance to reference point in meters, if it was given
+            double distance;
         };
 
     private:
+        QThreadPool* const _threadPool;
+
+        void performNearestSearch(
+            const Criteria& criteria,
+            const NewResultEntryCallback newResultEntryCallback,
+            const std::shared_ptr<const IQueryController>& queryController) const;
     protected:
     public:
-        AmenitiesInAreaSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection);
+        AmenitiesInAreaSearch(
+            const std::shared_ptr<const IObfsCollection>& obfsCollection,
+            QThreadPool* const threadPool = nullptr);
         virtual ~AmenitiesInAreaSearch();
 
         virtual void performSearch(
@@ -4,6 +4,10 @@
 #include <OsmAndCore/stdlib_common.h>
 
 #include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QList>
+#include <QMutex>
+#include <OsmAndCore/restore_internal_warnings.h>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/Data/DataCommonTypes.h>
@@ -12,10 +16,67 @@
 namespace OsmAnd
 {
     class ObfDataInterface;
+    class SimpleQueryController;
 
     class OSMAND_CORE_API BaseSearch : public ISearch
     {
         Q_DISABLE_COPY_AND_MOVE(BaseSearch);
+    public:
+        // Sequence of searches made one after another, e.g. on each keystroke of autocomplete. Results of
+        // completed searches are remembered, so search with criteria that only narrow some previous criteria
+        // (e.g. query that extends previous query) filters those results instead of scanning data again.
+        // Starting new search aborts search of this session that is still running.
+        // Source filter of criteria can't be compared, so session has to be reset if it's changed.
+        // Search started in background keeps its session alive until it completes.
+        class OSMAND_CORE_API Session Q_DECL_FINAL : public std::enable_shared_from_this<Session>
+        {
+            Q_DISABLE_COPY_AND_MOVE(Session);
+        public:
+            enum
+            {
+                HistoryDepth = 8,
+                MaxRememberedResults = 10000,
+            };
+
+        private:
+            struct HistoryEntry
+            {
+                std::shared_ptr<const Criteria> criteria;
+                QList< std::shared_ptr<const IResultEntry> > results;
+            };
+
+            mutable QMutex _mutex;
+            QList<HistoryEntry> _history;
+            std::shared_ptr<SimpleQueryController> _activeQueryController;
+            unsigned int _performedSearchesCount;
+            unsigned int _refinedSearchesCount;
+        protected:
+            Session(const BaseSearch* const search);
+        public:
+            ~Session();
+
+            // Search is not owned by session and has to outlive it
+            const BaseSearch* const search;
+
+            void performSearch(
+                const Criteria& criteria,
+                const NewResultEntryCallback newResultEntryCallback,
+                const std::shared_ptr<const IQueryController>& queryController = nullptr);
+            void startSearch(
+                const Criteria& criteria,
+                const NewResultEntryCallback newResultEntryCallback,
+                const SearchCompletedCallback searchCompletedCallback,
+                QThreadPool* const threadPool,
+                const std::shared_ptr<const IQueryController>& queryController = nullptr);
+            void abort();
+            void reset();
+
+            unsigned int getPerformedSearchesCount() const;
+            unsigned int getRefinedSearchesCount() const;
+
+        friend class OsmAnd::BaseSearch;
+        };
+
     private:
     protected:
         BaseSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection);
@@ -23,6 +84,15 @@ namespace OsmAnd
         std::shared_ptr<ObfDataInterface> obtainDataInterface(
             const Criteria& criteria,
             const ObfDataTypesMask desiredDataTypes) const;
+
+        // Session support: if search can't copy criteria or result entries, each search of session is performed
+        // from scratch. Filter of remembered results is created once per refined search, so whatever it derives
+        // from criteria is computed once; no filter accepts all results.
+        typedef std::function<bool (const IResultEntry& resultEntry)> ResultEntryFilter;
+        virtual std::shared_ptr<const Criteria> copyCriteria(const Criteria& criteria) const;
+        virtual std::shared_ptr<const IResultEntry> copyResultEntry(const IResultEntry& resultEntry) const;
+        virtual bool isNarrowing(const Criteria& criteria, const Criteria& previousCriteria) const;
+        virtual ResultEntryFilter createResultEntryFilter(const Criteria& criteria) const;
     public:
         virtual ~BaseSearch();
 
@@ -35,6 +105,8 @@ namespace OsmAnd
             const SearchCompletedCallback searchCompletedCallback,
             QThreadPool* const threadPool,
             const std::shared_ptr<const IQueryController>& queryController = nullptr) const;
+
+        std::shared_ptr<Session> createSession() const;
     };
 }
 
@@ -0,0 +1,102 @@
+#ifndef _OSMAND_CORE_RANKED_BY_NAME_SEARCH_H_
+#define _OSMAND_CORE_RANKED_BY_NAME_SEARCH_H_
+
+#include <OsmAndCore/stdlib_common.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/Nullable.h>
+#include <OsmAndCore/IObfsCollection.h>
+#include <OsmAndCore/Search/BaseSearch.h>
+
+class QThreadPool;
+
+namespace OsmAnd
+{
+    class Amenity;
+    class Address;
+
+    // Searches amenities and addresses by name in all OBFs at once: each file is scanned by separate task of
+    // thread pool, candidates are ranked by quality of name match and distance to reference point, and only
+    // resultsLimit best ones are kept. Each candidate that gets into kept results is reported immediately, so
+    // results get better while search goes on (callback is invoked from worker threads, one call at a time).
+    // Files are scanned in order of best score they can possibly give, and file is skipped (or its scan is
+    // stopped) once it can't give anything better than worst of kept results.
+    class OSMAND_CORE_API RankedByNameSearch Q_DECL_FINAL : public BaseSearch
+    {
+        Q_DISABLE_COPY_AND_MOVE(RankedByNameSearch);
+    public:
+        struct OSMAND_CORE_API Criteria : public BaseSearch::Criteria
+        {
+            Criteria();
+            virtual ~Criteria();
+
+            QString name;
+            // Allows up to that many typos in name (at most 2)
+            unsigned int maxEditDistance;
+            Nullable<PointI> referencePoint31;
+            unsigned int resultsLimit;
+
+            bool includeAmenities;
+            QHash<QString, QStringList> categoriesFilter;
+
+            bool includeAddresses;
+            ObfAddressStreetGroupTypesMask streetGroupTypesMask;
+            bool includeStreets;
+        };
+
+        struct OSMAND_CORE_API ResultEntry : public IResultEntry
+        {
+            ResultEntry();
+            virtual ~ResultEntry();
+
+            // Either amenity or address is set
+            std::shared_ptr<const Amenity> amenity;
+            std::shared_ptr<const Address> address;
+
+            float nameMatchQuality;
+            double distance;
+            float score;
+        };
+
+        // Score is name match quality scaled by DistanceHalfScore / (DistanceHalfScore + distance in meters)
+        enum
+        {
+            DistanceHalfScore = 5000,
+        };
+
+    private:
+        QThreadPool* const _threadPool;
+    protected:
+    public:
+        RankedByNameSearch(
+            const std::shared_ptr<const IObfsCollection>& obfsCollection,
+            QThreadPool* const threadPool = nullptr);
+        virtual ~RankedByNameSearch();
+
+        virtual void performSearch(
+            const ISearch::Criteria& criteria,
+            const NewResultEntryCallback newResultEntryCallback,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr) const;
+
+        // Same as performSearch(), but also returns kept results ordered from best to worst
+        QList<ResultEntry> performRankedSearch(
+            const Criteria& criteria,
+            const NewResultEntryCallback newResultEntryCallback = nullptr,
+            const std::shared_ptr<const IQueryController>& queryController = nullptr) const;
+
+        // 1.0 for exact match, 0.75 if name starts with query, 0.5 if some word of name starts with query,
+        // 0.25 if name just contains query, 0.0 otherwise (both are normalized as set by
+        // ObfFile::setNameNormalization()). Names that match query only with typos are ranked with quality of 0.1.
+        static float computeNameMatchQuality(const QString& name, const QString& query);
+        static float computeScore(const float nameMatchQuality, const double distance);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_RANKED_BY_NAME_SEARCH_H_)
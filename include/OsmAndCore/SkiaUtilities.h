@@ -33,6 +33,15 @@ namespace OsmAnd
         static std::shared_ptr<SkBitmap> mergeBitmaps(
             const QList< std::shared_ptr<const SkBitmap> >& bitmaps);
 
+        // 64-bit FNV-1a hash of bitmap dimensions, format and pixels (row padding excluded)
+        static uint64_t computeContentHash(
+            const SkBitmap& bitmap);
+
+        // True if bitmaps have same dimensions, format and pixels (row padding excluded)
+        static bool haveSameContent(
+            const SkBitmap& bitmap,
+            const SkBitmap& otherBitmap);
+
     private:
         SkiaUtilities();
         ~SkiaUtilities();
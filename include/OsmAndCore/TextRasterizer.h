@@ -6,6 +6,7 @@
 
 #include <OsmAndCore/QtExtensions.h>
 #include <QList>
+#include <QString>
 
 #include <OsmAndCore.h>
 #include <OsmAndCore/CommonTypes.h>
@@ -135,6 +136,26 @@ namespace OsmAnd
 #endif // !defined(SWIG)
         };
 
+        struct CachesMetrics Q_DECL_FINAL
+        {
+            CachesMetrics();
+
+            // Checks whether typeface contains character
+            unsigned int glyphCoverageHits;
+            unsigned int glyphCoverageMisses;
+
+            // Lines that were split into runs of typefaces and measured
+            unsigned int linePaintsHits;
+            unsigned int linePaintsMisses;
+
+            // Fully rasterized texts
+            unsigned int bitmapsHits;
+            unsigned int bitmapsMisses;
+            size_t bitmapsSizeInBytes;
+
+            QString toString() const;
+        };
+
     private:
         PrivateImplementation<TextRasterizer_P> _p;
     protected:
@@ -162,6 +183,9 @@ namespace OsmAnd
             float* const outExtraBottomSpace = nullptr,
             float* const outLineSpacing = nullptr) const;
 
+        CachesMetrics getCachesMetrics() const;
+        void clearCaches() const;
+
         static std::shared_ptr<const TextRasterizer> getDefault();
         static std::shared_ptr<const TextRasterizer> getOnlySystemFonts();
     };
@@ -223,6 +223,18 @@ namespace OsmAnd
             return qSqrt(squareDistance31(a, b));
         }
 
+        // Distance to nearest point of area, zero for point inside of it
+        inline static double distance31(const PointI& point31, const AreaI& area31)
+        {
+            if (area31.contains(point31))
+                return 0.0;
+
+            const PointI nearestPoint31(
+                qBound(area31.left(), point31.x, area31.right()),
+                qBound(area31.top(), point31.y, area31.bottom()));
+            return distance31(point31, nearestPoint31);
+        }
+
         inline static double distance(const double xLonA, const double yLatA, const double xLonB, const double yLatB)
         {
             double R = 6371; // km
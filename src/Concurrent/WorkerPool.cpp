@@ -43,9 +43,9 @@ bool OsmAnd::Concurrent::WorkerPool::waitForDone(const int msecs /*= -1*/) const
     return _p->waitForDone(msecs);
 }
 
-void OsmAnd::Concurrent::WorkerPool::enqueue(QRunnable* const runnable)
+void OsmAnd::Concurrent::WorkerPool::enqueue(QRunnable* const runnable, const float priority /*= 0.0f*/)
 {
-    _p->enqueue(runnable);
+    _p->enqueue(runnable, priority);
 }
 
 bool OsmAnd::Concurrent::WorkerPool::dequeue(QRunnable* const runnable)
@@ -58,7 +58,27 @@ void OsmAnd::Concurrent::WorkerPool::dequeueAll()
     _p->dequeueAll();
 }
 
+void OsmAnd::Concurrent::WorkerPool::reprioritize(const PriorityEvaluator evaluator)
+{
+    _p->reprioritize(evaluator);
+}
+
+OsmAnd::Concurrent::WorkerPool::Statistics OsmAnd::Concurrent::WorkerPool::getStatistics(const bool reset /*= false*/) const
+{
+    return _p->getStatistics(reset);
+}
+
 void OsmAnd::Concurrent::WorkerPool::reset()
 {
     _p->reset();
 }
+
+OsmAnd::Concurrent::WorkerPool::Statistics::Statistics()
+    : queueSize(0)
+    , maxQueueSize(0)
+    , startedRunnables(0)
+    , coalescedRunnables(0)
+    , totalWaitTime(0.0f)
+    , maxWaitTime(0.0f)
+{
+}
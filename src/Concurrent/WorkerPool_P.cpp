@@ -4,6 +4,7 @@
 #include "QtExtensions.h"
 #include <QElapsedTimer>
 
+#include "Common.h"
 #include "Logging.h"
 
 OsmAnd::Concurrent::WorkerPool_P::WorkerPool_P(WorkerPool* const owner_, const Order order_, const int maxThreadCount_)
@@ -12,6 +13,7 @@ OsmAnd::Concurrent::WorkerPool_P::WorkerPool_P(WorkerPool* const owner_, const O
     , _isBeingReset(false)
     , owner(owner_)
 {
+    _timer.start();
 }
 
 OsmAnd::Concurrent::WorkerPool_P::~WorkerPool_P()
@@ -57,19 +59,40 @@ bool OsmAnd::Concurrent::WorkerPool_P::waitForDone(const int msecs) const
     return waitForDoneNoLock(msecs);
 }
 
-void OsmAnd::Concurrent::WorkerPool_P::enqueue(QRunnable* const runnable)
+void OsmAnd::Concurrent::WorkerPool_P::enqueue(QRunnable* const runnable, const float priority)
 {
     QMutexLocker scopedLocker(&_mutex);
-    
-    _queue.push_front(runnable);
+
+    // Same runnable that still waits in queue is not queued twice, only it's priority is raised
+    const auto existingEntryIndex = findQueueEntryNoLock(runnable);
+    if (existingEntryIndex >= 0)
+    {
+        auto& existingEntry = _queue[existingEntryIndex];
+        existingEntry.priority = qMax(existingEntry.priority, priority);
+        _statistics.coalescedRunnables++;
+        return;
+    }
+
+    QueueEntry entry;
+    entry.runnable = runnable;
+    entry.priority = priority;
+    entry.enqueuedAt = _timer.nsecsElapsed();
+    _queue.push_front(entry);
+    _statistics.maxQueueSize = qMax(_statistics.maxQueueSize, static_cast<unsigned int>(_queue.size()));
+
     tryLaunchNextRunnable();
 }
 
 bool OsmAnd::Concurrent::WorkerPool_P::dequeue(QRunnable* const runnable)
 {
     QMutexLocker scopedLocker(&_mutex);
-    
-    return _queue.removeOne(runnable);
+
+    const auto entryIndex = findQueueEntryNoLock(runnable);
+    if (entryIndex < 0)
+        return false;
+
+    _queue.removeAt(entryIndex);
+    return true;
 }
 
 void OsmAnd::Concurrent::WorkerPool_P::dequeueAll()
@@ -79,6 +102,30 @@ void OsmAnd::Concurrent::WorkerPool_P::dequeueAll()
     dequeueAllNoLock();
 }
 
+void OsmAnd::Concurrent::WorkerPool_P::reprioritize(const PriorityEvaluator evaluator)
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    for (auto& entry : _queue)
+        entry.priority = evaluator(entry.runnable, entry.priority);
+}
+
+OsmAnd::Concurrent::WorkerPool_P::Statistics OsmAnd::Concurrent::WorkerPool_P::getStatistics(const bool reset) const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    auto statistics = _statistics;
+    statistics.queueSize = _queue.size();
+
+    if (reset)
+    {
+        _statistics = Statistics();
+        _statistics.maxQueueSize = _queue.size();
+    }
+
+    return statistics;
+}
+
 void OsmAnd::Concurrent::WorkerPool_P::reset()
 {
     QMutexLocker scopedLocker(&_mutex);
@@ -158,17 +205,54 @@ QRunnable* OsmAnd::Concurrent::WorkerPool_P::takeNextRunnable()
     if (_queue.isEmpty())
         return nullptr;
 
+    int entryIndex;
     switch (order())
     {
         case Order::FIFO:
-            return _queue.takeLast();
+            entryIndex = _queue.size() - 1;
+            break;
         case Order::LIFO:
-            return _queue.takeFirst();
+            entryIndex = 0;
+            break;
         case Order::Random:
-            return _queue.takeAt(qrand() % _queue.size());
+            entryIndex = qrand() % _queue.size();
+            break;
+        case Order::ByPriority:
+        {
+            // Queue is ordered from latest to earliest, so first of equal ones is the latest
+            entryIndex = 0;
+            const auto queueSize = _queue.size();
+            for (auto index = 1; index < queueSize; index++)
+            {
+                if (_queue[index].priority > _queue[entryIndex].priority)
+                    entryIndex = index;
+            }
+            break;
+        }
         default:
             return nullptr;
     }
+
+    const auto entry = _queue.takeAt(entryIndex);
+
+    const auto waitTime = static_cast<float>(_timer.nsecsElapsed() - entry.enqueuedAt) / 1000000000.0f;
+    _statistics.startedRunnables++;
+    _statistics.totalWaitTime += waitTime;
+    _statistics.maxWaitTime = qMax(_statistics.maxWaitTime, waitTime);
+
+    return entry.runnable;
+}
+
+int OsmAnd::Concurrent::WorkerPool_P::findQueueEntryNoLock(const QRunnable* const runnable) const
+{
+    const auto queueSize = _queue.size();
+    for (auto index = 0; index < queueSize; index++)
+    {
+        if (_queue[index].runnable == runnable)
+            return index;
+    }
+
+    return -1;
 }
 
 bool OsmAnd::Concurrent::WorkerPool_P::tooManyThreadsActive() const
@@ -179,10 +263,10 @@ bool OsmAnd::Concurrent::WorkerPool_P::tooManyThreadsActive() const
 
 void OsmAnd::Concurrent::WorkerPool_P::dequeueAllNoLock()
 {
-    for (auto runnable : _queue)
+    for (const auto& entry : constOf(_queue))
     {
-        if (runnable->autoDelete())
-            delete runnable;
+        if (entry.runnable->autoDelete())
+            delete entry.runnable;
     }
     _queue.clear();
 }
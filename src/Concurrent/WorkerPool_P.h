@@ -11,6 +11,7 @@
 #include <QThread>
 #include <QSet>
 #include <QQueue>
+#include <QElapsedTimer>
 
 #include "OsmAndCore.h"
 #include "PrivateImplementation.h"
@@ -26,6 +27,8 @@ namespace OsmAnd
 
         public:
             typedef WorkerPool::Order Order;
+            typedef WorkerPool::PriorityEvaluator PriorityEvaluator;
+            typedef WorkerPool::Statistics Statistics;
 
         private:
             class WorkerThread Q_DECL_FINAL : public QThread
@@ -50,8 +53,17 @@ namespace OsmAnd
             QAtomicInt _order;
             QAtomicInt _maxThreadCount;
 
+            struct QueueEntry
+            {
+                QRunnable* runnable;
+                float priority;
+                qint64 enqueuedAt;
+            };
+
             mutable QMutex _mutex;
-            QList<QRunnable*> _queue;
+            QList<QueueEntry> _queue;
+            QElapsedTimer _timer;
+            mutable Statistics _statistics;
             QSet<WorkerThread*> _allThreads;
             QQueue<WorkerThread*> _freeThreads;
             QQueue<WorkerThread*> _inactiveThreads;
@@ -63,6 +75,7 @@ namespace OsmAnd
             bool tryLaunchNextRunnable();
             void tryLaunchNextRunnables();
             QRunnable* takeNextRunnable();
+            int findQueueEntryNoLock(const QRunnable* const runnable) const;
             bool tooManyThreadsActive() const;
             bool waitForDoneNoLock(const int msecs) const;
             void dequeueAllNoLock();
@@ -82,9 +95,12 @@ namespace OsmAnd
 
             bool waitForDone(const int msecs) const;
 
-            void enqueue(QRunnable* const runnable);
+            void enqueue(QRunnable* const runnable, const float priority);
             bool dequeue(QRunnable* const runnable);
             void dequeueAll();
+            void reprioritize(const PriorityEvaluator evaluator);
+
+            Statistics getStatistics(const bool reset) const;
 
             void reset();
 
@@ -0,0 +1,226 @@
+#include "ObfAddressHierarchyCache.h"
+
+#include "stdlib_common.h"
+#include <limits>
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QMutexLocker>
+#include "restore_internal_warnings.h"
+
+#include "Common.h"
+#include "ObfAddressSectionInfo.h"
+#include "StreetGroup.h"
+#include "Street.h"
+#include "Building.h"
+#include "StreetIntersection.h"
+
+namespace OsmAnd
+{
+    namespace ObfAddressHierarchyCache_P
+    {
+        static int estimateSize(const QString& string)
+        {
+            return string.size() * sizeof(QChar);
+        }
+
+        static int estimateSize(const QHash<QString, QString>& strings)
+        {
+            auto size = 0;
+            for (const auto& stringsEntry : rangeOf(constOf(strings)))
+                size += 2 * sizeof(QString) + estimateSize(stringsEntry.key()) + estimateSize(stringsEntry.value());
+            return size;
+        }
+
+        // Objects are referenced by shared pointers, each of which has its own control block
+        enum
+        {
+            SharedPointerOverhead = 2 * sizeof(void*),
+        };
+    }
+}
+
+OsmAnd::ObfAddressHierarchyCache::ObfAddressHierarchyCache()
+    : _cache(0)
+{
+}
+
+OsmAnd::ObfAddressHierarchyCache::~ObfAddressHierarchyCache()
+{
+}
+
+OsmAnd::ObfAddressHierarchyCache::CachedEntry::CachedEntry(
+    const std::shared_ptr<const Entry>& entry_,
+    QList< std::shared_ptr<const Entry> >& releasedEntries_)
+    : entry(entry_)
+    , releasedEntries(releasedEntries_)
+{
+}
+
+OsmAnd::ObfAddressHierarchyCache::CachedEntry::~CachedEntry()
+{
+    releasedEntries.push_back(qMove(entry));
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::isEnabled() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return _cache.maxCost() > 0;
+}
+
+size_t OsmAnd::ObfAddressHierarchyCache::getCapacity() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return static_cast<size_t>(_cache.maxCost());
+}
+
+void OsmAnd::ObfAddressHierarchyCache::setCapacity(const size_t capacityInBytes)
+{
+    // Destroyed after locker, so evicted entries are released unlocked
+    QList< std::shared_ptr<const Entry> > releasedEntries;
+    QMutexLocker scopedLocker(&_mutex);
+
+    _cache.setMaxCost(static_cast<int>(qMin(capacityInBytes, static_cast<size_t>(std::numeric_limits<int>::max()))));
+    releasedEntries.swap(_releasedEntries);
+}
+
+void OsmAnd::ObfAddressHierarchyCache::clear()
+{
+    QList< std::shared_ptr<const Entry> > releasedEntries;
+    QMutexLocker scopedLocker(&_mutex);
+
+    _cache.clear();
+    _statistics = ObfAddressSectionReader::HierarchyCacheStatistics();
+    releasedEntries.swap(_releasedEntries);
+}
+
+void OsmAnd::ObfAddressHierarchyCache::removeEntriesOf(const ObfAddressSectionInfo& section)
+{
+    QList< std::shared_ptr<const Entry> > releasedEntries;
+    QMutexLocker scopedLocker(&_mutex);
+
+    for (const auto& key : constOf(_cache.keys()))
+    {
+        if (key.sectionId == section.runtimeGeneratedId)
+            _cache.remove(key);
+    }
+    releasedEntries.swap(_releasedEntries);
+}
+
+OsmAnd::ObfAddressSectionReader::HierarchyCacheStatistics OsmAnd::ObfAddressHierarchyCache::getStatistics() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    auto statistics = _statistics;
+    statistics.entriesCount = _cache.count();
+    statistics.usedBytes = _cache.totalCost();
+    statistics.capacityInBytes = _cache.maxCost();
+    return statistics;
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::contains(const Key& key) const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return _cache.contains(key);
+}
+
+std::shared_ptr<const OsmAnd::ObfAddressHierarchyCache::Entry> OsmAnd::ObfAddressHierarchyCache::obtain(
+    const Key& key)
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    const auto pEntry = _cache.object(key);
+    if (!pEntry)
+    {
+        _statistics.misses++;
+        return nullptr;
+    }
+
+    _statistics.hits++;
+    return pEntry->entry;
+}
+
+void OsmAnd::ObfAddressHierarchyCache::insert(
+    const Key& key,
+    const std::shared_ptr<const Entry>& entry,
+    const bool prefetched /*= false*/)
+{
+    const auto size = estimateSize(*entry);
+
+    QList< std::shared_ptr<const Entry> > releasedEntries;
+    QMutexLocker scopedLocker(&_mutex);
+
+    // Entry larger than whole capacity is not kept, QCache deletes it right away
+    const auto inserted = _cache.insert(key, new CachedEntry(entry, _releasedEntries), size);
+    if (inserted && prefetched)
+        _statistics.prefetchedEntries++;
+    releasedEntries.swap(_releasedEntries);
+}
+
+int OsmAnd::ObfAddressHierarchyCache::estimateSize(const Entry& entry)
+{
+    using namespace ObfAddressHierarchyCache_P;
+
+    auto size = static_cast<int>(sizeof(Entry));
+    for (const auto& streetGroup : constOf(entry.streetGroups))
+    {
+        size += sizeof(StreetGroup) + SharedPointerOverhead +
+            estimateSize(streetGroup->nativeName) + estimateSize(streetGroup->localizedNames);
+    }
+    for (const auto& street : constOf(entry.streets))
+    {
+        size += sizeof(Street) + SharedPointerOverhead +
+            estimateSize(street->nativeName) + estimateSize(street->localizedNames);
+    }
+    for (const auto& building : constOf(entry.buildings))
+    {
+        size += sizeof(Building) + SharedPointerOverhead +
+            estimateSize(building->nativeName) + estimateSize(building->localizedNames) +
+            estimateSize(building->postcode) +
+            estimateSize(building->interpolationNativeName) + estimateSize(building->interpolationLocalizedNames);
+    }
+    for (const auto& intersection : constOf(entry.intersections))
+    {
+        size += sizeof(StreetIntersection) + SharedPointerOverhead +
+            estimateSize(intersection->nativeName) + estimateSize(intersection->localizedNames);
+    }
+    return size;
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::fitsBBox(const StreetGroup& streetGroup, const AreaI& bbox31)
+{
+    return bbox31.contains(streetGroup.position31);
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::fitsBBox(const Street& street, const AreaI& bbox31)
+{
+    return bbox31.contains(street.position31);
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::fitsBBox(const Building& building, const AreaI& bbox31)
+{
+    // Building with interpolation spans both of its ends
+    AreaI buildingBBox31(building.position31, building.position31);
+    if (building.interpolationPosition31 != PointI())
+        buildingBBox31.enlargeToInclude(building.interpolationPosition31);
+
+    return
+        buildingBBox31.contains(bbox31) ||
+        buildingBBox31.intersects(bbox31) ||
+        bbox31.contains(buildingBBox31);
+}
+
+bool OsmAnd::ObfAddressHierarchyCache::fitsBBox(const StreetIntersection& intersection, const AreaI& bbox31)
+{
+    return bbox31.contains(intersection.position31);
+}
+
+OsmAnd::ObfAddressHierarchyCache& OsmAnd::ObfAddressHierarchyCache::getInstance()
+{
+    // Never destroyed, since files may be unloaded during exit after function-local statics are gone
+    static ObfAddressHierarchyCache* const instance = new ObfAddressHierarchyCache();
+    return *instance;
+}
@@ -0,0 +1,139 @@
+#ifndef _OSMAND_CORE_OBF_ADDRESS_HIERARCHY_CACHE_H_
+#define _OSMAND_CORE_OBF_ADDRESS_HIERARCHY_CACHE_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QList>
+#include <QCache>
+#include <QMutex>
+#include "restore_internal_warnings.h"
+
+#include "OsmAndCore.h"
+#include "CommonTypes.h"
+#include "DataCommonTypes.h"
+#include "ObfAddressSectionReader.h"
+
+namespace OsmAnd
+{
+    class ObfAddressSectionInfo;
+
+    // Decoded address objects: street groups of given type of section, streets of street group, buildings or
+    // intersections of street. Entries are keyed by section and type of street groups or offset of parent, so
+    // they are found no matter which instance of parent is used to look them up, and are evicted least recently
+    // used first once their estimated size exceeds capacity. Sections are identified by runtime-generated id rather
+    // than address, and entries of file are removed when its info is destroyed, so cache never keeps sections of
+    // unloaded files alive. Entries are complete (not filtered by bbox) and immutable, so they can be shared by any
+    // number of threads.
+    class ObfAddressHierarchyCache Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(ObfAddressHierarchyCache);
+    public:
+        enum class EntryType : int
+        {
+            StreetGroups,
+            Streets,
+            Buildings,
+            Intersections,
+        };
+
+        struct Key
+        {
+            // Runtime-generated id of section
+            int sectionId;
+            // Type of street groups for entries of street groups
+            uint32_t offset;
+            EntryType type;
+
+            inline bool operator==(const Key& that) const
+            {
+                return sectionId == that.sectionId && offset == that.offset && type == that.type;
+            }
+        };
+
+        struct Entry
+        {
+            QList< std::shared_ptr<const StreetGroup> > streetGroups;
+            QList< std::shared_ptr<const Street> > streets;
+            QList< std::shared_ptr<const Building> > buildings;
+            QList< std::shared_ptr<const StreetIntersection> > intersections;
+        };
+
+    private:
+        // QCache owns its objects and may delete them on any insert, so only references to entries are kept in it.
+        // Evicted references are moved aside and released after unlocking, since releasing last reference to
+        // entry destroys decoded objects and maybe their section.
+        struct CachedEntry
+        {
+            CachedEntry(const std::shared_ptr<const Entry>& entry, QList< std::shared_ptr<const Entry> >& releasedEntries);
+            ~CachedEntry();
+
+            std::shared_ptr<const Entry> entry;
+            QList< std::shared_ptr<const Entry> >& releasedEntries;
+        };
+
+        mutable QMutex _mutex;
+        // Declared before cache, since cache moves its entries here when destroyed
+        QList< std::shared_ptr<const Entry> > _releasedEntries;
+        QCache< Key, CachedEntry > _cache;
+        ObfAddressSectionReader::HierarchyCacheStatistics _statistics;
+
+        static int estimateSize(const Entry& entry);
+
+        static bool fitsBBox(const StreetGroup& streetGroup, const AreaI& bbox31);
+        static bool fitsBBox(const Street& street, const AreaI& bbox31);
+        static bool fitsBBox(const Building& building, const AreaI& bbox31);
+        static bool fitsBBox(const StreetIntersection& intersection, const AreaI& bbox31);
+    protected:
+    public:
+        ObfAddressHierarchyCache();
+        ~ObfAddressHierarchyCache();
+
+        bool isEnabled() const;
+        size_t getCapacity() const;
+        void setCapacity(const size_t capacityInBytes);
+        void clear();
+        void removeEntriesOf(const ObfAddressSectionInfo& section);
+
+        ObfAddressSectionReader::HierarchyCacheStatistics getStatistics() const;
+
+        // Lookups are counted in statistics, unlike checks
+        bool contains(const Key& key) const;
+        std::shared_ptr<const Entry> obtain(const Key& key);
+        void insert(const Key& key, const std::shared_ptr<const Entry>& entry, const bool prefetched = false);
+
+        // Same filtering by bbox and visiting as decoding objects of entry from file would do
+        template<typename OBJECT, typename VISITOR>
+        static void visit(
+            const QList< std::shared_ptr<const OBJECT> >& objects,
+            QList< std::shared_ptr<const OBJECT> >* resultOut,
+            const AreaI* const bbox31,
+            const VISITOR& visitor)
+        {
+            for (const auto& object : objects)
+            {
+                if (bbox31 && !fitsBBox(*object, *bbox31))
+                    continue;
+
+                if (!visitor || visitor(object))
+                {
+                    if (resultOut)
+                        resultOut->push_back(object);
+                }
+            }
+        }
+
+        // Process-wide instance shared by all readers
+        static ObfAddressHierarchyCache& getInstance();
+    };
+
+    inline uint qHash(const ObfAddressHierarchyCache::Key& key, uint seed = 0) Q_DECL_NOTHROW
+    {
+        return qHash(key.sectionId, seed) ^
+            qHash(key.offset) ^
+            (static_cast<uint>(key.type) << 29);
+    }
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_ADDRESS_HIERARCHY_CACHE_H_)
@@ -1,4 +1,5 @@
 #include "ObfAddressSectionInfo.h"
+#include "ObfAddressSectionInfo_P.h"
 
 #include "ignore_warnings_on_external_includes.h"
 #include "OBF.pb.h"
@@ -16,6 +17,7 @@ static_assert(
 
 OsmAnd::ObfAddressSectionInfo::ObfAddressSectionInfo(const std::shared_ptr<const ObfInfo>& container_)
     : ObfSectionInfo(container_)
+    , _p(new ObfAddressSectionInfo_P(this))
     , nameIndexInnerOffset(0)
     , firstStreetGroupInnerOffset(0)
 {
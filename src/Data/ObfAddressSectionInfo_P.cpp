@@ -0,0 +1,15 @@
+#include "ObfAddressSectionInfo_P.h"
+#include "ObfAddressSectionInfo.h"
+
+#include "ObfIndexedStringTable.h"
+#include "ObfNameNGramIndex.h"
+#include "ObfAddressSpatialIndex.h"
+
+OsmAnd::ObfAddressSectionInfo_P::ObfAddressSectionInfo_P(ObfAddressSectionInfo* owner_)
+    : owner(owner_)
+{
+}
+
+OsmAnd::ObfAddressSectionInfo_P::~ObfAddressSectionInfo_P()
+{
+}
@@ -0,0 +1,50 @@
+#ifndef _OSMAND_CORE_OBF_ADDRESS_SECTION_INFO_P_H_
+#define _OSMAND_CORE_OBF_ADDRESS_SECTION_INFO_P_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QMutex>
+#include <QAtomicInt>
+#include "restore_internal_warnings.h"
+
+#include "OsmAndCore.h"
+#include "PrivateImplementation.h"
+
+namespace OsmAnd
+{
+    class ObfIndexedStringTable;
+    class ObfNameNGramIndex;
+    class ObfAddressSpatialIndex;
+    class ObfAddressSectionReader_P;
+
+    class ObfAddressSectionInfo;
+    class ObfAddressSectionInfo_P Q_DECL_FINAL
+    {
+    private:
+    protected:
+        ObfAddressSectionInfo_P(ObfAddressSectionInfo* owner);
+
+        mutable std::shared_ptr<const ObfIndexedStringTable> _nameIndex;
+        mutable QAtomicInt _nameIndexLoaded;
+        mutable QMutex _nameIndexLoadMutex;
+
+        mutable std::shared_ptr<const ObfNameNGramIndex> _nameNGramIndex;
+        mutable QAtomicInt _nameNGramIndexLoaded;
+        mutable QMutex _nameNGramIndexLoadMutex;
+
+        mutable std::shared_ptr<const ObfAddressSpatialIndex> _spatialIndex;
+        mutable QAtomicInt _spatialIndexLoaded;
+        mutable QMutex _spatialIndexLoadMutex;
+    public:
+        virtual ~ObfAddressSectionInfo_P();
+
+        ImplementationInterface<ObfAddressSectionInfo> owner;
+
+    friend class OsmAnd::ObfAddressSectionInfo;
+    friend class OsmAnd::ObfAddressSectionReader_P;
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_ADDRESS_SECTION_INFO_P_H_)
@@ -2,6 +2,7 @@
 #include "ObfAddressSectionReader_P.h"
 
 #include "ObfReader.h"
+#include "ObfAddressHierarchyCache.h"
 
 OsmAnd::ObfAddressSectionReader::ObfAddressSectionReader()
 {
@@ -90,12 +91,14 @@ void OsmAnd::ObfAddressSectionReader::scanAddressesByName(
     const ObfAddressStreetGroupTypesMask streetGroupTypesFilter /*= fullObfAddressStreetGroupTypesMask()*/,
     const bool includeStreets /*= true*/,
     const ObfAddressSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    const unsigned int maxEditDistance /*= 0*/)
 {
     ObfAddressSectionReader_P::scanAddressesByName(
         *reader->_p,
         section,
         query,
+        maxEditDistance,
         outAddresses,
         bbox31,
         streetGroupTypesFilter,
@@ -103,3 +106,71 @@ void OsmAnd::ObfAddressSectionReader::scanAddressesByName(
         visitor,
         queryController);
 }
+
+void OsmAnd::ObfAddressSectionReader::reverseGeocode(
+    const std::shared_ptr<const ObfReader>& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    const QVector<PointI>& positions31,
+    QVector<ReverseGeocodingResult>& outResults,
+    const double maxDistance,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    ObfAddressSectionReader_P::reverseGeocode(
+        *reader->_p,
+        section,
+        positions31,
+        outResults,
+        maxDistance,
+        queryController);
+}
+
+OsmAnd::ObfAddressSectionReader::ReverseGeocodingResult::ReverseGeocodingResult()
+    : buildingDistance(0.0)
+    , streetDistance(0.0)
+    , streetGroupDistance(0.0)
+{
+}
+
+OsmAnd::ObfAddressSectionReader::ReverseGeocodingResult::~ReverseGeocodingResult()
+{
+}
+
+size_t OsmAnd::ObfAddressSectionReader::getHierarchyCacheCapacity()
+{
+    return ObfAddressHierarchyCache::getInstance().getCapacity();
+}
+
+void OsmAnd::ObfAddressSectionReader::setHierarchyCacheCapacity(const size_t capacityInBytes)
+{
+    ObfAddressHierarchyCache::getInstance().setCapacity(capacityInBytes);
+}
+
+OsmAnd::ObfAddressSectionReader::HierarchyCacheStatistics OsmAnd::ObfAddressSectionReader::getHierarchyCacheStatistics()
+{
+    return ObfAddressHierarchyCache::getInstance().getStatistics();
+}
+
+void OsmAnd::ObfAddressSectionReader::clearHierarchyCache()
+{
+    ObfAddressHierarchyCache::getInstance().clear();
+}
+
+OsmAnd::ObfAddressSectionReader::HierarchyCacheStatistics::HierarchyCacheStatistics()
+    : hits(0)
+    , misses(0)
+    , prefetchedEntries(0)
+    , entriesCount(0)
+    , usedBytes(0)
+    , capacityInBytes(0)
+{
+}
+
+OsmAnd::ObfAddressSectionReader::HierarchyCacheStatistics::~HierarchyCacheStatistics()
+{
+}
+
+float OsmAnd::ObfAddressSectionReader::HierarchyCacheStatistics::getHitRate() const
+{
+    const auto lookups = hits + misses;
+    return (lookups > 0) ? static_cast<float>(hits) / lookups : 0.0f;
+}
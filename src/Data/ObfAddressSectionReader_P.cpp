@@ -13,6 +13,12 @@
 #include "ObfReader.h"
 #include "ObfReader_P.h"
 #include "ObfAddressSectionInfo.h"
+#include "ObfAddressSectionInfo_P.h"
+#include "ObfFile.h"
+#include "ObfIndexedStringTable.h"
+#include "ObfNameNGramIndex.h"
+#include "ObfNameNormalizer.h"
+#include "ObfAddressSpatialIndex.h"
 #include "StreetGroup.h"
 #include "Street.h"
 #include "Building.h"
@@ -762,6 +768,8 @@ void OsmAnd::ObfAddressSectionReader_P::readAddressesByName(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfAddressSectionInfo>& section,
     const QString& query,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     QList< std::shared_ptr<const OsmAnd::Address> >* outAddresses,
     const AreaI* const bbox31,
     const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
@@ -791,7 +799,10 @@ void OsmAnd::ObfAddressSectionReader_P::readAddressesByName(
 
                 scanNameIndex(
                     reader,
+                    section,
                     query,
+                    normalization,
+                    maxEditDistance,
                     indexReferences,
                     bbox31,
                     streetGroupTypesFilter,
@@ -852,16 +863,17 @@ void OsmAnd::ObfAddressSectionReader_P::readAddressesByName(
 
                         if (!query.isNull())
                         {
-                            bool accept = false;
-                            accept = accept || street->nativeName.contains(query, Qt::CaseInsensitive);
-                            for (const auto& localizedName : constOf(street->localizedNames))
-                            {
-                                accept = accept || localizedName.contains(query, Qt::CaseInsensitive);
-
-                                if (accept)
-                                    break;
-                            }
-
+                            street->normalizedNames = ObfNameNormalizer::normalizeNames(
+                                street->nativeName,
+                                street->localizedNames,
+                                normalization);
+                            const auto accept = ObfNameNormalizer::anyNameContains(
+                                street->nativeName,
+                                street->localizedNames,
+                                street->normalizedNames,
+                                query,
+                                normalization,
+                                maxEditDistance);
                             if (!accept)
                                 continue;
                         }
@@ -892,16 +904,17 @@ void OsmAnd::ObfAddressSectionReader_P::readAddressesByName(
 
                         if (!query.isNull())
                         {
-                            bool accept = false;
-                            accept = accept || streetGroup->nativeName.contains(query, Qt::CaseInsensitive);
-                            for (const auto& localizedName : constOf(streetGroup->localizedNames))
-                            {
-                                accept = accept || localizedName.contains(query, Qt::CaseInsensitive);
-
-                                if (accept)
-                                    break;
-                            }
-
+                            streetGroup->normalizedNames = ObfNameNormalizer::normalizeNames(
+                                streetGroup->nativeName,
+                                streetGroup->localizedNames,
+                                normalization);
+                            const auto accept = ObfNameNormalizer::anyNameContains(
+                                streetGroup->nativeName,
+                                streetGroup->localizedNames,
+                                streetGroup->normalizedNames,
+                                query,
+                                normalization,
+                                maxEditDistance);
                             if (!accept)
                                 continue;
                         }
@@ -933,9 +946,37 @@ void OsmAnd::ObfAddressSectionReader_P::readAddressesByName(
     }
 }
 
+std::shared_ptr<const OsmAnd::ObfIndexedStringTable> OsmAnd::ObfAddressSectionReader_P::obtainNameIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section)
+{
+    return ObfIndexedStringTable::obtainResident(
+        reader.getCodedInputStream().get(),
+        section->_p->_nameIndexLoadMutex,
+        section->_p->_nameIndexLoaded,
+        section->_p->_nameIndex);
+}
+
+std::shared_ptr<const OsmAnd::ObfNameNGramIndex> OsmAnd::ObfAddressSectionReader_P::obtainNameNGramIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section)
+{
+    // Built from resident name index, so table at current position is consumed in any case
+    const auto nameIndex = obtainNameIndex(reader, section);
+
+    return ObfNameNGramIndex::obtainResident(
+        *nameIndex,
+        section->_p->_nameNGramIndexLoadMutex,
+        section->_p->_nameNGramIndexLoaded,
+        section->_p->_nameNGramIndex);
+}
+
 void OsmAnd::ObfAddressSectionReader_P::scanNameIndex(
     const ObfReader_P& reader,
-    const QString& query,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    const QString& normalizedQuery,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     QVector<AddressReference>& outAddressReferences,
     const AreaI* const bbox31,
     const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
@@ -963,7 +1004,13 @@ void OsmAnd::ObfAddressSectionReader_P::scanNameIndex(
                 baseOffset = cis->CurrentPosition();
                 const auto oldLimit = cis->PushLimit(length);
 
-                ObfReaderUtilities::scanIndexedStringTable(cis, query, intermediateOffsets);
+                // Query was folded by caller, so resident and streamed tables are scanned with same string
+                if (maxEditDistance > 0)
+                    obtainNameNGramIndex(reader, section)->scan(normalizedQuery, maxEditDistance, intermediateOffsets);
+                else if (ObfFile::isResidentNameIndexEnabled() || !ObfNameNormalizer::isCaseFoldingOnly(normalization))
+                    obtainNameIndex(reader, section)->scan(normalizedQuery, intermediateOffsets);
+                else
+                    ObfReaderUtilities::scanIndexedStringTable(cis, normalizedQuery, intermediateOffsets);
                 ObfReaderUtilities::ensureAllDataWasRead(cis);
 
                 cis->PopLimit(oldLimit);
@@ -1125,7 +1172,7 @@ void OsmAnd::ObfAddressSectionReader_P::readNameIndexDataAtom(
     }
 }
 
-void OsmAnd::ObfAddressSectionReader_P::loadStreetGroups(
+void OsmAnd::ObfAddressSectionReader_P::decodeStreetGroups(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfAddressSectionInfo>& section,
     QList< std::shared_ptr<const StreetGroup> >* resultOut,
@@ -1145,7 +1192,7 @@ void OsmAnd::ObfAddressSectionReader_P::loadStreetGroups(
     cis->PopLimit(oldLimit);
 }
 
-void OsmAnd::ObfAddressSectionReader_P::loadStreetsFromGroup(
+void OsmAnd::ObfAddressSectionReader_P::decodeStreetsFromGroup(
     const ObfReader_P& reader,
     const std::shared_ptr<const StreetGroup>& streetGroup,
     QList< std::shared_ptr<const Street> >* resultOut,
@@ -1173,7 +1220,7 @@ void OsmAnd::ObfAddressSectionReader_P::loadStreetsFromGroup(
     cis->PopLimit(oldLimit);
 }
 
-void OsmAnd::ObfAddressSectionReader_P::loadBuildingsFromStreet(
+void OsmAnd::ObfAddressSectionReader_P::decodeBuildingsFromStreet(
     const ObfReader_P& reader,
     const std::shared_ptr<const Street>& street,
     QList< std::shared_ptr<const Building> >* resultOut,
@@ -1202,7 +1249,7 @@ void OsmAnd::ObfAddressSectionReader_P::loadBuildingsFromStreet(
     cis->PopLimit(oldLimit);
 }
 
-void OsmAnd::ObfAddressSectionReader_P::loadIntersectionsFromStreet(
+void OsmAnd::ObfAddressSectionReader_P::decodeIntersectionsFromStreet(
     const ObfReader_P& reader,
     const std::shared_ptr<const Street>& street,
     QList< std::shared_ptr<const StreetIntersection> >* resultOut,
@@ -1231,10 +1278,217 @@ void OsmAnd::ObfAddressSectionReader_P::loadIntersectionsFromStreet(
     cis->PopLimit(oldLimit);
 }
 
+void OsmAnd::ObfAddressSectionReader_P::loadStreetGroups(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    QList< std::shared_ptr<const StreetGroup> >* resultOut,
+    const AreaI* const bbox31,
+    const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
+    const StreetGroupVisitorFunction visitor,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (!ObfAddressHierarchyCache::getInstance().isEnabled())
+    {
+        decodeStreetGroups(reader, section, resultOut, bbox31, streetGroupTypesFilter, visitor, queryController);
+        return;
+    }
+
+    const auto streetGroupTypes = QList<ObfAddressStreetGroupType>()
+        << ObfAddressStreetGroupType::CityOrTown
+        << ObfAddressStreetGroupType::Village
+        << ObfAddressStreetGroupType::Postcode;
+    for (const auto streetGroupType : constOf(streetGroupTypes))
+    {
+        if (!streetGroupTypesFilter.isSet(streetGroupType))
+            continue;
+
+        const auto entry = obtainCachedStreetGroups(reader, section, streetGroupType, queryController);
+        ObfAddressHierarchyCache::visit(entry->streetGroups, resultOut, bbox31, visitor);
+
+        if (queryController && queryController->isAborted())
+            return;
+    }
+}
+
+void OsmAnd::ObfAddressSectionReader_P::loadStreetsFromGroup(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const StreetGroup>& streetGroup,
+    QList< std::shared_ptr<const Street> >* resultOut,
+    const AreaI* const bbox31,
+    const StreetVisitorFunction visitor,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (!ObfAddressHierarchyCache::getInstance().isEnabled())
+    {
+        decodeStreetsFromGroup(reader, streetGroup, resultOut, bbox31, visitor, queryController);
+        return;
+    }
+
+    const auto entry = obtainCachedStreets(reader, streetGroup, queryController);
+    ObfAddressHierarchyCache::visit(entry->streets, resultOut, bbox31, visitor);
+}
+
+void OsmAnd::ObfAddressSectionReader_P::loadBuildingsFromStreet(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const Street>& street,
+    QList< std::shared_ptr<const Building> >* resultOut,
+    const AreaI* const bbox31,
+    const BuildingVisitorFunction visitor,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (!ObfAddressHierarchyCache::getInstance().isEnabled())
+    {
+        decodeBuildingsFromStreet(reader, street, resultOut, bbox31, visitor, queryController);
+        return;
+    }
+
+    const auto entry = obtainCachedStreetChildren(
+        reader,
+        street,
+        ObfAddressHierarchyCache::EntryType::Buildings,
+        queryController);
+    ObfAddressHierarchyCache::visit(entry->buildings, resultOut, bbox31, visitor);
+}
+
+void OsmAnd::ObfAddressSectionReader_P::loadIntersectionsFromStreet(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const Street>& street,
+    QList< std::shared_ptr<const StreetIntersection> >* resultOut,
+    const AreaI* const bbox31,
+    const IntersectionVisitorFunction visitor,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (!ObfAddressHierarchyCache::getInstance().isEnabled())
+    {
+        decodeIntersectionsFromStreet(reader, street, resultOut, bbox31, visitor, queryController);
+        return;
+    }
+
+    const auto entry = obtainCachedStreetChildren(
+        reader,
+        street,
+        ObfAddressHierarchyCache::EntryType::Intersections,
+        queryController);
+    ObfAddressHierarchyCache::visit(entry->intersections, resultOut, bbox31, visitor);
+}
+
+std::shared_ptr<const OsmAnd::ObfAddressHierarchyCache::Entry> OsmAnd::ObfAddressSectionReader_P::obtainCachedStreetGroups(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    const ObfAddressStreetGroupType streetGroupType,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    auto& cache = ObfAddressHierarchyCache::getInstance();
+    ObfAddressHierarchyCache::Key key;
+    key.sectionId = section->runtimeGeneratedId;
+    key.offset = static_cast<uint32_t>(streetGroupType);
+    key.type = ObfAddressHierarchyCache::EntryType::StreetGroups;
+    if (const auto cachedEntry = cache.obtain(key))
+        return cachedEntry;
+
+    const std::shared_ptr<ObfAddressHierarchyCache::Entry> entry(new ObfAddressHierarchyCache::Entry());
+    decodeStreetGroups(
+        reader,
+        section,
+        &entry->streetGroups,
+        nullptr,
+        ObfAddressStreetGroupTypesMask().set(streetGroupType),
+        nullptr,
+        queryController);
+
+    // Incomplete entry is still returned to the aborted query, but never cached
+    if (queryController && queryController->isAborted())
+        return entry;
+    cache.insert(key, entry);
+
+    return entry;
+}
+
+std::shared_ptr<const OsmAnd::ObfAddressHierarchyCache::Entry> OsmAnd::ObfAddressSectionReader_P::obtainCachedStreets(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const StreetGroup>& streetGroup,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    auto& cache = ObfAddressHierarchyCache::getInstance();
+    ObfAddressHierarchyCache::Key key;
+    key.sectionId = streetGroup->obfSection->runtimeGeneratedId;
+    key.offset = streetGroup->dataOffset;
+    key.type = ObfAddressHierarchyCache::EntryType::Streets;
+    if (const auto cachedEntry = cache.obtain(key))
+        return cachedEntry;
+
+    const std::shared_ptr<ObfAddressHierarchyCache::Entry> entry(new ObfAddressHierarchyCache::Entry());
+    decodeStreetsFromGroup(reader, streetGroup, &entry->streets, nullptr, nullptr, queryController);
+
+    if (queryController && queryController->isAborted())
+        return entry;
+    cache.insert(key, entry);
+
+    if (entry->streets.size() <= MaxStreetsCountToPrefetch)
+    {
+        for (const auto& street : constOf(entry->streets))
+        {
+            obtainCachedStreetChildren(
+                reader,
+                street,
+                ObfAddressHierarchyCache::EntryType::Buildings,
+                queryController,
+                true);
+
+            if (queryController && queryController->isAborted())
+                break;
+        }
+    }
+
+    return entry;
+}
+
+std::shared_ptr<const OsmAnd::ObfAddressHierarchyCache::Entry> OsmAnd::ObfAddressSectionReader_P::obtainCachedStreetChildren(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const Street>& street,
+    const ObfAddressHierarchyCache::EntryType entryType,
+    const std::shared_ptr<const IQueryController>& queryController,
+    const bool prefetch /*= false*/)
+{
+    auto& cache = ObfAddressHierarchyCache::getInstance();
+    ObfAddressHierarchyCache::Key buildingsKey;
+    buildingsKey.sectionId = street->streetGroup->obfSection->runtimeGeneratedId;
+    buildingsKey.offset = street->offset;
+    buildingsKey.type = ObfAddressHierarchyCache::EntryType::Buildings;
+    auto intersectionsKey = buildingsKey;
+    intersectionsKey.type = ObfAddressHierarchyCache::EntryType::Intersections;
+
+    const auto isBuildingsRequested = (entryType == ObfAddressHierarchyCache::EntryType::Buildings);
+    if (prefetch)
+    {
+        if (cache.contains(isBuildingsRequested ? buildingsKey : intersectionsKey))
+            return nullptr;
+    }
+    else if (const auto cachedEntry = cache.obtain(isBuildingsRequested ? buildingsKey : intersectionsKey))
+    {
+        return cachedEntry;
+    }
+
+    // Buildings and intersections are stored in same message of street, so both are decoded at once
+    const std::shared_ptr<ObfAddressHierarchyCache::Entry> buildingsEntry(new ObfAddressHierarchyCache::Entry());
+    decodeBuildingsFromStreet(reader, street, &buildingsEntry->buildings, nullptr, nullptr, queryController);
+    const std::shared_ptr<ObfAddressHierarchyCache::Entry> intersectionsEntry(new ObfAddressHierarchyCache::Entry());
+    decodeIntersectionsFromStreet(reader, street, &intersectionsEntry->intersections, nullptr, nullptr, queryController);
+
+    const auto& requestedEntry = isBuildingsRequested ? buildingsEntry : intersectionsEntry;
+    if (queryController && queryController->isAborted())
+        return requestedEntry;
+    cache.insert(buildingsKey, buildingsEntry, prefetch || !isBuildingsRequested);
+    cache.insert(intersectionsKey, intersectionsEntry, prefetch || isBuildingsRequested);
+
+    return requestedEntry;
+}
+
 void OsmAnd::ObfAddressSectionReader_P::scanAddressesByName(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfAddressSectionInfo>& section,
     const QString& query,
+    const unsigned int maxEditDistance,
     QList< std::shared_ptr<const OsmAnd::Address> >* outAddresses,
     const AreaI* const bbox31,
     const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
@@ -1247,10 +1501,16 @@ void OsmAnd::ObfAddressSectionReader_P::scanAddressesByName(
     auto oldLimit = cis->PushLimit(section->length);
     cis->Skip(section->nameIndexInnerOffset);
 
+    // Mode is read once and query is normalized once here, names index keys and names of addresses are compared
+    // to it as-is
+    const auto normalization = ObfNameNormalizer::lockNormalization();
+    const auto normalizedQuery = ObfNameNormalizer::normalize(query, normalization);
     readAddressesByName(
         reader,
         section,
-        query,
+        normalizedQuery,
+        normalization,
+        maxEditDistance,
         outAddresses,
         bbox31,
         streetGroupTypesFilter,
@@ -1261,3 +1521,103 @@ void OsmAnd::ObfAddressSectionReader_P::scanAddressesByName(
     ObfReaderUtilities::ensureAllDataWasRead(cis);
     cis->PopLimit(oldLimit);
 }
+
+std::shared_ptr<const OsmAnd::ObfAddressSpatialIndex> OsmAnd::ObfAddressSectionReader_P::obtainSpatialIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (section->_p->_spatialIndexLoaded.loadAcquire() != 0)
+        return section->_p->_spatialIndex;
+
+    QMutexLocker scopedLocker(&section->_p->_spatialIndexLoadMutex);
+    if (section->_p->_spatialIndex)
+        return section->_p->_spatialIndex;
+
+    // Streets of postcodes duplicate streets of settlements
+    QList< std::shared_ptr<const StreetGroup> > streetGroups;
+    loadStreetGroups(
+        reader,
+        section,
+        &streetGroups,
+        nullptr,
+        ObfAddressStreetGroupTypesMask()
+            .set(ObfAddressStreetGroupType::CityOrTown)
+            .set(ObfAddressStreetGroupType::Village),
+        nullptr,
+        queryController);
+    if (queryController && queryController->isAborted())
+        return nullptr;
+
+    QList< std::shared_ptr<const Street> > streets;
+    for (const auto& streetGroup : constOf(streetGroups))
+    {
+        loadStreetsFromGroup(reader, streetGroup, &streets, nullptr, nullptr, queryController);
+        if (queryController && queryController->isAborted())
+            return nullptr;
+    }
+
+    QList< std::shared_ptr<const Building> > buildings;
+    QList< std::shared_ptr<const StreetIntersection> > intersections;
+    for (const auto& street : constOf(streets))
+    {
+        loadBuildingsFromStreet(reader, street, &buildings, nullptr, nullptr, queryController);
+        loadIntersectionsFromStreet(reader, street, &intersections, nullptr, nullptr, queryController);
+        if (queryController && queryController->isAborted())
+            return nullptr;
+    }
+
+    // Index is shared by all later queries, so one built from partially loaded data must never be published
+    if (queryController && queryController->isAborted())
+        return nullptr;
+
+    section->_p->_spatialIndex = ObfAddressSpatialIndex::build(streetGroups, streets, buildings, intersections);
+    section->_p->_spatialIndexLoaded.storeRelease(1);
+
+    return section->_p->_spatialIndex;
+}
+
+void OsmAnd::ObfAddressSectionReader_P::reverseGeocode(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfAddressSectionInfo>& section,
+    const QVector<PointI>& positions31,
+    QVector<ObfAddressSectionReader::ReverseGeocodingResult>& outResults,
+    const double maxDistance,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    if (outResults.size() != positions31.size())
+        outResults.resize(positions31.size());
+
+    // Section is indexed only if some of points is close enough to it
+    const AreaI64 sectionArea31(section->area31);
+    QVector<double> maxSquaredDistances31(positions31.size(), -1.0);
+    bool anyPositionNearby = false;
+    for (auto positionIndex = 0; positionIndex < positions31.size(); positionIndex++)
+    {
+        const auto& position31 = positions31[positionIndex];
+        if (!Utilities::boundingBox31FromAreaInMeters(maxDistance, position31).intersects(sectionArea31))
+            continue;
+
+        const auto maxDistance31 = maxDistance / Utilities::getMetersPerTileUnit(ZoomLevel31, position31.y, 1);
+        maxSquaredDistances31[positionIndex] = maxDistance31 * maxDistance31;
+        anyPositionNearby = true;
+    }
+    if (!anyPositionNearby)
+        return;
+
+    const auto spatialIndex = obtainSpatialIndex(reader, section, queryController);
+    if (!spatialIndex)
+        return;
+
+    for (auto positionIndex = 0; positionIndex < positions31.size(); positionIndex++)
+    {
+        if (queryController && queryController->isAborted())
+            return;
+
+        const auto maxSquaredDistance31 = maxSquaredDistances31[positionIndex];
+        if (maxSquaredDistance31 < 0.0)
+            continue;
+
+        spatialIndex->findNearest(positions31[positionIndex], maxSquaredDistance31, outResults[positionIndex]);
+    }
+}
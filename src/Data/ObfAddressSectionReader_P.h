@@ -10,12 +10,17 @@
 #include "CommonTypes.h"
 #include "DataCommonTypes.h"
 #include "ObfAddressSectionReader.h"
+#include "ObfFile.h"
 #include "ObfAddressSectionInfo.h"
+#include "ObfAddressHierarchyCache.h"
 
 namespace OsmAnd
 {
     class ObfReader_P;
     class ObfAddressSectionInfo;
+    class ObfIndexedStringTable;
+    class ObfNameNGramIndex;
+    class ObfAddressSpatialIndex;
     
     class ObfAddressSectionReader_P Q_DECL_FINAL
     {
@@ -49,6 +54,13 @@ namespace OsmAnd
     private:
         ObfAddressSectionReader_P();
         ~ObfAddressSectionReader_P();
+
+        enum
+        {
+            // Buildings and intersections of streets are decoded along with streets only for street groups
+            // that small, since large ones are rarely walked through completely
+            MaxStreetsCountToPrefetch = 64,
+        };
     protected:
         static void read(
             const ObfReader_P& reader,
@@ -128,15 +140,26 @@ namespace OsmAnd
             const ObfReader_P& reader,
             const std::shared_ptr<const ObfAddressSectionInfo>& section,
             const QString& query,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             QList< std::shared_ptr<const OsmAnd::Address> >* outAddresses,
             const AreaI* const bbox31,
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
             const bool includeStreets,
             const ObfAddressSectionReader::VisitorFunction visitor,
             const std::shared_ptr<const IQueryController>& queryController);
+        static std::shared_ptr<const ObfIndexedStringTable> obtainNameIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section);
+        static std::shared_ptr<const ObfNameNGramIndex> obtainNameNGramIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section);
         static void scanNameIndex(
             const ObfReader_P& reader,
-            const QString& query,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            const QString& normalizedQuery,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             QVector<AddressReference>& outAddressReferences,
             const AreaI* const bbox31,
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
@@ -158,6 +181,52 @@ namespace OsmAnd
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
             const bool includeStreets,
             const std::shared_ptr<const IQueryController>& queryController);
+        static void decodeStreetGroups(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            QList< std::shared_ptr<const StreetGroup> >* resultOut,
+            const AreaI* const bbox31,
+            const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
+            const StreetGroupVisitorFunction visitor,
+            const std::shared_ptr<const IQueryController>& queryController);
+        static void decodeStreetsFromGroup(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const StreetGroup>& streetGroup,
+            QList< std::shared_ptr<const Street> >* resultOut,
+            const AreaI* const bbox31,
+            const StreetVisitorFunction visitor,
+            const std::shared_ptr<const IQueryController>& queryController);
+        static void decodeBuildingsFromStreet(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const Street>& street,
+            QList< std::shared_ptr<const Building> >* resultOut,
+            const AreaI* const bbox31,
+            const BuildingVisitorFunction visitor,
+            const std::shared_ptr<const IQueryController>& queryController);
+        static void decodeIntersectionsFromStreet(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const Street>& street,
+            QList< std::shared_ptr<const StreetIntersection> >* resultOut,
+            const AreaI* const bbox31,
+            const IntersectionVisitorFunction visitor,
+            const std::shared_ptr<const IQueryController>& queryController);
+
+        static std::shared_ptr<const ObfAddressHierarchyCache::Entry> obtainCachedStreetGroups(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            const ObfAddressStreetGroupType streetGroupType,
+            const std::shared_ptr<const IQueryController>& queryController);
+        static std::shared_ptr<const ObfAddressHierarchyCache::Entry> obtainCachedStreets(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const StreetGroup>& streetGroup,
+            const std::shared_ptr<const IQueryController>& queryController);
+        // When prefetching, nothing is returned and street is not decoded again if it's already cached
+        static std::shared_ptr<const ObfAddressHierarchyCache::Entry> obtainCachedStreetChildren(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const Street>& street,
+            const ObfAddressHierarchyCache::EntryType entryType,
+            const std::shared_ptr<const IQueryController>& queryController,
+            const bool prefetch = false);
     public:
         static void loadStreetGroups(
             const ObfReader_P& reader,
@@ -196,6 +265,7 @@ namespace OsmAnd
             const ObfReader_P& reader,
             const std::shared_ptr<const ObfAddressSectionInfo>& section,
             const QString& query,
+            const unsigned int maxEditDistance,
             QList< std::shared_ptr<const OsmAnd::Address> >* outAddresses,
             const AreaI* const bbox31,
             const ObfAddressStreetGroupTypesMask streetGroupTypesFilter,
@@ -203,6 +273,18 @@ namespace OsmAnd
             const ObfAddressSectionReader::VisitorFunction visitor,
             const std::shared_ptr<const IQueryController>& queryController);
 
+        static std::shared_ptr<const ObfAddressSpatialIndex> obtainSpatialIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            const std::shared_ptr<const IQueryController>& queryController);
+        static void reverseGeocode(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfAddressSectionInfo>& section,
+            const QVector<PointI>& positions31,
+            QVector<ObfAddressSectionReader::ReverseGeocodingResult>& outResults,
+            const double maxDistance,
+            const std::shared_ptr<const IQueryController>& queryController);
+
     friend class OsmAnd::ObfReader_P;
     friend class OsmAnd::ObfAddressSectionReader;
     };
@@ -0,0 +1,319 @@
+#include "ObfAddressSpatialIndex.h"
+
+#include "stdlib_common.h"
+#include <cmath>
+#include <queue>
+#include <vector>
+
+#include "QtExtensions.h"
+#include <QHash>
+
+#include "Common.h"
+#include "StreetGroup.h"
+#include "Street.h"
+#include "Building.h"
+#include "StreetIntersection.h"
+#include "Utilities.h"
+
+namespace OsmAnd
+{
+    namespace ObfAddressSpatialIndex_P
+    {
+        static double squaredDistanceToArea(const PointI& point31, const AreaI& area31)
+        {
+            const auto dx = qMax(0.0, qMax(
+                static_cast<double>(area31.left()) - point31.x,
+                static_cast<double>(point31.x) - area31.right()));
+            const auto dy = qMax(0.0, qMax(
+                static_cast<double>(area31.top()) - point31.y,
+                static_cast<double>(point31.y) - area31.bottom()));
+            return dx * dx + dy * dy;
+        }
+
+        static PointI nearestPointOnSegment(const PointI& point31, const PointI& point0, const PointI& point1)
+        {
+            const auto vx = static_cast<double>(point1.x) - point0.x;
+            const auto vy = static_cast<double>(point1.y) - point0.y;
+            const auto squaredLength = vx * vx + vy * vy;
+            if (squaredLength <= 0.0)
+                return point0;
+
+            const auto t = qBound(
+                0.0,
+                ((static_cast<double>(point31.x) - point0.x) * vx + (static_cast<double>(point31.y) - point0.y) * vy) /
+                    squaredLength,
+                1.0);
+            return PointI(
+                static_cast<int32_t>(qRound64(point0.x + t * vx)),
+                static_cast<int32_t>(qRound64(point0.y + t * vy)));
+        }
+
+        static double squaredDistance(const PointI& a, const PointI& b)
+        {
+            const auto dx = static_cast<double>(a.x) - b.x;
+            const auto dy = static_cast<double>(a.y) - b.y;
+            return dx * dx + dy * dy;
+        }
+
+        template<typename ENTRY>
+        static void sortByCenter(
+            const typename QVector<ENTRY>::iterator begin,
+            const typename QVector<ENTRY>::iterator end,
+            const bool byX)
+        {
+            std::sort(begin, end,
+                [byX]
+                (const ENTRY& l, const ENTRY& r) -> bool
+                {
+                    const auto lCenter = l.bbox31.center();
+                    const auto rCenter = r.bbox31.center();
+                    return byX ? (lCenter.x < rCenter.x) : (lCenter.y < rCenter.y);
+                });
+        }
+
+        // Sort-Tile-Recursive packing: entries are cut in vertical slices by X and each slice is packed by Y
+        template<typename ENTRY>
+        static void packSortTileRecursive(QVector<ENTRY>& entries, const int capacity)
+        {
+            const auto nodesCount = (entries.size() + capacity - 1) / capacity;
+            const auto slicesCount = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(nodesCount))));
+            const auto sliceSize = slicesCount * capacity;
+
+            sortByCenter<ENTRY>(entries.begin(), entries.end(), true);
+            for (auto sliceStart = 0; sliceStart < entries.size(); sliceStart += sliceSize)
+            {
+                const auto sliceEnd = qMin(sliceStart + sliceSize, entries.size());
+                sortByCenter<ENTRY>(entries.begin() + sliceStart, entries.begin() + sliceEnd, false);
+            }
+        }
+    }
+}
+
+OsmAnd::ObfAddressSpatialIndex::ObfAddressSpatialIndex()
+{
+}
+
+OsmAnd::ObfAddressSpatialIndex::~ObfAddressSpatialIndex()
+{
+}
+
+void OsmAnd::ObfAddressSpatialIndex::findNearest(
+    const PointI& point31,
+    const double maxSquaredDistance31,
+    ObfAddressSectionReader::ReverseGeocodingResult& inOutResult) const
+{
+    PointI nearestPoint31;
+
+    auto squaredDistance = maxSquaredDistance31;
+    auto itemIndex = _buildingsTree.findNearest(point31, squaredDistance, nearestPoint31);
+    if (itemIndex >= 0)
+    {
+        const auto distance = Utilities::distance31(point31, nearestPoint31);
+        if (!inOutResult.building || distance < inOutResult.buildingDistance)
+        {
+            inOutResult.building = _buildings[_buildingsTree.items[itemIndex].objectIndex];
+            inOutResult.buildingDistance = distance;
+        }
+    }
+
+    squaredDistance = maxSquaredDistance31;
+    itemIndex = _streetsTree.findNearest(point31, squaredDistance, nearestPoint31);
+    if (itemIndex >= 0)
+    {
+        const auto distance = Utilities::distance31(point31, nearestPoint31);
+        if (!inOutResult.street || distance < inOutResult.streetDistance)
+        {
+            inOutResult.street = _streets[_streetsTree.items[itemIndex].objectIndex];
+            inOutResult.streetDistance = distance;
+        }
+    }
+
+    squaredDistance = maxSquaredDistance31;
+    itemIndex = _streetGroupsTree.findNearest(point31, squaredDistance, nearestPoint31);
+    if (itemIndex >= 0)
+    {
+        const auto distance = Utilities::distance31(point31, nearestPoint31);
+        if (!inOutResult.streetGroup || distance < inOutResult.streetGroupDistance)
+        {
+            inOutResult.streetGroup = _streetGroups[_streetGroupsTree.items[itemIndex].objectIndex];
+            inOutResult.streetGroupDistance = distance;
+        }
+    }
+}
+
+OsmAnd::ObfAddressSpatialIndex::Item OsmAnd::ObfAddressSpatialIndex::makeItem(
+    const PointI& point0,
+    const PointI& point1,
+    const int objectIndex)
+{
+    Item item;
+    item.bbox31 = AreaI(point0, point0).enlargeToInclude(point1);
+    item.point0 = point0;
+    item.point1 = point1;
+    item.objectIndex = objectIndex;
+    return item;
+}
+
+std::shared_ptr<const OsmAnd::ObfAddressSpatialIndex> OsmAnd::ObfAddressSpatialIndex::build(
+    const QList< std::shared_ptr<const StreetGroup> >& streetGroups,
+    const QList< std::shared_ptr<const Street> >& streets,
+    const QList< std::shared_ptr<const Building> >& buildings,
+    const QList< std::shared_ptr<const StreetIntersection> >& intersections)
+{
+    const std::shared_ptr<ObfAddressSpatialIndex> index(new ObfAddressSpatialIndex());
+
+    QVector<Item> streetGroupsItems;
+    for (const auto& streetGroup : constOf(streetGroups))
+    {
+        if (streetGroup->type == ObfAddressStreetGroupType::Postcode)
+            continue;
+
+        const auto streetGroupIndex = index->_streetGroups.size();
+        streetGroupsItems.push_back(makeItem(streetGroup->position31, streetGroup->position31, streetGroupIndex));
+        index->_streetGroups.push_back(streetGroup);
+    }
+
+    QHash<const Street*, int> streetsIndices;
+    QVector<Item> streetsItems;
+    for (const auto& street : constOf(streets))
+    {
+        streetsIndices.insert(street.get(), index->_streets.size());
+        streetsItems.push_back(makeItem(street->position31, street->position31, index->_streets.size()));
+        index->_streets.push_back(street);
+    }
+    for (const auto& intersection : constOf(intersections))
+    {
+        const auto citStreetIndex = streetsIndices.constFind(intersection->street.get());
+        if (citStreetIndex == streetsIndices.cend())
+            continue;
+
+        streetsItems.push_back(makeItem(intersection->position31, intersection->position31, *citStreetIndex));
+    }
+
+    QVector<Item> buildingsItems;
+    for (const auto& building : constOf(buildings))
+    {
+        const auto hasInterpolation =
+            building->interpolation != Building::Interpolation::Disabled &&
+            building->interpolationPosition31 != PointI();
+        const auto point1 = hasInterpolation ? building->interpolationPosition31 : building->position31;
+        buildingsItems.push_back(makeItem(building->position31, point1, index->_buildings.size()));
+        index->_buildings.push_back(building);
+
+        if (!building->street)
+            continue;
+        const auto citStreetIndex = streetsIndices.constFind(building->street.get());
+        if (citStreetIndex == streetsIndices.cend())
+            continue;
+
+        streetsItems.push_back(makeItem(building->position31, point1, *citStreetIndex));
+    }
+
+    index->_streetGroupsTree.build(streetGroupsItems);
+    index->_streetsTree.build(streetsItems);
+    index->_buildingsTree.build(buildingsItems);
+
+    return index;
+}
+
+void OsmAnd::ObfAddressSpatialIndex::Tree::build(const QVector<Item>& items_)
+{
+    items = items_;
+    nodes.clear();
+    rootIndex = -1;
+    if (items.isEmpty())
+        return;
+
+    // Leaves reference ranges of items, upper levels reference ranges of nodes of level below
+    ObfAddressSpatialIndex_P::packSortTileRecursive(items, NodeCapacity);
+    for (auto itemIndex = 0; itemIndex < items.size(); itemIndex += NodeCapacity)
+    {
+        Node node;
+        node.isLeaf = true;
+        node.firstChildIndex = itemIndex;
+        node.childrenCount = qMin(static_cast<int>(NodeCapacity), items.size() - itemIndex);
+        node.bbox31 = items[itemIndex].bbox31;
+        for (auto childIndex = 1; childIndex < node.childrenCount; childIndex++)
+            node.bbox31.enlargeToInclude(items[itemIndex + childIndex].bbox31);
+        nodes.push_back(node);
+    }
+
+    auto levelStart = 0;
+    auto levelSize = nodes.size();
+    while (levelSize > 1)
+    {
+        QVector<Node> level = nodes.mid(levelStart, levelSize);
+        ObfAddressSpatialIndex_P::packSortTileRecursive(level, NodeCapacity);
+        std::copy(level.cbegin(), level.cend(), nodes.begin() + levelStart);
+
+        const auto nextLevelStart = nodes.size();
+        for (auto nodeIndex = levelStart; nodeIndex < levelStart + levelSize; nodeIndex += NodeCapacity)
+        {
+            Node node;
+            node.isLeaf = false;
+            node.firstChildIndex = nodeIndex;
+            node.childrenCount = qMin(static_cast<int>(NodeCapacity), levelStart + levelSize - nodeIndex);
+            node.bbox31 = nodes[nodeIndex].bbox31;
+            for (auto childIndex = 1; childIndex < node.childrenCount; childIndex++)
+                node.bbox31.enlargeToInclude(nodes[nodeIndex + childIndex].bbox31);
+            nodes.push_back(node);
+        }
+
+        levelStart = nextLevelStart;
+        levelSize = nodes.size() - nextLevelStart;
+    }
+    rootIndex = nodes.size() - 1;
+}
+
+int OsmAnd::ObfAddressSpatialIndex::Tree::findNearest(
+    const PointI& point31,
+    double& inOutSquaredDistance,
+    PointI& outNearestPoint31) const
+{
+    if (rootIndex < 0)
+        return -1;
+
+    // Best-first traversal: nodes are visited in order of distance to their bbox, so traversal stops as soon as
+    // closest remaining node is farther than nearest item found
+    typedef std::pair<double, int> QueueEntry;
+    std::priority_queue< QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+    const auto rootSquaredDistance = ObfAddressSpatialIndex_P::squaredDistanceToArea(point31, nodes[rootIndex].bbox31);
+    queue.push(QueueEntry(rootSquaredDistance, rootIndex));
+
+    auto nearestItemIndex = -1;
+    while (!queue.empty())
+    {
+        const auto entry = queue.top();
+        queue.pop();
+        if (entry.first > inOutSquaredDistance)
+            break;
+
+        const auto& node = nodes[entry.second];
+        const auto childrenEnd = node.firstChildIndex + node.childrenCount;
+        for (auto childIndex = node.firstChildIndex; childIndex < childrenEnd; childIndex++)
+        {
+            if (node.isLeaf)
+            {
+                const auto& item = items[childIndex];
+                const auto nearestPoint31 =
+                    ObfAddressSpatialIndex_P::nearestPointOnSegment(point31, item.point0, item.point1);
+                const auto squaredDistance = ObfAddressSpatialIndex_P::squaredDistance(point31, nearestPoint31);
+                if (squaredDistance > inOutSquaredDistance)
+                    continue;
+
+                inOutSquaredDistance = squaredDistance;
+                outNearestPoint31 = nearestPoint31;
+                nearestItemIndex = childIndex;
+            }
+            else
+            {
+                const auto squaredDistance =
+                    ObfAddressSpatialIndex_P::squaredDistanceToArea(point31, nodes[childIndex].bbox31);
+                if (squaredDistance <= inOutSquaredDistance)
+                    queue.push(QueueEntry(squaredDistance, childIndex));
+            }
+        }
+    }
+
+    return nearestItemIndex;
+}
@@ -0,0 +1,91 @@
+#ifndef _OSMAND_CORE_OBF_ADDRESS_SPATIAL_INDEX_H_
+#define _OSMAND_CORE_OBF_ADDRESS_SPATIAL_INDEX_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QList>
+#include <QVector>
+
+#include "OsmAndCore.h"
+#include "CommonTypes.h"
+#include "ObfAddressSectionReader.h"
+
+namespace OsmAnd
+{
+    class StreetGroup;
+    class Street;
+    class Building;
+    class StreetIntersection;
+
+    // Packed R-trees over buildings, streets and settlements of address section, for reverse geocoding.
+    // OBF doesn't store street geometry, so street is represented by its position, positions of its
+    // intersections and positions of its buildings. Building with interpolation is a segment between its
+    // two ends. Immutable once built, so it can be shared by any number of threads.
+    class ObfAddressSpatialIndex Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(ObfAddressSpatialIndex);
+    public:
+        enum
+        {
+            NodeCapacity = 16,
+        };
+
+    private:
+        struct Item
+        {
+            AreaI bbox31;
+            PointI point0;
+            PointI point1;
+            int objectIndex;
+        };
+
+        struct Node
+        {
+            AreaI bbox31;
+            bool isLeaf;
+            int firstChildIndex;
+            int childrenCount;
+        };
+
+        struct Tree
+        {
+            QVector<Item> items;
+            QVector<Node> nodes;
+            int rootIndex;
+
+            void build(const QVector<Item>& items);
+            int findNearest(const PointI& point31, double& inOutSquaredDistance, PointI& outNearestPoint31) const;
+        };
+
+        QVector< std::shared_ptr<const StreetGroup> > _streetGroups;
+        QVector< std::shared_ptr<const Street> > _streets;
+        QVector< std::shared_ptr<const Building> > _buildings;
+
+        Tree _streetGroupsTree;
+        Tree _streetsTree;
+        Tree _buildingsTree;
+
+        static Item makeItem(const PointI& point0, const PointI& point1, const int objectIndex);
+    protected:
+        ObfAddressSpatialIndex();
+    public:
+        ~ObfAddressSpatialIndex();
+
+        // Replaces objects in result with ones of this section that are closer to given point
+        void findNearest(
+            const PointI& point31,
+            const double maxSquaredDistance31,
+            ObfAddressSectionReader::ReverseGeocodingResult& inOutResult) const;
+
+        // Postcode street groups are not indexed as settlements, and their streets duplicate streets of
+        // settlements, so those are expected to be passed only once
+        static std::shared_ptr<const ObfAddressSpatialIndex> build(
+            const QList< std::shared_ptr<const StreetGroup> >& streetGroups,
+            const QList< std::shared_ptr<const Street> >& streets,
+            const QList< std::shared_ptr<const Building> >& buildings,
+            const QList< std::shared_ptr<const StreetIntersection> >& intersections);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_ADDRESS_SPATIAL_INDEX_H_)
@@ -2,6 +2,17 @@
 #include "ObfFile_P.h"
 
 #include <QFile>
+#include <QAtomicInt>
+
+static QAtomicInt residentNameIndexEnabled(0);
+static QAtomicInt poiCategoryIndexEnabled(0);
+// Lowest byte holds mode, NameNormalizationLocked is set once first search by name started
+enum
+{
+    NameNormalizationMask = 0xFF,
+    NameNormalizationLocked = 0x100,
+};
+static QAtomicInt nameNormalization(static_cast<int>(OsmAnd::ObfFile::NameNormalization::CaseFolding));
 
 OsmAnd::ObfFile::ObfFile(const QString& filePath_)
     : _p(new ObfFile_P(this))
@@ -22,3 +33,47 @@ OsmAnd::ObfFile::ObfFile(const QString& filePath_, const uint64_t fileSize_)
 OsmAnd::ObfFile::~ObfFile()
 {
 }
+
+bool OsmAnd::ObfFile::isResidentNameIndexEnabled()
+{
+    return residentNameIndexEnabled.loadAcquire() != 0;
+}
+
+void OsmAnd::ObfFile::setResidentNameIndexEnabled(const bool enabled)
+{
+    residentNameIndexEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+bool OsmAnd::ObfFile::isPoiCategoryIndexEnabled()
+{
+    return poiCategoryIndexEnabled.loadAcquire() != 0;
+}
+
+void OsmAnd::ObfFile::setPoiCategoryIndexEnabled(const bool enabled)
+{
+    poiCategoryIndexEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+OsmAnd::ObfFile::NameNormalization OsmAnd::ObfFile::getNameNormalization()
+{
+    return static_cast<NameNormalization>(nameNormalization.loadAcquire() & NameNormalizationMask);
+}
+
+bool OsmAnd::ObfFile::setNameNormalization(const NameNormalization normalization)
+{
+    for (;;)
+    {
+        const auto value = nameNormalization.loadAcquire();
+        if ((value & NameNormalizationLocked) != 0)
+            return (value & NameNormalizationMask) == static_cast<int>(normalization);
+
+        if (nameNormalization.testAndSetOrdered(value, static_cast<int>(normalization)))
+            return true;
+    }
+}
+
+OsmAnd::ObfFile::NameNormalization OsmAnd::ObfFile::lockNameNormalization()
+{
+    const auto value = nameNormalization.fetchAndOrOrdered(NameNormalizationLocked);
+    return static_cast<NameNormalization>(value & NameNormalizationMask);
+}
@@ -0,0 +1,170 @@
+#include "ObfIndexedStringTable.h"
+
+#include "ignore_warnings_on_external_includes.h"
+#include "OBF.pb.h"
+#include <google/protobuf/wire_format_lite.h>
+#include "restore_internal_warnings.h"
+
+#include "Common.h"
+#include "ObfReaderUtilities.h"
+#include "ObfNameNormalizer.h"
+
+OsmAnd::ObfIndexedStringTable::ObfIndexedStringTable()
+    : _entriesCount(0)
+    , _normalization(ObfFile::NameNormalization::CaseFolding)
+{
+}
+
+OsmAnd::ObfIndexedStringTable::~ObfIndexedStringTable()
+{
+}
+
+unsigned int OsmAnd::ObfIndexedStringTable::getEntriesCount() const
+{
+    return _entriesCount;
+}
+
+OsmAnd::ObfFile::NameNormalization OsmAnd::ObfIndexedStringTable::getNormalization() const
+{
+    return _normalization;
+}
+
+int OsmAnd::ObfIndexedStringTable::scan(const QString& normalizedQuery, QVector<uint32_t>& outValues) const
+{
+    return scanEntries(_entries, normalizedQuery, outValues, 0);
+}
+
+std::shared_ptr<const OsmAnd::ObfIndexedStringTable> OsmAnd::ObfIndexedStringTable::read(
+    gpb::io::CodedInputStream* cis)
+{
+    const std::shared_ptr<ObfIndexedStringTable> table(new ObfIndexedStringTable());
+    // Keys of resident table stay as normalized now, so queries have to be normalized same way from now on
+    table->_normalization = ObfFile::lockNameNormalization();
+    readEntries(cis, table->_entries, table->_entriesCount, QString(), table->_normalization);
+    return table;
+}
+
+std::shared_ptr<const OsmAnd::ObfIndexedStringTable> OsmAnd::ObfIndexedStringTable::obtainResident(
+    gpb::io::CodedInputStream* cis,
+    QMutex& loadMutex,
+    QAtomicInt& loaded,
+    std::shared_ptr<const ObfIndexedStringTable>& table)
+{
+    if (loaded.loadAcquire() == 0)
+    {
+        QMutexLocker scopedLocker(&loadMutex);
+        if (!table)
+        {
+            table = read(cis);
+            loaded.storeRelease(1);
+
+            return table;
+        }
+    }
+
+    cis->Skip(cis->BytesUntilLimit());
+    return table;
+}
+
+void OsmAnd::ObfIndexedStringTable::readEntries(
+    gpb::io::CodedInputStream* cis,
+    QVector<Entry>& outEntries,
+    unsigned int& entriesCount,
+    const QString& keysPrefix,
+    const ObfFile::NameNormalization normalization)
+{
+    // Values and subtable that follow key belong to that key
+    QString key;
+
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::IndexedStringTable::kKeyFieldNumber:
+            {
+                ObfReaderUtilities::readQString(cis, key);
+                key.prepend(keysPrefix);
+
+                Entry entry;
+                entry.key = ObfNameNormalizer::normalize(key, normalization);
+                outEntries.push_back(entry);
+                entriesCount++;
+                break;
+            }
+            case OBF::IndexedStringTable::kValFieldNumber:
+            {
+                const auto value = ObfReaderUtilities::readBigEndianInt(cis);
+
+                if (!outEntries.isEmpty())
+                    outEntries.last().values.push_back(value);
+                break;
+            }
+            case OBF::IndexedStringTable::kSubtablesFieldNumber:
+            {
+                const auto length = ObfReaderUtilities::readLength(cis);
+                const auto oldLimit = cis->PushLimit(length);
+
+                if (!outEntries.isEmpty())
+                    readEntries(cis, outEntries.last().subtable, entriesCount, key, normalization);
+                else
+                    cis->Skip(cis->BytesUntilLimit());
+
+                ObfReaderUtilities::ensureAllDataWasRead(cis);
+                cis->PopLimit(oldLimit);
+
+                break;
+            }
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+}
+
+int OsmAnd::ObfIndexedStringTable::scanEntries(
+    const QVector<Entry>& entries,
+    const QString& normalizedQuery,
+    QVector<uint32_t>& outValues,
+    const int matchedCharactersCount_)
+{
+    // Same matching rules as in ObfReaderUtilities::scanIndexedStringTable(): only keys that matched
+    // longest part of query are taken into account
+    auto matchedCharactersCount = matchedCharactersCount_;
+
+    for (const auto& entry : constOf(entries))
+    {
+        bool matches = false;
+        if (entry.key.startsWith(normalizedQuery))
+        {
+            if (normalizedQuery.size() > matchedCharactersCount)
+            {
+                matchedCharactersCount = normalizedQuery.size();
+                outValues.clear();
+            }
+            matches = (normalizedQuery.size() >= matchedCharactersCount);
+        }
+        else if (normalizedQuery.startsWith(entry.key))
+        {
+            if (entry.key.size() > matchedCharactersCount)
+            {
+                matchedCharactersCount = entry.key.size();
+                outValues.clear();
+            }
+            matches = (entry.key.size() >= matchedCharactersCount);
+        }
+        if (!matches)
+            continue;
+
+        outValues += entry.values;
+        if (!entry.subtable.isEmpty())
+            matchedCharactersCount = scanEntries(entry.subtable, normalizedQuery, outValues, matchedCharactersCount);
+    }
+
+    return matchedCharactersCount;
+}
@@ -0,0 +1,81 @@
+#ifndef _OSMAND_CORE_OBF_INDEXED_STRING_TABLE_H_
+#define _OSMAND_CORE_OBF_INDEXED_STRING_TABLE_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "ignore_warnings_on_external_includes.h"
+#include <google/protobuf/io/coded_stream.h>
+#include "restore_internal_warnings.h"
+
+#include "OsmAndCore.h"
+#include "ObfFile.h"
+
+namespace OsmAnd
+{
+    namespace gpb = google::obf_protobuf;
+
+    class ObfNameNGramIndex;
+
+    // Resident copy of on-disk indexed string table (trie of name prefixes to offsets of name index atoms).
+    // Keys are stored normalized by ObfNameNormalizer, so matching them is plain comparison of characters and,
+    // with case folding only, scan() gives same result as ObfReaderUtilities::scanIndexedStringTable() without
+    // decoding anything. Immutable once read, so it can be shared by any number of threads.
+    class ObfIndexedStringTable Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(ObfIndexedStringTable);
+
+    private:
+        struct Entry
+        {
+            QString key;
+            QVector<uint32_t> values;
+            QVector<Entry> subtable;
+        };
+        QVector<Entry> _entries;
+        unsigned int _entriesCount;
+        ObfFile::NameNormalization _normalization;
+
+        static void readEntries(
+            gpb::io::CodedInputStream* cis,
+            QVector<Entry>& outEntries,
+            unsigned int& entriesCount,
+            const QString& keysPrefix,
+            const ObfFile::NameNormalization normalization);
+        static int scanEntries(
+            const QVector<Entry>& entries,
+            const QString& normalizedQuery,
+            QVector<uint32_t>& outValues,
+            const int matchedCharactersCount);
+    protected:
+        ObfIndexedStringTable();
+    public:
+        ~ObfIndexedStringTable();
+
+        unsigned int getEntriesCount() const;
+        ObfFile::NameNormalization getNormalization() const;
+
+        // Query is expected to be normalized the same way keys are
+        int scan(const QString& normalizedQuery, QVector<uint32_t>& outValues) const;
+
+        // Reads table from current position of stream up to its limit
+        static std::shared_ptr<const ObfIndexedStringTable> read(gpb::io::CodedInputStream* cis);
+
+        // Reads table into resident slot of section on first call, later calls skip table in stream and return
+        // what was read. Slot is published by loaded flag, so checking it doesn't need mutex.
+        static std::shared_ptr<const ObfIndexedStringTable> obtainResident(
+            gpb::io::CodedInputStream* cis,
+            QMutex& loadMutex,
+            QAtomicInt& loaded,
+            std::shared_ptr<const ObfIndexedStringTable>& table);
+
+    friend class OsmAnd::ObfNameNGramIndex;
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_INDEXED_STRING_TABLE_H_)
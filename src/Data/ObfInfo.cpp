@@ -4,6 +4,7 @@
 #include "ObfRoutingSectionInfo.h"
 #include "ObfPoiSectionInfo.h"
 #include "ObfAddressSectionInfo.h"
+#include "ObfAddressHierarchyCache.h"
 
 OsmAnd::ObfInfo::ObfInfo()
     : version(-1)
@@ -15,6 +16,10 @@ OsmAnd::ObfInfo::ObfInfo()
 
 OsmAnd::ObfInfo::~ObfInfo()
 {
+    // Cached address objects reference their sections, so entries of file are dropped together with it
+    auto& addressHierarchyCache = ObfAddressHierarchyCache::getInstance();
+    for (const auto& addressSection : constOf(addressSections))
+        addressHierarchyCache.removeEntriesOf(*addressSection);
 }
 
 bool OsmAnd::ObfInfo::containsDataFor(
@@ -0,0 +1,280 @@
+#include "ObfNameNGramIndex.h"
+
+#include "QtExtensions.h"
+#include <QSet>
+
+#include "Common.h"
+#include "ObfIndexedStringTable.h"
+
+OsmAnd::ObfNameNGramIndex::ObfNameNGramIndex()
+{
+}
+
+OsmAnd::ObfNameNGramIndex::~ObfNameNGramIndex()
+{
+}
+
+unsigned int OsmAnd::ObfNameNGramIndex::getKeysCount() const
+{
+    return _keys.size();
+}
+
+void OsmAnd::ObfNameNGramIndex::scan(
+    const QString& normalizedQuery,
+    const unsigned int maxEditDistance_,
+    QVector<uint32_t>& outValues) const
+{
+    const auto queryLength = normalizedQuery.size();
+    if (queryLength == 0)
+        return;
+    const auto maxEditDistance = static_cast<int>(qMin(maxEditDistance_, static_cast<unsigned int>(MaxEditDistance)));
+
+    // Each edit destroys at most 3 trigrams, so key that shares less than (n - 3 * maxEditDistance) trigrams
+    // with query (n being length of shorter one) can not match. Keys that short have to be verified anyway.
+    QVector<int> candidatesIndices;
+    const auto minFilteredLength = 3 * maxEditDistance + 1;
+    if (queryLength < minFilteredLength)
+    {
+        candidatesIndices = _keysIndicesByLength;
+    }
+    else
+    {
+        QHash<int, int> hits;
+        const auto paddedQuery = pad(normalizedQuery);
+        for (auto position = 0; position < queryLength; position++)
+        {
+            const auto citPostings = _postings.constFind(trigramAt(paddedQuery, position));
+            if (citPostings == _postings.cend())
+                continue;
+
+            for (const auto& posting : constOf(*citPostings))
+            {
+                if (qAbs(posting.position - position) > maxEditDistance ||
+                    posting.position >= queryLength + maxEditDistance)
+                {
+                    continue;
+                }
+                hits[posting.keyIndex]++;
+            }
+        }
+
+        for (const auto& keyIndex : constOf(_keysIndicesByLength))
+        {
+            if (_keys[keyIndex].key.size() >= minFilteredLength)
+                break;
+            candidatesIndices.push_back(keyIndex);
+        }
+        for (const auto& hitsEntry : rangeOf(constOf(hits)))
+        {
+            const auto& key = _keys[hitsEntry.key()].key;
+            if (key.size() < minFilteredLength)
+                continue;
+
+            const auto minHits = qMin(key.size(), queryLength) - 3 * maxEditDistance;
+            if (hitsEntry.value() >= minHits)
+                candidatesIndices.push_back(hitsEntry.key());
+        }
+    }
+
+    QSet<uint32_t> values;
+    for (const auto& keyIndex : constOf(candidatesIndices))
+    {
+        const auto& key = _keys[keyIndex];
+        if (!matches(key, normalizedQuery, maxEditDistance))
+            continue;
+
+        for (const auto& value : constOf(key.values))
+            values.insert(value);
+    }
+    outValues.reserve(outValues.size() + values.size());
+    for (const auto& value : constOf(values))
+        outValues.push_back(value);
+}
+
+bool OsmAnd::ObfNameNGramIndex::matches(const Key& key, const QString& normalizedQuery, const int maxEditDistance) const
+{
+    // Too short parts can't be compared approximately, since anything is within few edits from them
+    if (qMin(key.key.size(), normalizedQuery.size()) <= maxEditDistance)
+        return key.key.startsWith(normalizedQuery) || normalizedQuery.startsWith(key.key);
+
+    if (key.key.size() <= normalizedQuery.size())
+        return computePrefixEditDistance(key.key, normalizedQuery, maxEditDistance) <= maxEditDistance;
+    return computePrefixEditDistance(normalizedQuery, key.key, maxEditDistance) <= maxEditDistance;
+}
+
+uint64_t OsmAnd::ObfNameNGramIndex::trigramAt(const QString& paddedString, const int position)
+{
+    return
+        (static_cast<uint64_t>(paddedString.at(position).unicode()) << 32) |
+        (static_cast<uint64_t>(paddedString.at(position + 1).unicode()) << 16) |
+        static_cast<uint64_t>(paddedString.at(position + 2).unicode());
+}
+
+QString OsmAnd::ObfNameNGramIndex::pad(const QString& string)
+{
+    // Padding makes each character start a trigram, so short keys and first characters are indexed too
+    return QString(2, QChar(0)) + string;
+}
+
+void OsmAnd::ObfNameNGramIndex::collectKeys(
+    const ObfIndexedStringTable& table,
+    QVector<QString>& outKeys,
+    QVector< QVector<uint32_t> >& outValues)
+{
+    // Walk the trie depth-first, keeping keys in same order as they are stored
+    struct Level
+    {
+        const QVector<ObfIndexedStringTable::Entry>* entries;
+        int entryIndex;
+    };
+    QVector<Level> levels;
+    levels.push_back({ &table._entries, 0 });
+    while (!levels.isEmpty())
+    {
+        auto& level = levels.last();
+        if (level.entryIndex >= level.entries->size())
+        {
+            levels.pop_back();
+            continue;
+        }
+
+        const auto& entry = level.entries->at(level.entryIndex++);
+        if (!entry.values.isEmpty())
+        {
+            outKeys.push_back(entry.key);
+            outValues.push_back(entry.values);
+        }
+
+        if (!entry.subtable.isEmpty())
+            levels.push_back({ &entry.subtable, 0 });
+    }
+}
+
+std::shared_ptr<const OsmAnd::ObfNameNGramIndex> OsmAnd::ObfNameNGramIndex::build(const ObfIndexedStringTable& table)
+{
+    const std::shared_ptr<ObfNameNGramIndex> index(new ObfNameNGramIndex());
+
+    QVector<QString> keys;
+    QVector< QVector<uint32_t> > values;
+    collectKeys(table, keys, values);
+
+    index->_keys.reserve(keys.size());
+    index->_keysIndicesByLength.reserve(keys.size());
+    for (auto keyIndex = 0; keyIndex < keys.size(); keyIndex++)
+    {
+        Key key;
+        key.key = keys[keyIndex];
+        key.values = values[keyIndex];
+        index->_keys.push_back(key);
+        index->_keysIndicesByLength.push_back(keyIndex);
+
+        const auto paddedKey = pad(key.key);
+        for (auto position = 0; position < key.key.size(); position++)
+        {
+            Posting posting;
+            posting.keyIndex = keyIndex;
+            posting.position = position;
+            index->_postings[trigramAt(paddedKey, position)].push_back(posting);
+        }
+    }
+
+    const auto& builtKeys = index->_keys;
+    std::stable_sort(index->_keysIndicesByLength.begin(), index->_keysIndicesByLength.end(),
+        [&builtKeys]
+        (const int l, const int r) -> bool
+        {
+            return builtKeys[l].key.size() < builtKeys[r].key.size();
+        });
+
+    return index;
+}
+
+std::shared_ptr<const OsmAnd::ObfNameNGramIndex> OsmAnd::ObfNameNGramIndex::obtainResident(
+    const ObfIndexedStringTable& table,
+    QMutex& buildMutex,
+    QAtomicInt& built,
+    std::shared_ptr<const ObfNameNGramIndex>& index)
+{
+    if (built.loadAcquire() == 0)
+    {
+        QMutexLocker scopedLocker(&buildMutex);
+        if (!index)
+        {
+            index = build(table);
+            built.storeRelease(1);
+        }
+    }
+
+    return index;
+}
+
+int OsmAnd::ObfNameNGramIndex::computePrefixEditDistance(const QString& shorter, const QString& longer, const int limit)
+{
+    // Prefixes of longer string that are more than limit characters longer than shorter one are not interesting
+    const auto columnsCount = qMin(longer.size(), shorter.size() + limit) + 1;
+    QVector<int> row(columnsCount);
+    for (auto column = 0; column < columnsCount; column++)
+        row[column] = column;
+
+    for (auto rowIndex = 1; rowIndex <= shorter.size(); rowIndex++)
+    {
+        const auto c = shorter.at(rowIndex - 1);
+
+        auto diagonal = row[0];
+        row[0] = rowIndex;
+        auto rowMin = row[0];
+        for (auto column = 1; column < columnsCount; column++)
+        {
+            const auto value = qMin(
+                diagonal + (c == longer.at(column - 1) ? 0 : 1),
+                qMin(row[column], row[column - 1]) + 1);
+            diagonal = row[column];
+            row[column] = value;
+            rowMin = qMin(rowMin, value);
+        }
+
+        if (rowMin > limit)
+            return limit + 1;
+    }
+
+    return *std::min_element(row.cbegin(), row.cend());
+}
+
+bool OsmAnd::ObfNameNGramIndex::containsApproximately(
+    const QString& text,
+    const QString& normalizedQuery,
+    const unsigned int maxEditDistance_,
+    const Qt::CaseSensitivity caseSensitivity /*= Qt::CaseSensitive*/)
+{
+    if (maxEditDistance_ == 0)
+        return text.contains(normalizedQuery, caseSensitivity);
+
+    const auto maxEditDistance = static_cast<int>(maxEditDistance_);
+    const auto queryLength = normalizedQuery.size();
+    if (queryLength <= maxEditDistance)
+        return true;
+
+    // Approximate substring matching: match may start anywhere in text, so first row is all zeroes
+    QVector<int> column(queryLength + 1);
+    for (auto row = 0; row <= queryLength; row++)
+        column[row] = row;
+
+    for (const auto& textCharacter : constOf(text))
+    {
+        const auto c = (caseSensitivity == Qt::CaseInsensitive) ? textCharacter.toCaseFolded() : textCharacter;
+        auto diagonal = column[0];
+        for (auto row = 1; row <= queryLength; row++)
+        {
+            const auto value = qMin(
+                diagonal + (c == normalizedQuery.at(row - 1) ? 0 : 1),
+                qMin(column[row], column[row - 1]) + 1);
+            diagonal = column[row];
+            column[row] = value;
+        }
+
+        if (column[queryLength] <= maxEditDistance)
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,90 @@
+#ifndef _OSMAND_CORE_OBF_NAME_N_GRAM_INDEX_H_
+#define _OSMAND_CORE_OBF_NAME_N_GRAM_INDEX_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "OsmAndCore.h"
+
+namespace OsmAnd
+{
+    class ObfIndexedStringTable;
+
+    // Trigram index over keys of resident name index, used to find keys that are within few edits from query.
+    // Trigram counts only filter candidate keys, each candidate is verified by bounded edit distance. Like
+    // keys of name index, query matches key if one of them is (approximately) prefix of another one.
+    // Immutable once built, so it can be shared by any number of threads.
+    class ObfNameNGramIndex Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(ObfNameNGramIndex);
+    public:
+        enum
+        {
+            MaxEditDistance = 2,
+        };
+
+    private:
+        struct Key
+        {
+            QString key;
+            QVector<uint32_t> values;
+        };
+        QVector<Key> _keys;
+
+        // Indices of keys ordered by length of key
+        QVector<int> _keysIndicesByLength;
+
+        struct Posting
+        {
+            int keyIndex;
+            int position;
+        };
+        QHash<uint64_t, QVector<Posting> > _postings;
+
+        bool matches(const Key& key, const QString& normalizedQuery, const int maxEditDistance) const;
+
+        static void collectKeys(
+            const ObfIndexedStringTable& table,
+            QVector<QString>& outKeys,
+            QVector< QVector<uint32_t> >& outValues);
+        static uint64_t trigramAt(const QString& paddedString, const int position);
+        static QString pad(const QString& string);
+    protected:
+        ObfNameNGramIndex();
+    public:
+        ~ObfNameNGramIndex();
+
+        unsigned int getKeysCount() const;
+
+        // Query is expected to be normalized by ObfNameNormalizer, like keys are
+        void scan(const QString& normalizedQuery, const unsigned int maxEditDistance, QVector<uint32_t>& outValues) const;
+
+        static std::shared_ptr<const ObfNameNGramIndex> build(const ObfIndexedStringTable& table);
+
+        // Builds index into resident slot of section on first call, like ObfIndexedStringTable::obtainResident()
+        static std::shared_ptr<const ObfNameNGramIndex> obtainResident(
+            const ObfIndexedStringTable& table,
+            QMutex& buildMutex,
+            QAtomicInt& built,
+            std::shared_ptr<const ObfNameNGramIndex>& index);
+
+        // Minimal edit distance between shorter string and any prefix of longer one
+        static int computePrefixEditDistance(const QString& shorter, const QString& longer, const int limit);
+
+        // True if some part of text is within maxEditDistance edits from normalized query. Text is either normalized
+        // too, or compared case-insensitively, which is what normalization with case folding only does to it
+        static bool containsApproximately(
+            const QString& text,
+            const QString& normalizedQuery,
+            const unsigned int maxEditDistance,
+            const Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_NAME_N_GRAM_INDEX_H_)
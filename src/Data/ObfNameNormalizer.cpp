@@ -0,0 +1,84 @@
+#include "ObfNameNormalizer.h"
+
+#include "QtCommon.h"
+#include "ICU.h"
+#include "ObfNameNGramIndex.h"
+
+QString OsmAnd::ObfNameNormalizer::normalize(const QString& input)
+{
+    return normalize(input, ObfFile::getNameNormalization());
+}
+
+QString OsmAnd::ObfNameNormalizer::normalize(const QString& input, const ObfFile::NameNormalization normalization)
+{
+    if (input.isEmpty())
+        return input;
+
+    switch (normalization)
+    {
+        case ObfFile::NameNormalization::StripAccentsAndDiacritics:
+            return ICU::stripAccentsAndDiacritics(input).toCaseFolded();
+        case ObfFile::NameNormalization::TransliterateToLatin:
+            return ICU::transliterateToLatin(input, false, false).toCaseFolded();
+        case ObfFile::NameNormalization::CaseFolding:
+        default:
+            return input.toCaseFolded();
+    }
+}
+
+OsmAnd::ObfFile::NameNormalization OsmAnd::ObfNameNormalizer::lockNormalization()
+{
+    return ObfFile::lockNameNormalization();
+}
+
+bool OsmAnd::ObfNameNormalizer::isCaseFoldingOnly(const ObfFile::NameNormalization normalization)
+{
+    return normalization == ObfFile::NameNormalization::CaseFolding;
+}
+
+QStringList OsmAnd::ObfNameNormalizer::normalizeNames(
+    const QString& nativeName,
+    const QHash<QString, QString>& localizedNames,
+    const ObfFile::NameNormalization normalization)
+{
+    QStringList normalizedNames;
+    if (isCaseFoldingOnly(normalization))
+        return normalizedNames;
+
+    normalizedNames.reserve(1 + localizedNames.size());
+    normalizedNames.push_back(normalize(nativeName, normalization));
+    for (const auto& localizedName : constOf(localizedNames))
+        normalizedNames.push_back(normalize(localizedName, normalization));
+    return normalizedNames;
+}
+
+bool OsmAnd::ObfNameNormalizer::anyNameContains(
+    const QString& nativeName,
+    const QHash<QString, QString>& localizedNames,
+    const QStringList& normalizedNames,
+    const QString& normalizedQuery,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance)
+{
+    if (isCaseFoldingOnly(normalization))
+    {
+        if (ObfNameNGramIndex::containsApproximately(nativeName, normalizedQuery, maxEditDistance, Qt::CaseInsensitive))
+            return true;
+        for (const auto& localizedName : constOf(localizedNames))
+        {
+            if (ObfNameNGramIndex::containsApproximately(localizedName, normalizedQuery, maxEditDistance, Qt::CaseInsensitive))
+                return true;
+        }
+        return false;
+    }
+
+    const auto& effectiveNormalizedNames = normalizedNames.isEmpty()
+        ? normalizeNames(nativeName, localizedNames, normalization)
+        : normalizedNames;
+    for (const auto& normalizedName : constOf(effectiveNormalizedNames))
+    {
+        if (ObfNameNGramIndex::containsApproximately(normalizedName, normalizedQuery, maxEditDistance))
+            return true;
+    }
+    return false;
+}
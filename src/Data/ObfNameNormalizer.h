@@ -0,0 +1,49 @@
+#ifndef _OSMAND_CORE_OBF_NAME_NORMALIZER_H_
+#define _OSMAND_CORE_OBF_NAME_NORMALIZER_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+#include "OsmAndCore.h"
+#include "ObfFile.h"
+
+namespace OsmAnd
+{
+    // Brings names and queries to the form in which searches by name compare them, so that comparison itself
+    // is plain comparison of characters. Queries are expected to be normalized once per search, and names
+    // once per decoded object or entry of resident name index.
+    struct ObfNameNormalizer Q_DECL_FINAL
+    {
+        static QString normalize(const QString& input);
+        static QString normalize(const QString& input, const ObfFile::NameNormalization normalization);
+
+        // Mode search has to use from start to end. Once any search obtained it, it can't be changed anymore
+        static ObfFile::NameNormalization lockNormalization();
+
+        // With nothing but case folding, names are compared to query case-insensitively as-is instead of being
+        // normalized, and on-disk name index can be scanned, since its keys don't need normalizing either
+        static bool isCaseFoldingOnly(const ObfFile::NameNormalization normalization);
+
+        // Native name followed by localized ones, or nothing if names are compared as-is
+        static QStringList normalizeNames(
+            const QString& nativeName,
+            const QHash<QString, QString>& localizedNames,
+            const ObfFile::NameNormalization normalization);
+
+        // True if any of names contains normalized query within maxEditDistance edits. Names normalized earlier
+        // are compared as they are, others are normalized only if mode requires that
+        static bool anyNameContains(
+            const QString& nativeName,
+            const QHash<QString, QString>& localizedNames,
+            const QStringList& normalizedNames,
+            const QString& normalizedQuery,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_NAME_NORMALIZER_H_)
@@ -0,0 +1,94 @@
+#include "ObfPoiCategoryIndex.h"
+
+#include "QtExtensions.h"
+
+#include "Common.h"
+
+OsmAnd::ObfPoiCategoryIndex::ObfPoiCategoryIndex()
+{
+}
+
+OsmAnd::ObfPoiCategoryIndex::~ObfPoiCategoryIndex()
+{
+}
+
+unsigned int OsmAnd::ObfPoiCategoryIndex::getDataBoxesCount() const
+{
+    return _dataBoxes.size();
+}
+
+bool OsmAnd::ObfPoiCategoryIndex::accept(
+    const DataBox& dataBox,
+    const ZoomLevel minZoom,
+    const ZoomLevel maxZoom,
+    const AreaI* const bbox31) const
+{
+    // Parent tiles have lower zoom and contain tile of data box, so checking data box alone is enough
+    if (dataBox.zoom < minZoom || dataBox.zoom > maxZoom)
+        return false;
+    if (bbox31 && !bbox31->intersects(dataBox.bbox31))
+        return false;
+    return true;
+}
+
+void OsmAnd::ObfPoiCategoryIndex::query(
+    const QSet<ObfPoiCategoryId>& categoriesFilter,
+    const ZoomLevel minZoom,
+    const ZoomLevel maxZoom,
+    const AreaI* const bbox31,
+    QSet<uint32_t>& outDataOffsets) const
+{
+    for (const auto& category : constOf(categoriesFilter))
+    {
+        const auto citPostings = _postings.constFind(category);
+        if (citPostings == _postings.cend())
+            continue;
+
+        for (const auto dataBoxIndex : constOf(*citPostings))
+        {
+            const auto& dataBox = _dataBoxes[dataBoxIndex];
+            if (accept(dataBox, minZoom, maxZoom, bbox31))
+                outDataOffsets.insert(dataBox.dataOffset);
+        }
+    }
+
+    for (const auto dataBoxIndex : constOf(_uncategorizedDataBoxesIndices))
+    {
+        const auto& dataBox = _dataBoxes[dataBoxIndex];
+        if (accept(dataBox, minZoom, maxZoom, bbox31))
+            outDataOffsets.insert(dataBox.dataOffset);
+    }
+}
+
+std::shared_ptr<const OsmAnd::ObfPoiCategoryIndex> OsmAnd::ObfPoiCategoryIndex::build(
+    const QVector<DataBox>& dataBoxes)
+{
+    const std::shared_ptr<ObfPoiCategoryIndex> index(new ObfPoiCategoryIndex());
+
+    index->_dataBoxes = dataBoxes;
+    std::sort(index->_dataBoxes.begin(), index->_dataBoxes.end(),
+        []
+        (const DataBox& l, const DataBox& r) -> bool
+        {
+            return l.dataOffset < r.dataOffset;
+        });
+
+    for (auto dataBoxIndex = 0; dataBoxIndex < index->_dataBoxes.size(); dataBoxIndex++)
+    {
+        const auto& dataBox = index->_dataBoxes[dataBoxIndex];
+        if (!dataBox.hasCategories)
+        {
+            index->_uncategorizedDataBoxesIndices.push_back(dataBoxIndex);
+            continue;
+        }
+
+        for (const auto& category : constOf(dataBox.categories))
+        {
+            auto& postings = index->_postings[category];
+            if (postings.isEmpty() || postings.last() != dataBoxIndex)
+                postings.push_back(dataBoxIndex);
+        }
+    }
+
+    return index;
+}
@@ -0,0 +1,62 @@
+#ifndef _OSMAND_CORE_OBF_POI_CATEGORY_INDEX_H_
+#define _OSMAND_CORE_OBF_POI_CATEGORY_INDEX_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QVector>
+#include <QHash>
+#include <QSet>
+
+#include "OsmAndCore.h"
+#include "CommonTypes.h"
+#include "DataCommonTypes.h"
+
+namespace OsmAnd
+{
+    // Posting lists of data boxes of POI section by category, so query with categories filter doesn't walk
+    // and decode whole tiles tree. Data box is listed under categories of its own tile, or of closest parent
+    // tile that has them. Immutable once built, so it can be shared by any number of threads.
+    class ObfPoiCategoryIndex Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(ObfPoiCategoryIndex);
+    public:
+        struct DataBox
+        {
+            uint32_t dataOffset;
+            ZoomLevel zoom;
+            AreaI bbox31;
+            bool hasCategories;
+            QVector<ObfPoiCategoryId> categories;
+        };
+
+    private:
+        // Ordered by data offset
+        QVector<DataBox> _dataBoxes;
+
+        // Indices of data boxes in ascending order, by category
+        QHash<uint32_t, QVector<int> > _postings;
+
+        // Data boxes without categories can't be filtered, so they match any filter
+        QVector<int> _uncategorizedDataBoxesIndices;
+
+        bool accept(const DataBox& dataBox, const ZoomLevel minZoom, const ZoomLevel maxZoom, const AreaI* const bbox31) const;
+    protected:
+        ObfPoiCategoryIndex();
+    public:
+        ~ObfPoiCategoryIndex();
+
+        unsigned int getDataBoxesCount() const;
+
+        void query(
+            const QSet<ObfPoiCategoryId>& categoriesFilter,
+            const ZoomLevel minZoom,
+            const ZoomLevel maxZoom,
+            const AreaI* const bbox31,
+            QSet<uint32_t>& outDataOffsets) const;
+
+        static std::shared_ptr<const ObfPoiCategoryIndex> build(const QVector<DataBox>& dataBoxes);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_OBF_POI_CATEGORY_INDEX_H_)
@@ -1,6 +1,10 @@
 #include "ObfPoiSectionInfo_P.h"
 #include "ObfPoiSectionInfo.h"
 
+#include "ObfIndexedStringTable.h"
+#include "ObfNameNGramIndex.h"
+#include "ObfPoiCategoryIndex.h"
+
 OsmAnd::ObfPoiSectionInfo_P::ObfPoiSectionInfo_P(ObfPoiSectionInfo* owner_)
     : owner(owner_)
 {
@@ -22,6 +22,9 @@ namespace OsmAnd
 {
     class ObfPoiSectionCategories;
     class ObfPoiSectionSubtypes;
+    class ObfIndexedStringTable;
+    class ObfNameNGramIndex;
+    class ObfPoiCategoryIndex;
     class ObfPoiSectionReader_P;
 
     class ObfPoiSectionInfo;
@@ -38,6 +41,18 @@ namespace OsmAnd
         mutable std::shared_ptr<ObfPoiSectionSubtypes> _subtypes;
         mutable QAtomicInt _subtypesLoaded;
         mutable QMutex _subtypesLoadMutex;
+
+        mutable std::shared_ptr<const ObfIndexedStringTable> _nameIndex;
+        mutable QAtomicInt _nameIndexLoaded;
+        mutable QMutex _nameIndexLoadMutex;
+
+        mutable std::shared_ptr<const ObfNameNGramIndex> _nameNGramIndex;
+        mutable QAtomicInt _nameNGramIndexLoaded;
+        mutable QMutex _nameNGramIndexLoadMutex;
+
+        mutable std::shared_ptr<const ObfPoiCategoryIndex> _categoryIndex;
+        mutable QAtomicInt _categoryIndexLoaded;
+        mutable QMutex _categoryIndexLoadMutex;
     public:
         virtual ~ObfPoiSectionInfo_P();
 
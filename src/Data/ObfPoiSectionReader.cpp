@@ -38,7 +38,8 @@ void OsmAnd::ObfPoiSectionReader::loadAmenities(
     const AreaI* const bbox31 /*= nullptr*/,
     const QSet<ObfPoiCategoryId>* const categoriesFilter /*= nullptr*/,
     const ObfPoiSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric /*= nullptr*/)
 {
     ObfPoiSectionReader_P::loadAmenities(
         *reader->_p,
@@ -49,6 +50,28 @@ void OsmAnd::ObfPoiSectionReader::loadAmenities(
         bbox31,
         categoriesFilter,
         visitor,
+        queryController,
+        metric);
+}
+
+void OsmAnd::ObfPoiSectionReader::loadNearestAmenities(
+    const std::shared_ptr<const ObfReader>& reader,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section,
+    NearestAmenitiesCollector& collector,
+    const ZoomLevel minZoom /*= MinZoomLevel*/,
+    const ZoomLevel maxZoom /*= MaxZoomLevel*/,
+    const AreaI* const bbox31 /*= nullptr*/,
+    const QSet<ObfPoiCategoryId>* const categoriesFilter /*= nullptr*/,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    ObfPoiSectionReader_P::loadNearestAmenities(
+        *reader->_p,
+        section,
+        collector,
+        minZoom,
+        maxZoom,
+        bbox31,
+        categoriesFilter,
         queryController);
 }
 
@@ -61,12 +84,14 @@ void OsmAnd::ObfPoiSectionReader::scanAmenitiesByName(
     const AreaI* const bbox31 /*= nullptr*/,
     const QSet<ObfPoiCategoryId>* const categoriesFilter /*= nullptr*/,
     const ObfPoiSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    const unsigned int maxEditDistance /*= 0*/)
 {
     ObfPoiSectionReader_P::scanAmenitiesByName(
         *reader->_p,
         section,
         query,
+        maxEditDistance,
         outAmenities,
         minZoom,
         maxZoom,
@@ -75,3 +100,81 @@ void OsmAnd::ObfPoiSectionReader::scanAmenitiesByName(
         visitor,
         queryController);
 }
+
+OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::NearestAmenitiesCollector(
+    const PointI& point31_,
+    const unsigned int limit_,
+    const double maxDistance_)
+    : _maxDistance(maxDistance_)
+    , point31(point31_)
+    , limit(limit_)
+    , maxDistance(maxDistance_)
+{
+}
+
+OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::~NearestAmenitiesCollector()
+{
+}
+
+bool OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::isNearer(const Entry& l, const Entry& r)
+{
+    return l.distance < r.distance;
+}
+
+double OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::getMaxDistance() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return _maxDistance;
+}
+
+bool OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::offer(
+    const std::shared_ptr<const OsmAnd::Amenity>& amenity,
+    const double distance)
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    if (limit == 0 || distance > _maxDistance)
+        return false;
+
+    Entry entry;
+    entry.amenity = amenity;
+    entry.distance = distance;
+    if (_entries.size() >= static_cast<int>(limit))
+    {
+        std::pop_heap(_entries.begin(), _entries.end(), isNearer);
+        _entries.last() = entry;
+    }
+    else
+    {
+        _entries.push_back(entry);
+    }
+    std::push_heap(_entries.begin(), _entries.end(), isNearer);
+
+    if (_entries.size() >= static_cast<int>(limit))
+        _maxDistance = _entries.first().distance;
+
+    return true;
+}
+
+QList<OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::Entry>
+OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::getEntries() const
+{
+    QVector<Entry> entries;
+    {
+        QMutexLocker scopedLocker(&_mutex);
+        entries = _entries;
+    }
+
+    std::sort(entries.begin(), entries.end(), isNearer);
+    return entries.toList();
+}
+
+OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::Entry::Entry()
+    : distance(0.0)
+{
+}
+
+OsmAnd::ObfPoiSectionReader::NearestAmenitiesCollector::Entry::~Entry()
+{
+}
@@ -0,0 +1,31 @@
+#include "ObfPoiSectionReader_Metrics.h"
+
+OsmAnd::ObfPoiSectionReader_Metrics::Metric_loadAmenities::Metric_loadAmenities()
+{
+    reset();
+}
+
+OsmAnd::ObfPoiSectionReader_Metrics::Metric_loadAmenities::~Metric_loadAmenities()
+{
+}
+
+void OsmAnd::ObfPoiSectionReader_Metrics::Metric_loadAmenities::reset()
+{
+    OsmAnd__ObfPoiSectionReader_Metrics__Metric_loadAmenities__FIELDS(RESET_METRIC_FIELD);
+
+    Metric::reset();
+}
+
+QString OsmAnd::ObfPoiSectionReader_Metrics::Metric_loadAmenities::toString(const bool shortFormat /*= false*/, const QString& prefix /*= QString::null*/) const
+{
+    QString output;
+
+    OsmAnd__ObfPoiSectionReader_Metrics__Metric_loadAmenities__FIELDS(PRINT_METRIC_FIELD);
+
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("~decoded/returned = %1")).arg(returnedAmenities > 0 ? static_cast<float>(decodedAmenities) / static_cast<float>(returnedAmenities) : 0.0f);
+    const auto submetricsString = Metric::toString(shortFormat, prefix);
+    if (!submetricsString.isEmpty())
+        output += QLatin1String("\n") + Metric::toString(shortFormat, prefix);
+
+    return output;
+}
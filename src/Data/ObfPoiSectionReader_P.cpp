@@ -1,5 +1,9 @@
 #include "ObfPoiSectionReader_P.h"
 
+#include "stdlib_common.h"
+#include <queue>
+#include <vector>
+
 #include "ignore_warnings_on_external_includes.h"
 #include "OBF.pb.h"
 #include <google/protobuf/wire_format_lite.h>
@@ -11,10 +15,17 @@
 #include "ObfReader_P.h"
 #include "ObfPoiSectionInfo.h"
 #include "ObfPoiSectionInfo_P.h"
+#include "ObfFile.h"
+#include "ObfIndexedStringTable.h"
+#include "ObfNameNGramIndex.h"
+#include "ObfNameNormalizer.h"
+#include "ObfPoiCategoryIndex.h"
+#include "ObfPoiSectionReader_Metrics.h"
 #include "Amenity.h"
 #include "ObfReaderUtilities.h"
 #include "IQueryController.h"
 #include "Utilities.h"
+#include "Stopwatch.h"
 
 OsmAnd::ObfPoiSectionReader_P::ObfPoiSectionReader_P()
 {
@@ -354,8 +365,10 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
     const ZoomLevel maxZoom,
     const AreaI* const bbox31,
     const QSet<ObfPoiCategoryId>* const categoriesFilter,
+    const std::shared_ptr<const ObfPoiCategoryIndex>& categoryIndex,
     const ObfPoiSectionReader::VisitorFunction visitor,
-    const std::shared_ptr<const IQueryController>& queryController)
+    const std::shared_ptr<const IQueryController>& queryController,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric)
 {
     const auto cis = reader.getCodedInputStream().get();
 
@@ -375,9 +388,16 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
             case OBF::OsmAndPoiIndex::kBoxesFieldNumber:
             {
                 const auto length = ObfReaderUtilities::readBigEndianInt(cis);
+                if (categoryIndex)
+                {
+                    cis->Skip(length);
+                    break;
+                }
                 const auto offset = cis->CurrentPosition();
                 const auto oldLimit = cis->PushLimit(length);
 
+                const Stopwatch scanTilesStopwatch(metric != nullptr);
+
                 scanTiles(
                     reader,
                     dataBoxesOffsetsSet,
@@ -386,7 +406,12 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
                     minZoom,
                     maxZoom,
                     bbox31,
-                    categoriesFilter);
+                    categoriesFilter,
+                    metric);
+
+                // Update metric
+                if (metric)
+                    metric->elapsedTimeForBoxes += scanTilesStopwatch.elapsed();
 
                 ObfReaderUtilities::ensureAllDataWasRead(cis);
                 cis->PopLimit(oldLimit);
@@ -397,6 +422,22 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
             }
             case OBF::OsmAndPoiIndex::kPoiDataFieldNumber:
             {
+                if (categoryIndex)
+                {
+                    const Stopwatch categoryIndexStopwatch(metric != nullptr);
+
+                    categoryIndex->query(*categoriesFilter, minZoom, maxZoom, bbox31, dataBoxesOffsetsSet);
+
+                    // Update metric
+                    if (metric)
+                    {
+                        metric->elapsedTimeForBoxes += categoryIndexStopwatch.elapsed();
+                        metric->dataBoxesFromCategoryIndex += dataBoxesOffsetsSet.size();
+                    }
+                }
+
+                const Stopwatch dataBoxesStopwatch(metric != nullptr);
+
                 auto dataBoxesOffsets = vectorFrom(dataBoxesOffsetsSet);
                 std::sort(dataBoxesOffsets);
 
@@ -417,12 +458,15 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
                         processedObjectsSet,
                         outAmenities,
                         QString::null,
+                        ObfFile::NameNormalization::CaseFolding,
+                        0,
                         minZoom,
                         maxZoom,
                         bbox31,
                         categoriesFilter,
                         visitor,
-                        queryController);
+                        queryController,
+                        metric);
 
                     ObfReaderUtilities::ensureAllDataWasRead(cis);
                     cis->PopLimit(oldLimit);
@@ -430,6 +474,10 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenities(
                         return;
                 }
 
+                // Update metric
+                if (metric)
+                    metric->elapsedTimeForDataBoxes += dataBoxesStopwatch.elapsed();
+
                 cis->Skip(cis->BytesUntilLimit());
                 return;
             }
@@ -448,10 +496,15 @@ void OsmAnd::ObfPoiSectionReader_P::scanTiles(
     const ZoomLevel minZoom,
     const ZoomLevel maxZoom,
     const AreaI* const bbox31,
-    const QSet<ObfPoiCategoryId>* const categoriesFilter)
+    const QSet<ObfPoiCategoryId>* const categoriesFilter,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric)
 {
     const auto cis = reader.getCodedInputStream().get();
 
+    // Update metric
+    if (metric)
+        metric->visitedBoxes++;
+
     gpb::uint32 deltaZoom = 0;
     auto zoom = MinZoomLevel;
     auto tileId = TileId::zero();
@@ -533,7 +586,7 @@ void OsmAnd::ObfPoiSectionReader_P::scanTiles(
                 const auto offset = cis->CurrentPosition();
                 const auto oldLimit = cis->PushLimit(length);
 
-                scanTiles(reader, outDataOffsets, zoom, tileId, minZoom, maxZoom, bbox31, categoriesFilter);
+                scanTiles(reader, outDataOffsets, zoom, tileId, minZoom, maxZoom, bbox31, categoriesFilter, metric);
                 ObfReaderUtilities::ensureAllDataWasRead(cis);
 
                 cis->PopLimit(oldLimit);
@@ -601,21 +654,213 @@ bool OsmAnd::ObfPoiSectionReader_P::scanTileForMatchingCategories(
     }
 }
 
+std::shared_ptr<const OsmAnd::ObfPoiCategoryIndex> OsmAnd::ObfPoiSectionReader_P::obtainCategoryIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section)
+{
+    if (section->_p->_categoryIndexLoaded.loadAcquire() == 0)
+    {
+        QMutexLocker scopedLocker(&section->_p->_categoryIndexLoadMutex);
+        if (!section->_p->_categoryIndex)
+        {
+            const auto cis = reader.getCodedInputStream().get();
+            cis->Seek(section->offset);
+            auto oldLimit = cis->PushLimit(section->length);
+            cis->Skip(section->firstBoxInnerOffset);
+
+            QVector<ObfPoiCategoryIndex::DataBox> dataBoxes;
+            readCategoryIndexDataBoxes(reader, dataBoxes);
+            section->_p->_categoryIndex = ObfPoiCategoryIndex::build(dataBoxes);
+
+            ObfReaderUtilities::ensureAllDataWasRead(cis);
+            cis->PopLimit(oldLimit);
+
+            section->_p->_categoryIndexLoaded.storeRelease(1);
+        }
+    }
+
+    return section->_p->_categoryIndex;
+}
+
+void OsmAnd::ObfPoiSectionReader_P::readCategoryIndexDataBoxes(
+    const ObfReader_P& reader,
+    QVector<ObfPoiCategoryIndex::DataBox>& outDataBoxes)
+{
+    const auto cis = reader.getCodedInputStream().get();
+
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::OsmAndPoiIndex::kBoxesFieldNumber:
+            {
+                const auto length = ObfReaderUtilities::readBigEndianInt(cis);
+                const auto oldLimit = cis->PushLimit(length);
+
+                readCategoryIndexTile(reader, outDataBoxes, MinZoomLevel, TileId::zero(), nullptr);
+
+                ObfReaderUtilities::ensureAllDataWasRead(cis);
+                cis->PopLimit(oldLimit);
+                break;
+            }
+            case OBF::OsmAndPoiIndex::kPoiDataFieldNumber:
+                cis->Skip(cis->BytesUntilLimit());
+                return;
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+}
+
+void OsmAnd::ObfPoiSectionReader_P::readCategoryIndexTile(
+    const ObfReader_P& reader,
+    QVector<ObfPoiCategoryIndex::DataBox>& outDataBoxes,
+    const ZoomLevel parentZoom,
+    const TileId parentTileId,
+    const QVector<ObfPoiCategoryId>* const parentCategories)
+{
+    const auto cis = reader.getCodedInputStream().get();
+
+    gpb::uint32 deltaZoom = 0;
+    auto zoom = MinZoomLevel;
+    auto tileId = TileId::zero();
+    QVector<ObfPoiCategoryId> categories;
+    bool hasCategories = false;
+
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::OsmAndPoiBox::kZoomFieldNumber:
+                cis->ReadVarint32(&deltaZoom);
+                zoom = static_cast<ZoomLevel>(static_cast<gpb::uint32>(parentZoom) + deltaZoom);
+                break;
+            case OBF::OsmAndPoiBox::kLeftFieldNumber:
+            {
+                const auto d = ObfReaderUtilities::readSInt32(cis);
+                tileId.x = (parentTileId.x << deltaZoom) + d;
+                break;
+            }
+            case OBF::OsmAndPoiBox::kTopFieldNumber:
+            {
+                const auto d = ObfReaderUtilities::readSInt32(cis);
+                tileId.y = (parentTileId.y << deltaZoom) + d;
+                break;
+            }
+            case OBF::OsmAndPoiBox::kCategoriesFieldNumber:
+            {
+                gpb::uint32 length;
+                cis->ReadVarint32(&length);
+                const auto oldLimit = cis->PushLimit(length);
+
+                readTileCategories(reader, categories);
+                hasCategories = true;
+
+                ObfReaderUtilities::ensureAllDataWasRead(cis);
+                cis->PopLimit(oldLimit);
+                break;
+            }
+            case OBF::OsmAndPoiBox::kSubBoxesFieldNumber:
+            {
+                const auto length = ObfReaderUtilities::readBigEndianInt(cis);
+                const auto oldLimit = cis->PushLimit(length);
+
+                readCategoryIndexTile(
+                    reader,
+                    outDataBoxes,
+                    zoom,
+                    tileId,
+                    hasCategories ? &categories : parentCategories);
+
+                ObfReaderUtilities::ensureAllDataWasRead(cis);
+                cis->PopLimit(oldLimit);
+                break;
+            }
+            case OBF::OsmAndPoiBox::kShiftToDataFieldNumber:
+            {
+                ObfPoiCategoryIndex::DataBox dataBox;
+                dataBox.dataOffset = ObfReaderUtilities::readBigEndianInt(cis);
+                dataBox.zoom = zoom;
+                dataBox.bbox31 = Utilities::tileBoundingBox31(tileId, zoom);
+                dataBox.hasCategories = hasCategories || parentCategories;
+                if (hasCategories)
+                    dataBox.categories = categories;
+                else if (parentCategories)
+                    dataBox.categories = *parentCategories;
+                outDataBoxes.push_back(dataBox);
+                break;
+            }
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+}
+
+void OsmAnd::ObfPoiSectionReader_P::readTileCategories(
+    const ObfReader_P& reader,
+    QVector<ObfPoiCategoryId>& outCategories)
+{
+    const auto cis = reader.getCodedInputStream().get();
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::OsmAndPoiCategories::kCategoriesFieldNumber:
+            {
+                ObfPoiCategoryId id;
+                cis->ReadVarint32(reinterpret_cast<gpb::uint32*>(&id));
+                outCategories.push_back(id);
+                break;
+            }
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+}
+
 void OsmAnd::ObfPoiSectionReader_P::readAmenitiesDataBox(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfPoiSectionInfo>& section,
     QSet<ObfObjectId>& processedObjects,
     QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
     const QString& query,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     const ZoomLevel minZoom,
     const ZoomLevel maxZoom,
     const AreaI* const bbox31,
     const QSet<ObfPoiCategoryId>* const categoriesFilter,
     const ObfPoiSectionReader::VisitorFunction visitor,
-    const std::shared_ptr<const IQueryController>& queryController)
+    const std::shared_ptr<const IQueryController>& queryController,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric)
 {
     const auto cis = reader.getCodedInputStream().get();
 
+    // Update metric
+    if (metric)
+        metric->dataBoxesRead++;
+
     auto zoom = InvalidZoomLevel;
     auto tileId = TileId::zero();
     bool firstAmenityRead = false;
@@ -669,11 +914,15 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenitiesDataBox(
                 const auto oldLimit = cis->PushLimit(length);
 
                 std::shared_ptr<const Amenity> amenity;
-                readAmenity(reader, section, amenity, query, zoom, tileId, bbox31, categoriesFilter, queryController);
+                readAmenity(reader, section, amenity, query, normalization, maxEditDistance, zoom, tileId, bbox31, categoriesFilter, queryController);
 
                 ObfReaderUtilities::ensureAllDataWasRead(cis);
                 cis->PopLimit(oldLimit);
 
+                // Update metric
+                if (metric)
+                    metric->decodedAmenities++;
+
                 if (!amenity)
                     break;
 
@@ -683,6 +932,10 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenitiesDataBox(
 
                 if (!visitor || visitor(amenity))
                 {
+                    // Update metric
+                    if (metric)
+                        metric->returnedAmenities++;
+
                     if (outAmenities)
                         outAmenities->push_back(qMove(amenity));
                 }
@@ -700,6 +953,8 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenity(
     const std::shared_ptr<const ObfPoiSectionInfo>& section,
     std::shared_ptr<const Amenity>& outAmenity,
     const QString& query,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     const ZoomLevel zoom,
     const TileId boxTileId,
     const AreaI* const bbox31,
@@ -731,18 +986,19 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenity(
                 if (!ObfReaderUtilities::reachedDataEnd(cis))
                     return;
 
+                // Each decoded name is normalized once and carried by amenity, so later stages of search don't
+                // normalize it again
+                QStringList normalizedNames;
                 if (!query.isNull())
                 {
-                    bool accept = false;
-                    accept = accept || nativeName.contains(query, Qt::CaseInsensitive);
-                    for (const auto& localizedName : constOf(localizedNames))
-                    {
-                        accept = accept || localizedName.contains(query, Qt::CaseInsensitive);
-
-                        if (accept)
-                            break;
-                    }
-
+                    normalizedNames = ObfNameNormalizer::normalizeNames(nativeName, localizedNames, normalization);
+                    const auto accept = ObfNameNormalizer::anyNameContains(
+                        nativeName,
+                        localizedNames,
+                        normalizedNames,
+                        query,
+                        normalization,
+                        maxEditDistance);
                     if (!accept)
                         return;
                 }
@@ -759,6 +1015,7 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenity(
 
                 amenity->nativeName = qMove(nativeName);
                 amenity->localizedNames = qMove(localizedNames);
+                amenity->normalizedNames = qMove(normalizedNames);
                 amenity->position31 = position31;
                 amenity->categories = qMove(categories);
                 if (autogenerateId)
@@ -868,10 +1125,131 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenity(
     }
 }
 
+void OsmAnd::ObfPoiSectionReader_P::readNearestAmenitiesTileHeader(
+    const ObfReader_P& reader,
+    NearestAmenitiesTile& inOutTile)
+{
+    const auto cis = reader.getCodedInputStream().get();
+
+    gpb::uint32 deltaZoom = 0;
+    inOutTile.zoom = inOutTile.parentZoom;
+    inOutTile.tileId = TileId::zero();
+
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::OsmAndPoiBox::kZoomFieldNumber:
+                cis->ReadVarint32(&deltaZoom);
+                inOutTile.zoom = static_cast<ZoomLevel>(static_cast<gpb::uint32>(inOutTile.parentZoom) + deltaZoom);
+                break;
+            case OBF::OsmAndPoiBox::kLeftFieldNumber:
+            {
+                const auto d = ObfReaderUtilities::readSInt32(cis);
+                inOutTile.tileId.x = (inOutTile.parentTileId.x << deltaZoom) + d;
+                break;
+            }
+            case OBF::OsmAndPoiBox::kTopFieldNumber:
+            {
+                const auto d = ObfReaderUtilities::readSInt32(cis);
+                inOutTile.tileId.y = (inOutTile.parentTileId.y << deltaZoom) + d;
+                return;
+            }
+            default:
+                // Header fields precede all others, so rest of tile is not needed
+                return;
+        }
+    }
+}
+
+void OsmAnd::ObfPoiSectionReader_P::readNearestAmenitiesTile(
+    const ObfReader_P& reader,
+    const NearestAmenitiesTile& tile,
+    QList<NearestAmenitiesTile>& outSubtiles,
+    QList<uint32_t>& outDataOffsets,
+    const ZoomLevel minZoom,
+    const ZoomLevel maxZoom,
+    const QSet<ObfPoiCategoryId>* const categoriesFilter)
+{
+    const auto cis = reader.getCodedInputStream().get();
+
+    for (;;)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+                if (!ObfReaderUtilities::reachedDataEnd(cis))
+                    return;
+
+                return;
+            case OBF::OsmAndPoiBox::kCategoriesFieldNumber:
+            {
+                gpb::uint32 length;
+                cis->ReadVarint32(&length);
+                if (!categoriesFilter)
+                {
+                    cis->Skip(length);
+                    break;
+                }
+                const auto oldLimit = cis->PushLimit(length);
+
+                const auto hasMatchingContent = scanTileForMatchingCategories(reader, *categoriesFilter);
+
+                cis->PopLimit(oldLimit);
+
+                if (!hasMatchingContent)
+                {
+                    cis->Skip(cis->BytesUntilLimit());
+                    return;
+                }
+                break;
+            }
+            case OBF::OsmAndPoiBox::kSubBoxesFieldNumber:
+            {
+                NearestAmenitiesTile subtile;
+                subtile.length = ObfReaderUtilities::readBigEndianInt(cis);
+                subtile.offset = cis->CurrentPosition();
+                subtile.parentZoom = tile.zoom;
+                subtile.parentTileId = tile.tileId;
+                subtile.dataOffset = 0;
+                const auto oldLimit = cis->PushLimit(subtile.length);
+
+                readNearestAmenitiesTileHeader(reader, subtile);
+
+                cis->Skip(cis->BytesUntilLimit());
+                cis->PopLimit(oldLimit);
+
+                if (subtile.zoom <= maxZoom)
+                    outSubtiles.push_back(subtile);
+                break;
+            }
+            case OBF::OsmAndPoiBox::kShiftToDataFieldNumber:
+            {
+                const auto dataOffset = ObfReaderUtilities::readBigEndianInt(cis);
+                if (tile.zoom >= minZoom)
+                    outDataOffsets.push_back(dataOffset);
+                break;
+            }
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+}
+
 void OsmAnd::ObfPoiSectionReader_P::readAmenitiesByName(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfPoiSectionInfo>& section,
     const QString& query,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
     const ZoomLevel minZoom,
     const ZoomLevel maxZoom,
@@ -903,7 +1281,10 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenitiesByName(
 
                 scanNameIndex(
                     reader,
+                    section,
                     query,
+                    normalization,
+                    maxEditDistance,
                     dataBoxesOffsetsSet,
                     minZoom,
                     maxZoom,
@@ -938,12 +1319,15 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenitiesByName(
                         processedObjectsSet,
                         outAmenities,
                         query,
+                        normalization,
+                        maxEditDistance,
                         minZoom,
                         maxZoom,
                         bbox31,
                         categoriesFilter,
                         visitor,
-                        queryController);
+                        queryController,
+                        nullptr);
 
                     ObfReaderUtilities::ensureAllDataWasRead(cis);
                     cis->PopLimit(oldLimit);
@@ -961,9 +1345,37 @@ void OsmAnd::ObfPoiSectionReader_P::readAmenitiesByName(
     }
 }
 
+std::shared_ptr<const OsmAnd::ObfIndexedStringTable> OsmAnd::ObfPoiSectionReader_P::obtainNameIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section)
+{
+    return ObfIndexedStringTable::obtainResident(
+        reader.getCodedInputStream().get(),
+        section->_p->_nameIndexLoadMutex,
+        section->_p->_nameIndexLoaded,
+        section->_p->_nameIndex);
+}
+
+std::shared_ptr<const OsmAnd::ObfNameNGramIndex> OsmAnd::ObfPoiSectionReader_P::obtainNameNGramIndex(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section)
+{
+    // Built from resident name index, so table at current position is consumed in any case
+    const auto nameIndex = obtainNameIndex(reader, section);
+
+    return ObfNameNGramIndex::obtainResident(
+        *nameIndex,
+        section->_p->_nameNGramIndexLoadMutex,
+        section->_p->_nameNGramIndexLoaded,
+        section->_p->_nameNGramIndex);
+}
+
 void OsmAnd::ObfPoiSectionReader_P::scanNameIndex(
     const ObfReader_P& reader,
-    const QString& query,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section,
+    const QString& normalizedQuery,
+    const ObfFile::NameNormalization normalization,
+    const unsigned int maxEditDistance,
     QSet<uint32_t>& outDataOffsets,
     const ZoomLevel minZoom,
     const ZoomLevel maxZoom,
@@ -990,7 +1402,13 @@ void OsmAnd::ObfPoiSectionReader_P::scanNameIndex(
                 baseOffset = cis->CurrentPosition();
                 const auto oldLimit = cis->PushLimit(length);
 
-                ObfReaderUtilities::scanIndexedStringTable(cis, query, intermediateOffsets);
+                // Query was folded by caller, so resident and streamed tables are scanned with same string
+                if (maxEditDistance > 0)
+                    obtainNameNGramIndex(reader, section)->scan(normalizedQuery, maxEditDistance, intermediateOffsets);
+                else if (ObfFile::isResidentNameIndexEnabled() || !ObfNameNormalizer::isCaseFoldingOnly(normalization))
+                    obtainNameIndex(reader, section)->scan(normalizedQuery, intermediateOffsets);
+                else
+                    ObfReaderUtilities::scanIndexedStringTable(cis, normalizedQuery, intermediateOffsets);
                 ObfReaderUtilities::ensureAllDataWasRead(cis);
 
                 cis->PopLimit(oldLimit);
@@ -1153,26 +1571,189 @@ void OsmAnd::ObfPoiSectionReader_P::loadAmenities(
     const AreaI* const bbox31,
     const QSet<ObfPoiCategoryId>* const categoriesFilter,
     const ObfPoiSectionReader::VisitorFunction visitor,
-    const std::shared_ptr<const IQueryController>& queryController)
+    const std::shared_ptr<const IQueryController>& queryController,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric)
 {
     ensureCategoriesLoaded(reader, section);
     ensureSubtypesLoaded(reader, section);
 
+    std::shared_ptr<const ObfPoiCategoryIndex> categoryIndex;
+    if (categoriesFilter && ObfFile::isPoiCategoryIndexEnabled())
+        categoryIndex = obtainCategoryIndex(reader, section);
+
     const auto cis = reader.getCodedInputStream().get();
     cis->Seek(section->offset);
     auto oldLimit = cis->PushLimit(section->length);
     cis->Skip(section->firstBoxInnerOffset);
 
-    readAmenities(reader, section, outAmenities, minZoom, maxZoom, bbox31, categoriesFilter, visitor, queryController);
+    readAmenities(
+        reader,
+        section,
+        outAmenities,
+        minZoom,
+        maxZoom,
+        bbox31,
+        categoriesFilter,
+        categoryIndex,
+        visitor,
+        queryController,
+        metric);
 
     ObfReaderUtilities::ensureAllDataWasRead(cis);
     cis->PopLimit(oldLimit);
 }
 
+void OsmAnd::ObfPoiSectionReader_P::loadNearestAmenities(
+    const ObfReader_P& reader,
+    const std::shared_ptr<const ObfPoiSectionInfo>& section,
+    ObfPoiSectionReader::NearestAmenitiesCollector& collector,
+    const ZoomLevel minZoom,
+    const ZoomLevel maxZoom,
+    const AreaI* const bbox31,
+    const QSet<ObfPoiCategoryId>* const categoriesFilter,
+    const std::shared_ptr<const IQueryController>& queryController)
+{
+    ensureCategoriesLoaded(reader, section);
+    ensureSubtypesLoaded(reader, section);
+
+    const auto cis = reader.getCodedInputStream().get();
+    cis->Seek(section->offset);
+    auto oldLimit = cis->PushLimit(section->length);
+    cis->Skip(section->firstBoxInnerOffset);
+
+    // Tiles and data boxes are visited in order of distance from point to their tile, so as soon as nearest
+    // of them is farther than farthest collected amenity, nothing else in this section can be collected
+    typedef std::pair<double, int> QueueEntry;
+    std::priority_queue< QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+    QVector<NearestAmenitiesTile> pendingTiles;
+    const auto enqueue =
+        [&queue, &pendingTiles, &collector, bbox31]
+        (const NearestAmenitiesTile& tile)
+        {
+            const auto tileBBox31 = Utilities::tileBoundingBox31(tile.tileId, tile.zoom);
+            if (bbox31 && !bbox31->intersects(tileBBox31))
+                return;
+
+            const auto distance = Utilities::distance31(collector.point31, tileBBox31);
+            if (distance > collector.getMaxDistance())
+                return;
+
+            queue.push(QueueEntry(distance, pendingTiles.size()));
+            pendingTiles.push_back(tile);
+        };
+
+    auto rootTilesRead = false;
+    while (!rootTilesRead)
+    {
+        const auto tag = cis->ReadTag();
+        switch (gpb::internal::WireFormatLite::GetTagFieldNumber(tag))
+        {
+            case 0:
+            case OBF::OsmAndPoiIndex::kPoiDataFieldNumber:
+                rootTilesRead = true;
+                break;
+            case OBF::OsmAndPoiIndex::kBoxesFieldNumber:
+            {
+                NearestAmenitiesTile tile;
+                tile.length = ObfReaderUtilities::readBigEndianInt(cis);
+                tile.offset = cis->CurrentPosition();
+                tile.parentZoom = MinZoomLevel;
+                tile.parentTileId = TileId::zero();
+                tile.dataOffset = 0;
+                const auto oldTileLimit = cis->PushLimit(tile.length);
+
+                readNearestAmenitiesTileHeader(reader, tile);
+
+                cis->Skip(cis->BytesUntilLimit());
+                cis->PopLimit(oldTileLimit);
+
+                if (tile.zoom <= maxZoom)
+                    enqueue(tile);
+                break;
+            }
+            default:
+                ObfReaderUtilities::skipUnknownField(cis, tag);
+                break;
+        }
+    }
+
+    QSet<ObfObjectId> processedObjects;
+    while (!queue.empty())
+    {
+        if (queryController && queryController->isAborted())
+            break;
+
+        const auto entry = queue.top();
+        queue.pop();
+        if (entry.first > collector.getMaxDistance())
+            break;
+        const auto tile = pendingTiles[entry.second];
+
+        if (tile.dataOffset == 0)
+        {
+            QList<NearestAmenitiesTile> subtiles;
+            QList<uint32_t> dataOffsets;
+
+            cis->Seek(tile.offset);
+            const auto oldTileLimit = cis->PushLimit(tile.length);
+
+            readNearestAmenitiesTile(reader, tile, subtiles, dataOffsets, minZoom, maxZoom, categoriesFilter);
+
+            cis->Skip(cis->BytesUntilLimit());
+            cis->PopLimit(oldTileLimit);
+
+            for (const auto& subtile : constOf(subtiles))
+                enqueue(subtile);
+
+            // Data box of tile is as far as tile itself
+            for (const auto& dataOffset : constOf(dataOffsets))
+            {
+                auto dataBox = tile;
+                dataBox.dataOffset = dataOffset;
+                queue.push(QueueEntry(entry.first, pendingTiles.size()));
+                pendingTiles.push_back(dataBox);
+            }
+            continue;
+        }
+
+        QList< std::shared_ptr<const OsmAnd::Amenity> > amenities;
+
+        cis->Seek(section->offset + tile.dataOffset);
+        const auto length = ObfReaderUtilities::readBigEndianInt(cis);
+        const auto oldDataBoxLimit = cis->PushLimit(length);
+
+        readAmenitiesDataBox(
+            reader,
+            section,
+            processedObjects,
+            &amenities,
+            QString::null,
+            ObfFile::NameNormalization::CaseFolding,
+            0,
+            minZoom,
+            maxZoom,
+            bbox31,
+            categoriesFilter,
+            nullptr,
+            queryController,
+            nullptr);
+
+        ObfReaderUtilities::ensureAllDataWasRead(cis);
+        cis->PopLimit(oldDataBoxLimit);
+
+        for (const auto& amenity : constOf(amenities))
+            collector.offer(amenity, Utilities::distance31(collector.point31, amenity->position31));
+    }
+
+    cis->Skip(cis->BytesUntilLimit());
+    cis->PopLimit(oldLimit);
+}
+
 void OsmAnd::ObfPoiSectionReader_P::scanAmenitiesByName(
     const ObfReader_P& reader,
     const std::shared_ptr<const ObfPoiSectionInfo>& section,
     const QString& query,
+    const unsigned int maxEditDistance,
     QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
     const ZoomLevel minZoom,
     const ZoomLevel maxZoom,
@@ -1189,7 +1770,11 @@ void OsmAnd::ObfPoiSectionReader_P::scanAmenitiesByName(
     auto oldLimit = cis->PushLimit(section->length);
     cis->Skip(section->nameIndexInnerOffset);
 
-    readAmenitiesByName(reader, section, query, outAmenities, minZoom, maxZoom, bbox31, categoriesFilter, visitor, queryController);
+    // Mode is read once and query is normalized once here, names index keys and names of amenities are compared
+    // to it as-is
+    const auto normalization = ObfNameNormalizer::lockNormalization();
+    const auto normalizedQuery = ObfNameNormalizer::normalize(query, normalization);
+    readAmenitiesByName(reader, section, normalizedQuery, normalization, maxEditDistance, outAmenities, minZoom, maxZoom, bbox31, categoriesFilter, visitor, queryController);
 
     ObfReaderUtilities::ensureAllDataWasRead(cis);
     cis->PopLimit(oldLimit);
@@ -10,14 +10,22 @@
 #include "CommonTypes.h"
 #include "DataCommonTypes.h"
 #include "ObfPoiSectionReader.h"
+#include "ObfFile.h"
 #include "ObfPoiSectionInfo.h"
+#include "ObfPoiCategoryIndex.h"
 
 namespace OsmAnd
 {
     class ObfReader_P;
     class ObfPoiSectionInfo;
+    class ObfIndexedStringTable;
+    class ObfNameNGramIndex;
     class Amenity;
     class IQueryController;
+    namespace ObfPoiSectionReader_Metrics
+    {
+        struct Metric_loadAmenities;
+    }
 
     class ObfPoiSectionReader;
     class ObfPoiSectionReader_P Q_DECL_FINAL
@@ -65,8 +73,10 @@ namespace OsmAnd
             const ZoomLevel maxZoom,
             const AreaI* const bbox31,
             const QSet<ObfPoiCategoryId>* const categoriesFilter,
+            const std::shared_ptr<const ObfPoiCategoryIndex>& categoryIndex,
             const ObfPoiSectionReader::VisitorFunction visitor,
-            const std::shared_ptr<const IQueryController>& queryController);
+            const std::shared_ptr<const IQueryController>& queryController,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric);
         static void scanTiles(
             const ObfReader_P& reader,
             QSet<uint32_t>& outDataOffsets,
@@ -75,15 +85,58 @@ namespace OsmAnd
             const ZoomLevel minZoom,
             const ZoomLevel maxZoom,
             const AreaI* const bbox31,
-            const QSet<ObfPoiCategoryId>* const categoriesFilter);
+            const QSet<ObfPoiCategoryId>* const categoriesFilter,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric);
         static bool scanTileForMatchingCategories(
             const ObfReader_P& reader,
             const QSet<ObfPoiCategoryId>& categories);
 
+        static std::shared_ptr<const ObfPoiCategoryIndex> obtainCategoryIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section);
+        static void readCategoryIndexDataBoxes(
+            const ObfReader_P& reader,
+            QVector<ObfPoiCategoryIndex::DataBox>& outDataBoxes);
+        static void readCategoryIndexTile(
+            const ObfReader_P& reader,
+            QVector<ObfPoiCategoryIndex::DataBox>& outDataBoxes,
+            const ZoomLevel parentZoom,
+            const TileId parentTileId,
+            const QVector<ObfPoiCategoryId>* const parentCategories);
+        static void readTileCategories(
+            const ObfReader_P& reader,
+            QVector<ObfPoiCategoryId>& outCategories);
+
+        struct NearestAmenitiesTile
+        {
+            uint32_t offset;
+            uint32_t length;
+            ZoomLevel parentZoom;
+            TileId parentTileId;
+            ZoomLevel zoom;
+            TileId tileId;
+
+            // Set only for data box of tile
+            uint32_t dataOffset;
+        };
+        static void readNearestAmenitiesTileHeader(
+            const ObfReader_P& reader,
+            NearestAmenitiesTile& inOutTile);
+        static void readNearestAmenitiesTile(
+            const ObfReader_P& reader,
+            const NearestAmenitiesTile& tile,
+            QList<NearestAmenitiesTile>& outSubtiles,
+            QList<uint32_t>& outDataOffsets,
+            const ZoomLevel minZoom,
+            const ZoomLevel maxZoom,
+            const QSet<ObfPoiCategoryId>* const categoriesFilter);
+
         static void readAmenitiesByName(
             const ObfReader_P& reader,
             const std::shared_ptr<const ObfPoiSectionInfo>& section,
             const QString& query,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
             const ZoomLevel minZoom,
             const ZoomLevel maxZoom,
@@ -91,9 +144,18 @@ namespace OsmAnd
             const QSet<ObfPoiCategoryId>* const categoriesFilter,
             const ObfPoiSectionReader::VisitorFunction visitor,
             const std::shared_ptr<const IQueryController>& queryController);
+        static std::shared_ptr<const ObfIndexedStringTable> obtainNameIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section);
+        static std::shared_ptr<const ObfNameNGramIndex> obtainNameNGramIndex(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section);
         static void scanNameIndex(
             const ObfReader_P& reader,
-            const QString& query,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section,
+            const QString& normalizedQuery,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             QSet<uint32_t>& outDataOffsets,
             const ZoomLevel minZoom,
             const ZoomLevel maxZoom,
@@ -117,17 +179,22 @@ namespace OsmAnd
             QSet<ObfObjectId>& processedObjects,
             QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
             const QString& query,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             const ZoomLevel minZoom,
             const ZoomLevel maxZoom,
             const AreaI* const bbox31,
             const QSet<ObfPoiCategoryId>* const categoriesFilter,
             const ObfPoiSectionReader::VisitorFunction visitor,
-            const std::shared_ptr<const IQueryController>& queryController);
+            const std::shared_ptr<const IQueryController>& queryController,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric);
         static void readAmenity(
             const ObfReader_P& reader,
             const std::shared_ptr<const ObfPoiSectionInfo>& section,
             std::shared_ptr<const Amenity>& outAmenity,
             const QString& query,
+            const ObfFile::NameNormalization normalization,
+            const unsigned int maxEditDistance,
             const ZoomLevel zoom,
             const TileId boxTileId,
             const AreaI* const bbox31,
@@ -155,12 +222,24 @@ namespace OsmAnd
             const AreaI* const bbox31,
             const QSet<ObfPoiCategoryId>* const categoriesFilter,
             const ObfPoiSectionReader::VisitorFunction visitor,
+            const std::shared_ptr<const IQueryController>& queryController,
+            ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric);
+
+        static void loadNearestAmenities(
+            const ObfReader_P& reader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& section,
+            ObfPoiSectionReader::NearestAmenitiesCollector& collector,
+            const ZoomLevel minZoom,
+            const ZoomLevel maxZoom,
+            const AreaI* const bbox31,
+            const QSet<ObfPoiCategoryId>* const categoriesFilter,
             const std::shared_ptr<const IQueryController>& queryController);
 
         static void scanAmenitiesByName(
             const ObfReader_P& reader,
             const std::shared_ptr<const ObfPoiSectionInfo>& section,
             const QString& query,
+            const unsigned int maxEditDistance,
             QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
             const ZoomLevel minZoom,
             const ZoomLevel maxZoom,
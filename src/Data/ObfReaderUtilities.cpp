@@ -85,7 +85,7 @@ void OsmAnd::ObfReaderUtilities::readStringTable(gpb::io::CodedInputStream* cis,
 
 int OsmAnd::ObfReaderUtilities::scanIndexedStringTable(
     gpb::io::CodedInputStream* cis,
-    const QString& query,
+    const QString& normalizedQuery,
     QVector<uint32_t>& outValues,
     const QString& keysPrefix /*= QString::null*/,
     const int matchedCharactersCount_ /*= 0*/)
@@ -108,27 +108,28 @@ int OsmAnd::ObfReaderUtilities::scanIndexedStringTable(
                 readQString(cis, key);
                 if (!keysPrefix.isEmpty())
                     key.prepend(keysPrefix);
+                const auto foldedKey = key.toCaseFolded();
 
-                if (key.startsWith(query, Qt::CaseInsensitive)) // (CollatorStringMatcher.cmatches(instance, key, query, StringMatcherMode.CHECK_ONLY_STARTS_WITH))
+                if (foldedKey.startsWith(normalizedQuery)) // (CollatorStringMatcher.cmatches(instance, key, query, StringMatcherMode.CHECK_ONLY_STARTS_WITH))
                 {
-                    if (query.size() > matchedCharactersCount)
+                    if (normalizedQuery.size() > matchedCharactersCount)
                     {
-                        matchedCharactersCount = query.length();
+                        matchedCharactersCount = normalizedQuery.length();
                         outValues.clear();
                     }
-                    else if (query.size() < matchedCharactersCount)
+                    else if (normalizedQuery.size() < matchedCharactersCount)
                     {
                         key = QString::null;
                     }
                 }
-                else if (query.startsWith(key, Qt::CaseInsensitive)) // (CollatorStringMatcher.cmatches(instance, query, key, StringMatcherMode.CHECK_ONLY_STARTS_WITH))
+                else if (normalizedQuery.startsWith(foldedKey)) // (CollatorStringMatcher.cmatches(instance, query, key, StringMatcherMode.CHECK_ONLY_STARTS_WITH))
                 {
-                    if (key.size() > matchedCharactersCount)
+                    if (foldedKey.size() > matchedCharactersCount)
                     {
-                        matchedCharactersCount = key.length();
+                        matchedCharactersCount = foldedKey.size();
                         outValues.clear();
                     }
-                    else if (key.size() < matchedCharactersCount)
+                    else if (foldedKey.size() < matchedCharactersCount)
                     {
                         key = QString::null;
                     }
@@ -153,7 +154,7 @@ int OsmAnd::ObfReaderUtilities::scanIndexedStringTable(
                 const auto oldLimit = cis->PushLimit(length);
 
                 if (!key.isNull())
-                    matchedCharactersCount = scanIndexedStringTable(cis, query, outValues, key, matchedCharactersCount);
+                    matchedCharactersCount = scanIndexedStringTable(cis, normalizedQuery, outValues, key, matchedCharactersCount);
                 else
                     cis->Skip(cis->BytesUntilLimit());
 
@@ -30,9 +30,10 @@ namespace OsmAnd
         static uint32_t readBigEndianInt(gpb::io::CodedInputStream* cis);
         static uint32_t readLength(gpb::io::CodedInputStream* cis);
         static void readStringTable(gpb::io::CodedInputStream* cis, QStringList& stringTableOut);
+        // Query is expected to be case-folded
         static int scanIndexedStringTable(
             gpb::io::CodedInputStream* cis,
-            const QString& query,
+            const QString& normalizedQuery,
             QVector<uint32_t>& outValues,
             const QString& keysPrefix = QString::null,
             const int matchedCharactersCount = 0);
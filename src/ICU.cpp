@@ -7,6 +7,8 @@
 #include "ignore_warnings_on_external_includes.h"
 #include <QByteArray>
 #include <QVector>
+#include <QCache>
+#include <QMutex>
 #include "restore_internal_warnings.h"
 
 #include "ignore_warnings_on_external_includes.h"
@@ -26,6 +28,33 @@ const Transliterator* g_pIcuAnyToLatinTransliterator = nullptr;
 const Transliterator* g_pIcuAccentsAndDiacriticsConverter = nullptr;
 const BreakIterator* g_pIcuLineBreakIterator = nullptr;
 
+// Results of convertToVisualOrderAndWrap() are shared by entire process, since same captions
+// are rasterized over and over again by all providers and on all zoom levels
+struct TextLayoutKey
+{
+    QString input;
+    int maxCharsPerLine;
+
+    inline bool operator==(const TextLayoutKey& that) const
+    {
+        return maxCharsPerLine == that.maxCharsPerLine && input == that.input;
+    }
+};
+inline uint qHash(const TextLayoutKey& key, uint seed = 0) Q_DECL_NOTHROW
+{
+    return qHash(key.input, seed) ^ qHash(key.maxCharsPerLine);
+}
+struct TextLayout
+{
+    QString visualText;
+    QVector<int> lineStartIndices;
+};
+enum {
+    MaxTextLayoutsCacheSizeInBytes = 4 * 1024 * 1024,
+};
+QMutex g_textLayoutsCacheMutex;
+std::unique_ptr< QCache<TextLayoutKey, TextLayout> > g_pTextLayoutsCache;
+
 bool OsmAnd::ICU::initialize()
 {
     // Initialize ICU
@@ -70,6 +99,11 @@ bool OsmAnd::ICU::initialize()
         return false;
     }
 
+    {
+        QMutexLocker scopedLocker(&g_textLayoutsCacheMutex);
+        g_pTextLayoutsCache.reset(new QCache<TextLayoutKey, TextLayout>(MaxTextLayoutsCacheSizeInBytes));
+    }
+
     return true;
 }
 
@@ -77,6 +111,11 @@ void OsmAnd::ICU::release()
 {
     // Release resources:
 
+    {
+        QMutexLocker scopedLocker(&g_textLayoutsCacheMutex);
+        g_pTextLayoutsCache.reset();
+    }
+
     delete g_pIcuAccentsAndDiacriticsConverter;
     g_pIcuAccentsAndDiacriticsConverter = nullptr;
     
@@ -303,6 +342,55 @@ OSMAND_CORE_API QStringList OSMAND_CORE_CALL OsmAnd::ICU::wrapText(const QString
     return result;
 }
 
+OSMAND_CORE_API QString OSMAND_CORE_CALL OsmAnd::ICU::convertToVisualOrderAndWrap(
+    const QString& input,
+    const int maxCharsPerLine,
+    QVector<int>& outLineStartIndices)
+{
+    TextLayoutKey key;
+    key.input = input;
+    key.maxCharsPerLine = qMax(maxCharsPerLine, 0);
+
+    {
+        QMutexLocker scopedLocker(&g_textLayoutsCacheMutex);
+
+        if (g_pTextLayoutsCache)
+        {
+            if (const auto textLayout = g_pTextLayoutsCache->object(key))
+            {
+                outLineStartIndices = textLayout->lineStartIndices;
+                return textLayout->visualText;
+            }
+        }
+    }
+
+    const auto textLayout = new TextLayout();
+    textLayout->visualText = convertToVisualOrder(input);
+    if (key.maxCharsPerLine > 0)
+        textLayout->lineStartIndices = getTextWrapping(textLayout->visualText, key.maxCharsPerLine);
+    else
+        textLayout->lineStartIndices.push_back(0);
+
+    outLineStartIndices = textLayout->lineStartIndices;
+    const auto visualText = textLayout->visualText;
+
+    {
+        QMutexLocker scopedLocker(&g_textLayoutsCacheMutex);
+
+        if (g_pTextLayoutsCache)
+        {
+            const auto cost =
+                (input.size() + visualText.size()) * sizeof(QChar) +
+                outLineStartIndices.size() * sizeof(int);
+            g_pTextLayoutsCache->insert(key, textLayout, static_cast<int>(cost));
+        }
+        else
+            delete textLayout;
+    }
+
+    return visualText;
+}
+
 OSMAND_CORE_API QString OSMAND_CORE_CALL OsmAnd::ICU::stripAccentsAndDiacritics(const QString& input)
 {
     QString output;
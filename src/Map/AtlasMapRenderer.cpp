@@ -84,7 +84,11 @@ bool OsmAnd::AtlasMapRenderer::postPrepareFrame()
         return false;
 
     // Notify resources manager about new active zone
-    getResources().updateActiveZone(_uniqueTiles, currentState.zoomLevel);
+    const auto internalState = static_cast<const AtlasMapRendererInternalState*>(getInternalStateRef());
+    getResources().updateActiveZone(
+        _uniqueTiles,
+        Utilities::normalizeTileId(internalState->targetTileId, currentState.zoomLevel),
+        currentState.zoomLevel);
 
     return true;
 }
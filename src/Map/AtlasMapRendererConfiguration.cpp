@@ -4,6 +4,9 @@
 
 OsmAnd::AtlasMapRendererConfiguration::AtlasMapRendererConfiguration()
     : referenceTileSizeOnScreenInPixels(IAtlasMapRenderer::DefaultReferenceTileSizeOnScreenInPixels)
+    , incrementalSymbolsPlacement(false)
+    , incrementalSymbolsPlacementMaxShiftInPixels(32.0f)
+    , symbolsIntersectionsIndex(SymbolsIntersectionsIndex::QuadTree)
 {
 }
 
@@ -16,6 +19,9 @@ void OsmAnd::AtlasMapRendererConfiguration::copyTo(MapRendererConfiguration& oth
     if (const auto other = dynamic_cast<AtlasMapRendererConfiguration*>(&other_))
     {
         other->referenceTileSizeOnScreenInPixels = referenceTileSizeOnScreenInPixels;
+        other->incrementalSymbolsPlacement = incrementalSymbolsPlacement;
+        other->incrementalSymbolsPlacementMaxShiftInPixels = incrementalSymbolsPlacementMaxShiftInPixels;
+        other->symbolsIntersectionsIndex = symbolsIntersectionsIndex;
     }
 
     MapRendererConfiguration::copyTo(other_);
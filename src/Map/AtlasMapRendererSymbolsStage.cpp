@@ -4,6 +4,7 @@
 #include "ignore_warnings_on_external_includes.h"
 #include <QLinkedList>
 #include <QSet>
+#include <QtMath>
 #include "restore_internal_warnings.h"
 
 #include "ignore_warnings_on_external_includes.h"
@@ -31,6 +32,7 @@
 #include "MapSymbolsGroup.h"
 #include "QKeyValueIterator.h"
 #include "MapSymbolIntersectionClassesRegistry.h"
+#include "MapSymbolsPlacement.h"
 #include "Stopwatch.h"
 #include "GlmExtensions.h"
 
@@ -43,11 +45,25 @@ OsmAnd::AtlasMapRendererSymbolsStage::~AtlasMapRendererSymbolsStage()
 {
 }
 
+OsmAnd::AtlasMapRendererSymbolsStage::ScreenIndex::ScreenIndex(
+    const Type type_ /*= Type::QuadTree*/,
+    const AreaI& rootArea /*= AreaI::largest()*/,
+    const uintmax_t maxDepth_ /*= std::numeric_limits<uintmax_t>::max()*/)
+    : type(type_)
+    , maxDepth(maxDepth_)
+{
+    // Grid cells match size of deepest quad tree nodes
+    if (type == Type::Grid)
+        _gridIndex = ScreenGridIndex(rootArea, MapSymbolsPlacement::getIndexCellSize(rootArea, maxDepth));
+    else
+        _quadTree = ScreenQuadTree(rootArea, maxDepth);
+}
+
 void OsmAnd::AtlasMapRendererSymbolsStage::prepare(AtlasMapRenderer_Metrics::Metric_renderFrame* const metric)
 {
     Stopwatch stopwatch(metric != nullptr);
 
-    ScreenQuadTree intersections;
+    ScreenIndex intersections;
     if (!obtainRenderableSymbols(renderableSymbols, intersections, metric))
     {
         // In case obtain failed due to lock, schedule another frame
@@ -61,10 +77,10 @@ void OsmAnd::AtlasMapRendererSymbolsStage::prepare(AtlasMapRenderer_Metrics::Met
 
     Stopwatch preparedSymbolsPublishingStopwatch(metric != nullptr);
     
-    ScreenQuadTree visibleSymbols(intersections.getRootArea(), intersections.maxDepth);
+    ScreenIndex visibleSymbols(intersections.type, intersections.getRootArea(), intersections.maxDepth);
     visibleSymbols.insertFrom(renderableSymbols,
         []
-        (const std::shared_ptr<const RenderableSymbol>& item, ScreenQuadTree::BBox& outBbox) -> bool
+        (const std::shared_ptr<const RenderableSymbol>& item, ScreenIndex::BBox& outBbox) -> bool
         {
             outBbox = item->visibleBBox;
             return true;
@@ -165,7 +181,7 @@ void OsmAnd::AtlasMapRendererSymbolsStage::queryLastVisibleSymbolsIn(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
     QList< std::shared_ptr<const RenderableSymbol> >& outRenderableSymbols,
-    ScreenQuadTree& outIntersections,
+    ScreenIndex& outIntersections,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     Stopwatch stopwatch(metric != nullptr);
@@ -176,6 +192,23 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
         if (!publishedMapSymbolsByOrderLock.tryLockForRead())
             return false;
 
+        // If map was barely moved since last full placement, re-plot only symbols accepted by it
+        const auto symbolsPlacementState = captureSymbolsPlacementState();
+        if (canReuseLastSymbolsPlacement(symbolsPlacementState))
+        {
+            publishedMapSymbolsByOrderLock.unlock();
+
+            if (metric)
+                metric->incrementalSymbolsPlacements++;
+
+            return obtainRenderableSymbols(
+                _lastAcceptedMapSymbolsByOrder,
+                outRenderableSymbols,
+                outIntersections,
+                nullptr,
+                metric);
+        }
+
         _lastAcceptedMapSymbolsByOrder.clear();
         const auto result = obtainRenderableSymbols(
             publishedMapSymbolsByOrder,
@@ -183,9 +216,13 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
             outIntersections,
             &_lastAcceptedMapSymbolsByOrder,
             metric);
+        _lastSymbolsPlacementState = symbolsPlacementState;
 
         publishedMapSymbolsByOrderLock.unlock();
 
+        if (metric)
+            metric->fullSymbolsPlacements++;
+
         if (metric)
         {
             metric->elapsedTimeForObtainingRenderableSymbolsWithLock = stopwatch.elapsed();
@@ -206,121 +243,80 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
     return result;
 }
 
-bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
-    const MapRenderer::PublishedMapSymbolsByOrder& mapSymbolsByOrder,
-    QList< std::shared_ptr<const RenderableSymbol> >& outRenderableSymbols,
-    ScreenQuadTree& outIntersections,
-    MapRenderer::PublishedMapSymbolsByOrder* pOutAcceptedMapSymbolsByOrder,
-    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementState::SymbolsPlacementState()
+    : isValid(false)
+    , publishedMapSymbolsVersion(0)
+    , azimuth(0.0f)
+    , elevationAngle(0.0f)
+    , zoomLevel(InvalidZoomLevel)
+    , visualZoom(0.0f)
+    , referenceTileSizeOnScreenInPixels(0.0f)
 {
-    Stopwatch stopwatch(metric != nullptr);
-
-    typedef QLinkedList< std::shared_ptr<const RenderableSymbol> > PlottedSymbols;
-    PlottedSymbols plottedSymbols;
-    
-    struct PlottedSymbolRef
-    {
-        PlottedSymbols::iterator iterator;
-        std::shared_ptr<const RenderableSymbol> renderable;
-    };
-    struct PlottedSymbolsRefGroupInstance
-    {
-        QList< PlottedSymbolRef > symbolsRefs;
-
-        void discard(
-            const AtlasMapRendererSymbolsStage* const stage,
-            PlottedSymbols& plottedSymbols,
-            ScreenQuadTree& intersections)
-        {
-            // Discard entire group
-            for (auto& symbolRef : symbolsRefs)
-            {
-                if (Q_UNLIKELY(stage->debugSettings->showSymbolsBBoxesRejectedByPresentationMode))
-                    stage->addIntersectionDebugBox(symbolRef.renderable, ColorARGB::fromSkColor(SK_ColorYELLOW).withAlpha(50));
-
-#if !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                const auto removed = intersections.removeOne(symbolRef.renderable, symbolRef.renderable->intersectionBBox);
-                assert(removed);
-#endif // !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                plottedSymbols.erase(symbolRef.iterator);
-            }
-            symbolsRefs.clear();
-        }
-
-        void discardSpecific(
-            const AtlasMapRendererSymbolsStage* const stage,
-            PlottedSymbols& plottedSymbols,
-            ScreenQuadTree& intersections,
-            const std::function<bool(const std::shared_ptr<const RenderableSymbol>&)> acceptor)
-        {
-            auto itSymbolRef = mutableIteratorOf(symbolsRefs);
-            while (itSymbolRef.hasNext())
-            {
-                const auto& symbolRef = itSymbolRef.next();
-
-                if (!acceptor(symbolRef.renderable))
-                    continue;
-
-                if (Q_UNLIKELY(stage->debugSettings->showSymbolsBBoxesRejectedByPresentationMode))
-                    stage->addIntersectionDebugBox(symbolRef.renderable, ColorARGB::fromSkColor(SK_ColorYELLOW).withAlpha(50));
+}
 
-#if !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                const auto removed = intersections.removeOne(symbolRef.renderable, symbolRef.renderable->intersectionBBox);
-                assert(removed);
-#endif // !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                plottedSymbols.erase(symbolRef.iterator);
-                itSymbolRef.remove();
-            }
-        }
+OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementState OsmAnd::AtlasMapRendererSymbolsStage::captureSymbolsPlacementState() const
+{
+    SymbolsPlacementState state;
+    state.isValid = true;
+    state.publishedMapSymbolsVersion = publishedMapSymbolsVersion;
+    state.viewport = currentState.viewport;
+    state.azimuth = currentState.azimuth;
+    state.elevationAngle = currentState.elevationAngle;
+    state.target31 = currentState.target31;
+    state.zoomLevel = currentState.zoomLevel;
+    state.visualZoom = currentState.visualZoom;
+    state.referenceTileSizeOnScreenInPixels = getInternalState().referenceTileSizeOnScreenInPixels;
+    return state;
+}
 
-        void discardAllOf(
-            const AtlasMapRendererSymbolsStage* const stage,
-            PlottedSymbols& plottedSymbols,
-            ScreenQuadTree& intersections,
-            const MapSymbol::ContentClass contentClass)
-        {
-            auto itSymbolRef = mutableIteratorOf(symbolsRefs);
-            while (itSymbolRef.hasNext())
-            {
-                const auto& symbolRef = itSymbolRef.next();
+bool OsmAnd::AtlasMapRendererSymbolsStage::canReuseLastSymbolsPlacement(const SymbolsPlacementState& state) const
+{
+    const auto& lastState = _lastSymbolsPlacementState;
+    if (!getCurrentConfiguration().incrementalSymbolsPlacement || !lastState.isValid)
+        return false;
 
-                if (symbolRef.renderable->mapSymbol->contentClass != contentClass)
-                    continue;
+    // Any change except panning invalidates placement
+    if (lastState.publishedMapSymbolsVersion != state.publishedMapSymbolsVersion ||
+        lastState.viewport != state.viewport ||
+        lastState.zoomLevel != state.zoomLevel ||
+        !qFuzzyCompare(lastState.visualZoom, state.visualZoom) ||
+        !qFuzzyCompare(lastState.azimuth, state.azimuth) ||
+        !qFuzzyCompare(lastState.elevationAngle, state.elevationAngle) ||
+        !qFuzzyCompare(lastState.referenceTileSizeOnScreenInPixels, state.referenceTileSizeOnScreenInPixels))
+    {
+        return false;
+    }
 
-                if (Q_UNLIKELY(stage->debugSettings->showSymbolsBBoxesRejectedByPresentationMode))
-                    stage->addIntersectionDebugBox(symbolRef.renderable, ColorARGB::fromSkColor(SK_ColorYELLOW).withAlpha(50));
+    // Panning invalidates placement only if map was moved too far on screen
+    const auto tileSize31 = static_cast<double>(1u << (ZoomLevel::MaxZoomLevel - state.zoomLevel));
+    const auto pixelsPer31 = state.referenceTileSizeOnScreenInPixels * state.visualZoom / tileSize31;
+    const auto shiftX = static_cast<double>(state.target31.x) - static_cast<double>(lastState.target31.x);
+    const auto shiftY = static_cast<double>(state.target31.y) - static_cast<double>(lastState.target31.y);
+    const auto shiftInPixels = qSqrt(shiftX * shiftX + shiftY * shiftY) * pixelsPer31;
 
-#if !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                const auto removed = intersections.removeOne(symbolRef.renderable, symbolRef.renderable->intersectionBBox);
-                assert(removed);
-#endif // !OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE
-                plottedSymbols.erase(symbolRef.iterator);
-                itSymbolRef.remove();
-            }
-        }
-    };
-    struct PlottedSymbolsRefGroupInstances
-    {
-        QHash< std::shared_ptr<const MapSymbolsGroup::AdditionalInstance>, PlottedSymbolsRefGroupInstance > instancesRefs;
+    return shiftInPixels <= getCurrentConfiguration().incrementalSymbolsPlacementMaxShiftInPixels;
+}
 
-        void discard(const AtlasMapRendererSymbolsStage* const stage, PlottedSymbols& plottedSymbols, ScreenQuadTree& intersections)
-        {
-            // Discard all instances
-            for (auto& instanceRef : instancesRefs)
-                instanceRef.discard(stage, plottedSymbols, intersections);
-            instancesRefs.clear();
-        }
-    };
-    QHash< std::shared_ptr<const MapSymbolsGroup>, PlottedSymbolsRefGroupInstances> plottedSymbolsMapByGroupAndInstance;
+bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
+    const MapRenderer::PublishedMapSymbolsByOrder& mapSymbolsByOrder,
+    QList< std::shared_ptr<const RenderableSymbol> >& outRenderableSymbols,
+    ScreenIndex& outIntersections,
+    MapRenderer::PublishedMapSymbolsByOrder* pOutAcceptedMapSymbolsByOrder,
+    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+{
+    Stopwatch stopwatch(metric != nullptr);
 
     // Iterate over map symbols layer sorted by "order" in ascending direction.
     // This means that map symbols with smaller order value are more important than map symbols with
     // larger order value.
     // Tree depth should satisfy following condition:
     // (max(width, height) / 2^depth) >= 64
-    const auto viewportMaxDimension = qMax(currentState.viewport.height(), currentState.viewport.width());
-    const auto treeDepth = 32u - SkCLZ(viewportMaxDimension >> 6);
-    outIntersections = qMove(ScreenQuadTree(currentState.viewport, qMax(treeDepth, 1u)));
+    outIntersections = qMove(ScreenIndex(
+        getCurrentConfiguration().symbolsIntersectionsIndex,
+        currentState.viewport,
+        MapSymbolsPlacement::getIndexDepth(currentState.viewport)));
+    const SymbolsPlacementDelegate placementDelegate(this, metric);
+    SymbolsPlacer placer(outIntersections, placementDelegate, OSMAND_KEEP_DISCARDED_SYMBOLS_IN_QUAD_TREE != 0);
     ComputedPathsDataCache computedPathsDataCache;
     for (const auto& mapSymbolsByOrderEntry : rangeOf(constOf(mapSymbolsByOrder)))
     {
@@ -392,7 +388,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
                     bool atLeastOnePlotted = false;
                     for (const auto& renderableSymbol : constOf(renderableSymbols))
                     {
-                        if (!plotSymbol(renderableSymbol, outIntersections, metric))
+                        if (!plotSymbol(renderableSymbol, placer, metric))
                             continue;
 
                         if (!atLeastOnePlotted)
@@ -408,13 +404,6 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
                             }
                             atLeastOnePlotted = true;
                         }
-
-                        const auto itPlottedSymbol = plottedSymbols.insert(plottedSymbols.end(), renderableSymbol);
-                        PlottedSymbolRef plottedSymbolRef = { itPlottedSymbol, renderableSymbol };
-
-                        plottedSymbolsMapByGroupAndInstance[mapSymbolsGroup]
-                            .instancesRefs[nullptr]
-                            .symbolsRefs.push_back(qMove(plottedSymbolRef));
                     }
                 }
             }
@@ -453,7 +442,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
                     bool atLeastOnePlotted = false;
                     for (const auto& renderableSymbol : constOf(renderableSymbols))
                     {
-                        if (!plotSymbol(renderableSymbol, outIntersections, metric))
+                        if (!plotSymbol(renderableSymbol, placer, metric))
                             continue;
 
                         if (!atLeastOnePlotted)
@@ -469,13 +458,6 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
                             }
                             atLeastOnePlotted = true;
                         }
-
-                        const auto itPlottedSymbol = plottedSymbols.insert(plottedSymbols.end(), renderableSymbol);
-                        PlottedSymbolRef plottedSymbolRef = { itPlottedSymbol, renderableSymbol };
-
-                        plottedSymbolsMapByGroupAndInstance[mapSymbolsGroup]
-                            .instancesRefs[additionalGroupInstance]
-                            .symbolsRefs.push_back(qMove(plottedSymbolRef));
                     }
                 }
             }
@@ -487,173 +469,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
         Stopwatch symbolsPresentationModeCheckStopwatch(metric != nullptr);
 
         // Remove those plotted symbols that do not conform to presentation rules
-        auto itPlottedSymbolsGroupInstancesEntry = mutableIteratorOf(plottedSymbolsMapByGroupAndInstance);
-        while (itPlottedSymbolsGroupInstancesEntry.hasNext())
-        {
-            const auto& plottedSymbolsGroupInstancesEntry = itPlottedSymbolsGroupInstancesEntry.next();
-            const auto& mapSymbolsGroup = plottedSymbolsGroupInstancesEntry.key();
-            auto& plottedSymbolsGroupInstances = plottedSymbolsGroupInstancesEntry.value();
-
-            if (!mapSymbolsGroup)
-            {
-                plottedSymbolsGroupInstances.discard(this, plottedSymbols, outIntersections);
-                itPlottedSymbolsGroupInstancesEntry.remove();
-                continue;
-            }
-
-            // Each instance of group is treated as separated group
-            {
-                auto itPlottedSymbolsGroupInstanceEntry = mutableIteratorOf(plottedSymbolsGroupInstances.instancesRefs);
-                while (itPlottedSymbolsGroupInstanceEntry.hasNext())
-                {
-                    const auto& plottedSymbolsGroupInstanceEntry = itPlottedSymbolsGroupInstanceEntry.next();
-                    const auto& mapSymbolsGroupInstance = plottedSymbolsGroupInstanceEntry.key();
-                    auto& plottedSymbolsGroupInstance = plottedSymbolsGroupInstanceEntry.value();
-
-                    // Just skip all rules
-                    if (mapSymbolsGroup->presentationMode & MapSymbolsGroup::PresentationModeFlag::ShowAnything)
-                        continue;
-
-                    // Rule: show all symbols or no symbols
-                    if (mapSymbolsGroup->presentationMode & MapSymbolsGroup::PresentationModeFlag::ShowAllOrNothing)
-                    {
-                        const auto symbolsCount = mapSymbolsGroupInstance
-                            ? mapSymbolsGroupInstance->symbols.size()
-                            : mapSymbolsGroup->symbols.size();
-
-                        if (symbolsCount != plottedSymbolsGroupInstance.symbolsRefs.size())
-                        {
-                            // Discard entire group instance
-                            plottedSymbolsGroupInstance.discard(
-                                this,
-                                plottedSymbols,
-                                outIntersections);
-                            itPlottedSymbolsGroupInstanceEntry.remove();
-                            continue;
-                        }
-                    }
-
-                    // Rule: if there's icon, icon must always be visible. Otherwise discard entire group
-                    if (mapSymbolsGroup->presentationMode & MapSymbolsGroup::PresentationModeFlag::ShowNoneIfIconIsNotShown)
-                    {
-                        const auto symbolWithIconContentClass = mapSymbolsGroupInstance
-                            ? mapSymbolsGroupInstance->getFirstSymbolWithContentClass(MapSymbol::ContentClass::Icon)
-                            : mapSymbolsGroup->getFirstSymbolWithContentClass(MapSymbol::ContentClass::Icon);
-
-                        if (symbolWithIconContentClass)
-                        {
-                            bool iconPlotted = false;
-                            for (const auto& plottedGroupSymbol : constOf(plottedSymbolsGroupInstance.symbolsRefs))
-                            {
-                                if (plottedGroupSymbol.renderable->mapSymbol != symbolWithIconContentClass)
-                                    continue;
-                                
-                                iconPlotted = true;
-                                break;
-                            }
-
-                            if (!iconPlotted)
-                            {
-                                // Discard entire group instance
-                                plottedSymbolsGroupInstance.discard(
-                                    this,
-                                    plottedSymbols,
-                                    outIntersections);
-                                itPlottedSymbolsGroupInstanceEntry.remove();
-                                continue;
-                            }
-                        }
-                    }
-
-                    // Rule: if at least one caption was not shown, discard all other captions
-                    if (mapSymbolsGroup->presentationMode & MapSymbolsGroup::PresentationModeFlag::ShowAllCaptionsOrNoCaptions)
-                    {
-                        const auto captionsCount = mapSymbolsGroupInstance
-                            ? mapSymbolsGroupInstance->numberOfSymbolsWithContentClass(MapSymbol::ContentClass::Caption)
-                            : mapSymbolsGroup->numberOfSymbolsWithContentClass(MapSymbol::ContentClass::Caption);
-
-                        if (captionsCount > 0)
-                        {
-                            unsigned int captionsPlotted = 0;
-                            for (const auto& plottedGroupSymbol : constOf(plottedSymbolsGroupInstance.symbolsRefs))
-                            {
-                                if (plottedGroupSymbol.renderable->mapSymbol->contentClass == MapSymbol::ContentClass::Caption)
-                                    captionsPlotted++;
-                            }
-
-                            if (captionsCount != captionsPlotted)
-                            {
-                                // Discard all captions since at least one was not shown
-                                plottedSymbolsGroupInstance.discardAllOf(
-                                    this,
-                                    plottedSymbols,
-                                    outIntersections,
-                                    MapSymbol::ContentClass::Caption);
-                                if (plottedSymbolsGroupInstance.symbolsRefs.isEmpty())
-                                {
-                                    itPlottedSymbolsGroupInstanceEntry.remove();
-                                    continue;
-                                }
-                            }
-                        }
-                    }
-
-                    // Rule: show anything until first map symbol from group was not plotted
-                    if (mapSymbolsGroup->presentationMode & MapSymbolsGroup::PresentationModeFlag::ShowAnythingUntilFirstGap)
-                    {
-                        const auto& mapSymbols = mapSymbolsGroupInstance
-                            ? mapSymbolsGroupInstance->symbols.keys()
-                            : mapSymbolsGroup->symbols;
-
-                        auto itMapSymbol = iteratorOf(mapSymbols);
-                        while (itMapSymbol.hasNext())
-                        {
-                            const auto& mapSymbol = itMapSymbol.next();
-
-                            // Check if this symbol is plotted
-                            bool symbolPlotted = false;
-                            for (const auto& plottedGroupSymbol : constOf(plottedSymbolsGroupInstance.symbolsRefs))
-                            {
-                                if (plottedGroupSymbol.renderable->mapSymbol == mapSymbol)
-                                {
-                                    symbolPlotted = true;
-                                    break;
-                                }
-                            }
-                            if (symbolPlotted)
-                                continue;
-
-                            // In case this symbol was not plotted, discard all remaining symbol including this
-                            itMapSymbol.previous();
-                            break;
-                        }
-                        while (itMapSymbol.hasNext())
-                        {
-                            const auto& mapSymbol = itMapSymbol.next();
-
-                            plottedSymbolsGroupInstance.discardSpecific(
-                                this,
-                                plottedSymbols,
-                                outIntersections,
-                                [mapSymbol]
-                                (const std::shared_ptr<const RenderableSymbol>& renderableSymbol) -> bool
-                                {
-                                    return (renderableSymbol->mapSymbol == mapSymbol);
-                                });
-                        }
-                        if (plottedSymbolsGroupInstance.symbolsRefs.isEmpty())
-                        {
-                            itPlottedSymbolsGroupInstanceEntry.remove();
-                            continue;
-                        }
-                    }
-                }
-            }
-
-            // In case all instances of group was removed, erase the group
-            if (plottedSymbolsGroupInstances.instancesRefs.isEmpty())
-                itPlottedSymbolsGroupInstancesEntry.remove();
-        }
+        placer.applyPresentationModes();
 
         if (metric)
             metric->elapsedTimeForSymbolsPresentationModeCheck = symbolsPresentationModeCheckStopwatch.elapsed();
@@ -661,6 +477,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderableSymbols(
 
     // Publish the result
     outRenderableSymbols.clear();
+    const auto& plottedSymbols = placer.getPlottedEntries();
     outRenderableSymbols.reserve(plottedSymbols.size());
     for (const auto& plottedSymbol : constOf(plottedSymbols))
     {
@@ -744,7 +561,7 @@ void OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderablesFromSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotSymbol(
     const std::shared_ptr<RenderableSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     Stopwatch stopwatch(metric != nullptr);
@@ -754,21 +571,21 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotSymbol(
     {
         plotted = plotBillboardSymbol(
             renderableBillboard,
-            intersections,
+            placer,
             metric);
     }
     else if (const auto& renderableOnPath = std::dynamic_pointer_cast<RenderableOnPathSymbol>(renderable))
     {
         plotted = plotOnPathSymbol(
             renderableOnPath,
-            intersections,
+            placer,
             metric);
     }
     else if (const auto& renderableOnSurface = std::dynamic_pointer_cast<RenderableOnSurfaceSymbol>(renderable))
     {
         plotted = plotOnSurfaceSymbol(
             renderableOnSurface,
-            intersections,
+            placer,
             metric);
     }
 
@@ -848,7 +665,7 @@ void OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderablesFromBillboardSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardSymbol(
     const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     bool plotted = false;
@@ -856,14 +673,15 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardSymbol(
     {
         plotted = plotBillboardRasterSymbol(
             renderable,
-            intersections,
+            placer,
             metric);
     }
     else if (std::dynamic_pointer_cast<const VectorMapSymbol>(renderable->mapSymbol))
     {
         plotted = plotBillboardVectorSymbol(
             renderable,
-            intersections,metric);
+            placer,
+            metric);
     }
 
     return plotted;
@@ -871,7 +689,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardRasterSymbol(
     const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     const auto& internalState = getInternalState();
@@ -903,21 +721,12 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardRasterSymbol(
     boundsInWindow.bottom() += symbol->margin.bottom();
     renderable->intersectionBBox = boundsInWindow;
 
-    if (!applyVisibilityFiltering(renderable->visibleBBox, intersections, metric))
-        return false;
-
-    if (!applyIntersectionWithOtherSymbolsFiltering(renderable, intersections, metric))
-        return false;
-
-    if (!applyMinDistanceToSameContentFromOtherSymbolFiltering(renderable, intersections, metric))
-        return false;
-
-    return addToIntersections(renderable, intersections, metric);
+    return placer.plot(renderable);
 }
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotBillboardVectorSymbol(
     const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     assert(false);
@@ -985,21 +794,21 @@ void OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderablesFromOnSurfaceSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnSurfaceSymbol(
     const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     if (std::dynamic_pointer_cast<const RasterMapSymbol>(renderable->mapSymbol))
     {
         return plotOnSurfaceRasterSymbol(
             renderable,
-            intersections,
+            placer,
             metric);
     }
     else if (std::dynamic_pointer_cast<const VectorMapSymbol>(renderable->mapSymbol))
     {
         return plotOnSurfaceVectorSymbol(
             renderable,
-            intersections,
+            placer,
             metric);
     }
 
@@ -1009,26 +818,20 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnSurfaceSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnSurfaceRasterSymbol(
     const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
-    const auto& internalState = getInternalState();
-
-    const auto& symbol = std::static_pointer_cast<const OnSurfaceRasterMapSymbol>(renderable->mapSymbol);
-    const auto& symbolGroupPtr = symbol->groupPtr;
+    placer.plotWithoutChecks(renderable);
 
     return true;
 }
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnSurfaceVectorSymbol(
     const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
-    const auto& internalState = getInternalState();
-
-    const auto& symbol = std::static_pointer_cast<const OnSurfaceVectorMapSymbol>(renderable->mapSymbol);
-    const auto& symbolGroupPtr = symbol->groupPtr;
+    placer.plotWithoutChecks(renderable);
 
     return true;
 }
@@ -1341,7 +1144,7 @@ void OsmAnd::AtlasMapRendererSymbolsStage::obtainRenderablesFromOnPathSymbol(
 
 bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnPathSymbol(
     const std::shared_ptr<RenderableOnPathSymbol>& renderable,
-    ScreenQuadTree& intersections,
+    SymbolsPlacer& placer,
     AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
 {
     const auto& internalState = getInternalState();
@@ -1356,19 +1159,10 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnPathSymbol(
         const auto oobb = calculateOnPath2dOOBB(renderable);
         renderable->visibleBBox = renderable->intersectionBBox = (OOBBI)oobb;
 
-        if (!applyVisibilityFiltering(renderable->visibleBBox, intersections, metric))
-            return false;
-
         //TODO: use symbolExtraTopSpace & symbolExtraBottomSpace from font via Rasterizer_P
         //        oobb.enlargeBy(PointF(3.0f*setupOptions.displayDensityFactor, 10.0f*setupOptions.displayDensityFactor)); /* 3dip; 10dip */
 
-        if (!applyIntersectionWithOtherSymbolsFiltering(renderable, intersections, metric))
-            return false;
-
-        if (!applyMinDistanceToSameContentFromOtherSymbolFiltering(renderable, intersections, metric))
-            return false;
-
-        if (!addToIntersections(renderable, intersections, metric))
+        if (!placer.plot(renderable))
             return false;
 
         if (Q_UNLIKELY(debugSettings->showOnPath2dSymbolGlyphDetails))
@@ -1394,19 +1188,10 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnPathSymbol(
         const auto oobb = calculateOnPath3dOOBB(renderable);
         renderable->visibleBBox = renderable->intersectionBBox = (OOBBI)oobb;
 
-        if (!applyVisibilityFiltering(renderable->visibleBBox, intersections, metric))
-            return false;
-
         //TODO: use symbolExtraTopSpace & symbolExtraBottomSpace from font via Rasterizer_P
         //        oobb.enlargeBy(PointF(3.0f*setupOptions.displayDensityFactor, 10.0f*setupOptions.displayDensityFactor)); /* 3dip; 10dip */
 
-        if (!applyIntersectionWithOtherSymbolsFiltering(renderable, intersections, metric))
-            return false;
-
-        if (!applyMinDistanceToSameContentFromOtherSymbolFiltering(renderable, intersections, metric))
-            return false;
-
-        if (!addToIntersections(renderable, intersections, metric))
+        if (!placer.plot(renderable))
             return false;
 
         if (Q_UNLIKELY(debugSettings->showOnPath3dSymbolGlyphDetails))
@@ -1444,205 +1229,216 @@ bool OsmAnd::AtlasMapRendererSymbolsStage::plotOnPathSymbol(
     return true;
 }
 
-bool OsmAnd::AtlasMapRendererSymbolsStage::applyVisibilityFiltering(
-    const ScreenQuadTree::BBox& visibleBBox,
-    const ScreenQuadTree& intersections,
-    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::SymbolsPlacementDelegate(
+    const AtlasMapRendererSymbolsStage* const stage_,
+    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric_)
+    : stage(stage_)
+    , metric(metric_)
 {
-    Stopwatch stopwatch(metric != nullptr);
+}
 
-    const auto mayBeVisible =
-        visibleBBox.isContainedBy(intersections.rootArea()) ||
-        visibleBBox.isIntersectedBy(intersections.rootArea()) ||
-        visibleBBox.contains(intersections.rootArea());
+const void* OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getGroupPtr(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->mapSymbol->groupPtr;
+}
 
-    if (metric)
-    {
-        metric->elapsedTimeForApplyVisibilityFilteringCalls += stopwatch.elapsed();
-        metric->applyVisibilityFilteringCalls++;
-        if (!mayBeVisible)
-            metric->rejectedByVisibilityFiltering++;
-        else
-            metric->acceptedByVisibilityFiltering++;
-    }
+const void* OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getGroupInstancePtr(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->genericInstanceParameters
+        ? renderable->genericInstanceParameters->groupInstancePtr
+        : nullptr;
+}
 
-    return mayBeVisible;
+const void* OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getSymbolPtr(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->mapSymbol.get();
 }
 
-bool OsmAnd::AtlasMapRendererSymbolsStage::applyIntersectionWithOtherSymbolsFiltering(
-    const std::shared_ptr<const RenderableSymbol>& renderable,
-    const ScreenQuadTree& intersections,
-    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+OsmAnd::MapSymbol::ContentClass OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getContentClass(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
 {
-    if (Q_UNLIKELY(debugSettings->skipSymbolsIntersectionCheck))
-        return true;
+    return renderable->mapSymbol->contentClass;
+}
 
-    const auto& symbol = renderable->mapSymbol;
+bool OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::checksIntersectionsWithinGroup(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->mapSymbolGroup->intersectionProcessingMode.isSet(
+        MapSymbolsGroup::IntersectionProcessingModeFlag::CheckIntersectionsWithinGroup);
+}
 
-    if (symbol->intersectsWithClasses.isEmpty())
-        return true;
+const QSet<OsmAnd::MapSymbolIntersectionClassId>& OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getIntersectsWithClasses(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->mapSymbol->intersectsWithClasses;
+}
 
-    Stopwatch stopwatch(metric != nullptr);
-    
-    // Check intersections
-    const auto checkIntersectionsWithinGroup = renderable->mapSymbolGroup->intersectionProcessingMode.isSet(MapSymbolsGroup::IntersectionProcessingModeFlag::CheckIntersectionsWithinGroup);
-    const auto& intersectionClassesRegistry = MapSymbolIntersectionClassesRegistry::globalInstance();
-    const auto& symbolIntersectsWithClasses = symbol->intersectsWithClasses;
-    const auto anyIntersectionClass = intersectionClassesRegistry.anyClass;
-    const auto symbolIntersectsWithAnyClass = symbolIntersectsWithClasses.contains(intersectionClassesRegistry.anyClass);
-    const auto symbolGroupPtr = symbol->groupPtr;
-    const auto symbolGroupInstancePtr = renderable->genericInstanceParameters
-        ? renderable->genericInstanceParameters->groupInstancePtr
-        : nullptr;
-    const auto intersects = intersections.test(renderable->intersectionBBox, false,
-        [symbolGroupPtr, symbolIntersectsWithClasses, symbolIntersectsWithAnyClass, anyIntersectionClass, symbolGroupInstancePtr, checkIntersectionsWithinGroup]
-        (const std::shared_ptr<const RenderableSymbol>& otherRenderable, const ScreenQuadTree::BBox& otherBBox) -> bool
-        {
-            const auto& otherSymbol = otherRenderable->mapSymbol;
+QString OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getContent(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    const auto rasterSymbol = dynamic_cast<const RasterMapSymbol*>(renderable->mapSymbol.get());
+    return rasterSymbol ? rasterSymbol->content : QString::null;
+}
 
-            // Symbols never intersect anything inside own group (different instances are treated as different groups)
-            if (!checkIntersectionsWithinGroup && symbolGroupPtr == otherSymbol->groupPtr)
-            {
-                const auto otherSymbolGroupInstancePtr = otherRenderable->genericInstanceParameters
-                    ? otherRenderable->genericInstanceParameters->groupInstancePtr
-                    : nullptr;
-                if (symbolGroupInstancePtr == otherSymbolGroupInstancePtr)
-                    return false;
-            }
+float OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getMinDistance(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    const auto rasterSymbol = dynamic_cast<const RasterMapSymbol*>(renderable->mapSymbol.get());
+    return rasterSymbol ? rasterSymbol->minDistance : 0.0f;
+}
 
-            // Special case: tested symbol intersects any other symbol with at least 1 any class
-            if (symbolIntersectsWithAnyClass && !otherSymbol->intersectsWithClasses.isEmpty())
-                return true;
+const OsmAnd::AtlasMapRendererSymbolsStage::ScreenIndex::BBox& OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getVisibleBBox(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->visibleBBox;
+}
 
-            // Special case: other symbol intersects tested symbol with at least 1 any class (which is true already)
-            if (otherSymbol->intersectsWithClasses.contains(anyIntersectionClass))
-                return true;
+const OsmAnd::AtlasMapRendererSymbolsStage::ScreenIndex::BBox& OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::getIntersectionBBox(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
+{
+    return renderable->intersectionBBox;
+}
 
-            // General case:
-            const auto commonIntersectionClasses = symbolIntersectsWithClasses & otherSymbol->intersectsWithClasses;
-            const auto hasCommonIntersectionClasses = !commonIntersectionClasses.isEmpty();
-            return hasCommonIntersectionClasses;
-        });
+bool OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::obtainGroupInstance(
+    const std::shared_ptr<const RenderableSymbol>& renderable,
+    MapSymbolsGroup::PresentationMode& outPresentationMode,
+    QList<MapSymbolsPlacement::GroupInstanceSymbol>& outSymbols) const
+{
+    const auto& mapSymbolsGroup = renderable->mapSymbolGroup;
+    if (!mapSymbolsGroup)
+        return false;
+    outPresentationMode = mapSymbolsGroup->presentationMode;
 
-    if (metric)
+    MapSymbolsPlacement::GroupInstanceSymbol symbol;
+    if (const auto mapSymbolsGroupInstance = getGroupInstancePtr(renderable))
     {
-        metric->elapsedTimeForApplyIntersectionWithOtherSymbolsFilteringCalls += stopwatch.elapsed();
-        metric->applyIntersectionWithOtherSymbolsFilteringCalls++;
-        if (intersects)
-            metric->rejectedByIntersectionWithOtherSymbolsFiltering++;
-        else
-            metric->acceptedByIntersectionWithOtherSymbolsFiltering++;
+        const auto& symbols = static_cast<const MapSymbolsGroup::AdditionalInstance*>(mapSymbolsGroupInstance)->symbols;
+        for (const auto& symbolEntry : rangeOf(constOf(symbols)))
+        {
+            symbol.symbolPtr = symbolEntry.key().get();
+            symbol.contentClass = symbolEntry.key()->contentClass;
+            outSymbols.push_back(symbol);
+        }
     }
-
-    if (intersects)
+    else
     {
-        if (Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByIntersectionCheck))
-            addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorRED).withAlpha(50));
-        return false;
+        for (const auto& mapSymbol : constOf(mapSymbolsGroup->symbols))
+        {
+            symbol.symbolPtr = mapSymbol.get();
+            symbol.contentClass = mapSymbol->contentClass;
+            outSymbols.push_back(symbol);
+        }
     }
+
     return true;
 }
 
-bool OsmAnd::AtlasMapRendererSymbolsStage::applyMinDistanceToSameContentFromOtherSymbolFiltering(
-    const std::shared_ptr<const RenderableSymbol>& renderable,
-    const ScreenQuadTree& intersections,
-    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+bool OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::isCheckEnabled(
+    const MapSymbolsPlacement::Check check) const
 {
-    if (Q_UNLIKELY(debugSettings->skipSymbolsMinDistanceToSameContentFromOtherSymbolCheck))
-        return true;
+    const auto& debugSettings = stage->debugSettings;
+    switch (check)
+    {
+        case MapSymbolsPlacement::Check::IntersectionWithOtherSymbols:
+            return !debugSettings->skipSymbolsIntersectionCheck;
+        case MapSymbolsPlacement::Check::MinDistanceToSameContent:
+            return !debugSettings->skipSymbolsMinDistanceToSameContentFromOtherSymbolCheck;
+        case MapSymbolsPlacement::Check::AddToIntersections:
+            return !debugSettings->allSymbolsTransparentForIntersectionLookup;
+        default:
+            return true;
+    }
+}
 
-    const auto& symbol = std::static_pointer_cast<const RasterMapSymbol>(renderable->mapSymbol);
+bool OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::isTimingEnabled() const
+{
+    return (metric != nullptr);
+}
 
-    if (symbol->minDistance <= 0.0f || symbol->content.isNull())
-        return true;
+void OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::onChecked(
+    const std::shared_ptr<const RenderableSymbol>& renderable,
+    const MapSymbolsPlacement::Check check,
+    const bool passed,
+    const float elapsedTime) const
+{
+    const auto& debugSettings = stage->debugSettings;
+    switch (check)
+    {
+        case MapSymbolsPlacement::Check::Visibility:
+            if (metric)
+            {
+                metric->elapsedTimeForApplyVisibilityFilteringCalls += elapsedTime;
+                metric->applyVisibilityFilteringCalls++;
+                if (!passed)
+                    metric->rejectedByVisibilityFiltering++;
+                else
+                    metric->acceptedByVisibilityFiltering++;
+            }
+            break;
 
-    Stopwatch stopwatch(metric != nullptr);
+        case MapSymbolsPlacement::Check::IntersectionWithOtherSymbols:
+            if (metric)
+            {
+                metric->elapsedTimeForApplyIntersectionWithOtherSymbolsFilteringCalls += elapsedTime;
+                metric->applyIntersectionWithOtherSymbolsFilteringCalls++;
+                if (!passed)
+                    metric->rejectedByIntersectionWithOtherSymbolsFiltering++;
+                else
+                    metric->acceptedByIntersectionWithOtherSymbolsFiltering++;
+            }
 
-    // Query for similar content from other groups in area of "minDistance" to exclude duplicates
-    const auto symbolGroupPtr = symbol->groupPtr;
-    const auto symbolGroupInstancePtr = renderable->genericInstanceParameters
-        ? renderable->genericInstanceParameters->groupInstancePtr
-        : nullptr;
-    const auto& symbolContent = symbol->content;
-    const auto hasSimilarContent = intersections.test(renderable->intersectionBBox.getEnlargedBy(symbol->minDistance), false,
-        [symbolContent, symbolGroupPtr, symbolGroupInstancePtr]
-        (const std::shared_ptr<const RenderableSymbol>& otherRenderable, const ScreenQuadTree::BBox& otherBBox) -> bool
-        {
-            const auto otherSymbol = std::dynamic_pointer_cast<const RasterMapSymbol>(otherRenderable->mapSymbol);
-            if (!otherSymbol)
-                return false;
+            if (!passed && Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByIntersectionCheck))
+                stage->addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorRED).withAlpha(50));
+            break;
 
-            if (symbolGroupPtr == otherSymbol->groupPtr)
+        case MapSymbolsPlacement::Check::MinDistanceToSameContent:
+            if (metric)
             {
-                const auto otherSymbolGroupInstancePtr = otherRenderable->genericInstanceParameters
-                    ? otherRenderable->genericInstanceParameters->groupInstancePtr
-                    : nullptr;
-                if (symbolGroupInstancePtr == otherSymbolGroupInstancePtr)
-                    return false;
+                metric->elapsedTimeForApplyMinDistanceToSameContentFromOtherSymbolFilteringCalls += elapsedTime;
+                metric->applyMinDistanceToSameContentFromOtherSymbolFilteringCalls++;
+                if (!passed)
+                    metric->rejectedByMinDistanceToSameContentFromOtherSymbolFiltering++;
+                else
+                    metric->acceptedByMinDistanceToSameContentFromOtherSymbolFiltering++;
             }
 
-            const auto shouldCheck = (otherSymbol->content == symbolContent);
-            return shouldCheck;
-        });
+            if (!passed && Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByMinDistanceToSameContentFromOtherSymbolCheck))
+                stage->addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorRED).withAlpha(128));
 
-    if (metric)
-    {
-        metric->elapsedTimeForApplyMinDistanceToSameContentFromOtherSymbolFilteringCalls += stopwatch.elapsed();
-        metric->applyMinDistanceToSameContentFromOtherSymbolFilteringCalls ++;
-        if (hasSimilarContent)
-            metric->rejectedByMinDistanceToSameContentFromOtherSymbolFiltering++;
-        else
-            metric->acceptedByMinDistanceToSameContentFromOtherSymbolFiltering++;
-    }
-
-    if (hasSimilarContent)
-    {
-        if (Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByMinDistanceToSameContentFromOtherSymbolCheck))
-            addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorRED).withAlpha(128));
+            if (!passed && Q_UNLIKELY(debugSettings->showSymbolsCheckBBoxesRejectedByMinDistanceToSameContentFromOtherSymbolCheck))
+            {
+                stage->addIntersectionDebugBox(
+                    renderable->intersectionBBox.getEnlargedBy(getMinDistance(renderable)),
+                    ColorARGB::fromSkColor(SK_ColorRED).withAlpha(128),
+                    false);
+            }
+            break;
 
-        if (Q_UNLIKELY(debugSettings->showSymbolsCheckBBoxesRejectedByMinDistanceToSameContentFromOtherSymbolCheck))
-            addIntersectionDebugBox(renderable->intersectionBBox.getEnlargedBy(symbol->minDistance), ColorARGB::fromSkColor(SK_ColorRED).withAlpha(128), false);
+        case MapSymbolsPlacement::Check::AddToIntersections:
+            if (metric)
+            {
+                metric->elapsedTimeForAddToIntersectionsCalls += elapsedTime;
+                metric->addToIntersectionsCalls++;
+                if (!passed)
+                    metric->rejectedByAddToIntersections++;
+                else
+                    metric->acceptedByAddToIntersections++;
+            }
 
-        return false;
+            if (!passed && Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByIntersectionCheck))
+                stage->addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorBLUE).withAlpha(50));
+            break;
     }
-
-    return true;
 }
 
-bool OsmAnd::AtlasMapRendererSymbolsStage::addToIntersections(
-    const std::shared_ptr<const RenderableSymbol>& renderable,
-    ScreenQuadTree& intersections,
-    AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const
+void OsmAnd::AtlasMapRendererSymbolsStage::SymbolsPlacementDelegate::onDiscarded(
+    const std::shared_ptr<const RenderableSymbol>& renderable) const
 {
-    if (Q_UNLIKELY(debugSettings->allSymbolsTransparentForIntersectionLookup))
-        return true;
-
-    if (renderable->mapSymbol->intersectsWithClasses.isEmpty())
-        return true;
-    
-    Stopwatch stopwatch(metric != nullptr);
-
-    const auto inserted = intersections.insert(renderable, renderable->intersectionBBox);
-
-    if (metric)
-    {
-        metric->elapsedTimeForAddToIntersectionsCalls += stopwatch.elapsed();
-        metric->addToIntersectionsCalls++;
-        if (!inserted)
-            metric->rejectedByAddToIntersections++;
-        else
-            metric->acceptedByAddToIntersections++;
-    }
-
-    if (!inserted)
-    {
-        if (Q_UNLIKELY(debugSettings->showSymbolsBBoxesRejectedByIntersectionCheck))
-            addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorBLUE).withAlpha(50));
-
-        return false;
-    }
-
-    return true;
+    if (Q_UNLIKELY(stage->debugSettings->showSymbolsBBoxesRejectedByPresentationMode))
+        stage->addIntersectionDebugBox(renderable, ColorARGB::fromSkColor(SK_ColorYELLOW).withAlpha(50));
 }
 
 QVector<glm::vec2> OsmAnd::AtlasMapRendererSymbolsStage::convertPoints31ToWorld(
@@ -2349,11 +2145,11 @@ void OsmAnd::AtlasMapRendererSymbolsStage::addIntersectionDebugBox(
 }
 
 void OsmAnd::AtlasMapRendererSymbolsStage::addIntersectionDebugBox(
-    const ScreenQuadTree::BBox intersectionBBox,
+    const ScreenIndex::BBox intersectionBBox,
     const ColorARGB color,
     const bool drawBorder /*= true*/) const
 {
-    if (intersectionBBox.type == ScreenQuadTree::BBoxType::AABB)
+    if (intersectionBBox.type == ScreenIndex::BBoxType::AABB)
     {
         const auto& boundsInWindow = intersectionBBox.asAABB;
 
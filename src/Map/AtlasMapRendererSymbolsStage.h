@@ -15,6 +15,8 @@
 #include "OsmAndCore.h"
 #include "CommonTypes.h"
 #include "QuadTree.h"
+#include "GridIndex.h"
+#include "MapSymbolsPlacement.h"
 #include "AtlasMapRendererStage.h"
 #include "GPUAPI.h"
 
@@ -31,6 +33,88 @@ namespace OsmAnd
     public:
         struct RenderableSymbol;
         typedef QuadTree< std::shared_ptr<const RenderableSymbol>, AreaI::CoordType > ScreenQuadTree;
+        typedef GridIndex< std::shared_ptr<const RenderableSymbol>, AreaI::CoordType > ScreenGridIndex;
+
+        // Screen-space index of renderable symbols, backed either by quad tree or by uniform grid
+        class ScreenIndex
+        {
+        public:
+            typedef ScreenQuadTree::BBox BBox;
+            typedef ScreenQuadTree::BBoxType BBoxType;
+            typedef ScreenQuadTree::Acceptor Acceptor;
+            typedef AtlasMapRendererConfiguration::SymbolsIntersectionsIndex Type;
+
+        private:
+            ScreenQuadTree _quadTree;
+            ScreenGridIndex _gridIndex;
+        public:
+            ScreenIndex(
+                const Type type = Type::QuadTree,
+                const AreaI& rootArea = AreaI::largest(),
+                const uintmax_t maxDepth = std::numeric_limits<uintmax_t>::max());
+
+            Type type;
+            uintmax_t maxDepth;
+
+            inline AreaI getRootArea() const
+            {
+                return (type == Type::Grid) ? _gridIndex.getRootArea() : _quadTree.getRootArea();
+            }
+
+            inline const AreaI& rootArea() const
+            {
+                return (type == Type::Grid) ? _gridIndex.rootArea() : _quadTree.rootArea();
+            }
+
+            inline bool insert(const std::shared_ptr<const RenderableSymbol>& entry, const BBox& bbox, const bool strict = false)
+            {
+                return (type == Type::Grid) ? _gridIndex.insert(entry, bbox, strict) : _quadTree.insert(entry, bbox, strict);
+            }
+
+            template<class CONTAINER_TYPE>
+            inline int insertFrom(
+                const CONTAINER_TYPE& container,
+                const std::function<bool(const std::shared_ptr<const RenderableSymbol>& item, BBox& outBbox)> obtainBBox,
+                const bool strict = false)
+            {
+                return (type == Type::Grid)
+                    ? _gridIndex.insertFrom(container, obtainBBox, strict)
+                    : _quadTree.insertFrom(container, obtainBBox, strict);
+            }
+
+            inline void query(
+                const BBox& bbox,
+                QList< std::shared_ptr<const RenderableSymbol> >& outResults,
+                const bool strict = false,
+                const Acceptor acceptor = nullptr) const
+            {
+                if (type == Type::Grid)
+                    _gridIndex.query(bbox, outResults, strict, acceptor);
+                else
+                    _quadTree.query(bbox, outResults, strict, acceptor);
+            }
+
+            inline bool test(const BBox& bbox, const bool strict = false, const Acceptor acceptor = nullptr) const
+            {
+                return (type == Type::Grid) ? _gridIndex.test(bbox, strict, acceptor) : _quadTree.test(bbox, strict, acceptor);
+            }
+
+            inline void select(
+                const PointI& point,
+                QList< std::shared_ptr<const RenderableSymbol> >& outResults,
+                const Acceptor acceptor = nullptr) const
+            {
+                if (type == Type::Grid)
+                    _gridIndex.select(point, outResults, acceptor);
+                else
+                    _quadTree.select(point, outResults, acceptor);
+            }
+
+            inline bool removeOne(const std::shared_ptr<const RenderableSymbol>& entry, const BBox& bbox)
+            {
+                return (type == Type::Grid) ? _gridIndex.removeOne(entry, bbox) : _quadTree.removeOne(entry, bbox);
+            }
+        };
 
         struct RenderableSymbol
         {
@@ -42,8 +126,8 @@ namespace OsmAnd
 
             std::shared_ptr<const GPUAPI::ResourceInGPU> gpuResource;
             double distanceToCamera;
-            ScreenQuadTree::BBox visibleBBox;
-            ScreenQuadTree::BBox intersectionBBox;
+            ScreenIndex::BBox visibleBBox;
+            ScreenIndex::BBox intersectionBBox;
         };
 
         struct RenderableBillboardSymbol : RenderableSymbol
@@ -108,23 +192,84 @@ namespace OsmAnd
             QVector< GlyphPlacement > glyphsPlacement;
         };
     private:
+        // Describes renderable symbols to symbols placement and reports results of its checks
+        class SymbolsPlacementDelegate
+        {
+        private:
+        protected:
+        public:
+            SymbolsPlacementDelegate(
+                const AtlasMapRendererSymbolsStage* const stage,
+                AtlasMapRenderer_Metrics::Metric_renderFrame* const metric);
+
+            const AtlasMapRendererSymbolsStage* const stage;
+            AtlasMapRenderer_Metrics::Metric_renderFrame* const metric;
+
+            const void* getGroupPtr(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            const void* getGroupInstancePtr(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            const void* getSymbolPtr(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            MapSymbol::ContentClass getContentClass(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            bool checksIntersectionsWithinGroup(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            const QSet<MapSymbolIntersectionClassId>& getIntersectsWithClasses(
+                const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            QString getContent(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            float getMinDistance(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            const ScreenIndex::BBox& getVisibleBBox(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            const ScreenIndex::BBox& getIntersectionBBox(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+            bool obtainGroupInstance(
+                const std::shared_ptr<const RenderableSymbol>& renderable,
+                MapSymbolsGroup::PresentationMode& outPresentationMode,
+                QList<MapSymbolsPlacement::GroupInstanceSymbol>& outSymbols) const;
+            bool isCheckEnabled(const MapSymbolsPlacement::Check check) const;
+            bool isTimingEnabled() const;
+            void onChecked(
+                const std::shared_ptr<const RenderableSymbol>& renderable,
+                const MapSymbolsPlacement::Check check,
+                const bool passed,
+                const float elapsedTime) const;
+            void onDiscarded(const std::shared_ptr<const RenderableSymbol>& renderable) const;
+        };
+        typedef MapSymbolsPlacement::Placer<
+            std::shared_ptr<const RenderableSymbol>,
+            ScreenIndex,
+            SymbolsPlacementDelegate> SymbolsPlacer;
+
         bool obtainRenderableSymbols(
             QList< std::shared_ptr<const RenderableSymbol> >& outRenderableSymbols,
-            ScreenQuadTree& outIntersections,
+            ScreenIndex& outIntersections,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool obtainRenderableSymbols(
             const MapRenderer::PublishedMapSymbolsByOrder& mapSymbolsByOrder,
             QList< std::shared_ptr<const RenderableSymbol> >& outRenderableSymbols,
-            ScreenQuadTree& outIntersections,
+            ScreenIndex& outIntersections,
             MapRenderer::PublishedMapSymbolsByOrder* pOutAcceptedMapSymbolsByOrder,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         mutable MapRenderer::PublishedMapSymbolsByOrder _lastAcceptedMapSymbolsByOrder;
 
+        // State in which last full placement of symbols was performed
+        struct SymbolsPlacementState
+        {
+            SymbolsPlacementState();
+
+            bool isValid;
+            unsigned int publishedMapSymbolsVersion;
+            AreaI viewport;
+            float azimuth;
+            float elevationAngle;
+            PointI target31;
+            ZoomLevel zoomLevel;
+            float visualZoom;
+            float referenceTileSizeOnScreenInPixels;
+        };
+        mutable SymbolsPlacementState _lastSymbolsPlacementState;
+        SymbolsPlacementState captureSymbolsPlacementState() const;
+        bool canReuseLastSymbolsPlacement(const SymbolsPlacementState& state) const;
+
         mutable QReadWriteLock _lastPreparedIntersectionsLock;
-        ScreenQuadTree _lastPreparedIntersections;
+        ScreenIndex _lastPreparedIntersections;
 
         mutable QReadWriteLock _lastVisibleSymbolsLock;
-        ScreenQuadTree _lastVisibleSymbols;
+        ScreenIndex _lastVisibleSymbols;
 
         // Path calculations cache
         struct ComputedPathData
@@ -147,7 +292,7 @@ namespace OsmAnd
 
         bool plotSymbol(
             const std::shared_ptr<RenderableSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
 
         // Billboard symbols:
@@ -160,15 +305,15 @@ namespace OsmAnd
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotBillboardSymbol(
             const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotBillboardRasterSymbol(
             const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotBillboardVectorSymbol(
             const std::shared_ptr<RenderableBillboardSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
 
         // On-surface symbols:
@@ -181,15 +326,15 @@ namespace OsmAnd
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotOnSurfaceSymbol(
             const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotOnSurfaceRasterSymbol(
             const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotOnSurfaceVectorSymbol(
             const std::shared_ptr<RenderableOnSurfaceSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
 
         // On-path symbols:
@@ -203,25 +348,7 @@ namespace OsmAnd
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
         bool plotOnPathSymbol(
             const std::shared_ptr<RenderableOnPathSymbol>& renderable,
-            ScreenQuadTree& intersections,
-            AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
-
-        // Intersection-related:
-        bool applyVisibilityFiltering(
-            const ScreenQuadTree::BBox& visibleBBox,
-            const ScreenQuadTree& intersections,
-            AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
-        bool applyIntersectionWithOtherSymbolsFiltering(
-            const std::shared_ptr<const RenderableSymbol>& renderable,
-            const ScreenQuadTree& intersections,
-            AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
-        bool applyMinDistanceToSameContentFromOtherSymbolFiltering(
-            const std::shared_ptr<const RenderableSymbol>& renderable,
-            const ScreenQuadTree& intersections,
-            AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
-        bool addToIntersections(
-            const std::shared_ptr<const RenderableSymbol>& renderable,
-            ScreenQuadTree& intersections,
+            SymbolsPlacer& placer,
             AtlasMapRenderer_Metrics::Metric_renderFrame* const metric) const;
 
         // Utilities:
@@ -311,7 +438,7 @@ namespace OsmAnd
             const bool drawBorder = true) const;
 
         void addIntersectionDebugBox(
-            const ScreenQuadTree::BBox intersectionBBox,
+            const ScreenIndex::BBox intersectionBBox,
             const ColorARGB color,
             const bool drawBorder = true) const;
 
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "VectorMapSymbol.h"
 #include "Logging.h"
 
 OsmAnd::GPUAPI::GPUAPI()
@@ -57,14 +58,87 @@ std::shared_ptr<OsmAnd::GPUAPI::SlotOnAtlasTextureInGPU> OsmAnd::GPUAPI::allocat
     return pool->allocateTile(alphaChannelType, atlasTextureAllocator);
 }
 
+std::shared_ptr<OsmAnd::GPUAPI::PackedTexturesPool> OsmAnd::GPUAPI::obtainPackedTexturesPool(
+    const TextureFormat format,
+    const unsigned int pageSize,
+    const unsigned int padding)
+{
+    auto itPool = _packedTexturesPools.constFind(format);
+    if (itPool == _packedTexturesPools.cend())
+    {
+        std::shared_ptr<PackedTexturesPool> pool(new PackedTexturesPool(this, format, pageSize, padding));
+        itPool = _packedTexturesPools.insert(format, pool);
+    }
+
+    return *itPool;
+}
+
+std::shared_ptr<OsmAnd::GPUAPI::SlotOnPackedTextureInGPU> OsmAnd::GPUAPI::allocateSlotInPackedTexture(
+    const unsigned int width,
+    const unsigned int height,
+    const AlphaChannelType alphaChannelType,
+    const std::shared_ptr<PackedTexturesPool>& pool,
+    PackedTexturesPool::PackedTextureAllocator packedTextureAllocator)
+{
+    return pool->allocateSlot(width, height, alphaChannelType, packedTextureAllocator);
+}
+
 OsmAnd::AlphaChannelType OsmAnd::GPUAPI::getGpuResourceAlphaChannelType(const std::shared_ptr<const ResourceInGPU> gpuResource)
 {
     if (gpuResource->type == ResourceInGPU::Type::SlotOnAtlasTexture)
         return std::static_pointer_cast<const SlotOnAtlasTextureInGPU>(gpuResource)->alphaChannelType;
-    else //if (gpuResource->type == ResourceInGPU::Type::Texture)
+    else //if (gpuResource->type == ResourceInGPU::Type::Texture || gpuResource->type == ResourceInGPU::Type::SlotOnPackedTexture)
         return std::static_pointer_cast<const TextureInGPU>(gpuResource)->alphaChannelType;
 }
 
+size_t OsmAnd::GPUAPI::getGpuResourceSize(const std::shared_ptr<const ResourceInGPU>& gpuResource)
+{
+    if (!gpuResource)
+        return 0;
+
+    // Actual texture format is not known here, so 32 bits per texel is assumed
+    switch (gpuResource->type)
+    {
+        case ResourceInGPU::Type::Texture:
+        {
+            const auto texture = std::static_pointer_cast<const TextureInGPU>(gpuResource);
+            size_t size = 0;
+            for (auto mipmapLevel = 0u; mipmapLevel < qMax(texture->mipmapLevels, 1u); mipmapLevel++)
+                size += qMax(texture->width >> mipmapLevel, 1u) * qMax(texture->height >> mipmapLevel, 1u) * 4;
+            return size;
+        }
+        case ResourceInGPU::Type::SlotOnAtlasTexture:
+        {
+            const auto slot = std::static_pointer_cast<const SlotOnAtlasTextureInGPU>(gpuResource);
+            return slot->atlasTexture->tileSize * slot->atlasTexture->tileSize * 4;
+        }
+        case ResourceInGPU::Type::SlotOnPackedTexture:
+        {
+            const auto slot = std::static_pointer_cast<const SlotOnPackedTextureInGPU>(gpuResource);
+            const auto padding = slot->packedTexture->pool->padding;
+            return (slot->width + 2 * padding) * (slot->height + 2 * padding) * 4;
+        }
+        case ResourceInGPU::Type::ArrayBuffer:
+            // Standalone array buffers hold elevation data
+            return std::static_pointer_cast<const ArrayBufferInGPU>(gpuResource)->itemsCount * sizeof(float);
+        case ResourceInGPU::Type::ElementArrayBuffer:
+            return std::static_pointer_cast<const ElementArrayBufferInGPU>(gpuResource)->itemsCount *
+                sizeof(VectorMapSymbol::Index);
+        case ResourceInGPU::Type::Mesh:
+        {
+            const auto mesh = std::static_pointer_cast<const MeshInGPU>(gpuResource);
+            size_t size = 0;
+            if (mesh->vertexBuffer)
+                size += mesh->vertexBuffer->itemsCount * sizeof(VectorMapSymbol::Vertex);
+            if (mesh->indexBuffer)
+                size += mesh->indexBuffer->itemsCount * sizeof(VectorMapSymbol::Index);
+            return size;
+        }
+    }
+
+    return 0;
+}
+
 OsmAnd::GPUAPI::ResourceInGPU::ResourceInGPU(const Type type_, GPUAPI* api_, const RefInGPU& refInGPU_)
     : _refInGPU(refInGPU_)
     , api(api_)
@@ -120,7 +194,19 @@ OsmAnd::GPUAPI::TextureInGPU::TextureInGPU(
     const unsigned int height_,
     const unsigned int mipmapLevels_,
     const AlphaChannelType alphaChannelType_)
-    : ResourceInGPU(Type::Texture, api_, refInGPU_)
+    : TextureInGPU(Type::Texture, api_, refInGPU_, width_, height_, mipmapLevels_, alphaChannelType_)
+{
+}
+
+OsmAnd::GPUAPI::TextureInGPU::TextureInGPU(
+    const Type type_,
+    GPUAPI* api_,
+    const RefInGPU& refInGPU_,
+    const unsigned int width_,
+    const unsigned int height_,
+    const unsigned int mipmapLevels_,
+    const AlphaChannelType alphaChannelType_)
+    : ResourceInGPU(type_, api_, refInGPU_)
     , width(width_)
     , height(height_)
     , mipmapLevels(mipmapLevels_)
@@ -313,6 +399,152 @@ std::shared_ptr<OsmAnd::GPUAPI::SlotOnAtlasTextureInGPU> OsmAnd::GPUAPI::AtlasTe
     }
 }
 
+OsmAnd::GPUAPI::PackedTexturesPool::PackedTexturesPool(
+    GPUAPI* api_,
+    const TextureFormat format_,
+    const unsigned int pageSize_,
+    const unsigned int padding_)
+    : api(api_)
+    , format(format_)
+    , pageSize(pageSize_)
+    , padding(padding_)
+{
+}
+
+OsmAnd::GPUAPI::PackedTexturesPool::~PackedTexturesPool()
+{
+}
+
+unsigned int OsmAnd::GPUAPI::PackedTexturesPool::getPagesCount() const
+{
+    QMutexLocker scopedLocker(&_pagesMutex);
+
+    unsigned int pagesCount = 0;
+    for (const auto& page : constOf(_pages))
+    {
+        if (!page.expired())
+            pagesCount++;
+    }
+    return pagesCount;
+}
+
+std::shared_ptr<OsmAnd::GPUAPI::SlotOnPackedTextureInGPU> OsmAnd::GPUAPI::PackedTexturesPool::allocateSlot(
+    const unsigned int width,
+    const unsigned int height,
+    const AlphaChannelType alphaChannelType,
+    PackedTextureAllocator packedTextureAllocator)
+{
+    std::shared_ptr<PackedTextureInGPU> page;
+    AreaI area;
+    bool allocated = false;
+
+    {
+        QMutexLocker scopedLocker(&_pagesMutex);
+
+        // Older pages are filled first, so that newer ones have a chance to get empty and released
+        auto itPage = mutableIteratorOf(_pages);
+        while (itPage.hasNext())
+        {
+            const auto candidatePage = itPage.next().lock();
+            if (!candidatePage)
+            {
+                itPage.remove();
+                continue;
+            }
+
+            QMutexLocker scopedPackerLocker(&candidatePage->_packerMutex);
+            if (candidatePage->_packer.allocate(width, height, area))
+            {
+                page = candidatePage;
+                allocated = true;
+                break;
+            }
+        }
+
+        if (!allocated)
+        {
+            const auto newPage = packedTextureAllocator();
+            if (!newPage)
+                return nullptr;
+            page.reset(newPage);
+
+            QMutexLocker scopedPackerLocker(&page->_packerMutex);
+            if (!page->_packer.allocate(width, height, area))
+                return nullptr;
+            _pages.push_back(page);
+        }
+    }
+
+    return std::shared_ptr<SlotOnPackedTextureInGPU>(new SlotOnPackedTextureInGPU(page, area, alphaChannelType));
+}
+
+OsmAnd::GPUAPI::PackedTextureInGPU::PackedTextureInGPU(
+    GPUAPI* api_,
+    const RefInGPU& refInGPU_,
+    const unsigned int pageSize_,
+    const std::shared_ptr<PackedTexturesPool>& pool_)
+    : TextureInGPU(api_, refInGPU_, pageSize_, pageSize_, 1, AlphaChannelType::Invalid)
+    , _packer(pageSize_, pageSize_, pool_->padding)
+    , pool(pool_)
+{
+}
+
+OsmAnd::GPUAPI::PackedTextureInGPU::~PackedTextureInGPU()
+{
+    assert(_packer.isEmpty());
+}
+
+float OsmAnd::GPUAPI::PackedTextureInGPU::getOccupancy() const
+{
+    QMutexLocker scopedLocker(&_packerMutex);
+
+    return _packer.getOccupancy();
+}
+
+OsmAnd::GPUAPI::SlotOnPackedTextureInGPU::SlotOnPackedTextureInGPU(
+    const std::shared_ptr<PackedTextureInGPU>& packedTexture_,
+    const AreaI& area_,
+    const AlphaChannelType alphaChannelType_)
+    : TextureInGPU(
+        Type::SlotOnPackedTexture,
+        packedTexture_->api,
+        packedTexture_->refInGPU,
+        area_.width(),
+        area_.height(),
+        1,
+        alphaChannelType_)
+    , packedTexture(packedTexture_)
+    , area(area_)
+    , texCoordsOffsetN(
+        static_cast<float>(area_.left()) / static_cast<float>(packedTexture_->width),
+        static_cast<float>(area_.top()) / static_cast<float>(packedTexture_->height))
+    , texCoordsScaleN(
+        static_cast<float>(area_.width()) / static_cast<float>(packedTexture_->width),
+        static_cast<float>(area_.height()) / static_cast<float>(packedTexture_->height))
+{
+}
+
+OsmAnd::GPUAPI::SlotOnPackedTextureInGPU::~SlotOnPackedTextureInGPU()
+{
+    // Return occupied area to page, so it can be reused or page can be released
+    {
+        QMutexLocker scopedLocker(&packedTexture->_packerMutex);
+
+        packedTexture->_packer.release(area);
+    }
+
+    // Clear reference to GPU resource to avoid removal in base class
+    _refInGPU = nullptr;
+}
+
+void OsmAnd::GPUAPI::SlotOnPackedTextureInGPU::lostRefInGPU() const
+{
+    TextureInGPU::lostRefInGPU();
+
+    // Page itself is not known to resources owner, so it has to be marked as lost too
+    packedTexture->lostRefInGPU();
+}
+
 OsmAnd::GPUAPI::MeshInGPU::MeshInGPU(
     GPUAPI* api_,
     const std::shared_ptr<ArrayBufferInGPU>& vertexBuffer_,
@@ -17,6 +17,7 @@
 #include "CommonTypes.h"
 #include "MapCommonTypes.h"
 #include "IMapTiledDataProvider.h"
+#include "TextureAtlasPacker.h"
 
 class SkBitmap;
 
@@ -48,6 +49,7 @@ namespace OsmAnd
             {
                 Texture,
                 SlotOnAtlasTexture,
+                SlotOnPackedTexture,
                 ArrayBuffer,
                 ElementArrayBuffer,
                 Mesh
@@ -82,6 +84,14 @@ namespace OsmAnd
             Q_DISABLE_COPY_AND_MOVE(TextureInGPU);
         private:
         protected:
+            TextureInGPU(
+                const Type type,
+                GPUAPI* api,
+                const RefInGPU& refInGPU,
+                const unsigned int width,
+                const unsigned int height,
+                const unsigned int mipmapLevels,
+                const AlphaChannelType alphaChannelType);
         public:
             TextureInGPU(
                 GPUAPI* api,
@@ -248,6 +258,88 @@ namespace OsmAnd
             const AlphaChannelType alphaChannelType;
         };
 
+        class SlotOnPackedTextureInGPU;
+        class PackedTextureInGPU;
+        class PackedTexturesPool
+        {
+            Q_DISABLE_COPY_AND_MOVE(PackedTexturesPool);
+        public:
+            typedef std::function< PackedTextureInGPU*() > PackedTextureAllocator;
+        private:
+            mutable QMutex _pagesMutex;
+            QList< std::weak_ptr<PackedTextureInGPU> > _pages;
+        protected:
+            PackedTexturesPool(
+                GPUAPI* api,
+                const TextureFormat format,
+                const unsigned int pageSize,
+                const unsigned int padding);
+
+            std::shared_ptr<SlotOnPackedTextureInGPU> allocateSlot(
+                const unsigned int width,
+                const unsigned int height,
+                const AlphaChannelType alphaChannelType,
+                PackedTextureAllocator packedTextureAllocator);
+        public:
+            virtual ~PackedTexturesPool();
+
+            GPUAPI* const api;
+            const TextureFormat format;
+            const unsigned int pageSize;
+            const unsigned int padding;
+
+            unsigned int getPagesCount() const;
+
+        friend OsmAnd::GPUAPI;
+        };
+
+        // Page of texture that holds symbols of different sizes packed by shelves. Page is released
+        // as soon as last slot on it is released.
+        class PackedTextureInGPU : public TextureInGPU
+        {
+            Q_DISABLE_COPY_AND_MOVE(PackedTextureInGPU);
+        private:
+        protected:
+            mutable QMutex _packerMutex;
+            TextureAtlasPacker _packer;
+        public:
+            PackedTextureInGPU(
+                GPUAPI* api,
+                const RefInGPU& refInGPU,
+                const unsigned int pageSize,
+                const std::shared_ptr<PackedTexturesPool>& pool);
+            virtual ~PackedTextureInGPU();
+
+            const std::shared_ptr<PackedTexturesPool> pool;
+
+            float getOccupancy() const;
+
+        friend OsmAnd::GPUAPI::PackedTexturesPool;
+        friend OsmAnd::GPUAPI::SlotOnPackedTextureInGPU;
+        };
+
+        // Sub-rectangle of packed texture page. Width, height and texel sizes are those of slot,
+        // texture coordinates of slot are mapped to page by offset and scale.
+        class SlotOnPackedTextureInGPU : public TextureInGPU
+        {
+            Q_DISABLE_COPY_AND_MOVE(SlotOnPackedTextureInGPU);
+        private:
+        protected:
+        public:
+            SlotOnPackedTextureInGPU(
+                const std::shared_ptr<PackedTextureInGPU>& packedTexture,
+                const AreaI& area,
+                const AlphaChannelType alphaChannelType);
+            virtual ~SlotOnPackedTextureInGPU();
+
+            const std::shared_ptr<PackedTextureInGPU> packedTexture;
+            const AreaI area;
+            const PointF texCoordsOffsetN;
+            const PointF texCoordsScaleN;
+
+            virtual void lostRefInGPU() const;
+        };
+
         class MeshInGPU : public MetaResourceInGPU
         {
             Q_DISABLE_COPY_AND_MOVE(MeshInGPU);
@@ -273,6 +365,7 @@ namespace OsmAnd
 #endif
 
         QHash< AtlasTypeId, std::shared_ptr<AtlasTexturesPool> > _atlasTexturesPools;
+        QHash< TextureFormat, std::shared_ptr<PackedTexturesPool> > _packedTexturesPools;
     protected:
         GPUAPI();
 
@@ -282,6 +375,17 @@ namespace OsmAnd
             const std::shared_ptr<AtlasTexturesPool>& pool,
             AtlasTexturesPool::AtlasTextureAllocator atlasTextureAllocator);
 
+        std::shared_ptr<PackedTexturesPool> obtainPackedTexturesPool(
+            const TextureFormat format,
+            const unsigned int pageSize,
+            const unsigned int padding);
+        std::shared_ptr<SlotOnPackedTextureInGPU> allocateSlotInPackedTexture(
+            const unsigned int width,
+            const unsigned int height,
+            const AlphaChannelType alphaChannelType,
+            const std::shared_ptr<PackedTexturesPool>& pool,
+            PackedTexturesPool::PackedTextureAllocator packedTextureAllocator);
+
         virtual bool releaseResourceInGPU(const ResourceInGPU::Type type, const RefInGPU& refInGPU) = 0;
 
         bool _isSupported_8bitPaletteRGBA8;
@@ -303,6 +407,7 @@ namespace OsmAnd
         virtual void waitUntilUploadIsComplete() = 0;
 
         virtual AlphaChannelType getGpuResourceAlphaChannelType(const std::shared_ptr<const ResourceInGPU> gpuResource);
+        virtual size_t getGpuResourceSize(const std::shared_ptr<const ResourceInGPU>& gpuResource);
 
     friend OsmAnd::GPUAPI::ResourceInGPU;
     };
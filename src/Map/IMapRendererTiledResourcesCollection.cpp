@@ -1,5 +1,7 @@
 #include "IMapRendererTiledResourcesCollection.h"
 
+#include "Utilities.h"
+
 OsmAnd::IMapRendererTiledResourcesCollection::IMapRendererTiledResourcesCollection()
 {
 }
@@ -7,3 +9,30 @@ OsmAnd::IMapRendererTiledResourcesCollection::IMapRendererTiledResourcesCollecti
 OsmAnd::IMapRendererTiledResourcesCollection::~IMapRendererTiledResourcesCollection()
 {
 }
+
+bool OsmAnd::IMapRendererTiledResourcesCollection::obtainAncestorResource(
+    const TileId tileId,
+    const ZoomLevel zoomLevel,
+    const int maxZoomShift,
+    std::shared_ptr<MapRendererBaseTiledResource>& outResource,
+    const TiledResourceAcceptorCallback filter /*= nullptr*/) const
+{
+    for (int absZoomShift = 1; absZoomShift <= maxZoomShift; absZoomShift++)
+    {
+        const auto ancestorZoom = static_cast<int>(zoomLevel) - absZoomShift;
+        if (ancestorZoom < static_cast<int>(MinZoomLevel))
+            break;
+
+        const auto ancestorTileId = Utilities::getTileIdOverscaledByZoomShift(tileId, -absZoomShift);
+        std::shared_ptr<MapRendererBaseTiledResource> resource;
+        if (!obtainResource(ancestorTileId, static_cast<ZoomLevel>(ancestorZoom), resource))
+            continue;
+        if (filter && !filter(resource))
+            continue;
+
+        outResource = resource;
+        return true;
+    }
+
+    return false;
+}
@@ -33,6 +33,15 @@ namespace OsmAnd
             const TileId tileId,
             const ZoomLevel zoomLevel,
             const TiledResourceAcceptorCallback filter = nullptr) const = 0;
+
+        // Finds nearest ancestor of given tile (that covers it entirely) accepted by filter, which can be used
+        // as placeholder while tile itself is not ready. Ancestors up to maxZoomShift levels above are checked
+        bool obtainAncestorResource(
+            const TileId tileId,
+            const ZoomLevel zoomLevel,
+            const int maxZoomShift,
+            std::shared_ptr<MapRendererBaseTiledResource>& outResource,
+            const TiledResourceAcceptorCallback filter = nullptr) const;
     };
 }
 
@@ -3,8 +3,10 @@
 
 OsmAnd::MapRasterLayerProvider_Software::MapRasterLayerProvider_Software(
     const std::shared_ptr<MapPrimitivesProvider>& primitivesProvider_,
-    const bool fillBackground_ /*= true*/)
+    const bool fillBackground_ /*= true*/,
+    const unsigned int rasterizationBandsCount_ /*= 1*/)
     : MapRasterLayerProvider(new MapRasterLayerProvider_Software_P(this), primitivesProvider_, fillBackground_)
+    , rasterizationBandsCount(rasterizationBandsCount_)
 {
 }
 
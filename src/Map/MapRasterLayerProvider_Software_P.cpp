@@ -6,6 +6,10 @@
 #   define OSMAND_PERFORMANCE_METRICS 0
 #endif // !defined(OSMAND_PERFORMANCE_METRICS)
 
+#include "QtCommon.h"
+#include <QMutex>
+#include <QWaitCondition>
+
 #include "ignore_warnings_on_external_includes.h"
 #include <SkStream.h>
 #include <SkBitmap.h>
@@ -20,18 +24,21 @@
 #include "ObfDataInterface.h"
 #include "MapRasterizer.h"
 #include "MapPresentationEnvironment.h"
+#include "QRunnableFunctor.h"
 #include "Stopwatch.h"
 #include "Utilities.h"
 #include "Logging.h"
 
 OsmAnd::MapRasterLayerProvider_Software_P::MapRasterLayerProvider_Software_P(MapRasterLayerProvider_Software* owner_)
     : MapRasterLayerProvider_P(owner_)
+    , _pixelBuffersPool(new PixelBuffersPool())
     , owner(owner_)
 {
 }
 
 OsmAnd::MapRasterLayerProvider_Software_P::~MapRasterLayerProvider_Software_P()
 {
+    REPEAT_UNTIL(_bandsThreadPool.waitForDone());
 }
 
 std::shared_ptr<SkBitmap> OsmAnd::MapRasterLayerProvider_Software_P::rasterize(
@@ -54,33 +61,41 @@ std::shared_ptr<SkBitmap> OsmAnd::MapRasterLayerProvider_Software_P::rasterize(
 #endif // OSMAND_PERFORMANCE_METRICS
         );
 
-    // Allocate rasterization target
+    // Obtain rasterization target
     const auto tileSize = owner->getTileSize();
-    const std::shared_ptr<SkBitmap> rasterizationSurface(new SkBitmap());
-    if (!rasterizationSurface->tryAllocPixels(SkImageInfo::MakeN32Premul(tileSize, tileSize)))
-    {
-        LogPrintf(LogSeverityLevel::Error,
-            "Failed to allocate buffer for rasterization surface %dx%d",
-            tileSize,
-            tileSize);
+    const auto rasterizationSurface = obtainPixelBuffer(SkImageInfo::MakeN32Premul(tileSize, tileSize));
+    if (!rasterizationSurface)
         return nullptr;
+
+    const auto bandsCount = getBandsCount(tileSize);
+    if (bandsCount > 1)
+    {
+        rasterizeBands(
+            request,
+            primitivesTile,
+            *rasterizationSurface,
+            bandsCount,
+            metric ? metric->findOrAddSubmetricOfType<MapRasterizer_Metrics::Metric_rasterize>().get() : nullptr);
+    }
+    else
+    {
+        SkBitmapDevice rasterizationTarget(*rasterizationSurface);
+
+        // Create rasterization canvas
+        SkCanvas canvas(&rasterizationTarget);
+
+        // Perform actual rasterization
+        if (!owner->fillBackground)
+            canvas.clear(SK_ColorTRANSPARENT);
+        _mapRasterizer->rasterize(
+            Utilities::tileBoundingBox31(request.tileId, request.zoom),
+            primitivesTile->primitivisedObjects,
+            canvas,
+            owner->fillBackground,
+            nullptr,
+            metric ? metric->findOrAddSubmetricOfType<MapRasterizer_Metrics::Metric_rasterize>().get() : nullptr,
+            request.queryController);
     }
-    SkBitmapDevice rasterizationTarget(*rasterizationSurface);
-
-    // Create rasterization canvas
-    SkCanvas canvas(&rasterizationTarget);
-
-    // Perform actual rasterization
-    if (!owner->fillBackground)
-        canvas.clear(SK_ColorTRANSPARENT);
-    _mapRasterizer->rasterize(
-        Utilities::tileBoundingBox31(request.tileId, request.zoom),
-        primitivesTile->primitivisedObjects,
-        canvas,
-        owner->fillBackground,
-        nullptr,
-        metric ? metric->findOrAddSubmetricOfType<MapRasterizer_Metrics::Metric_rasterize>().get() : nullptr,
-        request.queryController);
 
 #if OSMAND_PERFORMANCE_METRICS
 #if OSMAND_PERFORMANCE_METRICS <= 1
@@ -103,3 +118,189 @@ std::shared_ptr<SkBitmap> OsmAnd::MapRasterLayerProvider_Software_P::rasterize(
 
     return rasterizationSurface;
 }
+
+std::shared_ptr<SkBitmap> OsmAnd::MapRasterLayerProvider_Software_P::obtainPixelBuffer(const SkImageInfo& imageInfo)
+{
+    PixelBufferKind kind;
+    kind.width = imageInfo.width();
+    kind.height = imageInfo.height();
+    kind.colorType = imageInfo.colorType();
+
+    SkBitmap* bitmap = nullptr;
+    {
+        QMutexLocker scopedLocker(&_pixelBuffersPool->mutex);
+
+        const auto citBuffers = _pixelBuffersPool->buffers.find(kind);
+        if (citBuffers != _pixelBuffersPool->buffers.end() && !citBuffers->isEmpty())
+        {
+            bitmap = citBuffers->takeLast();
+            _pixelBuffersPool->pooledSizeInBytes -= bitmap->getSize();
+        }
+    }
+
+    if (!bitmap)
+    {
+        bitmap = new SkBitmap();
+        if (!bitmap->tryAllocPixels(imageInfo))
+        {
+            LogPrintf(LogSeverityLevel::Error,
+                "Failed to allocate buffer for rasterization surface %dx%d",
+                imageInfo.width(),
+                imageInfo.height());
+
+            delete bitmap;
+            return nullptr;
+        }
+    }
+
+    // Bitmap is consumed as-is by uploaders and encoders, and is returned to pool once last reference to it is gone
+    const std::weak_ptr<PixelBuffersPool> weakPixelBuffersPool(_pixelBuffersPool);
+    return std::shared_ptr<SkBitmap>(bitmap,
+        [weakPixelBuffersPool]
+        (SkBitmap* const pooledBitmap)
+        {
+            releasePixelBuffer(weakPixelBuffersPool, pooledBitmap);
+        });
+}
+
+void OsmAnd::MapRasterLayerProvider_Software_P::releasePixelBuffer(
+    const std::weak_ptr<PixelBuffersPool>& weakPixelBuffersPool,
+    SkBitmap* const bitmap)
+{
+    // Pixels can be reused only if no other SkBitmap shares them
+    const auto pixelBuffersPool = weakPixelBuffersPool.lock();
+    if (!pixelBuffersPool || !bitmap->pixelRef() || !bitmap->pixelRef()->unique())
+    {
+        delete bitmap;
+        return;
+    }
+
+    PixelBufferKind kind;
+    kind.width = bitmap->width();
+    kind.height = bitmap->height();
+    kind.colorType = bitmap->colorType();
+
+    {
+        QMutexLocker scopedLocker(&pixelBuffersPool->mutex);
+
+        if (pixelBuffersPool->pooledSizeInBytes + bitmap->getSize() <= PixelBuffersPool::MaxPooledSizeInBytes)
+        {
+            pixelBuffersPool->buffers[kind].push_back(bitmap);
+            pixelBuffersPool->pooledSizeInBytes += bitmap->getSize();
+            return;
+        }
+    }
+
+    delete bitmap;
+}
+
+OsmAnd::MapRasterLayerProvider_Software_P::PixelBuffersPool::PixelBuffersPool()
+    : pooledSizeInBytes(0)
+{
+}
+
+OsmAnd::MapRasterLayerProvider_Software_P::PixelBuffersPool::~PixelBuffersPool()
+{
+    for (const auto& buffers : constOf(this->buffers))
+        qDeleteAll(buffers);
+}
+
+unsigned int OsmAnd::MapRasterLayerProvider_Software_P::getBandsCount(const uint32_t tileSize) const
+{
+    const auto maxBandsCount = tileSize / MapRasterLayerProvider_Software::MinimalBandHeight;
+    return qMax(1u, qMin(owner->rasterizationBandsCount, maxBandsCount));
+}
+
+void OsmAnd::MapRasterLayerProvider_Software_P::rasterizeBands(
+    const MapRasterLayerProvider::Request& request,
+    const std::shared_ptr<const MapPrimitivesProvider::Data>& primitivesTile,
+    SkBitmap& rasterizationSurface,
+    const unsigned int bandsCount,
+    MapRasterizer_Metrics::Metric_rasterize* const metric)
+{
+    const Stopwatch totalStopwatch(metric != nullptr);
+
+    const auto tileSize = rasterizationSurface.width();
+    const auto bandHeight = (rasterizationSurface.height() + bandsCount - 1) / bandsCount;
+    const auto area31 = Utilities::tileBoundingBox31(request.tileId, request.zoom);
+
+    // All bands are rasterized in coordinates of entire tile and clipped by their own surface,
+    // so that primitives crossing bands borders are rasterized identically in each band
+    const AreaI tileArea(0, 0, rasterizationSurface.height(), tileSize);
+
+    // Each band reports to its own submetric, since metrics are not thread-safe
+    QVector< std::shared_ptr<MapRasterizer_Metrics::Metric_rasterize> > bandsMetrics(bandsCount);
+    if (metric)
+    {
+        for (auto& bandMetric : bandsMetrics)
+            bandMetric = metric->addSubmetricOfType<MapRasterizer_Metrics::Metric_rasterize>();
+    }
+
+    const auto rasterizeBand =
+        [this, &request, &primitivesTile, &rasterizationSurface, &bandsMetrics, tileSize, bandHeight, area31, tileArea]
+        (const unsigned int bandIndex)
+        {
+            const int bandTop = bandIndex * bandHeight;
+            const int bandBottom = qMin(bandTop + static_cast<int>(bandHeight), rasterizationSurface.height());
+            if (bandTop >= bandBottom)
+                return;
+
+            // Band surface shares pixels with entire tile surface
+            SkBitmap bandSurface;
+            if (!rasterizationSurface.extractSubset(&bandSurface, SkIRect::MakeLTRB(0, bandTop, tileSize, bandBottom)))
+            {
+                LogPrintf(LogSeverityLevel::Error,
+                    "Failed to extract band %d-%d from rasterization surface",
+                    bandTop,
+                    bandBottom);
+                return;
+            }
+            SkBitmapDevice bandTarget(bandSurface);
+
+            SkCanvas canvas(&bandTarget);
+            canvas.translate(0, -bandTop);
+
+            if (!owner->fillBackground)
+                canvas.clear(SK_ColorTRANSPARENT);
+            _mapRasterizer->rasterize(
+                area31,
+                primitivesTile->primitivisedObjects,
+                canvas,
+                owner->fillBackground,
+                &tileArea,
+                bandsMetrics[bandIndex].get(),
+                request.queryController);
+        };
+
+    // First band is rasterized by calling thread, rest are rasterized on bands pool
+    QMutex pendingBandsMutex;
+    QWaitCondition pendingBandsCondition;
+    auto pendingBandsCount = bandsCount - 1;
+    for (auto bandIndex = 1u; bandIndex < bandsCount; bandIndex++)
+    {
+        const QRunnableFunctor::Callback task =
+            [bandIndex, &rasterizeBand, &pendingBandsMutex, &pendingBandsCondition, &pendingBandsCount]
+            (const QRunnableFunctor* const runnable)
+            {
+                rasterizeBand(bandIndex);
+
+                QMutexLocker scopedLocker(&pendingBandsMutex);
+                if (--pendingBandsCount == 0)
+                    pendingBandsCondition.wakeAll();
+            };
+
+        const auto taskRunnable = new QRunnableFunctor(task);
+        taskRunnable->setAutoDelete(true);
+        _bandsThreadPool.start(taskRunnable);
+    }
+    rasterizeBand(0);
+
+    {
+        QMutexLocker scopedLocker(&pendingBandsMutex);
+        while (pendingBandsCount > 0)
+            pendingBandsCondition.wait(&pendingBandsMutex);
+    }
+
+    if (metric)
+        metric->elapsedTime += totalStopwatch.elapsed();
+}
@@ -6,12 +6,21 @@
 #include <array>
 
 #include "QtExtensions.h"
+#include <QThreadPool>
+#include <QMutex>
+#include <QHash>
+#include <QList>
+
+#include "ignore_warnings_on_external_includes.h"
+#include <SkImageInfo.h>
+#include "restore_internal_warnings.h"
 
 #include "OsmAndCore.h"
 #include "CommonTypes.h"
 #include "PrivateImplementation.h"
 #include "IRasterMapLayerProvider.h"
 #include "MapRasterLayerProvider_P.h"
+#include "MapRasterizer_Metrics.h"
 
 class SkBitmap;
 
@@ -28,6 +37,59 @@ namespace OsmAnd
             const MapRasterLayerProvider::Request& request,
             const std::shared_ptr<const MapPrimitivesProvider::Data>& primitivesTile,
             MapRasterLayerProvider_Metrics::Metric_obtainData* const metric);
+
+        struct PixelBufferKind
+        {
+            int width;
+            int height;
+            SkColorType colorType;
+
+            inline bool operator==(const PixelBufferKind& r) const
+            {
+                return width == r.width && height == r.height && colorType == r.colorType;
+            }
+
+            inline bool operator!=(const PixelBufferKind& r) const
+            {
+                return !(*this == r);
+            }
+
+            friend inline uint qHash(const PixelBufferKind& kind, uint seed = 0) Q_DECL_NOTHROW
+            {
+                return ::qHash((static_cast<quint64>(kind.width) << 32) | (static_cast<quint64>(kind.height) << 8) | kind.colorType, seed);
+            }
+        };
+
+        // Pixel buffers of released tiles are kept here to be rasterized into again.
+        // Pool outlives provider if some tiles are still in use.
+        struct PixelBuffersPool
+        {
+            PixelBuffersPool();
+            ~PixelBuffersPool();
+
+            enum {
+                MaxPooledSizeInBytes = 32 * 1024 * 1024,
+            };
+
+            QMutex mutex;
+            QHash< PixelBufferKind, QList<SkBitmap*> > buffers;
+            size_t pooledSizeInBytes;
+
+        private:
+            Q_DISABLE_COPY_AND_MOVE(PixelBuffersPool);
+        };
+        const std::shared_ptr<PixelBuffersPool> _pixelBuffersPool;
+        std::shared_ptr<SkBitmap> obtainPixelBuffer(const SkImageInfo& imageInfo);
+        static void releasePixelBuffer(const std::weak_ptr<PixelBuffersPool>& weakPixelBuffersPool, SkBitmap* const bitmap);
+
+        QThreadPool _bandsThreadPool;
+        unsigned int getBandsCount(const uint32_t tileSize) const;
+        void rasterizeBands(
+            const MapRasterLayerProvider::Request& request,
+            const std::shared_ptr<const MapPrimitivesProvider::Data>& primitivesTile,
+            SkBitmap& rasterizationSurface,
+            const unsigned int bandsCount,
+            MapRasterizer_Metrics::Metric_rasterize* const metric);
     public:
         virtual ~MapRasterLayerProvider_Software_P();
 
@@ -41,6 +41,13 @@ OsmAnd::MapRasterizer_P::~MapRasterizer_P()
         for (auto& pathEffect : _pathEffects)
             pathEffect->unref();
     }
+
+    {
+        QMutexLocker scopedLocker(&_bitmapShadersMutex);
+
+        for (auto& bitmapShader : _bitmapShaders)
+            bitmapShader->unref();
+    }
 }
 
 void OsmAnd::MapRasterizer_P::initialize()
@@ -102,10 +109,10 @@ void OsmAnd::MapRasterizer_P::rasterize(
     }
 
     // Rasterize layers of map:
-    rasterizeMapPrimitives(context, canvas, primitivisedObjects->polygons, PrimitivesType::Polygons, queryController);
+    rasterizeMapPrimitives(context, canvas, primitivisedObjects->polygons, PrimitivesType::Polygons, metric, queryController);
     if (context.shadowMode != MapPresentationEnvironment::ShadowMode::NoShadow)
-        rasterizeMapPrimitives(context, canvas, primitivisedObjects->polylines, PrimitivesType::Polylines_ShadowOnly, queryController);
-    rasterizeMapPrimitives(context, canvas, primitivisedObjects->polylines, PrimitivesType::Polylines, queryController);
+        rasterizeMapPrimitives(context, canvas, primitivisedObjects->polylines, PrimitivesType::Polylines_ShadowOnly, metric, queryController);
+    rasterizeMapPrimitives(context, canvas, primitivisedObjects->polylines, PrimitivesType::Polylines, metric, queryController);
 
     if (metric)
         metric->elapsedTime += totalStopwatch.elapsed();
@@ -116,10 +123,12 @@ void OsmAnd::MapRasterizer_P::rasterizeMapPrimitives(
     SkCanvas& canvas,
     const MapPrimitiviser::PrimitivesCollection& primitives,
     PrimitivesType type,
+    MapRasterizer_Metrics::Metric_rasterize* const metric,
     const std::shared_ptr<const IQueryController>& queryController)
 {
     assert(type != PrimitivesType::Points);
 
+    PrimitivesBatch batch;
     for (const auto& primitive : constOf(primitives))
     {
         if (queryController && queryController->isAborted())
@@ -130,7 +139,8 @@ void OsmAnd::MapRasterizer_P::rasterizeMapPrimitives(
             rasterizePolygon(
                 context,
                 canvas,
-                primitive);
+                primitive,
+                batch);
         }
         else if (type == PrimitivesType::Polylines || type == PrimitivesType::Polylines_ShadowOnly)
         {
@@ -138,17 +148,26 @@ void OsmAnd::MapRasterizer_P::rasterizeMapPrimitives(
                 context,
                 canvas,
                 primitive,
-                (type == PrimitivesType::Polylines_ShadowOnly));
+                (type == PrimitivesType::Polylines_ShadowOnly),
+                batch);
         }
     }
+    flushBatch(canvas, batch);
+
+    if (metric)
+    {
+        metric->drawCalls += batch.drawCalls;
+        metric->drawnPrimitives += batch.drawnPrimitives;
+        metric->batchedPrimitives += batch.batchedPrimitives;
+    }
 }
 
-bool OsmAnd::MapRasterizer_P::updatePaint(
+bool OsmAnd::MapRasterizer_P::resolvePaint(
     const Context& context,
-    SkPaint& paint,
     const MapStyleEvaluationResult& evalResult,
     const PaintValuesSet valueSetSelector,
-    const bool isArea)
+    const bool isArea,
+    PaintParameters& outPaintParameters) const
 {
     const auto& env = context.env;
 
@@ -212,16 +231,14 @@ bool OsmAnd::MapRasterizer_P::updatePaint(
             return false;
     }
 
+    PaintParameters paintParameters;
     if (isArea)
     {
         if (!evalResult.contains(valueDefId_color) && !evalResult.contains(env->styleBuiltinValueDefs->id_OUTPUT_SHADER))
             return false;
 
-        paint.setColorFilter(nullptr);
-        paint.setShader(nullptr);
-        paint.setLooper(nullptr);
-        paint.setStyle(SkPaint::kStrokeAndFill_Style);
-        paint.setStrokeWidth(0);
+        paintParameters.style = SkPaint::kStrokeAndFill_Style;
+        paintParameters.strokeWidth = 0.0f;
     }
     else
     {
@@ -230,42 +247,35 @@ bool OsmAnd::MapRasterizer_P::updatePaint(
         if (!ok || stroke <= 0.0f)
             return false;
 
-        paint.setColorFilter(nullptr);
-        paint.setShader(nullptr);
-        paint.setLooper(nullptr);
-        paint.setStyle(SkPaint::kStroke_Style);
-        paint.setStrokeWidth(stroke);
+        paintParameters.style = SkPaint::kStroke_Style;
+        paintParameters.strokeWidth = stroke;
 
         QString cap;
         ok = evalResult.getStringValue(valueDefId_cap, cap);
         if (!ok || cap.isEmpty() || cap.compare(QLatin1String("BUTT"), Qt::CaseInsensitive) == 0)
-            paint.setStrokeCap(SkPaint::kButt_Cap);
+            paintParameters.strokeCap = SkPaint::kButt_Cap;
         else if (cap.compare(QLatin1String("ROUND"), Qt::CaseInsensitive) == 0)
-            paint.setStrokeCap(SkPaint::kRound_Cap);
+            paintParameters.strokeCap = SkPaint::kRound_Cap;
         else if (cap.compare(QLatin1String("SQUARE"), Qt::CaseInsensitive) == 0)
-            paint.setStrokeCap(SkPaint::kSquare_Cap);
+            paintParameters.strokeCap = SkPaint::kSquare_Cap;
         else
-            paint.setStrokeCap(SkPaint::kButt_Cap);
+            paintParameters.strokeCap = SkPaint::kButt_Cap;
 
         QString encodedPathEffect;
         ok = evalResult.getStringValue(valueDefId_pathEffect, encodedPathEffect);
-        if (!ok || encodedPathEffect.isEmpty())
-        {
-            paint.setPathEffect(nullptr);
-        }
-        else
+        if (ok && !encodedPathEffect.isEmpty())
         {
             SkPathEffect* pathEffect = nullptr;
             ok = obtainPathEffect(encodedPathEffect, pathEffect);
 
             if (ok && pathEffect)
-                paint.setPathEffect(pathEffect);
+                paintParameters.pathEffect = pathEffect;
         }
     }
 
     SkColor color = SK_ColorTRANSPARENT;
     evalResult.getIntegerValue(valueDefId_color, color);
-    paint.setColor(color);
+    paintParameters.color = color;
 
     if (valueSetSelector == PaintValuesSet::Layer_1)
     {
@@ -273,14 +283,14 @@ bool OsmAnd::MapRasterizer_P::updatePaint(
         ok = evalResult.getStringValue(env->styleBuiltinValueDefs->id_OUTPUT_SHADER, shader);
         if (ok && !shader.isEmpty())
         {
-            SkBitmapProcShader* shaderObj = nullptr;
+            SkShader* shaderObj = nullptr;
             if (obtainBitmapShader(env, shader, shaderObj) && shaderObj)
             {
                 // SKIA requires non-transparent color
-                if (paint.getColor() == SK_ColorTRANSPARENT)
-                    paint.setColor(SK_ColorWHITE);
+                if (paintParameters.color == SK_ColorTRANSPARENT)
+                    paintParameters.color = SK_ColorWHITE;
 
-                paint.setShader(static_cast<SkShader*>(shaderObj))->unref();
+                paintParameters.shader = shaderObj;
             }
         }
     }
@@ -298,21 +308,62 @@ bool OsmAnd::MapRasterizer_P::updatePaint(
 
         if (shadowRadius > 0.0f && !shadowColor.isTransparent())
         {
-            paint.setLooper(SkBlurDrawLooper::Create(
-                shadowColor.toSkColor(),
-                SkBlurMaskFilter::ConvertRadiusToSigma(shadowRadius),
-                0,
-                0))->unref();
+            paintParameters.shadowColor = shadowColor;
+            paintParameters.shadowRadius = shadowRadius;
         }
     }
 
+    outPaintParameters = paintParameters;
+    return true;
+}
+
+void OsmAnd::MapRasterizer_P::applyPaint(
+    SkPaint& paint,
+    const PaintParameters& paintParameters)
+{
+    paint.setColorFilter(nullptr);
+    paint.setStyle(paintParameters.style);
+    paint.setStrokeWidth(paintParameters.strokeWidth);
+    if (paintParameters.style != SkPaint::kStrokeAndFill_Style)
+    {
+        paint.setStrokeCap(paintParameters.strokeCap);
+        paint.setPathEffect(paintParameters.pathEffect);
+    }
+    paint.setColor(paintParameters.color);
+    paint.setShader(paintParameters.shader);
+
+    if (paintParameters.shadowRadius > 0.0f)
+    {
+        paint.setLooper(SkBlurDrawLooper::Create(
+            paintParameters.shadowColor.toSkColor(),
+            SkBlurMaskFilter::ConvertRadiusToSigma(paintParameters.shadowRadius),
+            0,
+            0))->unref();
+    }
+    else
+        paint.setLooper(nullptr);
+}
+
+bool OsmAnd::MapRasterizer_P::updatePaint(
+    const Context& context,
+    SkPaint& paint,
+    const MapStyleEvaluationResult& evalResult,
+    const PaintValuesSet valueSetSelector,
+    const bool isArea) const
+{
+    PaintParameters paintParameters;
+    if (!resolvePaint(context, evalResult, valueSetSelector, isArea, paintParameters))
+        return false;
+
+    applyPaint(paint, paintParameters);
     return true;
 }
 
 void OsmAnd::MapRasterizer_P::rasterizePolygon(
     const Context& context,
     SkCanvas& canvas,
-    const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive)
+    const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive,
+    PrimitivesBatch& batch)
 {
     const auto& points31 = primitive->sourceObject->points31;
     const auto& area31 = context.area31;
@@ -328,15 +379,19 @@ void OsmAnd::MapRasterizer_P::rasterizePolygon(
     //}
     //////////////////////////////////////////////////////////////////////////
 
-    SkPaint paint = _defaultPaint;
-    if (!updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_1, true))
+    PaintParameters fillPaint;
+    if (!resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_1, true, fillPaint))
         return;
 
     // Construct and test geometry against bbox area
-    SkPath path;
+    auto& path = batch.primitivePath;
+    path.rewind();
     bool containsAtLeastOnePoint = false;
     int pointIdx = 0;
     PointF vertex;
+    PointF firstVertex;
+    PointF prevVertex;
+    auto doubledSignedArea = 0.0;
     Utilities::CHValue prevChValue;
     QVector< PointI > outerPoints;
     const auto pointsCount = points31.size();
@@ -367,10 +422,20 @@ void OsmAnd::MapRasterizer_P::rasterizePolygon(
 
         // Plot vertex
         if (pointIdx == 0)
+        {
             path.moveTo(vertex.x, vertex.y);
+            firstVertex = vertex;
+        }
         else
+        {
             path.lineTo(vertex.x, vertex.y);
+            doubledSignedArea +=
+                static_cast<double>(prevVertex.x) * vertex.y - static_cast<double>(vertex.x) * prevVertex.y;
+        }
+        prevVertex = vertex;
     }
+    doubledSignedArea +=
+        static_cast<double>(prevVertex.x) * firstVertex.y - static_cast<double>(firstVertex.x) * prevVertex.y;
 
     //////////////////////////////////////////////////////////////////////////
     //if ((primitive->sourceObject->id >> 1) == 9223372032559801460u)
@@ -417,16 +482,32 @@ void OsmAnd::MapRasterizer_P::rasterizePolygon(
         }
     }
 
-    canvas.drawPath(path, paint);
-    if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_2, false))
-        canvas.drawPath(path, paint);
+    auto& paints = batch.primitivePaints;
+    paints.clear();
+    paints.push_back(fillPaint);
+
+    // Polygons with holes or outline can not be merged with others, since holes would be cut
+    // from other polygons and outline of each polygon is drawn over previous ones
+    PaintParameters outlinePaint;
+    const auto hasOutline = resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_2, false, outlinePaint);
+    if (hasOutline)
+        paints.push_back(outlinePaint);
+    const auto canBeBatched =
+        !hasOutline &&
+        path.getFillType() == SkPath::kWinding_FillType &&
+        fillPaint.canBeBatched();
+
+    // Merged polygons are filled by non-zero winding, so overlapping rings of opposite orientation would cancel
+    // each other out. All rings are appended in same orientation to keep overlaps filled.
+    appendToBatch(canvas, batch, canBeBatched, canBeBatched && doubledSignedArea < 0.0);
 }
 
 void OsmAnd::MapRasterizer_P::rasterizePolyline(
     const Context& context,
     SkCanvas& canvas,
     const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive,
-    bool drawOnlyShadow)
+    bool drawOnlyShadow,
+    PrimitivesBatch& batch)
 {
     const auto& points31 = primitive->sourceObject->points31;
     const auto& area31 = context.area31;
@@ -434,8 +515,8 @@ void OsmAnd::MapRasterizer_P::rasterizePolyline(
 
     assert(points31.size() >= 2);
 
-    SkPaint paint = _defaultPaint;
-    if (!updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_1, false))
+    PaintParameters mainPaint;
+    if (!resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_1, false, mainPaint))
         return;
 
     bool ok;
@@ -450,7 +531,8 @@ void OsmAnd::MapRasterizer_P::rasterizePolyline(
     if (drawOnlyShadow && (!ok || shadowRadius <= 0.0f))
         return;
 
-    SkPath path;
+    auto& path = batch.primitivePath;
+    path.rewind();
     int pointIdx = 0;
     bool intersect = false;
     int prevCross = 0;
@@ -492,6 +574,9 @@ void OsmAnd::MapRasterizer_P::rasterizePolyline(
 
     if (drawOnlyShadow)
     {
+        SkPaint paint = _defaultPaint;
+        applyPaint(paint, mainPaint);
+
         rasterizePolylineShadow(
             context,
             canvas,
@@ -499,37 +584,97 @@ void OsmAnd::MapRasterizer_P::rasterizePolyline(
             paint,
             shadowColor,
             shadowRadius);
+        batch.drawCalls++;
+        batch.drawnPrimitives++;
     }
     else
     {
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_minus2, false))
-            canvas.drawPath(path, paint);
-
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_minus1, false))
-            canvas.drawPath(path, paint);
-
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_0, false))
-            canvas.drawPath(path, paint);
+        auto& paints = batch.primitivePaints;
+        paints.clear();
+
+        PaintParameters layerPaint;
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_minus2, false, layerPaint))
+            paints.push_back(layerPaint);
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_minus1, false, layerPaint))
+            paints.push_back(layerPaint);
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_0, false, layerPaint))
+            paints.push_back(layerPaint);
+        const auto hasLowerLayers = !paints.isEmpty();
+        paints.push_back(mainPaint);
+        paints.push_back(mainPaint);
+        const auto paintsCountWithoutUpperLayers = paints.size();
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_2, false, layerPaint))
+            paints.push_back(layerPaint);
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_3, false, layerPaint))
+            paints.push_back(layerPaint);
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_4, false, layerPaint))
+            paints.push_back(layerPaint);
+        if (resolvePaint(context, primitive->evaluationResult, PaintValuesSet::Layer_5, false, layerPaint))
+            paints.push_back(layerPaint);
+
+        // Polylines with icons are never merged, since icons have to be placed along each path. Neither are
+        // polylines with several layers, since then casing of each of them would be drawn over other ones.
+        QString pathIconName;
+        const auto hasPathIcons =
+            primitive->evaluationResult.getStringValue(env->styleBuiltinValueDefs->id_OUTPUT_PATH_ICON, pathIconName) &&
+            !pathIconName.isEmpty();
+        const auto hasSeveralLayers = hasLowerLayers || paints.size() > paintsCountWithoutUpperLayers;
+        auto canBeBatched = !hasPathIcons && !hasSeveralLayers;
+        for (const auto& paint : constOf(paints))
+            canBeBatched = canBeBatched && paint.canBeBatched();
+
+        appendToBatch(canvas, batch, canBeBatched);
+
+        if (hasPathIcons)
+            rasterizePolylineIcons(context, canvas, path, primitive->evaluationResult);
+    }
+}
 
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_1, false))
-            canvas.drawPath(path, paint);
+void OsmAnd::MapRasterizer_P::appendToBatch(
+    SkCanvas& canvas,
+    PrimitivesBatch& batch,
+    const bool canBeBatched,
+    const bool reversePrimitive /*= false*/)
+{
+    if (batch.primitivesCount > 0 && (!canBeBatched || batch.paints != batch.primitivePaints))
+        flushBatch(canvas, batch);
 
-        canvas.drawPath(path, paint);
+    if (batch.primitivesCount == 0)
+    {
+        batch.paints = batch.primitivePaints;
+        batch.path.rewind();
+        batch.path.setFillType(batch.primitivePath.getFillType());
+    }
+    else
+        batch.batchedPrimitives++;
 
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_2, false))
-            canvas.drawPath(path, paint);
+    if (reversePrimitive)
+        batch.path.reverseAddPath(batch.primitivePath);
+    else
+        batch.path.addPath(batch.primitivePath);
+    batch.primitivesCount++;
 
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_3, false))
-            canvas.drawPath(path, paint);
+    if (!canBeBatched)
+        flushBatch(canvas, batch);
+}
 
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_4, false))
-            canvas.drawPath(path, paint);
+void OsmAnd::MapRasterizer_P::flushBatch(
+    SkCanvas& canvas,
+    PrimitivesBatch& batch)
+{
+    if (batch.primitivesCount == 0)
+        return;
 
-        if (updatePaint(context, paint, primitive->evaluationResult, PaintValuesSet::Layer_5, false))
-            canvas.drawPath(path, paint);
-            
-        rasterizePolylineIcons(context, canvas, path, primitive->evaluationResult);
+    SkPaint paint = _defaultPaint;
+    for (const auto& paintParameters : constOf(batch.paints))
+    {
+        applyPaint(paint, paintParameters);
+        canvas.drawPath(batch.path, paint);
     }
+
+    batch.drawCalls += batch.paints.size();
+    batch.drawnPrimitives += batch.primitivesCount;
+    batch.primitivesCount = 0;
 }
 
 void OsmAnd::MapRasterizer_P::rasterizePolylineShadow(
@@ -743,19 +888,28 @@ bool OsmAnd::MapRasterizer_P::obtainPathEffect(const QString& encodedPathEffect,
 bool OsmAnd::MapRasterizer_P::obtainBitmapShader(
     const std::shared_ptr<const MapPresentationEnvironment>& env,
     const QString& name,
-    SkBitmapProcShader* &outShader)
+    SkShader* &outShader) const
 {
-    std::shared_ptr<const SkBitmap> bitmap;
-    if (!env->obtainShaderBitmap(name, bitmap))
+    QMutexLocker scopedLocker(&_bitmapShadersMutex);
+
+    auto itBitmapShader = _bitmapShaders.constFind(name);
+    if (itBitmapShader == _bitmapShaders.cend())
     {
-        LogPrintf(LogSeverityLevel::Warning,
-            "Failed to get '%s' bitmap shader",
-            qPrintable(name));
+        std::shared_ptr<const SkBitmap> bitmap;
+        if (!env->obtainShaderBitmap(name, bitmap))
+        {
+            LogPrintf(LogSeverityLevel::Warning,
+                "Failed to get '%s' bitmap shader",
+                qPrintable(name));
 
-        return false;
+            return false;
+        }
+
+        const auto bitmapShader = new SkBitmapProcShader(*bitmap, SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode);
+        itBitmapShader = _bitmapShaders.insert(name, bitmapShader);
     }
 
-    outShader = new SkBitmapProcShader(*bitmap, SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode);
+    outShader = *itBitmapShader;
     return true;
 }
 
@@ -771,3 +925,32 @@ OsmAnd::MapRasterizer_P::Context::Context(
 {
     env->obtainShadowOptions(zoom, shadowMode, shadowColor);
 }
+
+OsmAnd::MapRasterizer_P::PaintParameters::PaintParameters()
+    : style(SkPaint::kFill_Style)
+    , color(SK_ColorTRANSPARENT)
+    , strokeWidth(0.0f)
+    , strokeCap(SkPaint::kButt_Cap)
+    , pathEffect(nullptr)
+    , shader(nullptr)
+    , shadowColor(0x00000000)
+    , shadowRadius(0.0f)
+{
+}
+
+bool OsmAnd::MapRasterizer_P::PaintParameters::canBeBatched() const
+{
+    // Merged paths are drawn once, so overlapping parts would look different unless paint is opaque
+    return
+        SkColorGetA(color) == 0xFF &&
+        shader == nullptr &&
+        shadowRadius <= 0.0f;
+}
+
+OsmAnd::MapRasterizer_P::PrimitivesBatch::PrimitivesBatch()
+    : primitivesCount(0)
+    , drawCalls(0)
+    , drawnPrimitives(0)
+    , batchedPrimitives(0)
+{
+}
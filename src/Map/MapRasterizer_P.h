@@ -75,30 +75,109 @@ namespace OsmAnd
             Layer_5,
         };
 
+        // Resolved state of SkPaint. Path effects and shaders are interned by rasterizer,
+        // so comparing pointers is enough to tell if two paints are identical
+        struct PaintParameters
+        {
+            PaintParameters();
+
+            SkPaint::Style style;
+            SkColor color;
+            float strokeWidth;
+            SkPaint::Cap strokeCap;
+            SkPathEffect* pathEffect;
+            SkShader* shader;
+            ColorARGB shadowColor;
+            float shadowRadius;
+
+            bool canBeBatched() const;
+
+            inline bool operator==(const PaintParameters& r) const
+            {
+                return
+                    style == r.style &&
+                    color == r.color &&
+                    qFuzzyCompare(strokeWidth, r.strokeWidth) &&
+                    strokeCap == r.strokeCap &&
+                    pathEffect == r.pathEffect &&
+                    shader == r.shader &&
+                    shadowColor == r.shadowColor &&
+                    qFuzzyCompare(shadowRadius, r.shadowRadius);
+            }
+
+            inline bool operator!=(const PaintParameters& r) const
+            {
+                return !(*this == r);
+            }
+        };
+
+        // Consecutive primitives that resolve to identical paints are merged into single path,
+        // that is drawn once per paint. Paths are reused during entire rasterization.
+        struct PrimitivesBatch
+        {
+            PrimitivesBatch();
+
+            QVector<PaintParameters> paints;
+            SkPath path;
+            unsigned int primitivesCount;
+
+            QVector<PaintParameters> primitivePaints;
+            SkPath primitivePath;
+
+            unsigned int drawCalls;
+            unsigned int drawnPrimitives;
+            unsigned int batchedPrimitives;
+
+        private:
+            Q_DISABLE_COPY_AND_MOVE(PrimitivesBatch);
+        };
+
+        bool resolvePaint(
+            const Context& context,
+            const MapStyleEvaluationResult& evalResult,
+            const PaintValuesSet valueSetSelector,
+            const bool isArea,
+            PaintParameters& outPaintParameters) const;
+        static void applyPaint(
+            SkPaint& paint,
+            const PaintParameters& paintParameters);
         bool updatePaint(
             const Context& context,
             SkPaint& paint,
             const MapStyleEvaluationResult& evalResult,
             const PaintValuesSet valueSetSelector,
-            const bool isArea);
+            const bool isArea) const;
 
         void rasterizeMapPrimitives(
             const Context& context,
             SkCanvas& canvas,
             const MapPrimitiviser::PrimitivesCollection& primitives,
             const PrimitivesType type,
+            MapRasterizer_Metrics::Metric_rasterize* const metric,
             const std::shared_ptr<const IQueryController>& queryController);
 
         void rasterizePolygon(
             const Context& context,
             SkCanvas& canvas,
-            const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive);
+            const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive,
+            PrimitivesBatch& batch);
 
         void rasterizePolyline(
             const Context& context,
             SkCanvas& canvas,
             const std::shared_ptr<const MapPrimitiviser::Primitive>& primitive,
-            bool drawOnlyShadow);
+            bool drawOnlyShadow,
+            PrimitivesBatch& batch);
+
+        void appendToBatch(
+            SkCanvas& canvas,
+            PrimitivesBatch& batch,
+            const bool canBeBatched,
+            const bool reversePrimitive = false);
+
+        void flushBatch(
+            SkCanvas& canvas,
+            PrimitivesBatch& batch);
 
         void rasterizePolylineShadow(
             const Context& context,
@@ -126,7 +205,10 @@ namespace OsmAnd
         mutable QMutex _pathEffectsMutex;
         mutable QHash< QString, SkPathEffect* > _pathEffects;
         bool obtainPathEffect(const QString& encodedPathEffect, SkPathEffect* &outPathEffect) const;
-        bool obtainBitmapShader(const std::shared_ptr<const MapPresentationEnvironment>& env, const QString& name, SkBitmapProcShader* &outShader);
+
+        mutable QMutex _bitmapShadersMutex;
+        mutable QHash< QString, SkShader* > _bitmapShaders;
+        bool obtainBitmapShader(const std::shared_ptr<const MapPresentationEnvironment>& env, const QString& name, SkShader* &outShader) const;
     public:
         ~MapRasterizer_P();
 
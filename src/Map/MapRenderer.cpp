@@ -40,6 +40,7 @@ OsmAnd::MapRenderer::MapRenderer(
     , _currentConfiguration(baseConfiguration_->createCopy())
     , _currentConfigurationAsConst(_currentConfiguration)
     , _requestedConfiguration(baseConfiguration_->createCopy())
+    , _publishedMapSymbolsVersion(0)
     , _suspendSymbolsUpdateCounter(0)
     , _gpuWorkerThreadId(nullptr)
     , _gpuWorkerThreadIsAlive(false)
@@ -48,11 +49,13 @@ OsmAnd::MapRenderer::MapRenderer(
     , _currentDebugSettings(baseDebugSettings_->createCopy())
     , _currentDebugSettingsAsConst(_currentDebugSettings)
     , _requestedDebugSettings(baseDebugSettings_->createCopy())
+    , _frameTelemetry(new MapRendererFrameTelemetry())
     , setupOptions(_setupOptions)
     , currentConfiguration(_currentConfigurationAsConst)
     , currentState(_currentState)
     , publishedMapSymbolsByOrderLock(_publishedMapSymbolsByOrderLock)
     , publishedMapSymbolsByOrder(_publishedMapSymbolsByOrder)
+    , publishedMapSymbolsVersion(_publishedMapSymbolsVersion)
     , currentDebugSettings(_currentDebugSettingsAsConst)
     , gpuAPI(gpuAPI_)
 {
@@ -255,7 +258,7 @@ void OsmAnd::MapRenderer::processGpuWorker()
             const auto requestsToProcess = _resourcesGpuSyncRequestsCounter.fetchAndAddOrdered(0);
             unsigned int resourcesUploaded = 0u;
             unsigned int resourcesUnloaded = 0u;
-            _resources->syncResourcesInGPU(0, nullptr, &resourcesUploaded, &resourcesUnloaded);
+            _resources->syncResourcesInGPU(0.0f, 0u, nullptr, &resourcesUploaded, &resourcesUnloaded);
             if (resourcesUploaded > 0 || resourcesUnloaded > 0)
                 invalidateFrame();
             unprocessedRequests = _resourcesGpuSyncRequestsCounter.fetchAndAddOrdered(-requestsToProcess) - requestsToProcess;
@@ -263,12 +266,17 @@ void OsmAnd::MapRenderer::processGpuWorker()
     }
     else if (isInRenderThread())
     {
-        // To reduce FPS drop, upload not more than 1 resource per frame.
+        // To reduce FPS drop, upload only as much as fits into per-frame budget
         const auto requestsToProcess = _resourcesGpuSyncRequestsCounter.fetchAndAddOrdered(0);
         bool moreUploadThanLimitAvailable = false;
         unsigned int resourcesUploaded = 0u;
         unsigned int resourcesUnloaded = 0u;
-        _resources->syncResourcesInGPU(1u, &moreUploadThanLimitAvailable, &resourcesUploaded, &resourcesUnloaded);
+        _resources->syncResourcesInGPU(
+            currentConfiguration->resourcesUploadTimeBudget,
+            currentConfiguration->resourcesUploadBytesBudget,
+            &moreUploadThanLimitAvailable,
+            &resourcesUploaded,
+            &resourcesUnloaded);
         const auto unprocessedRequests =
             _resourcesGpuSyncRequestsCounter.fetchAndAddOrdered(-requestsToProcess) - requestsToProcess;
 
@@ -414,6 +422,17 @@ bool OsmAnd::MapRenderer::doUpdate(IMapRenderer_Metrics::Metric_update* const me
 
 bool OsmAnd::MapRenderer::postUpdate(IMapRenderer_Metrics::Metric_update* const metric)
 {
+    if (metric)
+    {
+        size_t cpuMemoryUsage = 0;
+        size_t gpuMemoryUsage = 0;
+        _resources->getResourcesMemoryUsage(cpuMemoryUsage, gpuMemoryUsage);
+        metric->resourcesCpuMemoryUsage = static_cast<unsigned int>(cpuMemoryUsage / 1024);
+        metric->resourcesGpuMemoryUsage = static_cast<unsigned int>(gpuMemoryUsage / 1024);
+        metric->resourcesEvictedByMemoryBudget = _resources->getResourcesEvictedByMemoryBudget(true);
+        metric->symbolResourcesSharedInGPU = _resources->getSymbolResourcesSharedInGPU(true);
+    }
+
     return true;
 }
 
@@ -542,14 +561,21 @@ bool OsmAnd::MapRenderer::renderFrame(IMapRenderer_Metrics::Metric_renderFrame*
 
     bool ok = true;
 
-    Stopwatch totalStopwatch(metric != nullptr);
+    const auto telemetryEnabled = _frameTelemetry->isEnabled();
+    if (telemetryEnabled)
+        _frameTelemetry->beginFrame();
+
+    Stopwatch totalStopwatch(metric != nullptr || telemetryEnabled);
 
     ok = ok && preRenderFrame(metric);
     ok = ok && doRenderFrame(metric);
     ok = ok && postRenderFrame(metric);
 
+    const auto elapsedTime = (metric != nullptr || telemetryEnabled) ? totalStopwatch.elapsed() : 0.0f;
     if (metric)
-        metric->elapsedTime = totalStopwatch.elapsed();
+        metric->elapsedTime = elapsedTime;
+    if (telemetryEnabled)
+        _frameTelemetry->endFrame(elapsedTime);
 
     return ok;
 }
@@ -782,11 +808,11 @@ bool OsmAnd::MapRenderer::adjustBitmapToConfiguration(
         (currentConfiguration->limitTextureColorDepthBy16bits && input->colorType() == SkColorType::kRGBA_8888_SkColorType);
     const bool canUsePaletteTextures = currentConfiguration->paletteTexturesAllowed && gpuAPI->isSupported_8bitPaletteRGBA8;
     const bool paletteTexture = (input->colorType() == SkColorType::kIndex_8_SkColorType);
-    const bool unsupportedFormat =
-        (canUsePaletteTextures ? !paletteTexture : paletteTexture) ||
-        (input->colorType() != SkColorType::kRGBA_8888_SkColorType) ||
-        (input->colorType() != SkColorType::kARGB_4444_SkColorType) ||
-        (input->colorType() != SkColorType::kRGB_565_SkColorType);
+    const bool unsupportedFormat = paletteTexture
+        ? !canUsePaletteTextures
+        : (input->colorType() != SkColorType::kRGBA_8888_SkColorType) &&
+            (input->colorType() != SkColorType::kARGB_4444_SkColorType) &&
+            (input->colorType() != SkColorType::kRGB_565_SkColorType);
     doConvert = doConvert || force16bit;
     doConvert = doConvert || unsupportedFormat;
 
@@ -895,6 +921,7 @@ void OsmAnd::MapRenderer::doPublishMapSymbol(
     symbolReferencedResources.insert(resource);
 
     _publishedMapSymbolsGroups[symbolGroup] += 1;
+    _publishedMapSymbolsVersion++;
 
 #if OSMAND_LOG_MAP_SYMBOLS_REGISTRATION_LIFECYCLE
     LogPrintf(LogSeverityLevel::Debug,
@@ -992,6 +1019,7 @@ void OsmAnd::MapRenderer::doUnpublishMapSymbol(
 #endif // OSMAND_LOG_MAP_SYMBOLS_REGISTRATION_LIFECYCLE
     if (groupRefsCounter == 0)
         _publishedMapSymbolsGroups.erase(itGroupRefsCounter);
+    _publishedMapSymbolsVersion++;
 
 #if OSMAND_LOG_MAP_SYMBOLS_REGISTRATION_LIFECYCLE
     LogPrintf(LogSeverityLevel::Debug,
@@ -1692,3 +1720,8 @@ void OsmAnd::MapRenderer::dumpResourcesInfo() const
 {
     getResources().dumpResourcesInfo();
 }
+
+std::shared_ptr<OsmAnd::MapRendererFrameTelemetry> OsmAnd::MapRenderer::getFrameTelemetry() const
+{
+    return _frameTelemetry;
+}
@@ -20,6 +20,7 @@
 #include "Thread.h"
 #include "Dispatcher.h"
 #include "IMapRenderer.h"
+#include "MapRendererFrameTelemetry.h"
 #include "GPUAPI.h"
 #include "IMapTiledDataProvider.h"
 #include "TiledEntriesCollection.h"
@@ -79,6 +80,7 @@ namespace OsmAnd
         PublishedMapSymbolsByOrder _publishedMapSymbolsByOrder;
         QHash< std::shared_ptr<const MapSymbolsGroup>, SmartPOD<unsigned int, 0> > _publishedMapSymbolsGroups;
         QAtomicInt _publishedMapSymbolsCount;
+        unsigned int _publishedMapSymbolsVersion;
         void doPublishMapSymbol(
             const std::shared_ptr<const MapSymbolsGroup>& symbolGroup,
             const std::shared_ptr<const MapSymbol>& symbol,
@@ -113,6 +115,9 @@ namespace OsmAnd
         std::shared_ptr<const MapRendererDebugSettings> _currentDebugSettingsAsConst;
         std::shared_ptr<MapRendererDebugSettings> _requestedDebugSettings;
         bool updateCurrentDebugSettings();
+
+        // Telemetry-related:
+        const std::shared_ptr<MapRendererFrameTelemetry> _frameTelemetry;
     protected:
         MapRenderer(
             GPUAPI* const gpuAPI,
@@ -174,6 +179,7 @@ namespace OsmAnd
         // Symbols-related:
         QReadWriteLock& publishedMapSymbolsByOrderLock;
         const PublishedMapSymbolsByOrder& publishedMapSymbolsByOrder;
+        const unsigned int& publishedMapSymbolsVersion;
         void publishMapSymbol(
             const std::shared_ptr<const MapSymbolsGroup>& symbolGroup,
             const std::shared_ptr<const MapSymbol>& symbol,
@@ -299,6 +305,9 @@ namespace OsmAnd
         virtual unsigned int getActiveResourceRequestsCount() const;
         virtual void dumpResourcesInfo() const;
 
+        // Telemetry-related:
+        virtual std::shared_ptr<MapRendererFrameTelemetry> getFrameTelemetry() const;
+
     friend struct OsmAnd::MapRendererInternalState;
     friend class OsmAnd::MapRendererStage;
     friend class OsmAnd::MapRendererResourcesManager;
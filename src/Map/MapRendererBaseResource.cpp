@@ -4,6 +4,9 @@ OsmAnd::MapRendererBaseResource::MapRendererBaseResource(
     MapRendererResourcesManager* const owner_,
     const MapRendererResourceType type_)
     : _isJunk(false)
+    , _cpuMemoryUsage(0)
+    , _gpuMemoryUsage(0)
+    , _lastUseEpoch(0)
     , resourcesManager(owner_)
     , type(type_)
     , isJunk(_isJunk)
@@ -19,6 +22,26 @@ void OsmAnd::MapRendererBaseResource::markAsJunk()
     _isJunk = true;
 }
 
+void OsmAnd::MapRendererBaseResource::setCpuMemoryUsage(const size_t bytes)
+{
+    _cpuMemoryUsage.storeRelease(static_cast<int>(bytes));
+}
+
+void OsmAnd::MapRendererBaseResource::setGpuMemoryUsage(const size_t bytes)
+{
+    _gpuMemoryUsage.storeRelease(static_cast<int>(bytes));
+}
+
+size_t OsmAnd::MapRendererBaseResource::getCpuMemoryUsage() const
+{
+    return static_cast<size_t>(_cpuMemoryUsage.loadAcquire());
+}
+
+size_t OsmAnd::MapRendererBaseResource::getGpuMemoryUsage() const
+{
+    return static_cast<size_t>(_gpuMemoryUsage.loadAcquire());
+}
+
 bool OsmAnd::MapRendererBaseResource::updatesPresent()
 {
     return false;
@@ -5,6 +5,7 @@
 #include <functional>
 
 #include "QtExtensions.h"
+#include <QAtomicInt>
 
 #include "OsmAndCore.h"
 #include "MapRendererResourceType.h"
@@ -25,6 +26,10 @@ namespace OsmAnd
 
     private:
         bool _isJunk;
+
+        QAtomicInt _cpuMemoryUsage;
+        QAtomicInt _gpuMemoryUsage;
+        unsigned int _lastUseEpoch;
     protected:
         MapRendererBaseResource(
             MapRendererResourcesManager* const owner,
@@ -36,6 +41,10 @@ namespace OsmAnd
 
         void markAsJunk();
 
+        // Resource reports how many bytes its data occupies, each time that data is obtained, uploaded or released
+        void setCpuMemoryUsage(const size_t bytes);
+        void setGpuMemoryUsage(const size_t bytes);
+
         virtual bool updatesPresent();
         virtual bool checkForUpdatesAndApply();
         
@@ -62,6 +71,9 @@ namespace OsmAnd
 
         const bool& isJunk;
 
+        size_t getCpuMemoryUsage() const;
+        size_t getGpuMemoryUsage() const;
+
         virtual MapRendererResourceState getState() const = 0;
         virtual void setState(const MapRendererResourceState newState) = 0;
         virtual bool setStateIf(const MapRendererResourceState testState, const MapRendererResourceState newState) = 0;
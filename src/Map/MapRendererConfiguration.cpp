@@ -4,6 +4,16 @@ OsmAnd::MapRendererConfiguration::MapRendererConfiguration()
     : texturesFilteringQuality(TextureFilteringQuality::Good)
     , limitTextureColorDepthBy16bits(false)
     , paletteTexturesAllowed(false)
+    , resourcesCpuMemoryBudget(0)
+    , resourcesGpuMemoryBudget(0)
+    , mapLayersCpuMemoryBudget(0)
+    , mapLayersGpuMemoryBudget(0)
+    , elevationDataCpuMemoryBudget(0)
+    , elevationDataGpuMemoryBudget(0)
+    , symbolsCpuMemoryBudget(0)
+    , symbolsGpuMemoryBudget(0)
+    , resourcesUploadTimeBudget(0.005f)
+    , resourcesUploadBytesBudget(0)
 {
 }
 
@@ -16,6 +26,16 @@ void OsmAnd::MapRendererConfiguration::copyTo(MapRendererConfiguration& other) c
     other.texturesFilteringQuality = texturesFilteringQuality;
     other.limitTextureColorDepthBy16bits = limitTextureColorDepthBy16bits;
     other.paletteTexturesAllowed = paletteTexturesAllowed;
+    other.resourcesCpuMemoryBudget = resourcesCpuMemoryBudget;
+    other.resourcesGpuMemoryBudget = resourcesGpuMemoryBudget;
+    other.mapLayersCpuMemoryBudget = mapLayersCpuMemoryBudget;
+    other.mapLayersGpuMemoryBudget = mapLayersGpuMemoryBudget;
+    other.elevationDataCpuMemoryBudget = elevationDataCpuMemoryBudget;
+    other.elevationDataGpuMemoryBudget = elevationDataGpuMemoryBudget;
+    other.symbolsCpuMemoryBudget = symbolsCpuMemoryBudget;
+    other.symbolsGpuMemoryBudget = symbolsGpuMemoryBudget;
+    other.resourcesUploadTimeBudget = resourcesUploadTimeBudget;
+    other.resourcesUploadBytesBudget = resourcesUploadBytesBudget;
 }
 
 std::shared_ptr<OsmAnd::MapRendererConfiguration> OsmAnd::MapRendererConfiguration::createCopy() const
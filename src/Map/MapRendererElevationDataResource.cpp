@@ -66,7 +66,10 @@ bool OsmAnd::MapRendererElevationDataResource::obtainData(
 
     // Store data
     if (dataAvailable)
+    {
         _sourceData = std::static_pointer_cast<IMapElevationDataProvider::Data>(tile);
+        setCpuMemoryUsage(_sourceData->rowLength * _sourceData->size);
+    }
 
     return true;
 }
@@ -107,7 +110,10 @@ void OsmAnd::MapRendererElevationDataResource::obtainDataAsync(
 
             // Store data
             if (dataAvailable)
+            {
                 _sourceData = std::static_pointer_cast<IMapElevationDataProvider::Data>(data);
+                setCpuMemoryUsage(_sourceData->rowLength * _sourceData->size);
+            }
 
             callback(requestSucceeded, dataAvailable);
         });
@@ -122,6 +128,8 @@ bool OsmAnd::MapRendererElevationDataResource::uploadToGPU()
     // Since content was uploaded to GPU, it's safe to release it keeping retainable data
     _retainableCacheMetadata = _sourceData->retainableCacheMetadata;
     _sourceData.reset();
+    setCpuMemoryUsage(0);
+    setGpuMemoryUsage(resourcesManager->getMemoryUsageInGPU(_resourceInGPU));
 
     return true;
 }
@@ -129,16 +137,19 @@ bool OsmAnd::MapRendererElevationDataResource::uploadToGPU()
 void OsmAnd::MapRendererElevationDataResource::unloadFromGPU()
 {
     _resourceInGPU.reset();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererElevationDataResource::lostDataInGPU()
 {
     _resourceInGPU->lostRefInGPU();
     _resourceInGPU.reset();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererElevationDataResource::releaseData()
 {
     _retainableCacheMetadata.reset();
     _sourceData.reset();
+    setCpuMemoryUsage(0);
 }
@@ -0,0 +1,266 @@
+#include "MapRendererFrameTelemetry.h"
+
+#include <cmath>
+
+#include "QtCommon.h"
+
+OsmAnd::MapRendererFrameTelemetry::MapRendererFrameTelemetry(const float targetFps /*= 60.0f*/)
+    : _currentWindowIndex(0)
+    , _totalFramesCount(0)
+    , _totalDroppedFrames(0)
+    , _enabled(1)
+    , _targetFrameInterval(0)
+    , _lastFrameStartValid(false)
+{
+    setTargetFps(targetFps);
+}
+
+OsmAnd::MapRendererFrameTelemetry::~MapRendererFrameTelemetry()
+{
+}
+
+bool OsmAnd::MapRendererFrameTelemetry::isEnabled() const
+{
+    return _enabled.loadAcquire() != 0;
+}
+
+void OsmAnd::MapRendererFrameTelemetry::setEnabled(const bool enabled)
+{
+    _enabled.storeRelease(enabled ? 1 : 0);
+}
+
+float OsmAnd::MapRendererFrameTelemetry::getTargetFps() const
+{
+    return 1000000.0f / _targetFrameInterval.loadAcquire();
+}
+
+void OsmAnd::MapRendererFrameTelemetry::setTargetFps(const float targetFps)
+{
+    _targetFrameInterval.storeRelease(qMax(1, qRound(1000000.0f / qMax(targetFps, 1.0f))));
+}
+
+void OsmAnd::MapRendererFrameTelemetry::beginFrame()
+{
+    const auto now = std::chrono::high_resolution_clock::now();
+    if (_lastFrameStartValid)
+    {
+        const auto interval = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - _lastFrameStart).count());
+        if (interval > 0 && interval <= MaxFrameInterval)
+        {
+            auto& window = _windows[_currentWindowIndex.loadAcquire()];
+            window.intervalsCount.fetchAndAddOrdered(1);
+            window.intervalsDuration.fetchAndAddOrdered(interval);
+        }
+    }
+    _lastFrameStart = now;
+    _lastFrameStartValid = true;
+}
+
+void OsmAnd::MapRendererFrameTelemetry::recordStage(const Stage stage, const float elapsedTime)
+{
+    const auto stageIndex = static_cast<unsigned int>(stage);
+    const auto duration = qMax(0, qRound(elapsedTime * 1000000.0f));
+    auto& window = _windows[_currentWindowIndex.loadAcquire()];
+
+    window.buckets[stageIndex][getBucketIndex(duration)].fetchAndAddOrdered(1);
+    window.samplesCount[stageIndex].fetchAndAddOrdered(1);
+    window.totalDuration[stageIndex].fetchAndAddOrdered(duration);
+    if (duration > window.maxDuration[stageIndex].loadAcquire())
+        window.maxDuration[stageIndex].storeRelease(duration);
+}
+
+void OsmAnd::MapRendererFrameTelemetry::endFrame(const float elapsedTime)
+{
+    recordStage(Stage::Frame, elapsedTime);
+
+    // Frame that took longer than target interval missed that many presentations
+    const auto targetFrameInterval = _targetFrameInterval.loadAcquire();
+    const auto duration = qMax(0, qRound(elapsedTime * 1000000.0f));
+    const auto droppedFrames = duration > targetFrameInterval ? (duration - 1) / targetFrameInterval : 0;
+
+    const auto windowIndex = _currentWindowIndex.loadAcquire();
+    auto& window = _windows[windowIndex];
+    if (droppedFrames > 0)
+    {
+        window.droppedFrames.fetchAndAddOrdered(droppedFrames);
+        _totalDroppedFrames.fetchAndAddOrdered(droppedFrames);
+    }
+    _totalFramesCount.fetchAndAddOrdered(1);
+
+    // Oldest window is cleared and becomes current one
+    if (window.framesCount.fetchAndAddOrdered(1) + 1 >= FramesPerWindow)
+    {
+        const auto nextWindowIndex = (windowIndex + 1) % WindowsCount;
+        resetWindow(_windows[nextWindowIndex]);
+        _currentWindowIndex.storeRelease(nextWindowIndex);
+    }
+}
+
+float OsmAnd::MapRendererFrameTelemetry::getCurrentFps() const
+{
+    int intervalsCount = 0;
+    int64_t intervalsDuration = 0;
+    for (const auto& window : constOf(_windows))
+    {
+        intervalsCount += window.intervalsCount.loadAcquire();
+        intervalsDuration += window.intervalsDuration.loadAcquire();
+    }
+    if (intervalsCount == 0 || intervalsDuration <= 0)
+        return 0.0f;
+
+    return static_cast<float>(1000000.0 * intervalsCount / intervalsDuration);
+}
+
+OsmAnd::MapRendererFrameTelemetry::Snapshot OsmAnd::MapRendererFrameTelemetry::getSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.targetFps = getTargetFps();
+    snapshot.fps = getCurrentFps();
+    snapshot.totalFramesCount = static_cast<unsigned int>(_totalFramesCount.loadAcquire());
+    snapshot.totalDroppedFrames = static_cast<unsigned int>(_totalDroppedFrames.loadAcquire());
+    for (const auto& window : constOf(_windows))
+    {
+        snapshot.framesCount += window.framesCount.loadAcquire();
+        snapshot.droppedFrames += window.droppedFrames.loadAcquire();
+    }
+
+    for (auto stageIndex = 0u; stageIndex < StagesCount; stageIndex++)
+    {
+        std::array<unsigned int, BucketsCount> buckets;
+        buckets.fill(0);
+        unsigned int samplesCount = 0;
+        int64_t totalDuration = 0;
+        int maxDuration = 0;
+        for (const auto& window : constOf(_windows))
+        {
+            for (auto bucketIndex = 0u; bucketIndex < BucketsCount; bucketIndex++)
+                buckets[bucketIndex] += window.buckets[stageIndex][bucketIndex].loadAcquire();
+            samplesCount += window.samplesCount[stageIndex].loadAcquire();
+            totalDuration += window.totalDuration[stageIndex].loadAcquire();
+            maxDuration = qMax(maxDuration, window.maxDuration[stageIndex].loadAcquire());
+        }
+
+        auto& stageSnapshot = snapshot.stages[stageIndex];
+        stageSnapshot.samplesCount = samplesCount;
+        if (samplesCount == 0)
+            continue;
+        stageSnapshot.mean = static_cast<float>(totalDuration / 1000000.0 / samplesCount);
+        stageSnapshot.max = maxDuration / 1000000.0f;
+
+        const auto percentile =
+            [&buckets, samplesCount, &stageSnapshot]
+            (const float fraction) -> float
+            {
+                const auto rank = qMax(1u, static_cast<unsigned int>(std::ceil(fraction * samplesCount)));
+                unsigned int accumulated = 0;
+                for (auto bucketIndex = 0u; bucketIndex < BucketsCount; bucketIndex++)
+                {
+                    accumulated += buckets[bucketIndex];
+                    if (accumulated >= rank)
+                        return qMin(getBucketDuration(bucketIndex), stageSnapshot.max);
+                }
+                return stageSnapshot.max;
+            };
+        stageSnapshot.p50 = percentile(0.50f);
+        stageSnapshot.p90 = percentile(0.90f);
+        stageSnapshot.p99 = percentile(0.99f);
+    }
+
+    return snapshot;
+}
+
+void OsmAnd::MapRendererFrameTelemetry::reset()
+{
+    for (auto& window : _windows)
+        resetWindow(window);
+    _totalFramesCount.storeRelease(0);
+    _totalDroppedFrames.storeRelease(0);
+}
+
+void OsmAnd::MapRendererFrameTelemetry::resetWindow(Window& window)
+{
+    for (auto stageIndex = 0u; stageIndex < StagesCount; stageIndex++)
+    {
+        for (auto& bucket : window.buckets[stageIndex])
+            bucket.storeRelease(0);
+        window.samplesCount[stageIndex].storeRelease(0);
+        window.totalDuration[stageIndex].storeRelease(0);
+        window.maxDuration[stageIndex].storeRelease(0);
+    }
+    window.framesCount.storeRelease(0);
+    window.droppedFrames.storeRelease(0);
+    window.intervalsCount.storeRelease(0);
+    window.intervalsDuration.storeRelease(0);
+}
+
+unsigned int OsmAnd::MapRendererFrameTelemetry::getBucketIndex(const int duration)
+{
+    if (duration < MinBucketDuration)
+        return 0;
+
+    const auto bucketIndex = 1 + static_cast<int>(
+        std::floor(std::log2(static_cast<double>(duration) / MinBucketDuration) * BucketsPerOctave));
+    return static_cast<unsigned int>(qMin(bucketIndex, static_cast<int>(BucketsCount) - 1));
+}
+
+float OsmAnd::MapRendererFrameTelemetry::getBucketDuration(const unsigned int bucketIndex)
+{
+    // Upper bound of bucket, in seconds
+    return static_cast<float>(
+        MinBucketDuration * std::exp2(static_cast<double>(bucketIndex) / BucketsPerOctave) / 1000000.0);
+}
+
+OsmAnd::MapRendererFrameTelemetry::StageSnapshot::StageSnapshot()
+    : samplesCount(0)
+    , mean(0.0f)
+    , p50(0.0f)
+    , p90(0.0f)
+    , p99(0.0f)
+    , max(0.0f)
+{
+}
+
+OsmAnd::MapRendererFrameTelemetry::Snapshot::Snapshot()
+    : targetFps(0.0f)
+    , fps(0.0f)
+    , framesCount(0)
+    , droppedFrames(0)
+    , totalFramesCount(0)
+    , totalDroppedFrames(0)
+{
+}
+
+QString OsmAnd::MapRendererFrameTelemetry::Snapshot::toString() const
+{
+    static const char* const stageNames[StagesCount] =
+    {
+        "frame",
+        "sky",
+        "mapLayers",
+        "symbols",
+        "debug",
+        "resourcesUpload",
+    };
+
+    QString result = QString(QLatin1String("fps = %1 (target %2), frames = %3, dropped = %4 (total %5 / %6)\n"))
+        .arg(fps, 0, 'f', 1)
+        .arg(targetFps, 0, 'f', 1)
+        .arg(framesCount)
+        .arg(droppedFrames)
+        .arg(totalDroppedFrames)
+        .arg(totalFramesCount);
+    for (auto stageIndex = 0u; stageIndex < StagesCount; stageIndex++)
+    {
+        const auto& stage = stages[stageIndex];
+        result += QString(QLatin1String("%1: n = %2, mean = %3ms, p50 = %4ms, p90 = %5ms, p99 = %6ms, max = %7ms\n"))
+            .arg(QLatin1String(stageNames[stageIndex]))
+            .arg(stage.samplesCount)
+            .arg(stage.mean * 1000.0f, 0, 'f', 2)
+            .arg(stage.p50 * 1000.0f, 0, 'f', 2)
+            .arg(stage.p90 * 1000.0f, 0, 'f', 2)
+            .arg(stage.p99 * 1000.0f, 0, 'f', 2)
+            .arg(stage.max * 1000.0f, 0, 'f', 2);
+    }
+    return result;
+}
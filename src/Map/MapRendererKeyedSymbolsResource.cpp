@@ -91,16 +91,20 @@ bool OsmAnd::MapRendererKeyedSymbolsResource::obtainData(
         return true;
 
     // Convert data
+    size_t cpuMemoryUsage = 0;
     for (const auto& mapSymbol : constOf(_sourceData->symbolsGroup->symbols))
     {
-        const auto rasterMapSymbol = std::dynamic_pointer_cast<RasterMapSymbol>(mapSymbol);
-        if (!rasterMapSymbol)
-            continue;
+        if (const auto rasterMapSymbol = std::dynamic_pointer_cast<RasterMapSymbol>(mapSymbol))
+        {
+            rasterMapSymbol->bitmap = resourcesManager->adjustBitmapToConfiguration(
+                rasterMapSymbol->bitmap,
+                AlphaChannelPresence::Present);
+            _contentHashes.insert(mapSymbol, resourcesManager->computeSymbolContentHash(mapSymbol));
+        }
 
-        rasterMapSymbol->bitmap = resourcesManager->adjustBitmapToConfiguration(
-            rasterMapSymbol->bitmap,
-            AlphaChannelPresence::Present);
+        cpuMemoryUsage += resourcesManager->getGpuUploadableDataSize(mapSymbol);
     }
+    setCpuMemoryUsage(cpuMemoryUsage);
 
     // Register all obtained symbols
     _mapSymbolsGroup = _sourceData->symbolsGroup;
@@ -139,7 +143,7 @@ bool OsmAnd::MapRendererKeyedSymbolsResource::uploadToGPU()
     {
         // Prepare data and upload to GPU
         std::shared_ptr<const GPUAPI::ResourceInGPU> resourceInGPU;
-        ok = resourcesManager->uploadSymbolToGPU(symbol, resourceInGPU);
+        ok = resourcesManager->uploadSymbolToGPU(symbol, _contentHashes.value(symbol), resourceInGPU);
 
         // If upload have failed, stop
         if (!ok)
@@ -166,11 +170,14 @@ bool OsmAnd::MapRendererKeyedSymbolsResource::uploadToGPU()
     // All resources have been uploaded to GPU successfully by this point
     _retainableCacheMetadata = _sourceData->retainableCacheMetadata;
     _sourceData.reset();
+    _contentHashes.clear();
 
+    size_t gpuMemoryUsage = 0;
     for (const auto& entry : rangeOf(constOf(uploaded)))
     {
         const auto& symbol = entry.key();
         auto& resource = entry.value();
+        gpuMemoryUsage += resourcesManager->getMemoryUsageInGPU(resource);
 
         // Unload GPU data from symbol, since it's uploaded already
         resourcesManager->releaseGpuUploadableDataFrom(symbol);
@@ -178,6 +185,8 @@ bool OsmAnd::MapRendererKeyedSymbolsResource::uploadToGPU()
         // Move reference
         _resourcesInGPU.insert(symbol, qMove(resource));
     }
+    setCpuMemoryUsage(0);
+    setGpuMemoryUsage(gpuMemoryUsage);
 
     return true;
 }
@@ -185,6 +194,7 @@ bool OsmAnd::MapRendererKeyedSymbolsResource::uploadToGPU()
 void OsmAnd::MapRendererKeyedSymbolsResource::unloadFromGPU()
 {
     _resourcesInGPU.clear();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererKeyedSymbolsResource::lostDataInGPU()
@@ -192,6 +202,7 @@ void OsmAnd::MapRendererKeyedSymbolsResource::lostDataInGPU()
     for (auto& resourceInGPU : constOf(_resourcesInGPU))
         resourceInGPU->lostRefInGPU();
     _resourcesInGPU.clear();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererKeyedSymbolsResource::releaseData()
@@ -214,6 +225,8 @@ void OsmAnd::MapRendererKeyedSymbolsResource::releaseData()
 
     _retainableCacheMetadata.reset();
     _sourceData.reset();
+    _contentHashes.clear();
+    setCpuMemoryUsage(0);
 }
 
 std::shared_ptr<const OsmAnd::GPUAPI::ResourceInGPU> OsmAnd::MapRendererKeyedSymbolsResource::getGpuResourceFor(
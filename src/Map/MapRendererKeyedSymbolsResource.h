@@ -31,6 +31,7 @@ namespace OsmAnd
 
         std::shared_ptr<IMapKeyedSymbolsProvider::Data> _sourceData;
         std::shared_ptr<MapSymbolsGroup> _mapSymbolsGroup;
+        QHash< std::shared_ptr<const MapSymbol>, uint64_t > _contentHashes;
         QHash< std::shared_ptr<const MapSymbol>, std::shared_ptr<const GPUAPI::ResourceInGPU> > _resourcesInGPU;
 
         virtual bool updatesPresent();
@@ -1,5 +1,9 @@
 #include "MapRendererRasterMapLayerResource.h"
 
+#include "ignore_warnings_on_external_includes.h"
+#include <SkBitmap.h>
+#include "restore_internal_warnings.h"
+
 #include "IRasterMapLayerProvider.h"
 #include "MapRendererResourcesManager.h"
 
@@ -74,6 +78,7 @@ bool OsmAnd::MapRendererRasterMapLayerResource::obtainData(
         _sourceData->bitmap = resourcesManager->adjustBitmapToConfiguration(
             _sourceData->bitmap,
             _sourceData->alphaChannelPresence);
+        setCpuMemoryUsage(_sourceData->bitmap ? _sourceData->bitmap->getSize() : 0);
     }
 
     return true;
@@ -123,6 +128,7 @@ void OsmAnd::MapRendererRasterMapLayerResource::obtainDataAsync(
                 _sourceData->bitmap = resourcesManager->adjustBitmapToConfiguration(
                     _sourceData->bitmap,
                     _sourceData->alphaChannelPresence);
+                setCpuMemoryUsage(_sourceData->bitmap ? _sourceData->bitmap->getSize() : 0);
             }
 
             callback(requestSucceeded, dataAvailable);
@@ -138,6 +144,8 @@ bool OsmAnd::MapRendererRasterMapLayerResource::uploadToGPU()
     // Since content was uploaded to GPU, it's safe to release it keeping retainable data
     _retainableCacheMetadata = _sourceData->retainableCacheMetadata;
     _sourceData.reset();
+    setCpuMemoryUsage(0);
+    setGpuMemoryUsage(resourcesManager->getMemoryUsageInGPU(_resourceInGPU));
 
     return true;
 }
@@ -145,16 +153,19 @@ bool OsmAnd::MapRendererRasterMapLayerResource::uploadToGPU()
 void OsmAnd::MapRendererRasterMapLayerResource::unloadFromGPU()
 {
     _resourceInGPU.reset();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererRasterMapLayerResource::lostDataInGPU()
 {
     _resourceInGPU->lostRefInGPU();
     _resourceInGPU.reset();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererRasterMapLayerResource::releaseData()
 {
     _retainableCacheMetadata.reset();
     _sourceData.reset();
+    setCpuMemoryUsage(0);
 }
@@ -1,8 +1,11 @@
 #include "MapRendererResourcesManager.h"
 
 #include <cassert>
+#include <cmath>
+#include <algorithm>
 
 #include "QtCommon.h"
+#include <QElapsedTimer>
 
 #include "ignore_warnings_on_external_includes.h"
 #include <SkBitmap.h>
@@ -25,6 +28,7 @@
 #include "QKeyValueIterator.h"
 #include "QCachingIterator.h"
 #include "SimpleQueryController.h"
+#include "SkiaUtilities.h"
 #include "Utilities.h"
 #include "Logging.h"
 
@@ -58,7 +62,14 @@
 
 OsmAnd::MapRendererResourcesManager::MapRendererResourcesManager(MapRenderer* const owner_)
     : _taskHostBridge(this)
-    , _resourcesRequestWorkerPool(Concurrent::WorkerPool::Order::LIFO)
+    , _resourcesRequestWorkerPool(Concurrent::WorkerPool::Order::ByPriority)
+    , _memoryBudgetEpoch(0)
+    , _resourcesEvictedByMemoryBudget(0)
+    , _sharedSymbolResourcesInGPUPurgeThreshold(SharedSymbolResourcesInGPUMinPurgeThreshold)
+    , _symbolResourcesSharedInGPU(0)
+    , _activeTargetTileId(TileId::zero())
+    , _activeZoom(InvalidZoomLevel)
+    , _uploadTimePerByte(0.0f)
     , _workerThreadIsAlive(false)
     , _workerThreadId(nullptr)
     , _workerThread(new Concurrent::Thread(std::bind(&MapRendererResourcesManager::workerThreadProcedure, this)))
@@ -66,6 +77,9 @@ OsmAnd::MapRendererResourcesManager::MapRendererResourcesManager(MapRenderer* co
     , processingTileStubs(_processingTileStubs)
     , unavailableTileStubs(_unavailableTileStubs)
 {
+    _memoryBudgetRequestPriorityLimit.fill(-std::numeric_limits<float>::infinity());
+    _memoryBudgetKeyedRequestPriorityLimit.fill(-std::numeric_limits<float>::infinity());
+
     resetResourceWorkerThreadsLimit();
 
     // Start worker thread
@@ -165,11 +179,82 @@ bool OsmAnd::MapRendererResourcesManager::uploadTiledDataToGPU(
     return renderer->gpuAPI->uploadTiledDataToGPU(mapTile, outResourceInGPU);
 }
 
+uint64_t OsmAnd::MapRendererResourcesManager::computeSymbolContentHash(
+    const std::shared_ptr<const MapSymbol>& mapSymbol) const
+{
+    const auto rasterMapSymbol = std::dynamic_pointer_cast<const RasterMapSymbol>(mapSymbol);
+    if (!rasterMapSymbol || !rasterMapSymbol->bitmap)
+        return 0;
+
+    return SkiaUtilities::computeContentHash(*rasterMapSymbol->bitmap);
+}
+
 bool OsmAnd::MapRendererResourcesManager::uploadSymbolToGPU(
     const std::shared_ptr<const MapSymbol>& mapSymbol,
+    const uint64_t contentHash,
     std::shared_ptr<const GPUAPI::ResourceInGPU>& outResourceInGPU)
 {
-    return renderer->gpuAPI->uploadSymbolToGPU(mapSymbol, outResourceInGPU);
+    const auto rasterMapSymbol = std::dynamic_pointer_cast<const RasterMapSymbol>(mapSymbol);
+    if (!rasterMapSymbol || !rasterMapSymbol->bitmap)
+        return renderer->gpuAPI->uploadSymbolToGPU(mapSymbol, outResourceInGPU);
+    const auto bitmap = rasterMapSymbol->bitmap;
+
+    // Same icon or label is usually present in many tiles, so reuse resource already uploaded for it.
+    // Resource that lost its reference in GPU (e.g. after context loss) is never reused. Hash collision
+    // is not shared and doesn't replace resource that is registered already. Resource whose bitmap was
+    // released can't be verified, so it's replaced by the one uploaded now.
+    bool canBeRegistered = true;
+    {
+        QMutexLocker scopedLocker(&_sharedSymbolResourcesInGPUMutex);
+
+        const auto citSharedResourceInGPU = _sharedSymbolResourcesInGPU.constFind(contentHash);
+        if (citSharedResourceInGPU != _sharedSymbolResourcesInGPU.cend())
+        {
+            const auto sharedResourceInGPU = citSharedResourceInGPU->resourceInGPU.lock();
+            const auto sharedBitmap = citSharedResourceInGPU->bitmap.lock();
+            if (sharedResourceInGPU && sharedResourceInGPU->refInGPU && sharedBitmap)
+            {
+                if (SkiaUtilities::haveSameContent(*sharedBitmap, *bitmap))
+                {
+                    outResourceInGPU = sharedResourceInGPU;
+                    _symbolResourcesSharedInGPU.fetchAndAddOrdered(1);
+                    return true;
+                }
+
+                canBeRegistered = false;
+            }
+        }
+    }
+
+    if (!renderer->gpuAPI->uploadSymbolToGPU(mapSymbol, outResourceInGPU))
+        return false;
+    if (!canBeRegistered)
+        return true;
+
+    {
+        QMutexLocker scopedLocker(&_sharedSymbolResourcesInGPUMutex);
+
+        SharedSymbolResourceInGPU sharedResourceInGPU;
+        sharedResourceInGPU.bitmap = bitmap;
+        sharedResourceInGPU.resourceInGPU = outResourceInGPU;
+        _sharedSymbolResourcesInGPU.insert(contentHash, sharedResourceInGPU);
+
+        if (_sharedSymbolResourcesInGPU.size() > _sharedSymbolResourcesInGPUPurgeThreshold)
+        {
+            auto itEntry = mutableIteratorOf(_sharedSymbolResourcesInGPU);
+            while (itEntry.hasNext())
+            {
+                const auto& entry = itEntry.next().value();
+                if (entry.resourceInGPU.expired() || entry.bitmap.expired())
+                    itEntry.remove();
+            }
+            _sharedSymbolResourcesInGPUPurgeThreshold = qMax(
+                static_cast<int>(SharedSymbolResourcesInGPUMinPurgeThreshold),
+                2 * _sharedSymbolResourcesInGPU.size());
+        }
+    }
+
+    return true;
 }
 
 std::shared_ptr<const SkBitmap> OsmAnd::MapRendererResourcesManager::adjustBitmapToConfiguration(
@@ -191,6 +276,29 @@ void OsmAnd::MapRendererResourcesManager::releaseGpuUploadableDataFrom(const std
     }
 }
 
+size_t OsmAnd::MapRendererResourcesManager::getGpuUploadableDataSize(const std::shared_ptr<const MapSymbol>& mapSymbol) const
+{
+    if (const auto rasterMapSymbol = std::dynamic_pointer_cast<const RasterMapSymbol>(mapSymbol))
+    {
+        if (rasterMapSymbol->bitmap)
+            return rasterMapSymbol->bitmap->getSize();
+    }
+    else if (const auto vectorMapSymbol = std::dynamic_pointer_cast<const VectorMapSymbol>(mapSymbol))
+    {
+        return
+            vectorMapSymbol->verticesCount * sizeof(VectorMapSymbol::Vertex) +
+            vectorMapSymbol->indicesCount * sizeof(VectorMapSymbol::Index);
+    }
+
+    return 0;
+}
+
+size_t OsmAnd::MapRendererResourcesManager::getMemoryUsageInGPU(
+    const std::shared_ptr<const GPUAPI::ResourceInGPU>& resourceInGPU) const
+{
+    return renderer->gpuAPI->getGpuResourceSize(resourceInGPU);
+}
+
 void OsmAnd::MapRendererResourcesManager::updateBindings(
     const MapRendererState& state,
     const MapRendererStateChanges updatedMask)
@@ -377,11 +485,15 @@ void OsmAnd::MapRendererResourcesManager::updateBindings(
         _resourcesStoragesLock.unlock();
 }
 
-void OsmAnd::MapRendererResourcesManager::updateActiveZone(const QSet<TileId>& tiles, const ZoomLevel zoom)
+void OsmAnd::MapRendererResourcesManager::updateActiveZone(
+    const QSet<TileId>& tiles,
+    const TileId targetTileId,
+    const ZoomLevel zoom)
 {
     // Check if update needed
     bool update = true; //NOTE: So far this won't work, since resources won't be updated
     update = update || (_activeZoom != zoom);
+    update = update || (_activeTargetTileId != targetTileId);
     update = update || (_activeTiles != tiles);
 
     if (update)
@@ -391,6 +503,7 @@ void OsmAnd::MapRendererResourcesManager::updateActiveZone(const QSet<TileId>& t
 
         // Update active zone
         _activeTiles = tiles;
+        _activeTargetTileId = targetTileId;
         _activeZoom = zoom;
 
         // Wake up the worker
@@ -415,6 +528,76 @@ void OsmAnd::MapRendererResourcesManager::setResourceWorkerThreadsLimit(const un
     }
 }
 
+float OsmAnd::MapRendererResourcesManager::getResourceRequestPriority(
+    const std::shared_ptr<const MapRendererBaseResource>& resource,
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom)
+{
+    // Keyed resources have no location, so only type matters
+    const auto tiledResource = std::dynamic_pointer_cast<const MapRendererBaseTiledResource>(resource);
+    if (!tiledResource)
+        return getResourceRequestPriority(resource->type);
+
+    return getResourceRequestPriority(
+        resource->type,
+        tiledResource->tileId,
+        tiledResource->zoom,
+        activeTargetTileId,
+        activeZoom);
+}
+
+float OsmAnd::MapRendererResourcesManager::getResourceRequestPriority(const MapRendererResourceType type)
+{
+    // Map layers are needed first, since without them nothing is shown
+    if (type == MapRendererResourceType::ElevationData)
+        return -ElevationDataRequestPenalty;
+    else if (type == MapRendererResourceType::Symbols)
+        return -SymbolsRequestPenalty;
+    return 0.0f;
+}
+
+float OsmAnd::MapRendererResourcesManager::getResourceRequestPriority(
+    const MapRendererResourceType type,
+    const TileId tileId,
+    const ZoomLevel zoom,
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom)
+{
+    auto penalty = -getResourceRequestPriority(type);
+
+    // Distance between tile center and view center is measured in tiles of active zoom
+    const auto zoomShift = static_cast<int>(activeZoom) - static_cast<int>(zoom);
+    const auto scale = std::ldexp(1.0, zoomShift);
+    const auto tilesCount = std::ldexp(1.0, static_cast<int>(activeZoom));
+    auto dx = (tileId.x + 0.5) * scale - (activeTargetTileId.x + 0.5);
+    auto dy = (tileId.y + 0.5) * scale - (activeTargetTileId.y + 0.5);
+
+    // Tiles are wrapped horizontally
+    if (dx > tilesCount / 2.0)
+        dx -= tilesCount;
+    else if (dx < -tilesCount / 2.0)
+        dx += tilesCount;
+
+    penalty += static_cast<float>(std::sqrt(dx*dx + dy*dy));
+    penalty += ZoomShiftRequestPenalty * qAbs(zoomShift);
+
+    return -penalty;
+}
+
+void OsmAnd::MapRendererResourcesManager::reprioritizeResourcesRequests(
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom)
+{
+    // Only resource requests are ever enqueued into this pool
+    _resourcesRequestWorkerPool.reprioritize(
+        [activeTargetTileId, activeZoom]
+        (QRunnable* const runnable, const float priority) -> float
+        {
+            const auto task = static_cast<ResourceRequestTask*>(runnable);
+            return getResourceRequestPriority(task->requestedResource, activeTargetTileId, activeZoom);
+        });
+}
+
 void OsmAnd::MapRendererResourcesManager::resetResourceWorkerThreadsLimit()
 {
 #if OSMAND_SINGLE_MAP_RENDERER_RESOURCES_WORKER
@@ -530,33 +713,59 @@ void OsmAnd::MapRendererResourcesManager::workerThreadProcedure()
     // Capture worker thread ID
     _workerThreadId = QThread::currentThreadId();
 
+    auto lastActiveZoom = InvalidZoomLevel;
+    QElapsedTimer activeZoomTimer;
+    bool zoomChangesInBurst = false;
+    bool requestsDeferred = false;
     while (_workerThreadIsAlive)
     {
         // Local copy of active zone
         QSet<TileId> activeTiles;
+        TileId activeTargetTileId;
         ZoomLevel activeZoom;
 
-        // Wait until we're unblocked by host
+        // Wait until we're unblocked by host. If some requests were deferred, don't wait longer than
+        // it takes zoom to settle
         {
             QMutexLocker scopedLocker(&_workerThreadWakeupMutex);
-            REPEAT_UNTIL(_workerThreadWakeup.wait(&_workerThreadWakeupMutex));
+            if (requestsDeferred)
+                _workerThreadWakeup.wait(&_workerThreadWakeupMutex, ZoomSettleTimeout);
+            else
+                REPEAT_UNTIL(_workerThreadWakeup.wait(&_workerThreadWakeupMutex));
 
             // Copy active zone to local copy
             activeTiles = _activeTiles;
+            activeTargetTileId = _activeTargetTileId;
             activeZoom = _activeZoom;
         }
         if (!_workerThreadIsAlive)
             break;
 
+        // Single zoom change is served right away, only change that follows previous one within timeout
+        // means that zoom is still changing
+        if (activeZoom != lastActiveZoom)
+        {
+            zoomChangesInBurst = activeZoomTimer.isValid() && activeZoomTimer.elapsed() < ZoomSettleTimeout;
+            lastActiveZoom = activeZoom;
+            activeZoomTimer.start();
+        }
+        const auto zoomIsSettling = zoomChangesInBurst && activeZoomTimer.elapsed() < ZoomSettleTimeout;
+
         // Update resources
-        updateResources(activeTiles, activeZoom);
+        requestsDeferred = updateResources(activeTiles, activeTargetTileId, activeZoom, zoomIsSettling);
     }
 
     _workerThreadId = nullptr;
 }
 
-void OsmAnd::MapRendererResourcesManager::requestNeededResources(const QSet<TileId>& activeTiles, const ZoomLevel activeZoom)
+bool OsmAnd::MapRendererResourcesManager::requestNeededResources(
+    const QSet<TileId>& activeTiles,
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom,
+    const bool deferTilesWithPlaceholders)
 {
+    bool requestsDeferred = false;
+
     for (const auto& resourcesCollections : constOf(_storageByType))
     {
         for (const auto& resourcesCollection : constOf(resourcesCollections))
@@ -571,31 +780,74 @@ void OsmAnd::MapRendererResourcesManager::requestNeededResources(const QSet<Tile
 
             if (const auto tiledResourcesCollection = std::dynamic_pointer_cast<MapRendererTiledResourcesCollection>(resourcesCollection))
             {
-                requestNeededTiledResources(
+                // Only map layers are drawn using placeholders
+                const auto deferred = requestNeededTiledResources(
                     tiledResourcesCollection,
                     activeTiles,
-                    activeZoom);
+                    activeTargetTileId,
+                    activeZoom,
+                    deferTilesWithPlaceholders && tiledResourcesCollection->type == MapRendererResourceType::MapLayer);
+                requestsDeferred = requestsDeferred || deferred;
             }
             else if (const auto keyedResourcesCollection = std::dynamic_pointer_cast<MapRendererKeyedResourcesCollection>(resourcesCollection))
             {
                 requestNeededKeyedResources(
-                    keyedResourcesCollection);
+                    keyedResourcesCollection,
+                    activeTargetTileId,
+                    activeZoom);
             }
         }
     }
+
+    return requestsDeferred;
 }
 
-void OsmAnd::MapRendererResourcesManager::requestNeededTiledResources(
+bool OsmAnd::MapRendererResourcesManager::requestNeededTiledResources(
     const std::shared_ptr<MapRendererTiledResourcesCollection>& resourcesCollection,
     const QSet<TileId>& activeTiles,
-    const ZoomLevel activeZoom)
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom,
+    const bool deferTilesWithPlaceholders)
 {
+    bool requestsDeferred = false;
     for (const auto& activeTileId : constOf(activeTiles))
     {
+        // Tile that was never requested and can be drawn using ancestor is requested only when zoom settles,
+        // since it's likely to be skipped
+        if (deferTilesWithPlaceholders && !resourcesCollection->containsResource(activeTileId, activeZoom, nullptr))
+        {
+            std::shared_ptr<MapRendererBaseTiledResource> ancestorResource;
+            const auto hasPlaceholder = resourcesCollection->obtainAncestorResource(
+                activeTileId,
+                activeZoom,
+                MapRenderer::MaxMissingDataZoomShift,
+                ancestorResource,
+                []
+                (const std::shared_ptr<MapRendererBaseTiledResource>& entry) -> bool
+                {
+                    return !entry->isJunk && entry->getState() == MapRendererResourceState::Uploaded;
+                });
+            if (hasPlaceholder)
+            {
+                requestsDeferred = true;
+                continue;
+            }
+        }
+
+        // Resources that do not fit into memory budget are not even allocated
+        const auto resourceType = resourcesCollection->type;
+        const auto priority = getResourceRequestPriority(
+            resourceType,
+            activeTileId,
+            activeZoom,
+            activeTargetTileId,
+            activeZoom);
+        if (!isRequestAllowedByMemoryBudget(resourceType, false, priority))
+            continue;
+
         // Obtain a resource entry and if it's state is "Unknown", create a task that will
         // request resource data
         std::shared_ptr<MapRendererBaseTiledResource> resource;
-        const auto resourceType = resourcesCollection->type;
         resourcesCollection->obtainOrAllocateEntry(resource, activeTileId, activeZoom,
             [this, resourceType]
             (const TiledEntriesCollection<MapRendererBaseTiledResource>& collection,
@@ -612,12 +864,16 @@ void OsmAnd::MapRendererResourcesManager::requestNeededTiledResources(
                     return nullptr;
             });
 
-        requestNeededResource(resource);
+        requestNeededResource(resource, priority);
     }
+
+    return requestsDeferred;
 }
 
 void OsmAnd::MapRendererResourcesManager::requestNeededKeyedResources(
-    const std::shared_ptr<MapRendererKeyedResourcesCollection>& resourcesCollection)
+    const std::shared_ptr<MapRendererKeyedResourcesCollection>& resourcesCollection,
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom)
 {
     // Get keyed provider
     std::shared_ptr<IMapDataProvider> provider_;
@@ -627,6 +883,12 @@ void OsmAnd::MapRendererResourcesManager::requestNeededKeyedResources(
     if (!provider)
         return;
 
+    // Resources that do not fit into memory budget are not even allocated
+    const auto resourceType = resourcesCollection->type;
+    const auto priority = getResourceRequestPriority(resourceType);
+    if (!isRequestAllowedByMemoryBudget(resourceType, true, priority))
+        return;
+
     // Get list of keys this provider has and check that all are present
     const auto& resourceKeys = provider->getProvidedDataKeys();
     for (const auto& resourceKey : constOf(resourceKeys))
@@ -634,7 +896,6 @@ void OsmAnd::MapRendererResourcesManager::requestNeededKeyedResources(
         // Obtain a resource entry and if it's state is "Unknown", create a task that will
         // request resource data
         std::shared_ptr<MapRendererBaseKeyedResource> resource;
-        const auto resourceType = resourcesCollection->type;
         resourcesCollection->obtainOrAllocateEntry(resource, resourceKey,
             [this, resourceType]
             (const KeyedEntriesCollection<MapRendererKeyedResourcesCollection::Key,
@@ -647,11 +908,13 @@ void OsmAnd::MapRendererResourcesManager::requestNeededKeyedResources(
                     return nullptr;
             });
 
-        requestNeededResource(resource);
+        requestNeededResource(resource, priority);
     }
 }
 
-void OsmAnd::MapRendererResourcesManager::requestNeededResource(const std::shared_ptr<MapRendererBaseResource>& resource)
+void OsmAnd::MapRendererResourcesManager::requestNeededResource(
+    const std::shared_ptr<MapRendererBaseResource>& resource,
+    const float priority)
 {
     // Only if tile entry has "Unknown" state proceed to "Requesting" state
     if (!resource->setStateIf(MapRendererResourceState::Unknown, MapRendererResourceState::Requesting))
@@ -706,7 +969,7 @@ void OsmAnd::MapRendererResourcesManager::requestNeededResource(const std::share
         LOG_RESOURCE_STATE_CHANGE(resource, ?, MapRendererResourceState::Requested);
 
         // Finally start the request in a proper workers pool
-        _resourcesRequestWorkerPool.enqueue(asyncTask);
+        _resourcesRequestWorkerPool.enqueue(asyncTask, priority);
     }
 }
 
@@ -953,16 +1216,27 @@ bool OsmAnd::MapRendererResourcesManager::checkForUpdatesAndApply() const
     return (updatesApplied || updatesPresent);
 }
 
-void OsmAnd::MapRendererResourcesManager::updateResources(const QSet<TileId>& tiles, const ZoomLevel zoom)
+bool OsmAnd::MapRendererResourcesManager::updateResources(
+    const QSet<TileId>& tiles,
+    const TileId targetTileId,
+    const ZoomLevel zoom,
+    const bool zoomIsSettling)
 {
     // Before requesting missing tiled resources, clean up cache to free some space
     if (!renderer->currentDebugSettings->disableJunkResourcesCleanup)
         cleanupJunkResources(tiles, zoom);
 
+    // Resources that are still needed may not fit into memory budget
+    enforceMemoryBudget(tiles, targetTileId, zoom);
+
+    // Requests that are still waiting were prioritized for previous active zone
+    reprioritizeResourcesRequests(targetTileId, zoom);
+
     // In the end of rendering processing, request tiled resources that are neither
     // present in requested list, nor in pending, nor in uploaded
-    if (!renderer->currentDebugSettings->disableNeededResourcesRequests)
-        requestNeededResources(tiles, zoom);
+    if (renderer->currentDebugSettings->disableNeededResourcesRequests)
+        return false;
+    return requestNeededResources(tiles, targetTileId, zoom, zoomIsSettling);
 }
 
 unsigned int OsmAnd::MapRendererResourcesManager::unloadResources()
@@ -1020,102 +1294,155 @@ void OsmAnd::MapRendererResourcesManager::unloadResourcesFrom(
 }
 
 unsigned int OsmAnd::MapRendererResourcesManager::uploadResources(
-    const unsigned int limit /*= 0u*/,
+    const float timeBudget /*= 0.0f*/,
+    const size_t bytesBudget /*= 0u*/,
     bool* const outMoreThanLimitAvailable /*= nullptr*/)
-{
-    unsigned int totalUploaded = 0u;
-    bool moreThanLimitAvailable = false;
-    bool atLeastOneUploadFailed = false;
-
-    const auto& resourcesCollections = safeGetAllResourcesCollections();
-    for (const auto& resourcesCollection : constOf(resourcesCollections))
-        uploadResourcesFrom(resourcesCollection, limit, totalUploaded, moreThanLimitAvailable, atLeastOneUploadFailed);
-
-    // If any resource failed to upload, report that more ready resources are available
-    if (atLeastOneUploadFailed)
-        moreThanLimitAvailable = true;
-
-    if (outMoreThanLimitAvailable)
-        *outMoreThanLimitAvailable = moreThanLimitAvailable;
-    return totalUploaded;
-}
-
-void OsmAnd::MapRendererResourcesManager::uploadResourcesFrom(
-    const std::shared_ptr<MapRendererBaseResourcesCollection>& collection,
-    const unsigned int limit,
-    unsigned int& totalUploaded,
-    bool& moreThanLimitAvailable,
-    bool& atLeastOneUploadFailed)
 {
     // Select all resources with "Ready" state
     QList< std::shared_ptr<MapRendererBaseResource> > resources;
-    collection->obtainResources(&resources,
-        [&resources, limit, totalUploaded, &moreThanLimitAvailable]
-        (const std::shared_ptr<MapRendererBaseResource>& entry, bool& cancel) -> bool
-        {
-            // Skip not-ready resources
-            if (entry->getState() != MapRendererResourceState::Ready)
-                return false;
-
-            // Check if limit was reached
-            if (limit > 0 && (totalUploaded + resources.size()) > limit)
+    const auto& resourcesCollections = safeGetAllResourcesCollections();
+    for (const auto& resourcesCollection : constOf(resourcesCollections))
+    {
+        resourcesCollection->obtainResources(&resources,
+            []
+            (const std::shared_ptr<MapRendererBaseResource>& entry, bool& cancel) -> bool
             {
-                // Tell that more resources are available for upload
-                moreThanLimitAvailable = true;
-
-                cancel = true;
-                return false;
-            }
-
-            // Accept this resource
-            return true;
-        });
+                return entry->getState() == MapRendererResourceState::Ready;
+            });
+    }
     if (resources.isEmpty())
-        return;
+    {
+        if (outMoreThanLimitAvailable)
+            *outMoreThanLimitAvailable = false;
+        return 0u;
+    }
 
-    // Upload to GPU all selected resources
+    // Most relevant resources are uploaded first
+    TileId activeTargetTileId;
+    ZoomLevel activeZoom;
+    {
+        QMutexLocker scopedLocker(&_workerThreadWakeupMutex);
+        activeTargetTileId = _activeTargetTileId;
+        activeZoom = _activeZoom;
+    }
+    QList< std::pair<float, std::shared_ptr<MapRendererBaseResource> > > prioritizedResources;
+    prioritizedResources.reserve(resources.size());
     for (const auto& resource : constOf(resources))
     {
-        // Since state change is allowed (it's not changed to "Uploading" during query), check state here
-        if (!resource->setStateIf(MapRendererResourceState::Ready, MapRendererResourceState::Uploading))
-            continue;
-        LOG_RESOURCE_STATE_CHANGE(resource, MapRendererResourceState::Ready, MapRendererResourceState::Uploading);
+        prioritizedResources.push_back(std::make_pair(
+            getResourceRequestPriority(resource, activeTargetTileId, activeZoom),
+            resource));
+    }
+    std::stable_sort(prioritizedResources.begin(), prioritizedResources.end(),
+        []
+        (const std::pair<float, std::shared_ptr<MapRendererBaseResource> >& l,
+            const std::pair<float, std::shared_ptr<MapRendererBaseResource> >& r) -> bool
+        {
+            return l.first > r.first;
+        });
 
-        // Actually upload resource to GPU
-        const auto didUpload = resource->uploadToGPU();
-        if (!atLeastOneUploadFailed && !didUpload)
-            atLeastOneUploadFailed = true;
-        if (!didUpload)
+    // Upload to GPU while predicted time and size fit the budget. At least one resource is always uploaded
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    unsigned int totalUploaded = 0u;
+    size_t totalUploadedBytes = 0u;
+    bool atLeastOneUploadFailed = false;
+    unsigned int processedResources = 0u;
+    unsigned int deferredResources = 0u;
+    for (const auto& prioritizedResource : constOf(prioritizedResources))
+    {
+        const auto& resource = prioritizedResource.second;
+        const auto resourceBytes = resource->getCpuMemoryUsage();
+        const auto elapsedTime = elapsedTimer.nsecsElapsed() / 1000000000.0f;
+
+        if (totalUploaded > 0 || atLeastOneUploadFailed)
         {
-            if (const auto tiledResource = std::dynamic_pointer_cast<const MapRendererBaseTiledResource>(resource))
+            const auto predictedTime = resourceBytes * _uploadTimePerByte;
+            const auto exceedsTimeBudget = timeBudget > 0.0f && elapsedTime + predictedTime > timeBudget;
+            const auto exceedsBytesBudget = bytesBudget > 0u && totalUploadedBytes + resourceBytes > bytesBudget;
+            if (exceedsTimeBudget || exceedsBytesBudget)
             {
-                LogPrintf(LogSeverityLevel::Error,
-                    "Failed to upload tiled resource %p for %dx%d@%d to GPU",
-                    resource.get(),
-                    tiledResource->tileId.x, tiledResource->tileId.y, tiledResource->zoom);
-            }
-            else
-            {
-                LogPrintf(LogSeverityLevel::Error,
-                    "Failed to upload resource %p to GPU",
-                    resource.get());
+                deferredResources = prioritizedResources.size() - processedResources;
+                break;
             }
+        }
+        processedResources++;
+
+        const auto didUpload = uploadResource(resource);
+        if (!didUpload)
+        {
+            atLeastOneUploadFailed = true;
             continue;
         }
+        totalUploaded++;
+        totalUploadedBytes += resourceBytes;
 
-        // Before marking as uploaded, if uploading is done from GPU worker thread,
-        // wait until operation completes
-        if (renderer->setupOptions.gpuWorkerThreadEnabled)
-            renderer->gpuAPI->waitUntilUploadIsComplete();
+        // Measured throughput is smoothed, since single uploads vary a lot
+        if (resourceBytes > 0)
+        {
+            const auto uploadTimePerByte = (elapsedTimer.nsecsElapsed() / 1000000000.0f - elapsedTime) / resourceBytes;
+            _uploadTimePerByte = (_uploadTimePerByte > 0.0f)
+                ? _uploadTimePerByte + (uploadTimePerByte - _uploadTimePerByte) / UploadThroughputSmoothing
+                : uploadTimePerByte;
+        }
+    }
+    const auto totalElapsedTime = elapsedTimer.nsecsElapsed() / 1000000000.0f;
 
-        // Mark as uploaded
-        assert(resource->getState() == MapRendererResourceState::Uploading);
-        resource->setState(MapRendererResourceState::Uploaded);
-        LOG_RESOURCE_STATE_CHANGE(resource, MapRendererResourceState::Uploading, MapRendererResourceState::Uploaded);
+    {
+        QMutexLocker scopedLocker(&_uploadStatisticsMutex);
+
+        _uploadStatistics.uploadedResources += totalUploaded;
+        _uploadStatistics.uploadedBytes += totalUploadedBytes;
+        _uploadStatistics.elapsedTime += totalElapsedTime;
+        _uploadStatistics.deferredResources += deferredResources;
+        if (timeBudget > 0.0f && totalElapsedTime > timeBudget)
+            _uploadStatistics.stalls++;
+    }
 
-        // Count uploaded resources
-        totalUploaded++;
+    // If any resource failed to upload or was deferred, report that more ready resources are available
+    if (outMoreThanLimitAvailable)
+        *outMoreThanLimitAvailable = atLeastOneUploadFailed || deferredResources > 0;
+    return totalUploaded;
+}
+
+bool OsmAnd::MapRendererResourcesManager::uploadResource(const std::shared_ptr<MapRendererBaseResource>& resource)
+{
+    // Since state change is allowed (it's not changed to "Uploading" during query), check state here
+    if (!resource->setStateIf(MapRendererResourceState::Ready, MapRendererResourceState::Uploading))
+        return false;
+    LOG_RESOURCE_STATE_CHANGE(resource, MapRendererResourceState::Ready, MapRendererResourceState::Uploading);
+
+    // Actually upload resource to GPU
+    const auto didUpload = resource->uploadToGPU();
+    if (!didUpload)
+    {
+        if (const auto tiledResource = std::dynamic_pointer_cast<const MapRendererBaseTiledResource>(resource))
+        {
+            LogPrintf(LogSeverityLevel::Error,
+                "Failed to upload tiled resource %p for %dx%d@%d to GPU",
+                resource.get(),
+                tiledResource->tileId.x, tiledResource->tileId.y, tiledResource->zoom);
+        }
+        else
+        {
+            LogPrintf(LogSeverityLevel::Error,
+                "Failed to upload resource %p to GPU",
+                resource.get());
+        }
+        return false;
     }
+
+    // Before marking as uploaded, if uploading is done from GPU worker thread,
+    // wait until operation completes
+    if (renderer->setupOptions.gpuWorkerThreadEnabled)
+        renderer->gpuAPI->waitUntilUploadIsComplete();
+
+    // Mark as uploaded
+    assert(resource->getState() == MapRendererResourceState::Uploading);
+    resource->setState(MapRendererResourceState::Uploaded);
+    LOG_RESOURCE_STATE_CHANGE(resource, MapRendererResourceState::Uploading, MapRendererResourceState::Uploaded);
+
+    return true;
 }
 
 void OsmAnd::MapRendererResourcesManager::cleanupJunkResources(const QSet<TileId>& activeTiles, const ZoomLevel activeZoom)
@@ -1298,6 +1625,20 @@ void OsmAnd::MapRendererResourcesManager::cleanupJunkResources(const QSet<TileId
                     if (tiledResourcesCollection->containsResource(activeTileId, activeZoom, isUsableResource))
                         continue;
 
+                    // If there's an ancestor that renderer uses as placeholder, keep only it. Intermediate zooms that
+                    // were passed during zoom animation are not needed anymore
+                    std::shared_ptr<MapRendererBaseTiledResource> ancestorResource;
+                    if (tiledResourcesCollection->obtainAncestorResource(
+                        activeTileId,
+                        activeZoom,
+                        MapRenderer::MaxMissingDataZoomShift,
+                        ancestorResource,
+                        isUsableAndNotUnavailableResource))
+                    {
+                        neededTilesMap[ancestorResource->zoom].insert(ancestorResource->tileId);
+                        continue;
+                    }
+
                     // Exact match was not found, so now try to look for overscaled/underscaled resources, taking into account
                     // MaxMissingDataZoomShift and active zoom. It's better to show Z-"nearest" resource available,
                     // giving preference to underscaled resource
@@ -1430,6 +1771,212 @@ bool OsmAnd::MapRendererResourcesManager::cleanupJunkResource(
     return false;
 }
 
+void OsmAnd::MapRendererResourcesManager::enforceMemoryBudget(
+    const QSet<TileId>& activeTiles,
+    const TileId activeTargetTileId,
+    const ZoomLevel activeZoom)
+{
+    const auto configuration = renderer->currentConfiguration;
+    std::array<size_t, MapRendererResourceTypesCount> cpuBudgetByType;
+    std::array<size_t, MapRendererResourceTypesCount> gpuBudgetByType;
+    cpuBudgetByType[static_cast<int>(MapRendererResourceType::ElevationData)] = configuration->elevationDataCpuMemoryBudget;
+    gpuBudgetByType[static_cast<int>(MapRendererResourceType::ElevationData)] = configuration->elevationDataGpuMemoryBudget;
+    cpuBudgetByType[static_cast<int>(MapRendererResourceType::MapLayer)] = configuration->mapLayersCpuMemoryBudget;
+    gpuBudgetByType[static_cast<int>(MapRendererResourceType::MapLayer)] = configuration->mapLayersGpuMemoryBudget;
+    cpuBudgetByType[static_cast<int>(MapRendererResourceType::Symbols)] = configuration->symbolsCpuMemoryBudget;
+    gpuBudgetByType[static_cast<int>(MapRendererResourceType::Symbols)] = configuration->symbolsGpuMemoryBudget;
+    const auto cpuBudget = configuration->resourcesCpuMemoryBudget;
+    const auto gpuBudget = configuration->resourcesGpuMemoryBudget;
+
+    QWriteLocker scopedLocker(&_resourcesStoragesLock);
+
+    _memoryBudgetEpoch++;
+
+    struct Candidate
+    {
+        std::shared_ptr<MapRendererBaseResource> resource;
+        MapRendererBaseResourcesCollection* collection;
+        bool isKeyed;
+        bool isOnScreen;
+        float priority;
+    };
+    QList<Candidate> candidates;
+    std::array<size_t, MapRendererResourceTypesCount> cpuUsageByType;
+    std::array<size_t, MapRendererResourceTypesCount> gpuUsageByType;
+    cpuUsageByType.fill(0);
+    gpuUsageByType.fill(0);
+    size_t cpuUsage = 0;
+    size_t gpuUsage = 0;
+    for (const auto& resourcesCollections : constOf(_storageByType))
+    {
+        for (const auto& resourcesCollection : constOf(resourcesCollections))
+        {
+            if (!resourcesCollection)
+                continue;
+
+            const auto collection = resourcesCollection.get();
+            const auto typeIndex = static_cast<int>(resourcesCollection->type);
+            resourcesCollection->forEachResourceExecute(
+                [this, collection, typeIndex, &candidates, &cpuUsageByType, &gpuUsageByType, &cpuUsage, &gpuUsage,
+                    activeTiles, activeTargetTileId, activeZoom]
+                (const std::shared_ptr<MapRendererBaseResource>& entry, bool& cancel)
+                {
+                    const auto entryCpuUsage = entry->getCpuMemoryUsage();
+                    const auto entryGpuUsage = entry->getGpuMemoryUsage();
+                    cpuUsageByType[typeIndex] += entryCpuUsage;
+                    gpuUsageByType[typeIndex] += entryGpuUsage;
+                    cpuUsage += entryCpuUsage;
+                    gpuUsage += entryGpuUsage;
+
+                    // Keyed resources are always in use
+                    const auto tiledEntry = std::dynamic_pointer_cast<const MapRendererBaseTiledResource>(entry);
+                    const auto isKeyed = !tiledEntry;
+                    const auto isOnScreen = isKeyed ||
+                        (tiledEntry->zoom == activeZoom && activeTiles.contains(tiledEntry->tileId));
+                    if (isOnScreen)
+                        entry->_lastUseEpoch = _memoryBudgetEpoch;
+
+                    // Only resources that hold data and are not being processed can be evicted
+                    if (entry->isJunk || (entryCpuUsage == 0 && entryGpuUsage == 0))
+                        return;
+                    const auto state = entry->getState();
+                    if (state != MapRendererResourceState::Ready && state != MapRendererResourceState::Uploaded)
+                        return;
+
+                    Candidate candidate = {
+                        entry,
+                        collection,
+                        isKeyed,
+                        isOnScreen,
+                        getResourceRequestPriority(entry, activeTargetTileId, activeZoom) };
+                    candidates.push_back(candidate);
+                });
+        }
+    }
+
+    const auto isOverBudget =
+        []
+        (const size_t usage, const size_t budget) -> bool
+        {
+            return budget > 0 && usage > budget;
+        };
+    const auto isBelowHysteresis =
+        []
+        (const size_t usage, const size_t budget) -> bool
+        {
+            return budget == 0 || usage * 100 < budget * MemoryBudgetHysteresis;
+        };
+
+    // Lift request limits of types that have enough free memory again
+    for (auto typeIndex = 0; typeIndex < MapRendererResourceTypesCount; typeIndex++)
+    {
+        if (isBelowHysteresis(cpuUsageByType[typeIndex], cpuBudgetByType[typeIndex]) &&
+            isBelowHysteresis(gpuUsageByType[typeIndex], gpuBudgetByType[typeIndex]) &&
+            isBelowHysteresis(cpuUsage, cpuBudget) &&
+            isBelowHysteresis(gpuUsage, gpuBudget))
+        {
+            _memoryBudgetRequestPriorityLimit[typeIndex] = -std::numeric_limits<float>::infinity();
+            _memoryBudgetKeyedRequestPriorityLimit[typeIndex] = -std::numeric_limits<float>::infinity();
+        }
+    }
+
+    bool anyOverBudget = isOverBudget(cpuUsage, cpuBudget) || isOverBudget(gpuUsage, gpuBudget);
+    for (auto typeIndex = 0; typeIndex < MapRendererResourceTypesCount && !anyOverBudget; typeIndex++)
+    {
+        anyOverBudget =
+            isOverBudget(cpuUsageByType[typeIndex], cpuBudgetByType[typeIndex]) ||
+            isOverBudget(gpuUsageByType[typeIndex], gpuBudgetByType[typeIndex]);
+    }
+    if (!anyOverBudget)
+        return;
+
+    // Off-screen resources go first, least recently used first. Then on-screen ones, least important first
+    std::sort(candidates.begin(), candidates.end(),
+        []
+        (const Candidate& l, const Candidate& r) -> bool
+        {
+            if (l.isOnScreen != r.isOnScreen)
+                return !l.isOnScreen;
+            if (!l.isOnScreen && l.resource->_lastUseEpoch != r.resource->_lastUseEpoch)
+                return l.resource->_lastUseEpoch < r.resource->_lastUseEpoch;
+            return l.priority < r.priority;
+        });
+
+    QHash< MapRendererBaseResourcesCollection*, QSet<MapRendererBaseResource*> > evictedResources;
+    unsigned int evictedCount = 0;
+    for (const auto& candidate : constOf(candidates))
+    {
+        const auto typeIndex = static_cast<int>(candidate.resource->type);
+        const auto entryCpuUsage = candidate.resource->getCpuMemoryUsage();
+        const auto entryGpuUsage = candidate.resource->getGpuMemoryUsage();
+
+        const auto freesNeededCpuMemory = entryCpuUsage > 0 &&
+            (isOverBudget(cpuUsage, cpuBudget) || isOverBudget(cpuUsageByType[typeIndex], cpuBudgetByType[typeIndex]));
+        const auto freesNeededGpuMemory = entryGpuUsage > 0 &&
+            (isOverBudget(gpuUsage, gpuBudget) || isOverBudget(gpuUsageByType[typeIndex], gpuBudgetByType[typeIndex]));
+        if (!freesNeededCpuMemory && !freesNeededGpuMemory)
+            continue;
+
+        candidate.resource->markAsJunk();
+        evictedResources[candidate.collection].insert(candidate.resource.get());
+        evictedCount++;
+
+        cpuUsage -= entryCpuUsage;
+        gpuUsage -= entryGpuUsage;
+        cpuUsageByType[typeIndex] -= entryCpuUsage;
+        gpuUsageByType[typeIndex] -= entryGpuUsage;
+
+        // Don't request evicted on-screen resource (or any less important one) again, since it doesn't fit
+        if (candidate.isOnScreen)
+        {
+            auto& requestPriorityLimit = candidate.isKeyed
+                ? _memoryBudgetKeyedRequestPriorityLimit[typeIndex]
+                : _memoryBudgetRequestPriorityLimit[typeIndex];
+            requestPriorityLimit = qMax(requestPriorityLimit, candidate.priority);
+        }
+    }
+    if (evictedCount == 0)
+        return;
+    _resourcesEvictedByMemoryBudget.fetchAndAddOrdered(evictedCount);
+
+    // Resources that can not be removed right now are junk already, so they will be removed later
+    bool needsResourcesUploadOrUnload = false;
+    for (const auto& resourcesCollections : constOf(_storageByType))
+    {
+        for (const auto& resourcesCollection : constOf(resourcesCollections))
+        {
+            const auto citEvictedResources = evictedResources.constFind(resourcesCollection.get());
+            if (citEvictedResources == evictedResources.cend())
+                continue;
+            const auto& evictedResourcesFromCollection = *citEvictedResources;
+
+            resourcesCollection->removeResources(
+                [this, &evictedResourcesFromCollection, &needsResourcesUploadOrUnload]
+                (const std::shared_ptr<MapRendererBaseResource>& entry, bool& cancel) -> bool
+                {
+                    if (!evictedResourcesFromCollection.contains(entry.get()))
+                        return false;
+
+                    return cleanupJunkResource(entry, needsResourcesUploadOrUnload);
+                });
+        }
+    }
+
+    if (needsResourcesUploadOrUnload)
+        requestResourcesUploadOrUnload();
+}
+
+bool OsmAnd::MapRendererResourcesManager::isRequestAllowedByMemoryBudget(
+    const MapRendererResourceType type,
+    const bool isKeyed,
+    const float priority) const
+{
+    const auto& requestPriorityLimit = isKeyed
+        ? _memoryBudgetKeyedRequestPriorityLimit
+        : _memoryBudgetRequestPriorityLimit;
+    return priority > requestPriorityLimit[static_cast<int>(type)];
+}
+
 void OsmAnd::MapRendererResourcesManager::blockingReleaseResourcesFrom(
     const std::shared_ptr<MapRendererBaseResourcesCollection>& collection,
     const bool gpuContextLost)
@@ -1665,7 +2212,8 @@ void OsmAnd::MapRendererResourcesManager::releaseAllResources(const bool gpuCont
 }
 
 void OsmAnd::MapRendererResourcesManager::syncResourcesInGPU(
-    const unsigned int limitUploads /*= 0u*/,
+    const float uploadTimeBudget /*= 0.0f*/,
+    const size_t uploadBytesBudget /*= 0u*/,
     bool* const outMoreUploadsThanLimitAvailable /*= nullptr*/,
     unsigned int* const outResourcesUploaded /*= nullptr*/,
     unsigned int* const outResourcesUnloaded /*= nullptr*/)
@@ -1676,7 +2224,7 @@ void OsmAnd::MapRendererResourcesManager::syncResourcesInGPU(
         *outResourcesUnloaded = resourcesUnloaded;
 
     // Upload resources
-    const auto resourcesUploaded = uploadResources(limitUploads, outMoreUploadsThanLimitAvailable);
+    const auto resourcesUploaded = uploadResources(uploadTimeBudget, uploadBytesBudget, outMoreUploadsThanLimitAvailable);
     if (outResourcesUploaded)
         *outResourcesUploaded = resourcesUploaded;
 }
@@ -1802,6 +2350,66 @@ bool OsmAnd::MapRendererResourcesManager::allResourcesAreUploaded() const
     return !atLeastOneNotUploaded;
 }
 
+OsmAnd::Concurrent::WorkerPool::Statistics OsmAnd::MapRendererResourcesManager::getResourcesRequestsStatistics(
+    const bool reset /*= false*/) const
+{
+    return _resourcesRequestWorkerPool.getStatistics(reset);
+}
+
+void OsmAnd::MapRendererResourcesManager::getResourcesMemoryUsage(
+    size_t& outCpuMemoryUsage,
+    size_t& outGpuMemoryUsage,
+    const MapRendererResourceType type /*= MapRendererResourceType::Unknown*/) const
+{
+    QReadLocker scopedLocker(&_resourcesStoragesLock);
+
+    outCpuMemoryUsage = 0;
+    outGpuMemoryUsage = 0;
+    for (const auto& resourcesCollections : constOf(_storageByType))
+    {
+        for (const auto& resourcesCollection : constOf(resourcesCollections))
+        {
+            if (!resourcesCollection)
+                continue;
+            if (type != MapRendererResourceType::Unknown && resourcesCollection->type != type)
+                continue;
+
+            resourcesCollection->forEachResourceExecute(
+                [&outCpuMemoryUsage, &outGpuMemoryUsage]
+                (const std::shared_ptr<MapRendererBaseResource>& entry, bool& cancel)
+                {
+                    outCpuMemoryUsage += entry->getCpuMemoryUsage();
+                    outGpuMemoryUsage += entry->getGpuMemoryUsage();
+                });
+        }
+    }
+}
+
+unsigned int OsmAnd::MapRendererResourcesManager::getResourcesEvictedByMemoryBudget(const bool reset /*= false*/) const
+{
+    if (reset)
+        return static_cast<unsigned int>(_resourcesEvictedByMemoryBudget.fetchAndStoreOrdered(0));
+    return static_cast<unsigned int>(_resourcesEvictedByMemoryBudget.loadAcquire());
+}
+
+unsigned int OsmAnd::MapRendererResourcesManager::getSymbolResourcesSharedInGPU(const bool reset /*= false*/) const
+{
+    if (reset)
+        return static_cast<unsigned int>(_symbolResourcesSharedInGPU.fetchAndStoreOrdered(0));
+    return static_cast<unsigned int>(_symbolResourcesSharedInGPU.loadAcquire());
+}
+
+OsmAnd::MapRendererResourcesManager::UploadStatistics OsmAnd::MapRendererResourcesManager::getResourcesUploadStatistics(
+    const bool reset /*= false*/) const
+{
+    QMutexLocker scopedLocker(&_uploadStatisticsMutex);
+
+    const auto statistics = _uploadStatistics;
+    if (reset)
+        _uploadStatistics = UploadStatistics();
+    return statistics;
+}
+
 void OsmAnd::MapRendererResourcesManager::dumpResourcesInfo() const
 {
     QMap<MapRendererResourceState, QString> resourceStateMap;
@@ -1822,6 +2430,33 @@ void OsmAnd::MapRendererResourcesManager::dumpResourcesInfo() const
     resourceStateMap.insert(MapRendererResourceState::JustBeforeDeath, QLatin1String("JustBeforeDeath"));
 
     QString dump;
+    const auto requestsStatistics = getResourcesRequestsStatistics();
+    dump += QString(QLatin1String("Requests: %1 queued (max %2), %3 started, %4 coalesced, wait %5s avg / %6s max\n"))
+        .arg(requestsStatistics.queueSize)
+        .arg(requestsStatistics.maxQueueSize)
+        .arg(requestsStatistics.startedRunnables)
+        .arg(requestsStatistics.coalescedRunnables)
+        .arg(requestsStatistics.startedRunnables > 0
+            ? requestsStatistics.totalWaitTime / requestsStatistics.startedRunnables
+            : 0.0f)
+        .arg(requestsStatistics.maxWaitTime);
+    const QList< QPair<MapRendererResourceType, QString> > memoryUsageTypes = {
+        { MapRendererResourceType::ElevationData, QLatin1String("elevation data") },
+        { MapRendererResourceType::MapLayer, QLatin1String("map layers") },
+        { MapRendererResourceType::Symbols, QLatin1String("symbols") },
+        { MapRendererResourceType::Unknown, QLatin1String("total") } };
+    for (const auto& memoryUsageType : constOf(memoryUsageTypes))
+    {
+        size_t cpuMemoryUsage = 0;
+        size_t gpuMemoryUsage = 0;
+        getResourcesMemoryUsage(cpuMemoryUsage, gpuMemoryUsage, memoryUsageType.first);
+        dump += QString(QLatin1String("Memory (%1): %2KB in CPU, %3KB in GPU\n"))
+            .arg(memoryUsageType.second)
+            .arg(cpuMemoryUsage / 1024)
+            .arg(gpuMemoryUsage / 1024);
+    }
+    dump += QString(QLatin1String("Evicted by memory budget: %1\n")).arg(getResourcesEvictedByMemoryBudget());
+    dump += QString(QLatin1String("Symbol resources shared in GPU: %1\n")).arg(getSymbolResourcesSharedInGPU());
     dump += QLatin1String("Resources:\n");
     dump += QLatin1String("--------------------------------------------------------------------------------\n");
 
@@ -1891,6 +2526,15 @@ void OsmAnd::MapRendererResourcesManager::dumpResourcesInfo() const
     LogPrintf(LogSeverityLevel::Debug, qPrintable(dump));
 }
 
+OsmAnd::MapRendererResourcesManager::UploadStatistics::UploadStatistics()
+    : uploadedResources(0)
+    , uploadedBytes(0)
+    , elapsedTime(0.0f)
+    , deferredResources(0)
+    , stalls(0)
+{
+}
+
 OsmAnd::MapRendererResourcesManager::ResourceRequestTask::ResourceRequestTask(
     const std::shared_ptr<MapRendererBaseResource>& requestedResource_,
     const Concurrent::TaskHost::Bridge& bridge_)
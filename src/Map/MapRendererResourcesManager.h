@@ -10,6 +10,7 @@
 #include <QHash>
 #include <QSet>
 #include <QReadWriteLock>
+#include <QMutex>
 #include <QWaitCondition>
 
 #include "OsmAndCore.h"
@@ -56,6 +57,17 @@ namespace OsmAnd
             QList< std::shared_ptr<MapRendererBaseResourcesCollection> >,
             MapRendererResourceTypesCount > ResourcesStorage;
 
+        struct UploadStatistics
+        {
+            UploadStatistics();
+
+            unsigned int uploadedResources;
+            size_t uploadedBytes;
+            float elapsedTime;
+            unsigned int deferredResources;
+            unsigned int stalls;
+        };
+
     private:
         // Resource-requests related:
         const Concurrent::TaskHost::Bridge _taskHostBridge;
@@ -85,6 +97,27 @@ namespace OsmAnd
         void setResourceWorkerThreadsLimit(const unsigned int limit);
         void resetResourceWorkerThreadsLimit();
 
+        // Requests are taken by priority, which is recomputed each time active zone changes.
+        // Penalties are measured in tiles of distance from view center
+        enum
+        {
+            ZoomShiftRequestPenalty = 4,
+            ElevationDataRequestPenalty = 1,
+            SymbolsRequestPenalty = 2,
+        };
+        static float getResourceRequestPriority(
+            const std::shared_ptr<const MapRendererBaseResource>& resource,
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom);
+        static float getResourceRequestPriority(const MapRendererResourceType type);
+        static float getResourceRequestPriority(
+            const MapRendererResourceType type,
+            const TileId tileId,
+            const ZoomLevel zoom,
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom);
+        void reprioritizeResourcesRequests(const TileId activeTargetTileId, const ZoomLevel activeZoom);
+
         // Each provider has a binded resource collection, and these are bindings:
         struct Binding
         {
@@ -122,20 +155,78 @@ namespace OsmAnd
         bool validateResources();
         bool validateResourcesOfType(const MapRendererResourceType type);
 
+        // Memory budget: once usage exceeds configured budget, resources are evicted starting from least recently
+        // used off-screen ones, then on-screen ones most distant from view center. After on-screen resource of some
+        // type was evicted, resources of that type with same or lower priority are not requested until usage drops
+        // below MemoryBudgetHysteresis percents of budget. Priorities of keyed and tiled resources are not comparable,
+        // so each of them has own limit.
+        enum
+        {
+            MemoryBudgetHysteresis = 90,
+        };
+        unsigned int _memoryBudgetEpoch;
+        std::array<float, MapRendererResourceTypesCount> _memoryBudgetRequestPriorityLimit;
+        std::array<float, MapRendererResourceTypesCount> _memoryBudgetKeyedRequestPriorityLimit;
+        mutable QAtomicInt _resourcesEvictedByMemoryBudget;
+        void enforceMemoryBudget(
+            const QSet<TileId>& activeTiles,
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom);
+        bool isRequestAllowedByMemoryBudget(
+            const MapRendererResourceType type,
+            const bool isKeyed,
+            const float priority) const;
+
+        // Raster symbols with identical bitmaps share single resource in GPU. Content hash only finds candidate,
+        // so bitmap of uploaded symbol is referenced to compare pixels with, as long as something else keeps it
+        enum
+        {
+            SharedSymbolResourcesInGPUMinPurgeThreshold = 1024,
+        };
+        struct SharedSymbolResourceInGPU
+        {
+            std::weak_ptr<const SkBitmap> bitmap;
+            std::weak_ptr<const GPUAPI::ResourceInGPU> resourceInGPU;
+        };
+        mutable QMutex _sharedSymbolResourcesInGPUMutex;
+        QHash< uint64_t, SharedSymbolResourceInGPU > _sharedSymbolResourcesInGPU;
+        int _sharedSymbolResourcesInGPUPurgeThreshold;
+        mutable QAtomicInt _symbolResourcesSharedInGPU;
+
         // Resources management:
         QSet<TileId> _activeTiles;
+        TileId _activeTargetTileId;
         ZoomLevel _activeZoom;
         bool updatesPresent() const;
         bool checkForUpdatesAndApply() const;
-        void updateResources(const QSet<TileId>& tiles, const ZoomLevel zoom);
-        void requestNeededResources(const QSet<TileId>& activeTiles, const ZoomLevel activeZoom);
-        void requestNeededTiledResources(
+
+        // While zoom keeps changing (changes again within timeout), map layer tiles that have a placeholder
+        // are not requested
+        enum
+        {
+            ZoomSettleTimeout = 300, // ms
+        };
+        bool updateResources(
+            const QSet<TileId>& tiles,
+            const TileId targetTileId,
+            const ZoomLevel zoom,
+            const bool zoomIsSettling);
+        bool requestNeededResources(
+            const QSet<TileId>& activeTiles,
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom,
+            const bool deferTilesWithPlaceholders);
+        bool requestNeededTiledResources(
             const std::shared_ptr<MapRendererTiledResourcesCollection>& resourcesCollection,
             const QSet<TileId>& activeTiles,
-            const ZoomLevel activeZoom);
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom,
+            const bool deferTilesWithPlaceholders);
         void requestNeededKeyedResources(
-            const std::shared_ptr<MapRendererKeyedResourcesCollection>& resourcesCollection);
-        void requestNeededResource(const std::shared_ptr<MapRendererBaseResource>& resource);
+            const std::shared_ptr<MapRendererKeyedResourcesCollection>& resourcesCollection,
+            const TileId activeTargetTileId,
+            const ZoomLevel activeZoom);
+        void requestNeededResource(const std::shared_ptr<MapRendererBaseResource>& resource, const float priority);
         bool beginResourceRequestProcessing(const std::shared_ptr<MapRendererBaseResource>& resource);
         void endResourceRequestProcessing(
             const std::shared_ptr<MapRendererBaseResource>& resource,
@@ -148,13 +239,20 @@ namespace OsmAnd
         void unloadResourcesFrom(
             const std::shared_ptr<MapRendererBaseResourcesCollection>& collection,
             unsigned int& totalUnloaded);
-        unsigned int uploadResources(const unsigned int limit = 0u, bool* const outMoreThanLimitAvailable = nullptr);
-        void uploadResourcesFrom(
-            const std::shared_ptr<MapRendererBaseResourcesCollection>& collection,
-            const unsigned int limit,
-            unsigned int& totalUploaded,
-            bool& moreThanLimitAvailable,
-            bool& atLeastOneUploadFailed);
+        unsigned int uploadResources(
+            const float timeBudget = 0.0f,
+            const size_t bytesBudget = 0u,
+            bool* const outMoreThanLimitAvailable = nullptr);
+        bool uploadResource(const std::shared_ptr<MapRendererBaseResource>& resource);
+
+        // Upload time of a resource is predicted from its size and measured upload throughput
+        enum
+        {
+            UploadThroughputSmoothing = 8,
+        };
+        float _uploadTimePerByte;
+        mutable QMutex _uploadStatisticsMutex;
+        mutable UploadStatistics _uploadStatistics;
         void blockingReleaseResourcesFrom(
             const std::shared_ptr<MapRendererBaseResourcesCollection>& collection,
             const bool gpuContextLost);
@@ -181,16 +279,24 @@ namespace OsmAnd
 
         // Resources management:
         bool uploadTiledDataToGPU(const std::shared_ptr<const IMapTiledDataProvider::Data>& mapTile, std::shared_ptr<const GPUAPI::ResourceInGPU>& outResourceInGPU);
-        bool uploadSymbolToGPU(const std::shared_ptr<const MapSymbol>& mapSymbol, std::shared_ptr<const GPUAPI::ResourceInGPU>& outResourceInGPU);
+        // Content hash is computed by computeSymbolContentHash() on worker thread that obtained the symbol
+        uint64_t computeSymbolContentHash(const std::shared_ptr<const MapSymbol>& mapSymbol) const;
+        bool uploadSymbolToGPU(
+            const std::shared_ptr<const MapSymbol>& mapSymbol,
+            const uint64_t contentHash,
+            std::shared_ptr<const GPUAPI::ResourceInGPU>& outResourceInGPU);
         std::shared_ptr<const SkBitmap> adjustBitmapToConfiguration(
             const std::shared_ptr<const SkBitmap>& input,
             const AlphaChannelPresence alphaChannelPresence) const;
         void releaseGpuUploadableDataFrom(const std::shared_ptr<MapSymbol>& mapSymbol);
+        size_t getGpuUploadableDataSize(const std::shared_ptr<const MapSymbol>& mapSymbol) const;
+        size_t getMemoryUsageInGPU(const std::shared_ptr<const GPUAPI::ResourceInGPU>& resourceInGPU) const;
 
         void updateBindings(const MapRendererState& state, const MapRendererStateChanges updatedMask);
-        void updateActiveZone(const QSet<TileId>& tiles, const ZoomLevel zoom);
+        void updateActiveZone(const QSet<TileId>& tiles, const TileId targetTileId, const ZoomLevel zoom);
         void syncResourcesInGPU(
-            const unsigned int limitUploads = 0u,
+            const float uploadTimeBudget = 0.0f,
+            const size_t uploadBytesBudget = 0u,
             bool* const outMoreUploadsThanLimitAvailable = nullptr,
             unsigned int* const outResourcesUploaded = nullptr,
             unsigned int* const outResourcesUnloaded = nullptr);
@@ -215,6 +321,14 @@ namespace OsmAnd
             const std::shared_ptr<IMapDataProvider>& ofProvider) const;
         bool eachResourceIsUploadedOrUnavailable() const;
         bool allResourcesAreUploaded() const;
+        Concurrent::WorkerPool::Statistics getResourcesRequestsStatistics(const bool reset = false) const;
+        void getResourcesMemoryUsage(
+            size_t& outCpuMemoryUsage,
+            size_t& outGpuMemoryUsage,
+            const MapRendererResourceType type = MapRendererResourceType::Unknown) const;
+        unsigned int getResourcesEvictedByMemoryBudget(const bool reset = false) const;
+        unsigned int getSymbolResourcesSharedInGPU(const bool reset = false) const;
+        UploadStatistics getResourcesUploadStatistics(const bool reset = false) const;
         void dumpResourcesInfo() const;
 
     friend class OsmAnd::MapRenderer;
@@ -12,6 +12,7 @@ OsmAnd::MapRendererStage::MapRendererStage(MapRenderer* const renderer_)
     , debugSettings(renderer->currentDebugSettings)
     , publishedMapSymbolsByOrderLock(renderer->publishedMapSymbolsByOrderLock)
     , publishedMapSymbolsByOrder(renderer->publishedMapSymbolsByOrder)
+    , publishedMapSymbolsVersion(renderer->publishedMapSymbolsVersion)
 {
 }
 
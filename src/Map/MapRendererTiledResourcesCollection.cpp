@@ -61,6 +61,9 @@ bool OsmAnd::MapRendererTiledResourcesCollection::containsResource(
     if (!obtainEntry(resource, tileId, zoomLevel))
         return false;
 
+    if (!filter)
+        return true;
+
     return filter(resource);
 }
 
@@ -121,20 +121,26 @@ bool OsmAnd::MapRendererTiledSymbolsResource::obtainData(
     if (!dataAvailable)
         return true;
 
-    // Convert data
+    // Convert data. Content hashes are computed here, so that render thread doesn't spend time on that
+    size_t cpuMemoryUsage = 0;
+    QHash< std::shared_ptr<const MapSymbolsGroup>, QHash< std::shared_ptr<MapSymbol>, uint64_t > > contentHashes;
     for (const auto& symbolsGroup : constOf(_sourceData->symbolsGroups))
     {
+        auto& groupContentHashes = contentHashes[symbolsGroup];
         for (const auto& mapSymbol : constOf(symbolsGroup->symbols))
         {
-            const auto rasterMapSymbol = std::dynamic_pointer_cast<RasterMapSymbol>(mapSymbol);
-            if (!rasterMapSymbol)
-                continue;
+            if (const auto rasterMapSymbol = std::dynamic_pointer_cast<RasterMapSymbol>(mapSymbol))
+            {
+                rasterMapSymbol->bitmap = resourcesManager->adjustBitmapToConfiguration(
+                    rasterMapSymbol->bitmap,
+                    AlphaChannelPresence::Present);
+                groupContentHashes.insert(mapSymbol, resourcesManager->computeSymbolContentHash(mapSymbol));
+            }
 
-            rasterMapSymbol->bitmap = resourcesManager->adjustBitmapToConfiguration(
-                rasterMapSymbol->bitmap,
-                AlphaChannelPresence::Present);
+            cpuMemoryUsage += resourcesManager->getGpuUploadableDataSize(mapSymbol);
         }
     }
+    setCpuMemoryUsage(cpuMemoryUsage);
 
     // Move referenced shared groups
     _referencedSharedGroupsResources = referencedSharedGroupsResources;
@@ -150,12 +156,14 @@ bool OsmAnd::MapRendererTiledSymbolsResource::obtainData(
             {
                 // Create GroupResources instance and add it to unique group resources
                 const std::shared_ptr<GroupResources> groupResources(new GroupResources(symbolsGroup));
+                groupResources->contentHashes = contentHashes.value(symbolsGroup);
                 _uniqueGroupsResources.push_back(qMove(groupResources));
                 continue;
             }
 
             // Otherwise insert it as shared group
             const std::shared_ptr<SharedGroupResources> groupResources(new SharedGroupResources(symbolsGroup));
+            groupResources->contentHashes = contentHashes.value(symbolsGroup);
             sharedGroupsResources.fulfilPromiseAndReference(sharingKey, groupResources);
             _referencedSharedGroupsResources.push_back(qMove(groupResources));
 
@@ -173,6 +181,7 @@ bool OsmAnd::MapRendererTiledSymbolsResource::obtainData(
         {
             // Create GroupResources instance and add it to unique group resources
             const std::shared_ptr<GroupResources> groupResources(new GroupResources(symbolsGroup));
+            groupResources->contentHashes = contentHashes.value(symbolsGroup);
             _uniqueGroupsResources.push_back(qMove(groupResources));
         }
     }
@@ -263,7 +272,10 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
         {
             // Prepare data and upload to GPU
             std::shared_ptr<const GPUAPI::ResourceInGPU> resourceInGPU;
-            ok = resourcesManager->uploadSymbolToGPU(symbol, resourceInGPU);
+            ok = resourcesManager->uploadSymbolToGPU(
+                symbol,
+                groupResources->contentHashes.value(symbol),
+                resourceInGPU);
 
             // If upload have failed, stop
             if (!ok)
@@ -308,7 +320,10 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
         {
             // Prepare data and upload to GPU
             std::shared_ptr<const GPUAPI::ResourceInGPU> resourceInGPU;
-            ok = resourcesManager->uploadSymbolToGPU(symbol, resourceInGPU);
+            ok = resourcesManager->uploadSymbolToGPU(
+                symbol,
+                groupResources->contentHashes.value(symbol),
+                resourceInGPU);
 
             // If upload have failed, stop
             if (!ok)
@@ -339,6 +354,7 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
 
     // All resources have been uploaded to GPU successfully by this point,
     // so it's safe to walk across symbols and remove bitmaps:
+    size_t gpuMemoryUsage = 0;
 
     // Unique
     for (const auto& entry : rangeOf(constOf(uniqueUploaded)))
@@ -346,9 +362,11 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
         const auto& groupResources = entry.key();
         const auto& symbol = entry.value().first;
         auto& resource = entry.value().second;
+        gpuMemoryUsage += resourcesManager->getMemoryUsageInGPU(resource);
 
         // Unload GPU data from symbol, since it's uploaded already
         resourcesManager->releaseGpuUploadableDataFrom(symbol);
+        groupResources->contentHashes.remove(symbol);
 
         // Add GPU resource reference
         _symbolToResourceInGpuLUT.insert(symbol, resource);
@@ -368,9 +386,11 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
         const auto& groupResources = entry.key();
         auto symbol = entry.value().first;
         auto& resource = entry.value().second;
+        gpuMemoryUsage += resourcesManager->getMemoryUsageInGPU(resource);
 
         // Unload GPU data from symbol, since it's uploaded already
         resourcesManager->releaseGpuUploadableDataFrom(symbol);
+        groupResources->contentHashes.remove(symbol);
 
         // Add GPU resource reference
         _symbolToResourceInGpuLUT.insert(symbol, resource);
@@ -402,6 +422,10 @@ bool OsmAnd::MapRendererTiledSymbolsResource::uploadToGPU()
 #endif // OSMAND_LOG_MAP_SYMBOLS_TO_GPU_RESOURCES_MAP_CHANGES
     }
 
+    // Shared groups that were uploaded by other resources are accounted there
+    setCpuMemoryUsage(0);
+    setGpuMemoryUsage(gpuMemoryUsage);
+
     return true;
 }
 
@@ -487,6 +511,7 @@ void OsmAnd::MapRendererTiledSymbolsResource::unloadFromGPU(const bool gpuContex
         }
     }
     _referencedSharedGroupsResources.clear();
+    setGpuMemoryUsage(0);
 }
 
 void OsmAnd::MapRendererTiledSymbolsResource::unloadFromGPU()
@@ -621,6 +646,7 @@ void OsmAnd::MapRendererTiledSymbolsResource::releaseData()
 
     _retainableCacheMetadata.reset();
     _sourceData.reset();
+    setCpuMemoryUsage(0);
 }
 
 std::shared_ptr<const OsmAnd::GPUAPI::ResourceInGPU> OsmAnd::MapRendererTiledSymbolsResource::getGpuResourceFor(
@@ -42,6 +42,7 @@ namespace OsmAnd
             virtual ~GroupResources();
 
             const std::shared_ptr<const MapSymbolsGroup> group;
+            QHash< std::shared_ptr<MapSymbol>, uint64_t > contentHashes;
             QHash< std::shared_ptr<MapSymbol>, std::shared_ptr<const GPUAPI::ResourceInGPU> > resourcesInGPU;
 
         friend class OsmAnd::MapRendererTiledSymbolsResource;
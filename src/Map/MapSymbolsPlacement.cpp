@@ -0,0 +1,215 @@
+#include "MapSymbolsPlacement.h"
+
+#include "GridIndex.h"
+#include "Stopwatch.h"
+
+namespace OsmAnd
+{
+    namespace MapSymbolsPlacement_P
+    {
+        // Entries of index are indices of candidates
+        struct CandidatesDelegate
+        {
+            CandidatesDelegate(const QList<MapSymbolsPlacement::Candidate>& candidates_, MapSymbolsPlacement::Result& result_)
+                : candidates(candidates_)
+                , result(result_)
+            {
+                for (auto candidateIndex = 0; candidateIndex < candidates.size(); candidateIndex++)
+                {
+                    const auto& candidate = candidates[candidateIndex];
+
+                    MapSymbolsPlacement::GroupInstanceSymbol symbol;
+                    symbol.symbolPtr = &candidate;
+                    symbol.contentClass = candidate.contentClass;
+                    groupInstancesSymbols[candidate.groupPtr][candidate.groupInstancePtr].push_back(symbol);
+                }
+            }
+
+            const QList<MapSymbolsPlacement::Candidate>& candidates;
+            MapSymbolsPlacement::Result& result;
+            QHash< const void*, QHash< const void*, QList<MapSymbolsPlacement::GroupInstanceSymbol> > > groupInstancesSymbols;
+
+            const void* getGroupPtr(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].groupPtr;
+            }
+
+            const void* getGroupInstancePtr(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].groupInstancePtr;
+            }
+
+            const void* getSymbolPtr(const int candidateIndex) const
+            {
+                return &candidates[candidateIndex];
+            }
+
+            MapSymbol::ContentClass getContentClass(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].contentClass;
+            }
+
+            bool checksIntersectionsWithinGroup(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].checkIntersectionsWithinGroup;
+            }
+
+            const QSet<MapSymbolIntersectionClassId>& getIntersectsWithClasses(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].intersectsWithClasses;
+            }
+
+            QString getContent(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].content;
+            }
+
+            float getMinDistance(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].minDistance;
+            }
+
+            const MapSymbolsPlacement::BBox& getVisibleBBox(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].visibleBBox;
+            }
+
+            const MapSymbolsPlacement::BBox& getIntersectionBBox(const int candidateIndex) const
+            {
+                return candidates[candidateIndex].intersectionBBox;
+            }
+
+            bool obtainGroupInstance(
+                const int candidateIndex,
+                MapSymbolsGroup::PresentationMode& outPresentationMode,
+                QList<MapSymbolsPlacement::GroupInstanceSymbol>& outSymbols) const
+            {
+                const auto& candidate = candidates[candidateIndex];
+                if (!candidate.groupPtr)
+                    return false;
+
+                outSymbols = groupInstancesSymbols[candidate.groupPtr][candidate.groupInstancePtr];
+                outPresentationMode = static_cast<const MapSymbolsPlacement::Candidate*>(outSymbols.first().symbolPtr)
+                    ->presentationMode;
+                return true;
+            }
+
+            bool isCheckEnabled(const MapSymbolsPlacement::Check check) const
+            {
+                return true;
+            }
+
+            bool isTimingEnabled() const
+            {
+                return false;
+            }
+
+            void onChecked(
+                const int candidateIndex,
+                const MapSymbolsPlacement::Check check,
+                const bool passed,
+                const float elapsedTime) const
+            {
+                if (passed)
+                    return;
+
+                switch (check)
+                {
+                    case MapSymbolsPlacement::Check::Visibility:
+                        result.rejectedByVisibility++;
+                        break;
+                    case MapSymbolsPlacement::Check::IntersectionWithOtherSymbols:
+                        result.rejectedByIntersection++;
+                        break;
+                    case MapSymbolsPlacement::Check::MinDistanceToSameContent:
+                        result.rejectedByMinDistance++;
+                        break;
+                    case MapSymbolsPlacement::Check::AddToIntersections:
+                        result.rejectedByIndex++;
+                        break;
+                }
+            }
+
+            void onDiscarded(const int candidateIndex) const
+            {
+                result.discardedByPresentationMode++;
+            }
+        };
+
+        template<typename INDEX>
+        static void placeCandidates(
+            INDEX& index,
+            const QList<MapSymbolsPlacement::Candidate>& candidates,
+            MapSymbolsPlacement::Result& result)
+        {
+            const CandidatesDelegate delegate(candidates, result);
+            MapSymbolsPlacement::Placer<int, INDEX, CandidatesDelegate> placer(index, delegate);
+            for (auto candidateIndex = 0; candidateIndex < candidates.size(); candidateIndex++)
+                placer.plot(candidateIndex);
+            placer.applyPresentationModes();
+
+            for (const auto candidateIndex : constOf(placer.getPlottedEntries()))
+                result.acceptedCandidates.push_back(candidateIndex);
+        }
+    }
+}
+
+OsmAnd::MapSymbolsPlacement::Candidate::Candidate()
+    : groupPtr(nullptr)
+    , groupInstancePtr(nullptr)
+    , contentClass(MapSymbol::ContentClass::Unknown)
+    , checkIntersectionsWithinGroup(false)
+    , minDistance(0.0f)
+{
+}
+
+OsmAnd::MapSymbolsPlacement::Result::Result()
+    : rejectedByVisibility(0)
+    , rejectedByIntersection(0)
+    , rejectedByMinDistance(0)
+    , rejectedByIndex(0)
+    , discardedByPresentationMode(0)
+    , elapsedTime(0.0f)
+{
+}
+
+OsmAnd::MapSymbolsPlacement::Result OsmAnd::MapSymbolsPlacement::place(
+    const AreaI& viewport,
+    const QList<Candidate>& candidates,
+    const IndexType indexType /*= IndexType::QuadTree*/)
+{
+    const Stopwatch stopwatch(true);
+
+    Result result;
+    result.acceptedCandidates.reserve(candidates.size());
+
+    const auto depth = getIndexDepth(viewport);
+    if (indexType == IndexType::Grid)
+    {
+        GridIndex<int, AreaI::CoordType> index(viewport, getIndexCellSize(viewport, depth));
+        MapSymbolsPlacement_P::placeCandidates(index, candidates, result);
+    }
+    else
+    {
+        QuadTree<int, AreaI::CoordType> index(viewport, depth);
+        MapSymbolsPlacement_P::placeCandidates(index, candidates, result);
+    }
+
+    result.elapsedTime = stopwatch.elapsed();
+    return result;
+}
+
+unsigned int OsmAnd::MapSymbolsPlacement::getIndexDepth(const AreaI& viewport)
+{
+    auto depth = 0u;
+    for (auto value = static_cast<unsigned int>(qMax(viewport.width(), viewport.height())) >> 6; value != 0; value >>= 1)
+        depth++;
+    return qMax(depth, 1u);
+}
+
+OsmAnd::AreaI::CoordType OsmAnd::MapSymbolsPlacement::getIndexCellSize(const AreaI& viewport, const unsigned int depth)
+{
+    const auto viewportMaxDimension = static_cast<int64_t>(qMax(viewport.width(), viewport.height()));
+    const auto cellSize = (depth >= 1u && depth <= 63u) ? (viewportMaxDimension >> (depth - 1)) : 0;
+    return static_cast<AreaI::CoordType>(qMax<int64_t>(cellSize, 1));
+}
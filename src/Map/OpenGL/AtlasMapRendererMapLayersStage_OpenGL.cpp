@@ -1289,39 +1289,52 @@ OsmAnd::AtlasMapRendererMapLayersStage_OpenGL::batchLayersByTiles(const AtlasMap
                 // Exact match was not found, so now try to look for overscaled/underscaled resources, taking into account
                 // MaxMissingDataZoomShift and current zoom. It's better to show Z-"nearest" resource available,
                 // giving preference to underscaled resource
-                for (int absZoomShift = 1; absZoomShift <= MapRenderer::MaxMissingDataZoomShift; absZoomShift++)
+                //TODO: Try to find underscaled first (that is, currentState.zoomLevel + 1). Only full match is accepted.
+                // Drawing four children in place of one tile requires multipass rendering, that is not supported yet
+                if (Q_LIKELY(!debugSettings->rasterLayersUnderscaleForbidden))
                 {
-                    //TODO: Try to find underscaled first (that is, currentState.zoomLevel + 1). Only full match is accepted
-                    if (Q_LIKELY(!debugSettings->rasterLayersUnderscaleForbidden))
-                    {
-                    }
-                    
-                    // If underscaled was not found, look for overscaled (surely, if such zoom level exists at all)
-                    if (Q_LIKELY(!debugSettings->rasterLayersOverscaleForbidden))
-                    {
-                        const auto overscaleZoom = static_cast<int>(currentState.zoomLevel) - absZoomShift;
-                        if (overscaleZoom >= static_cast<int>(MinZoomLevel))
+                }
+
+                // If underscaled was not found, use nearest overscaled ancestor as placeholder. Resources manager keeps
+                // same ancestor alive while it's needed
+                if (batchedLayer->resourcesInGPU.isEmpty() && Q_LIKELY(!debugSettings->rasterLayersOverscaleForbidden))
+                {
+                    const auto& tiledResourcesCollection =
+                        std::static_pointer_cast<const MapRendererTiledResourcesCollection::Snapshot>(resourcesCollection);
+
+                    std::shared_ptr<const GPUAPI::ResourceInGPU> gpuResource;
+                    std::shared_ptr<MapRendererBaseTiledResource> ancestorResource;
+                    tiledResourcesCollection->obtainAncestorResource(
+                        tileIdN,
+                        currentState.zoomLevel,
+                        MapRenderer::MaxMissingDataZoomShift,
+                        ancestorResource,
+                        [&gpuResource]
+                        (const std::shared_ptr<MapRendererBaseTiledResource>& entry) -> bool
                         {
-                            PointF nOffsetInTile;
-                            PointF nSizeInTile;
-                            const auto overscaledTileIdN = Utilities::getTileIdOverscaledByZoomShift(
-                                tileIdN,
-                                -absZoomShift,
-                                &nOffsetInTile,
-                                &nSizeInTile);
-                            if (const auto gpuResource = captureLayerResource(
-                                resourcesCollection,
-                                overscaledTileIdN,
-                                static_cast<ZoomLevel>(overscaleZoom)))
-                            {
-                                batchedLayer->resourcesInGPU.push_back(Ref<BatchedLayerResource>(new BatchedLayerResource(
-                                    gpuResource,
-                                    -absZoomShift,
-                                    nOffsetInTile,
-                                    nSizeInTile)));
-                                break;
-                            }
-                        }
+                            const auto resource = std::static_pointer_cast<MapRendererRasterMapLayerResource>(entry);
+
+                            // Capture GPU resource
+                            if (!resource->setStateIf(MapRendererResourceState::Uploaded, MapRendererResourceState::IsBeingUsed))
+                                return false;
+                            gpuResource = resource->resourceInGPU;
+                            resource->setState(MapRendererResourceState::Uploaded);
+
+                            return true;
+                        });
+                    if (gpuResource)
+                    {
+                        const auto zoomShift = static_cast<int>(ancestorResource->zoom) - static_cast<int>(currentState.zoomLevel);
+
+                        PointF nOffsetInTile;
+                        PointF nSizeInTile;
+                        Utilities::getTileIdOverscaledByZoomShift(tileIdN, zoomShift, &nOffsetInTile, &nSizeInTile);
+
+                        batchedLayer->resourcesInGPU.push_back(Ref<BatchedLayerResource>(new BatchedLayerResource(
+                            gpuResource,
+                            zoomShift,
+                            nOffsetInTile,
+                            nSizeInTile)));
                     }
                 }
             }
@@ -20,6 +20,7 @@
 OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::AtlasMapRendererSymbolsStage_OpenGL(AtlasMapRenderer_OpenGL* const renderer_)
     : AtlasMapRendererSymbolsStage(renderer_)
     , AtlasMapRendererStageHelper_OpenGL(this)
+    , _symbolTexturesBound(0)
     , _onPathSymbol2dMaxGlyphsPerDrawCall(0)
     , _onPathSymbol3dMaxGlyphsPerDrawCall(0)
 {
@@ -59,6 +60,9 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::render(IMapRenderer_Metrics::M
 
     prepare(metric);
 
+    _lastUsedSymbolTexture.reset();
+    _symbolTexturesBound = 0;
+
     // Initially, configure for straight alpha channel type
     auto currentAlphaChannelType = AlphaChannelType::Straight;
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -113,6 +117,10 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::render(IMapRenderer_Metrics::M
     GL_CHECK_RESULT;
     glBindTexture(GL_TEXTURE_2D, 0);
     GL_CHECK_RESULT;
+    _lastUsedSymbolTexture.reset();
+
+    if (metric)
+        metric->symbolTexturesBound += _symbolTexturesBound;
 
     // Deactivate program
     glUseProgram(0);
@@ -125,6 +133,43 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::render(IMapRenderer_Metrics::M
     return ok;
 }
 
+void OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::useSymbolTexture(
+    const std::shared_ptr<const GPUAPI::TextureInGPU>& gpuResource,
+    const GLlocation& texCoordsOffsetAndScale)
+{
+    const auto gpuAPI = getGPUAPI();
+
+    // Map texture coordinates of symbol to its slot on page
+    if (gpuResource->type == GPUAPI::ResourceInGPU::Type::SlotOnPackedTexture)
+    {
+        const auto slot = std::static_pointer_cast<const GPUAPI::SlotOnPackedTextureInGPU>(gpuResource);
+        glUniform4f(texCoordsOffsetAndScale,
+            slot->texCoordsOffsetN.x,
+            slot->texCoordsOffsetN.y,
+            slot->texCoordsScaleN.x,
+            slot->texCoordsScaleN.y);
+        GL_CHECK_RESULT;
+    }
+    else
+    {
+        glUniform4f(texCoordsOffsetAndScale, 0.0f, 0.0f, 1.0f, 1.0f);
+        GL_CHECK_RESULT;
+    }
+
+    const auto texture = static_cast<GLuint>(reinterpret_cast<intptr_t>(gpuResource->refInGPU));
+    if (_lastUsedSymbolTexture.isValid() && _lastUsedSymbolTexture == texture)
+        return;
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    GL_CHECK_RESULT;
+
+    // Apply settings from texture block to texture
+    gpuAPI->applyTextureBlockToTexture(GL_TEXTURE_2D, GL_TEXTURE0 + 0);
+
+    _lastUsedSymbolTexture = texture;
+    _symbolTexturesBound++;
+}
+
 bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderBillboardSymbol(
     const std::shared_ptr<const RenderableBillboardSymbol>& renderable,
     AlphaChannelType &currentAlphaChannelType,
@@ -236,6 +281,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeBillboardRaster()
         "uniform ivec2 param_vs_symbolSize;                                                                                 ""\n"
         "uniform float param_vs_distanceFromCamera;                                                                         ""\n"
         "uniform ivec2 param_vs_onScreenOffset;                                                                             ""\n"
+        "uniform vec4 param_vs_texCoordsOffsetAndScale;                                                                     ""\n"
         "                                                                                                                   ""\n"
         "void main()                                                                                                        ""\n"
         "{                                                                                                                  ""\n"
@@ -289,6 +335,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeBillboardRaster()
         "                                                                                                                   ""\n"
         // Texture coordinates are simply forwarded from input
         "   v2f_texCoords = in_vs_vertexTexCoords;                                                                          ""\n"
+        "    v2f_texCoords = v2f_texCoords * param_vs_texCoordsOffsetAndScale.zw + param_vs_texCoordsOffsetAndScale.xy;     ""\n"
         "}                                                                                                                  ""\n");
     auto preprocessedVertexShader = vertexShader;
     preprocessedVertexShader.replace("%TileSize3D%", QString::number(AtlasMapRenderer::TileSize3D));
@@ -355,6 +402,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeBillboardRaster()
     ok = ok && lookup->lookupLocation(_billboardRasterProgram.vs.param.symbolSize, "param_vs_symbolSize", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_billboardRasterProgram.vs.param.distanceFromCamera, "param_vs_distanceFromCamera", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_billboardRasterProgram.vs.param.onScreenOffset, "param_vs_onScreenOffset", GlslVariableType::Uniform);
+    ok = ok && lookup->lookupLocation(_billboardRasterProgram.vs.param.texCoordsOffsetAndScale, "param_vs_texCoordsOffsetAndScale", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_billboardRasterProgram.fs.param.sampler, "param_fs_sampler", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_billboardRasterProgram.fs.param.modulationColor, "param_fs_modulationColor", GlslVariableType::Uniform);
     if (!ok)
@@ -537,9 +585,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderBillboardRasterSymbol(
         currentAlphaChannelType = gpuResource->alphaChannelType;
     }
 
-    // Activate symbol texture
-    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(gpuResource->refInGPU)));
-    GL_CHECK_RESULT;
+    // Activate symbol texture (or page of it)
+    useSymbolTexture(gpuResource, _billboardRasterProgram.vs.param.texCoordsOffsetAndScale);
 
     // Set modulation color
     glUniform4f(_billboardRasterProgram.fs.param.modulationColor,
@@ -549,9 +596,6 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderBillboardRasterSymbol(
         symbol->modulationColor.a);
     GL_CHECK_RESULT;
 
-    // Apply settings from texture block to texture
-    gpuAPI->applyTextureBlockToTexture(GL_TEXTURE_2D, GL_TEXTURE0 + 0);
-
     // Draw symbol actually
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
     GL_CHECK_RESULT;
@@ -627,7 +671,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath2D()
     const auto alreadyOccupiedUniforms =
         4 /*param_vs_mPerspectiveProjectionView*/ +
         1 /*param_vs_glyphHeight*/ +
-        1 /*param_vs_zDistanceFromCamera*/;
+        1 /*param_vs_zDistanceFromCamera*/ +
+        1 /*param_vs_texCoordsOffsetAndScale*/;
     _onPathSymbol2dMaxGlyphsPerDrawCall = (gpuAPI->maxVertexUniformVectors - alreadyOccupiedUniforms) / 5;
     if (initializeOnPath2DProgram(_onPathSymbol2dMaxGlyphsPerDrawCall))
     {
@@ -787,6 +832,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath2DProgram(cons
         // Parameters: per-symbol data
         "uniform float param_vs_glyphHeight;                                                                                ""\n"
         "uniform float param_vs_distanceFromCamera;                                                                         ""\n"
+        "uniform vec4 param_vs_texCoordsOffsetAndScale;                                                                     ""\n"
         "                                                                                                                   ""\n"
         // Parameters: per-glyph data
         "struct Glyph                                                                                                       ""\n"
@@ -840,6 +886,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath2DProgram(cons
         // Prepare texture coordinates
         "    v2f_texCoords.s = glyph.widthOfPreviousN + in_vs_vertexTexCoords.s*glyph.widthN;                               ""\n"
         "    v2f_texCoords.t = in_vs_vertexTexCoords.t; // Height is compatible as-is                                       ""\n"
+        "    v2f_texCoords = v2f_texCoords * param_vs_texCoordsOffsetAndScale.zw + param_vs_texCoordsOffsetAndScale.xy;     ""\n"
         "}                                                                                                                  ""\n");
     auto preprocessedVertexShader = vertexShader;
     preprocessedVertexShader.replace("%MaxGlyphsPerDrawCall%", QString::number(maxGlyphsPerDrawCall));
@@ -903,6 +950,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath2DProgram(cons
     ok = ok && lookup->lookupLocation(_onPath2dProgram.vs.param.mOrthographicProjection, "param_vs_mOrthographicProjection", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onPath2dProgram.vs.param.glyphHeight, "param_vs_glyphHeight", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onPath2dProgram.vs.param.distanceFromCamera, "param_vs_distanceFromCamera", GlslVariableType::Uniform);
+    ok = ok && lookup->lookupLocation(_onPath2dProgram.vs.param.texCoordsOffsetAndScale, "param_vs_texCoordsOffsetAndScale", GlslVariableType::Uniform);
     auto& glyphs = _onPath2dProgram.vs.param.glyphs;
     glyphs.resize(maxGlyphsPerDrawCall);
     int glyphStructIndex = 0;
@@ -944,7 +992,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath3D()
     const auto alreadyOccupiedUniforms =
         4 /*param_vs_mPerspectiveProjectionView*/ +
         1 /*param_vs_glyphHeight*/ +
-        1 /*param_vs_zDistanceFromCamera*/;
+        1 /*param_vs_zDistanceFromCamera*/ +
+        1 /*param_vs_texCoordsOffsetAndScale*/;
     _onPathSymbol3dMaxGlyphsPerDrawCall = (gpuAPI->maxVertexUniformVectors - alreadyOccupiedUniforms) / 5;
     if (initializeOnPath3DProgram(_onPathSymbol3dMaxGlyphsPerDrawCall))
     {
@@ -1104,6 +1153,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath3DProgram(cons
         // Parameters: per-symbol data
         "uniform float param_vs_glyphHeight;                                                                                ""\n"
         "uniform float param_vs_zDistanceFromCamera;                                                                        ""\n"
+        "uniform vec4 param_vs_texCoordsOffsetAndScale;                                                                     ""\n"
         "                                                                                                                   ""\n"
         // Parameters: per-glyph data
         "struct Glyph                                                                                                       ""\n"
@@ -1137,6 +1187,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath3DProgram(cons
         // Prepare texture coordinates
         "    v2f_texCoords.s = glyph.widthOfPreviousN + in_vs_vertexTexCoords.s*glyph.widthN;                               ""\n"
         "    v2f_texCoords.t = in_vs_vertexTexCoords.t; // Height is compatible as-is                                       ""\n"
+        "    v2f_texCoords = v2f_texCoords * param_vs_texCoordsOffsetAndScale.zw + param_vs_texCoordsOffsetAndScale.xy;     ""\n"
         "}                                                                                                                  ""\n");
     auto preprocessedVertexShader = vertexShader;
     preprocessedVertexShader.replace("%MaxGlyphsPerDrawCall%", QString::number(maxGlyphsPerDrawCall));
@@ -1200,6 +1251,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnPath3DProgram(cons
     ok = ok && lookup->lookupLocation(_onPath3dProgram.vs.param.mPerspectiveProjectionView, "param_vs_mPerspectiveProjectionView", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onPath3dProgram.vs.param.glyphHeight, "param_vs_glyphHeight", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onPath3dProgram.vs.param.zDistanceFromCamera, "param_vs_zDistanceFromCamera", GlslVariableType::Uniform);
+    ok = ok && lookup->lookupLocation(_onPath3dProgram.vs.param.texCoordsOffsetAndScale, "param_vs_texCoordsOffsetAndScale", GlslVariableType::Uniform);
     auto& glyphs = _onPath3dProgram.vs.param.glyphs;
     glyphs.resize(maxGlyphsPerDrawCall);
     int glyphStructIndex = 0;
@@ -1304,12 +1356,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnPath2dSymbol(
         currentAlphaChannelType = gpuResource->alphaChannelType;
     }
 
-    // Activate symbol texture
-    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(gpuResource->refInGPU)));
-    GL_CHECK_RESULT;
-
-    // Apply settings from texture block to texture
-    gpuAPI->applyTextureBlockToTexture(GL_TEXTURE_2D, GL_TEXTURE0 + 0);
+    // Activate symbol texture (or page of it)
+    useSymbolTexture(gpuResource, _onPath2dProgram.vs.param.texCoordsOffsetAndScale);
 
     // Set modulation color
     glUniform4f(_onPath2dProgram.fs.param.modulationColor,
@@ -1448,9 +1496,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnPath3dSymbol(
         currentAlphaChannelType = gpuResource->alphaChannelType;
     }
 
-    // Activate symbol texture
-    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(gpuResource->refInGPU)));
-    GL_CHECK_RESULT;
+    // Activate symbol texture (or page of it)
+    useSymbolTexture(gpuResource, _onPath3dProgram.vs.param.texCoordsOffsetAndScale);
 
     // Set modulation color
     glUniform4f(_onPath3dProgram.fs.param.modulationColor,
@@ -1460,9 +1507,6 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnPath3dSymbol(
         symbol->modulationColor.a);
     GL_CHECK_RESULT;
 
-    // Apply settings from texture block to texture
-    gpuAPI->applyTextureBlockToTexture(GL_TEXTURE_2D, GL_TEXTURE0 + 0);
-
     // Draw chains of glyphs
     const auto glyphsCount = renderable->glyphsPlacement.size();
     unsigned int glyphsDrawn = 0;
@@ -1642,6 +1686,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnSurfaceRaster()
         "uniform float param_vs_direction;                                                                                  ""\n"
         "uniform ivec2 param_vs_symbolSize;                                                                                 ""\n"
         "uniform float param_vs_zDistanceFromCamera;                                                                        ""\n"
+        "uniform vec4 param_vs_texCoordsOffsetAndScale;                                                                     ""\n"
         "                                                                                                                   ""\n"
         "void main()                                                                                                        ""\n"
         "{                                                                                                                  ""\n"
@@ -1661,6 +1706,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnSurfaceRaster()
         "                                                                                                                   ""\n"
         // Prepare texture coordinates
         "    v2f_texCoords = in_vs_vertexTexCoords;                                                                         ""\n"
+        "    v2f_texCoords = v2f_texCoords * param_vs_texCoordsOffsetAndScale.zw + param_vs_texCoordsOffsetAndScale.xy;     ""\n"
         "}                                                                                                                  ""\n");
     auto preprocessedVertexShader = vertexShader;
     preprocessedVertexShader.replace("%TileSize3D%", QString::number(AtlasMapRenderer::TileSize3D));
@@ -1725,6 +1771,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::initializeOnSurfaceRaster()
     ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.vs.param.direction, "param_vs_direction", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.vs.param.symbolSize, "param_vs_symbolSize", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.vs.param.zDistanceFromCamera, "param_vs_zDistanceFromCamera", GlslVariableType::Uniform);
+    ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.vs.param.texCoordsOffsetAndScale, "param_vs_texCoordsOffsetAndScale", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.fs.param.sampler, "param_fs_sampler", GlslVariableType::Uniform);
     ok = ok && lookup->lookupLocation(_onSurfaceRasterProgram.fs.param.modulationColor, "param_fs_modulationColor", GlslVariableType::Uniform);
     if (!ok)
@@ -1887,9 +1934,8 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnSurfaceRasterSymbol(
         currentAlphaChannelType = gpuResource->alphaChannelType;
     }
 
-    // Activate symbol texture
-    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(gpuResource->refInGPU)));
-    GL_CHECK_RESULT;
+    // Activate symbol texture (or page of it)
+    useSymbolTexture(gpuResource, _onSurfaceRasterProgram.vs.param.texCoordsOffsetAndScale);
 
     // Set modulation color
     glUniform4f(_onSurfaceRasterProgram.fs.param.modulationColor,
@@ -1899,9 +1945,6 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnSurfaceRasterSymbol(
         symbol->modulationColor.a);
     GL_CHECK_RESULT;
 
-    // Apply settings from texture block to texture
-    gpuAPI->applyTextureBlockToTexture(GL_TEXTURE_2D, GL_TEXTURE0 + 0);
-
     // Draw symbol actually
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
     GL_CHECK_RESULT;
@@ -2184,6 +2227,7 @@ bool OsmAnd::AtlasMapRendererSymbolsStage_OpenGL::renderOnSurfaceVectorSymbol(
     // Unbind symbol texture from texture sampler
     glBindTexture(GL_TEXTURE_2D, 0);
     GL_CHECK_RESULT;
+    _lastUsedSymbolTexture.reset();
 
     // Draw symbol actually
     GLenum primitivesType = GL_INVALID_ENUM;
@@ -18,6 +18,13 @@ namespace OsmAnd
     {
     private:
     protected:
+        // Symbols packed into same texture page don't need texture to be rebound
+        GLname _lastUsedSymbolTexture;
+        unsigned int _symbolTexturesBound;
+        void useSymbolTexture(
+            const std::shared_ptr<const GPUAPI::TextureInGPU>& gpuResource,
+            const GLlocation& texCoordsOffsetAndScale);
+
         bool renderBillboardSymbol(
             const std::shared_ptr<const RenderableBillboardSymbol>& renderable,
             AlphaChannelType &currentAlphaChannelType,
@@ -48,6 +55,7 @@ namespace OsmAnd
                     GLlocation symbolSize;
                     GLlocation distanceFromCamera;
                     GLlocation onScreenOffset;
+                    GLlocation texCoordsOffsetAndScale;
                 } param;
             } vs;
 
@@ -106,6 +114,7 @@ namespace OsmAnd
                     // Per-symbol data
                     GLlocation glyphHeight;
                     GLlocation distanceFromCamera;
+                    GLlocation texCoordsOffsetAndScale;
 
                     // Per-glyph data
                     QVector<Glyph> glyphs;
@@ -154,6 +163,7 @@ namespace OsmAnd
                     // Per-symbol data
                     GLlocation glyphHeight;
                     GLlocation zDistanceFromCamera;
+                    GLlocation texCoordsOffsetAndScale;
 
                     // Per-glyph data
                     QVector<Glyph> glyphs;
@@ -208,6 +218,7 @@ namespace OsmAnd
                     GLlocation direction;
                     GLlocation symbolSize;
                     GLlocation zDistanceFromCamera;
+                    GLlocation texCoordsOffsetAndScale;
                 } param;
             } vs;
 
@@ -77,6 +77,9 @@ bool OsmAnd::AtlasMapRenderer_OpenGL::doRenderFrame(IMapRenderer_Metrics::Metric
     bool ok = true;
 
     const auto metric = dynamic_cast<AtlasMapRenderer_Metrics::Metric_renderFrame*>(metric_);
+    const auto frameTelemetry = getFrameTelemetry();
+    const auto telemetryEnabled = frameTelemetry->isEnabled();
+    const auto measureStages = (metric != nullptr || telemetryEnabled);
 
     GL_PUSH_GROUP_MARKER(QLatin1String("OsmAndCore"));
 
@@ -122,22 +125,34 @@ bool OsmAnd::AtlasMapRenderer_OpenGL::doRenderFrame(IMapRenderer_Metrics::Metric
     GL_CHECK_RESULT;
 
     // Render the sky
-    Stopwatch skyStageStopwatch(metric != nullptr);
+    Stopwatch skyStageStopwatch(measureStages);
     if (!_skyStage->render(metric))
         ok = false;
-    if (metric)
-        metric->elapsedTimeForSkyStage = skyStageStopwatch.elapsed();
+    if (measureStages)
+    {
+        const auto elapsedTime = skyStageStopwatch.elapsed();
+        if (metric)
+            metric->elapsedTimeForSkyStage = elapsedTime;
+        if (telemetryEnabled)
+            frameTelemetry->recordStage(MapRendererFrameTelemetry::Stage::Sky, elapsedTime);
+    }
 
     // Change depth test function prior to raster map stage and further stages
     glDepthFunc(GL_LEQUAL);
     GL_CHECK_RESULT;
 
     // Raster map stage is rendered without blending, since it's done in fragment shader
-    Stopwatch mapLayersStageStopwatch(metric != nullptr);
+    Stopwatch mapLayersStageStopwatch(measureStages);
     if (!_mapLayersStage->render(metric))
         ok = false;
-    if (metric)
-        metric->elapsedTimeForMapLayersStage = mapLayersStageStopwatch.elapsed();
+    if (measureStages)
+    {
+        const auto elapsedTime = mapLayersStageStopwatch.elapsed();
+        if (metric)
+            metric->elapsedTimeForMapLayersStage = elapsedTime;
+        if (telemetryEnabled)
+            frameTelemetry->recordStage(MapRendererFrameTelemetry::Stage::MapLayers, elapsedTime);
+    }
 
     // Turn on blending since now objects with transparency are going to be rendered
     glEnable(GL_BLEND);
@@ -145,15 +160,21 @@ bool OsmAnd::AtlasMapRenderer_OpenGL::doRenderFrame(IMapRenderer_Metrics::Metric
 
     // Render map symbols without writing depth buffer, since symbols use own sorting and intersection checking
     //NOTE: Currently map symbols are incompatible with height-maps
-    Stopwatch symbolsStageStopwatch(metric != nullptr);
+    Stopwatch symbolsStageStopwatch(measureStages);
     glDepthMask(GL_FALSE);
     GL_CHECK_RESULT;
     if (!_symbolsStage->render(metric))
         ok = false;
     glDepthMask(GL_TRUE);
     GL_CHECK_RESULT;
-    if (metric)
-        metric->elapsedTimeForSymbolsStage = symbolsStageStopwatch.elapsed();
+    if (measureStages)
+    {
+        const auto elapsedTime = symbolsStageStopwatch.elapsed();
+        if (metric)
+            metric->elapsedTimeForSymbolsStage = elapsedTime;
+        if (telemetryEnabled)
+            frameTelemetry->recordStage(MapRendererFrameTelemetry::Stage::Symbols, elapsedTime);
+    }
 
     // Restore straight color blending
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -162,7 +183,7 @@ bool OsmAnd::AtlasMapRenderer_OpenGL::doRenderFrame(IMapRenderer_Metrics::Metric
     //TODO: render special fog object some day
 
     // Render debug stage
-    Stopwatch debugStageStopwatch(metric != nullptr);
+    Stopwatch debugStageStopwatch(measureStages);
     if (currentDebugSettings->debugStageEnabled)
     {
         glDisable(GL_DEPTH_TEST);
@@ -174,13 +195,39 @@ bool OsmAnd::AtlasMapRenderer_OpenGL::doRenderFrame(IMapRenderer_Metrics::Metric
         glEnable(GL_DEPTH_TEST);
         GL_CHECK_RESULT;
     }
-    if (metric)
-        metric->elapsedTimeForDebugStage = debugStageStopwatch.elapsed();
+    if (measureStages)
+    {
+        const auto elapsedTime = debugStageStopwatch.elapsed();
+        if (metric)
+            metric->elapsedTimeForDebugStage = elapsedTime;
+        if (telemetryEnabled)
+            frameTelemetry->recordStage(MapRendererFrameTelemetry::Stage::Debug, elapsedTime);
+    }
 
     // Turn off blending
     glDisable(GL_BLEND);
     GL_CHECK_RESULT;
 
+    // Uploads are done either in update() or by GPU worker, so report all that happened since previous frame
+    if (measureStages)
+    {
+        const auto uploadStatistics = getResources().getResourcesUploadStatistics(true);
+        if (metric)
+        {
+            metric->elapsedTimeForResourcesUpload = uploadStatistics.elapsedTime;
+            metric->resourcesUploaded = uploadStatistics.uploadedResources;
+            metric->resourcesUploadedSize = static_cast<unsigned int>(uploadStatistics.uploadedBytes / 1024);
+            metric->resourcesUploadsDeferred = uploadStatistics.deferredResources;
+            metric->resourcesUploadStalls = uploadStatistics.stalls;
+        }
+        if (telemetryEnabled && uploadStatistics.uploadedResources > 0)
+        {
+            frameTelemetry->recordStage(
+                MapRendererFrameTelemetry::Stage::ResourcesUpload,
+                uploadStatistics.elapsedTime);
+        }
+    }
+
     GL_POP_GROUP_MARKER;
 
     return ok;
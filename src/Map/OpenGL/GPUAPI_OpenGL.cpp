@@ -4,6 +4,7 @@
 
 #include "QtExtensions.h"
 #include <QtMath>
+#include <QByteArray>
 #include <QRegularExpression>
 #include <QRegExp>
 
@@ -1207,6 +1208,83 @@ bool OsmAnd::GPUAPI_OpenGL::uploadSymbolAsTextureToGPU(
     }
     const auto textureFormat = getTextureFormat(symbol);
 
+    // Symbols that are small enough are packed into shared pages, so that symbols stage can render them
+    // without switching textures. Page area around each symbol is cleared to avoid bleeding of neighbours.
+    const auto pageSize = qMin<GLint>(SymbolsTexturePageSize, _maxTextureSize);
+    const auto bitmapWidth = symbol->bitmap->width();
+    const auto bitmapHeight = symbol->bitmap->height();
+    if (!symbolUsesPalette && bitmapWidth * 2 <= pageSize && bitmapHeight * 2 <= pageSize)
+    {
+        const auto packedTexturesPool = obtainPackedTexturesPool(textureFormat, pageSize, SymbolsTexturePagePadding);
+        const auto slotInGPU = allocateSlotInPackedTexture(bitmapWidth, bitmapHeight, alphaChannelType, packedTexturesPool,
+            [this, pageSize, packedTexturesPool, textureFormat]
+            () -> PackedTextureInGPU*
+            {
+                // Allocate texture id
+                GLuint texture;
+                glGenTextures(1, &texture);
+                GL_CHECK_RESULT;
+                assert(texture != 0);
+
+                // Select this texture
+                glBindTexture(GL_TEXTURE_2D, texture);
+                GL_CHECK_RESULT;
+
+                // Allocate space for this texture
+                allocateTexture2D(GL_TEXTURE_2D, 1, pageSize, pageSize, textureFormat);
+                GL_CHECK_RESULT;
+
+                // Set maximal mipmap level to 0
+                setMipMapLevelsLimit(GL_TEXTURE_2D, 0);
+
+                // Deselect texture
+                glBindTexture(GL_TEXTURE_2D, 0);
+                GL_CHECK_RESULT;
+
+                return new PackedTextureInGPU(
+                    this,
+                    reinterpret_cast<RefInGPU>(texture),
+                    pageSize,
+                    packedTexturesPool);
+            });
+
+        if (slotInGPU)
+        {
+            // Copy bitmap into center of cleared padded area
+            const auto padding = packedTexturesPool->padding;
+            const auto paddedWidth = bitmapWidth + 2 * padding;
+            const auto paddedHeight = bitmapHeight + 2 * padding;
+            QByteArray paddedData(paddedWidth * paddedHeight * sourcePixelByteSize, 0);
+            const auto pSourceData = reinterpret_cast<const char*>(symbol->bitmap->getPixels());
+            for (auto row = 0; row < bitmapHeight; row++)
+            {
+                memcpy(
+                    paddedData.data() + ((row + padding) * paddedWidth + padding) * sourcePixelByteSize,
+                    pSourceData + row * symbol->bitmap->rowBytes(),
+                    bitmapWidth * sourcePixelByteSize);
+            }
+
+            // Select page as active texture
+            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(slotInGPU->refInGPU)));
+            GL_CHECK_RESULT;
+
+            // Upload data
+            uploadDataToTexture2D(GL_TEXTURE_2D, 0,
+                slotInGPU->area.left() - padding, slotInGPU->area.top() - padding,
+                (GLsizei)paddedWidth, (GLsizei)paddedHeight,
+                paddedData.constData(), paddedWidth, sourcePixelByteSize,
+                getSourceFormat(symbol));
+
+            // Deselect page as active texture
+            glBindTexture(GL_TEXTURE_2D, 0);
+            GL_CHECK_RESULT;
+
+            resourceInGPU = slotInGPU;
+
+            return true;
+        }
+    }
+
     // Symbols don't use mipmapping, so there is no difference between POT vs NPOT size of texture.
     // In OpenGLES 2.0 and OpenGL 2.0+, NPOT textures are supported in general.
     // OpenGLES 2.0 has some limitations without isSupported_texturesNPOT:
@@ -172,6 +172,11 @@ namespace OsmAnd
             }
         };
 
+        enum {
+            SymbolsTexturePageSize = 1024,
+            SymbolsTexturePagePadding = 1,
+        };
+
         struct GlslProgramVariable
         {
             GlslVariableType type;
@@ -3,6 +3,7 @@
 
 #include "QtCommon.h"
 #include <QReadWriteLock>
+#include <QMutexLocker>
 
 #include "ignore_warnings_on_external_includes.h"
 #include <SkBlurDrawLooper.h>
@@ -34,7 +35,8 @@
 #endif // OSMAND_DUMP_SYMBOLS
 
 OsmAnd::SymbolRasterizer_P::SymbolRasterizer_P(SymbolRasterizer* const owner_)
-    : owner(owner_)
+    : _rasterizedContentCachePurgeThreshold(RasterizedContentCacheMinPurgeThreshold)
+    , owner(owner_)
 {
 }
 
@@ -42,6 +44,43 @@ OsmAnd::SymbolRasterizer_P::~SymbolRasterizer_P()
 {
 }
 
+void OsmAnd::SymbolRasterizer_P::validateRasterizedContentCache(
+    const std::shared_ptr<const MapPresentationEnvironment>& environment) const
+{
+    // Rasterized contents depend on icons, shields and fonts of environment
+    if (_rasterizedContentCacheEnvironment.lock() != environment)
+    {
+        _rasterizedTextsCache.clear();
+        _rasterizedIconsCache.clear();
+        _rasterizedContentCacheEnvironment = environment;
+    }
+
+    if (_rasterizedTextsCache.size() + _rasterizedIconsCache.size() >= _rasterizedContentCachePurgeThreshold)
+    {
+        purgeRasterizedContentCache();
+        _rasterizedContentCachePurgeThreshold = qMax<int>(
+            RasterizedContentCacheMinPurgeThreshold,
+            2 * (_rasterizedTextsCache.size() + _rasterizedIconsCache.size()));
+    }
+}
+
+void OsmAnd::SymbolRasterizer_P::purgeRasterizedContentCache() const
+{
+    auto itTextEntry = mutableIteratorOf(_rasterizedTextsCache);
+    while (itTextEntry.hasNext())
+    {
+        if (itTextEntry.next().value().bitmap.expired())
+            itTextEntry.remove();
+    }
+
+    auto itIconEntry = mutableIteratorOf(_rasterizedIconsCache);
+    while (itIconEntry.hasNext())
+    {
+        if (itIconEntry.next().value().expired())
+            itIconEntry.remove();
+    }
+}
+
 void OsmAnd::SymbolRasterizer_P::rasterize(
     const std::shared_ptr<const MapPrimitiviser::PrimitivisedObjects>& primitivisedObjects,
     QList< std::shared_ptr<const RasterizedSymbolsGroup> >& outSymbolsGroups,
@@ -87,18 +126,6 @@ void OsmAnd::SymbolRasterizer_P::rasterize(
                 TextRasterizer::Style style;
                 if (!textSymbol->drawOnPath && textSymbol->shieldResourceName.isEmpty())
                     style.wrapWidth = textSymbol->wrapWidth;
-                if (!textSymbol->shieldResourceName.isEmpty())
-                {
-                    env->obtainTextShield(textSymbol->shieldResourceName, style.backgroundBitmap);
-
-                    if (!qFuzzyCompare(textSymbol->scaleFactor, 1.0f) && style.backgroundBitmap)
-                    {
-                        style.backgroundBitmap = SkiaUtilities::scaleBitmap(
-                            style.backgroundBitmap,
-                            textSymbol->scaleFactor,
-                            textSymbol->scaleFactor);
-                    }
-                }
                 style
                     .setBold(textSymbol->isBold)
                     .setItalic(textSymbol->isItalic)
@@ -112,19 +139,74 @@ void OsmAnd::SymbolRasterizer_P::rasterize(
                         .setHaloRadius(textSymbol->shadowRadius);
                 }
 
+                const auto contentKey = QString::fromLatin1("%1;%2;%3;%4;%5;%6;%7;%8;%9;")
+                    .arg(textSymbol->drawOnPath ? 1 : 0)
+                    .arg(style.wrapWidth)
+                    .arg(style.bold ? 1 : 0)
+                    .arg(style.italic ? 1 : 0)
+                    .arg(style.color.argb)
+                    .arg(style.size)
+                    .arg(style.haloColor.argb)
+                    .arg(style.haloRadius)
+                    .arg(textSymbol->scaleFactor) + textSymbol->shieldResourceName + QLatin1Char('\n') + textSymbol->value;
+
                 float lineSpacing;
                 float symbolExtraTopSpace;
                 float symbolExtraBottomSpace;
                 QVector<SkScalar> glyphsWidth;
-                const auto rasterizedText = owner->textRasterizer->rasterize(
-                    textSymbol->value,
-                    style,
-                    textSymbol->drawOnPath ? &glyphsWidth : nullptr,
-                    &symbolExtraTopSpace,
-                    &symbolExtraBottomSpace,
-                    &lineSpacing);
+                std::shared_ptr<const SkBitmap> rasterizedText;
+                {
+                    QMutexLocker scopedLocker(&_rasterizedContentCacheMutex);
+
+                    validateRasterizedContentCache(env);
+                    const auto citEntry = _rasterizedTextsCache.constFind(contentKey);
+                    if (citEntry != _rasterizedTextsCache.cend())
+                    {
+                        rasterizedText = citEntry->bitmap.lock();
+                        if (rasterizedText)
+                        {
+                            glyphsWidth = citEntry->glyphsWidth;
+                            symbolExtraTopSpace = citEntry->extraTopSpace;
+                            symbolExtraBottomSpace = citEntry->extraBottomSpace;
+                            lineSpacing = citEntry->lineSpacing;
+                        }
+                    }
+                }
                 if (!rasterizedText)
-                    continue;
+                {
+                    if (!textSymbol->shieldResourceName.isEmpty())
+                    {
+                        env->obtainTextShield(textSymbol->shieldResourceName, style.backgroundBitmap);
+
+                        if (!qFuzzyCompare(textSymbol->scaleFactor, 1.0f) && style.backgroundBitmap)
+                        {
+                            style.backgroundBitmap = SkiaUtilities::scaleBitmap(
+                                style.backgroundBitmap,
+                                textSymbol->scaleFactor,
+                                textSymbol->scaleFactor);
+                        }
+                    }
+
+                    rasterizedText = owner->textRasterizer->rasterize(
+                        textSymbol->value,
+                        style,
+                        textSymbol->drawOnPath ? &glyphsWidth : nullptr,
+                        &symbolExtraTopSpace,
+                        &symbolExtraBottomSpace,
+                        &lineSpacing);
+                    if (!rasterizedText)
+                        continue;
+
+                    QMutexLocker scopedLocker(&_rasterizedContentCacheMutex);
+
+                    RasterizedTextEntry entry;
+                    entry.bitmap = rasterizedText;
+                    entry.glyphsWidth = glyphsWidth;
+                    entry.extraTopSpace = symbolExtraTopSpace;
+                    entry.extraBottomSpace = symbolExtraBottomSpace;
+                    entry.lineSpacing = lineSpacing;
+                    _rasterizedTextsCache.insert(contentKey, entry);
+                }
 
 #if OSMAND_DUMP_SYMBOLS
                 {
@@ -225,54 +307,76 @@ void OsmAnd::SymbolRasterizer_P::rasterize(
             }
             else if (const auto& iconSymbol = std::dynamic_pointer_cast<const MapPrimitiviser::IconSymbol>(symbol))
             {
-                std::shared_ptr<const SkBitmap> iconBitmap;
-                if (!env->obtainMapIcon(iconSymbol->resourceName, iconBitmap) || !iconBitmap)
-                    continue;
-                if (!qFuzzyCompare(iconSymbol->scaleFactor, 1.0f))
-                {
-                    iconBitmap = SkiaUtilities::scaleBitmap(
-                        iconBitmap,
-                        iconSymbol->scaleFactor,
-                        iconSymbol->scaleFactor);
-                }
+                const auto contentKey = QString::number(iconSymbol->scaleFactor) + QLatin1Char(';') +
+                    iconSymbol->shieldResourceName + QLatin1Char(';') +
+                    QStringList(iconSymbol->underlayResourceNames).join(QLatin1Char(',')) + QLatin1Char(';') +
+                    QStringList(iconSymbol->overlayResourceNames).join(QLatin1Char(',')) + QLatin1Char(';') +
+                    iconSymbol->resourceName;
 
-                std::shared_ptr<const SkBitmap> backgroundBitmap;
-                if (!iconSymbol->shieldResourceName.isEmpty())
+                std::shared_ptr<const SkBitmap> rasterizedIcon;
                 {
-                    env->obtainIconShield(iconSymbol->shieldResourceName, backgroundBitmap);
+                    QMutexLocker scopedLocker(&_rasterizedContentCacheMutex);
 
-                    if (!qFuzzyCompare(iconSymbol->scaleFactor, 1.0f) && backgroundBitmap)
+                    validateRasterizedContentCache(env);
+                    rasterizedIcon = _rasterizedIconsCache.value(contentKey).lock();
+                }
+                if (!rasterizedIcon)
+                {
+                    std::shared_ptr<const SkBitmap> iconBitmap;
+                    if (!env->obtainMapIcon(iconSymbol->resourceName, iconBitmap) || !iconBitmap)
+                        continue;
+                    if (!qFuzzyCompare(iconSymbol->scaleFactor, 1.0f))
                     {
-                        backgroundBitmap = SkiaUtilities::scaleBitmap(
-                            backgroundBitmap,
+                        iconBitmap = SkiaUtilities::scaleBitmap(
+                            iconBitmap,
                             iconSymbol->scaleFactor,
                             iconSymbol->scaleFactor);
                     }
-                }
 
-                QList< std::shared_ptr<const SkBitmap> > layers;
-                if (backgroundBitmap)
-                    layers.push_back(backgroundBitmap);
-                for (const auto& overlayResourceName : constOf(iconSymbol->underlayResourceNames))
-                {
-                    std::shared_ptr<const SkBitmap> underlayBitmap;
-                    if (!env->obtainMapIcon(overlayResourceName, underlayBitmap) || !underlayBitmap)
-                        continue;
+                    std::shared_ptr<const SkBitmap> backgroundBitmap;
+                    if (!iconSymbol->shieldResourceName.isEmpty())
+                    {
+                        env->obtainIconShield(iconSymbol->shieldResourceName, backgroundBitmap);
+
+                        if (!qFuzzyCompare(iconSymbol->scaleFactor, 1.0f) && backgroundBitmap)
+                        {
+                            backgroundBitmap = SkiaUtilities::scaleBitmap(
+                                backgroundBitmap,
+                                iconSymbol->scaleFactor,
+                                iconSymbol->scaleFactor);
+                        }
+                    }
 
-                    layers.push_back(underlayBitmap);
-                }
-                layers.push_back(iconBitmap);
-                for (const auto& overlayResourceName : constOf(iconSymbol->overlayResourceNames))
-                {
-                    std::shared_ptr<const SkBitmap> overlayBitmap;
-                    if (!env->obtainMapIcon(overlayResourceName, overlayBitmap) || !overlayBitmap)
+                    QList< std::shared_ptr<const SkBitmap> > layers;
+                    if (backgroundBitmap)
+                        layers.push_back(backgroundBitmap);
+                    for (const auto& overlayResourceName : constOf(iconSymbol->underlayResourceNames))
+                    {
+                        std::shared_ptr<const SkBitmap> underlayBitmap;
+                        if (!env->obtainMapIcon(overlayResourceName, underlayBitmap) || !underlayBitmap)
+                            continue;
+
+                        layers.push_back(underlayBitmap);
+                    }
+                    layers.push_back(iconBitmap);
+                    for (const auto& overlayResourceName : constOf(iconSymbol->overlayResourceNames))
+                    {
+                        std::shared_ptr<const SkBitmap> overlayBitmap;
+                        if (!env->obtainMapIcon(overlayResourceName, overlayBitmap) || !overlayBitmap)
+                            continue;
+
+                        layers.push_back(overlayBitmap);
+                    }
+
+                    // Compose final image
+                    rasterizedIcon = SkiaUtilities::mergeBitmaps(layers);
+                    if (!rasterizedIcon)
                         continue;
 
-                    layers.push_back(overlayBitmap);
-                }
+                    QMutexLocker scopedLocker(&_rasterizedContentCacheMutex);
 
-                // Compose final image
-                const auto rasterizedIcon = SkiaUtilities::mergeBitmaps(layers);
+                    _rasterizedIconsCache.insert(contentKey, rasterizedIcon);
+                }
 
 #if OSMAND_DUMP_SYMBOLS
                 {
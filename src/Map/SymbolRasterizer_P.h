@@ -8,6 +8,8 @@
 #include "ignore_warnings_on_external_includes.h"
 #include <QList>
 #include <QVector>
+#include <QHash>
+#include <QMutex>
 #include "restore_internal_warnings.h"
 
 #include "ignore_warnings_on_external_includes.h"
@@ -25,6 +27,7 @@ namespace OsmAnd
 {
     class MapObject;
     class IQueryController;
+    class MapPresentationEnvironment;
 
     class SymbolRasterizer_P Q_DECL_FINAL
     {
@@ -36,6 +39,27 @@ namespace OsmAnd
         typedef SymbolRasterizer::FilterByMapObject FilterByMapObject;
 
     private:
+        // Rasterized contents are shared by all symbols with same content and style. Entries don't own
+        // bitmaps, so bitmap lives as long as any symbol references it.
+        struct RasterizedTextEntry
+        {
+            std::weak_ptr<const SkBitmap> bitmap;
+            QVector<SkScalar> glyphsWidth;
+            float extraTopSpace;
+            float extraBottomSpace;
+            float lineSpacing;
+        };
+        mutable QMutex _rasterizedContentCacheMutex;
+        mutable std::weak_ptr<const MapPresentationEnvironment> _rasterizedContentCacheEnvironment;
+        mutable QHash<QString, RasterizedTextEntry> _rasterizedTextsCache;
+        mutable QHash<QString, std::weak_ptr<const SkBitmap> > _rasterizedIconsCache;
+        mutable int _rasterizedContentCachePurgeThreshold;
+        enum {
+            RasterizedContentCacheMinPurgeThreshold = 1024,
+        };
+
+        void validateRasterizedContentCache(const std::shared_ptr<const MapPresentationEnvironment>& environment) const;
+        void purgeRasterizedContentCache() const;
     protected:
         SymbolRasterizer_P(SymbolRasterizer* const owner);
     public:
@@ -0,0 +1,260 @@
+#include "TextureAtlasPacker.h"
+
+#include <cassert>
+#include <limits>
+
+OsmAnd::TextureAtlasPacker::TextureAtlasPacker(
+    const unsigned int width_,
+    const unsigned int height_,
+    const unsigned int padding_)
+    : _shelvesBottom(0)
+    , _allocationsCount(0)
+    , _allocatedArea(0)
+    , width(width_)
+    , height(height_)
+    , padding(padding_)
+{
+}
+
+OsmAnd::TextureAtlasPacker::~TextureAtlasPacker()
+{
+}
+
+bool OsmAnd::TextureAtlasPacker::canFit(const unsigned int width_, const unsigned int height_) const
+{
+    return (width_ + 2 * padding <= width) && (height_ + 2 * padding <= height);
+}
+
+bool OsmAnd::TextureAtlasPacker::allocate(const unsigned int width_, const unsigned int height_, AreaI& outArea)
+{
+    if (width_ == 0 || height_ == 0 || !canFit(width_, height_))
+        return false;
+    const int paddedWidth = width_ + 2 * padding;
+    const int paddedHeight = height_ + 2 * padding;
+
+    // Look for shelf that wastes least height. Non-empty shelves are accepted only if they are not much
+    // taller than needed, otherwise new shelf is preferred while page has unused space.
+    int bestShelfIndex = -1;
+    int bestSpanIndex = -1;
+    int bestHeightWaste = std::numeric_limits<int>::max();
+    int fallbackShelfIndex = -1;
+    int fallbackSpanIndex = -1;
+    int fallbackHeightWaste = std::numeric_limits<int>::max();
+    for (auto shelfIndex = 0, shelvesCount = _shelves.size(); shelfIndex < shelvesCount; shelfIndex++)
+    {
+        const auto& shelf = _shelves[shelfIndex];
+        if (shelf.height < paddedHeight)
+            continue;
+
+        int spanIndex = -1;
+        for (auto index = 0, spansCount = shelf.freeSpans.size(); index < spansCount; index++)
+        {
+            if (shelf.freeSpans[index].width >= paddedWidth)
+            {
+                spanIndex = index;
+                break;
+            }
+        }
+        if (spanIndex < 0)
+            continue;
+
+        const auto heightWaste = shelf.allocationsCount > 0 ? shelf.height - paddedHeight : 0;
+        if (shelf.allocationsCount == 0 || heightWaste * 4 <= shelf.height)
+        {
+            if (heightWaste < bestHeightWaste)
+            {
+                bestShelfIndex = shelfIndex;
+                bestSpanIndex = spanIndex;
+                bestHeightWaste = heightWaste;
+            }
+        }
+        else if (heightWaste < fallbackHeightWaste)
+        {
+            fallbackShelfIndex = shelfIndex;
+            fallbackSpanIndex = spanIndex;
+            fallbackHeightWaste = heightWaste;
+        }
+    }
+
+    if (bestShelfIndex < 0)
+    {
+        if (_shelvesBottom + paddedHeight <= static_cast<int>(height))
+        {
+            bestShelfIndex = _shelves.size();
+            bestSpanIndex = 0;
+            insertShelf(bestShelfIndex, _shelvesBottom, paddedHeight);
+            _shelvesBottom += paddedHeight;
+        }
+        else if (fallbackShelfIndex >= 0)
+        {
+            bestShelfIndex = fallbackShelfIndex;
+            bestSpanIndex = fallbackSpanIndex;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    auto& shelf = _shelves[bestShelfIndex];
+
+    // Empty shelf is shrunk to needed height, rest of it becomes new empty shelf
+    if (shelf.allocationsCount == 0 && shelf.height > paddedHeight)
+    {
+        const auto restTop = shelf.top + paddedHeight;
+        const auto restHeight = shelf.height - paddedHeight;
+        shelf.height = paddedHeight;
+        insertShelf(bestShelfIndex + 1, restTop, restHeight);
+    }
+
+    auto& span = _shelves[bestShelfIndex].freeSpans[bestSpanIndex];
+    outArea.left() = span.left + padding;
+    outArea.top() = _shelves[bestShelfIndex].top + padding;
+    outArea.right() = outArea.left() + width_;
+    outArea.bottom() = outArea.top() + height_;
+
+    span.left += paddedWidth;
+    span.width -= paddedWidth;
+    if (span.width == 0)
+        _shelves[bestShelfIndex].freeSpans.remove(bestSpanIndex);
+
+    _shelves[bestShelfIndex].allocationsCount++;
+    _allocationsCount++;
+    _allocatedArea += static_cast<uint64_t>(paddedWidth) * paddedHeight;
+
+    return true;
+}
+
+bool OsmAnd::TextureAtlasPacker::release(const AreaI& area)
+{
+    const int paddedLeft = area.left() - padding;
+    const int paddedTop = area.top() - padding;
+    const int paddedWidth = area.width() + 2 * padding;
+    const int paddedHeight = area.height() + 2 * padding;
+
+    int shelfIndex = -1;
+    for (auto index = 0, shelvesCount = _shelves.size(); index < shelvesCount; index++)
+    {
+        if (_shelves[index].top == paddedTop)
+        {
+            shelfIndex = index;
+            break;
+        }
+    }
+    if (shelfIndex < 0 || _shelves[shelfIndex].allocationsCount == 0)
+    {
+        assert(false);
+        return false;
+    }
+    auto& shelf = _shelves[shelfIndex];
+
+    // Insert freed span keeping spans sorted and coalesce it with adjacent ones
+    auto& freeSpans = shelf.freeSpans;
+    auto insertIndex = 0;
+    while (insertIndex < freeSpans.size() && freeSpans[insertIndex].left < paddedLeft)
+        insertIndex++;
+    const bool mergesWithPrevious =
+        insertIndex > 0 &&
+        freeSpans[insertIndex - 1].left + freeSpans[insertIndex - 1].width == paddedLeft;
+    const bool mergesWithNext =
+        insertIndex < freeSpans.size() &&
+        paddedLeft + paddedWidth == freeSpans[insertIndex].left;
+    if (mergesWithPrevious && mergesWithNext)
+    {
+        freeSpans[insertIndex - 1].width += paddedWidth + freeSpans[insertIndex].width;
+        freeSpans.remove(insertIndex);
+    }
+    else if (mergesWithPrevious)
+    {
+        freeSpans[insertIndex - 1].width += paddedWidth;
+    }
+    else if (mergesWithNext)
+    {
+        freeSpans[insertIndex].left = paddedLeft;
+        freeSpans[insertIndex].width += paddedWidth;
+    }
+    else
+    {
+        Span span;
+        span.left = paddedLeft;
+        span.width = paddedWidth;
+        freeSpans.insert(insertIndex, span);
+    }
+
+    shelf.allocationsCount--;
+    _allocationsCount--;
+    _allocatedArea -= static_cast<uint64_t>(paddedWidth) * paddedHeight;
+
+    if (shelf.allocationsCount == 0)
+        defragmentShelves(shelfIndex);
+
+    return true;
+}
+
+void OsmAnd::TextureAtlasPacker::clear()
+{
+    _shelves.clear();
+    _shelvesBottom = 0;
+    _allocationsCount = 0;
+    _allocatedArea = 0;
+}
+
+bool OsmAnd::TextureAtlasPacker::isEmpty() const
+{
+    return _allocationsCount == 0;
+}
+
+unsigned int OsmAnd::TextureAtlasPacker::getAllocationsCount() const
+{
+    return _allocationsCount;
+}
+
+unsigned int OsmAnd::TextureAtlasPacker::getShelvesCount() const
+{
+    return _shelves.size();
+}
+
+float OsmAnd::TextureAtlasPacker::getOccupancy() const
+{
+    return static_cast<float>(static_cast<double>(_allocatedArea) / (static_cast<double>(width) * height));
+}
+
+void OsmAnd::TextureAtlasPacker::insertShelf(const int index, const int top, const int height_)
+{
+    Shelf shelf;
+    shelf.top = top;
+    shelf.height = height_;
+    shelf.allocationsCount = 0;
+
+    Span span;
+    span.left = 0;
+    span.width = width;
+    shelf.freeSpans.push_back(span);
+
+    _shelves.insert(index, shelf);
+}
+
+void OsmAnd::TextureAtlasPacker::defragmentShelves(int shelfIndex)
+{
+    // Merge emptied shelf with following empty shelf
+    if (shelfIndex + 1 < _shelves.size() && _shelves[shelfIndex + 1].allocationsCount == 0)
+    {
+        _shelves[shelfIndex].height += _shelves[shelfIndex + 1].height;
+        _shelves.removeAt(shelfIndex + 1);
+    }
+
+    // Merge emptied shelf with preceding empty shelf
+    if (shelfIndex > 0 && _shelves[shelfIndex - 1].allocationsCount == 0)
+    {
+        _shelves[shelfIndex - 1].height += _shelves[shelfIndex].height;
+        _shelves.removeAt(shelfIndex);
+        shelfIndex--;
+    }
+
+    // Trailing empty shelf is returned to unused space of page
+    if (shelfIndex == _shelves.size() - 1)
+    {
+        _shelvesBottom = _shelves[shelfIndex].top;
+        _shelves.removeAt(shelfIndex);
+    }
+}
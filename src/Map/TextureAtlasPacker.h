@@ -0,0 +1,73 @@
+#ifndef _OSMAND_CORE_TEXTURE_ATLAS_PACKER_H_
+#define _OSMAND_CORE_TEXTURE_ATLAS_PACKER_H_
+
+#include "stdlib_common.h"
+
+#include "QtExtensions.h"
+#include <QList>
+#include <QVector>
+
+#include "OsmAndCore.h"
+#include "CommonTypes.h"
+
+namespace OsmAnd
+{
+    // Shelf packer of rectangles of arbitrary size into single page of fixed size. Doesn't depend on GPU.
+    // Each shelf is a row of page that holds rectangles not taller than shelf itself. Free space of shelf
+    // is kept as sorted list of spans that are coalesced on release. Emptied shelves are merged with
+    // adjacent empty shelves and trailing empty shelves are returned to unused space of page,
+    // so page gets defragmented as rectangles are released.
+    class TextureAtlasPacker Q_DECL_FINAL
+    {
+    private:
+        struct Span
+        {
+            int left;
+            int width;
+        };
+
+        struct Shelf
+        {
+            int top;
+            int height;
+            int allocationsCount;
+            QVector<Span> freeSpans;
+        };
+
+        QList<Shelf> _shelves;
+        int _shelvesBottom;
+        unsigned int _allocationsCount;
+        uint64_t _allocatedArea;
+
+        void insertShelf(const int index, const int top, const int height);
+        void defragmentShelves(int shelfIndex);
+    protected:
+    public:
+        TextureAtlasPacker(
+            const unsigned int width,
+            const unsigned int height,
+            const unsigned int padding = 0);
+        ~TextureAtlasPacker();
+
+        const unsigned int width;
+        const unsigned int height;
+        const unsigned int padding;
+
+        // Checks if rectangle of given size (padding excluded) can ever fit this page
+        bool canFit(const unsigned int width, const unsigned int height) const;
+
+        // Returns area of rectangle (padding excluded), right and bottom are exclusive
+        bool allocate(const unsigned int width, const unsigned int height, AreaI& outArea);
+        bool release(const AreaI& area);
+        void clear();
+
+        bool isEmpty() const;
+        unsigned int getAllocationsCount() const;
+        unsigned int getShelvesCount() const;
+
+        // Share of page area occupied by allocated rectangles (padding included)
+        float getOccupancy() const;
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_TEXTURE_ATLAS_PACKER_H_)
@@ -19,6 +19,59 @@
 #include "Street.h"
 #include "IQueryController.h"
 #include "QKeyValueIterator.h"
+#include "Utilities.h"
+
+namespace OsmAnd
+{
+    namespace ObfDataInterface_P
+    {
+        // Names of categories are resolved to ids of categories of given section. False if section has no categories
+        static bool resolveCategoriesFilter(
+            const std::shared_ptr<const ObfReader>& obfReader,
+            const std::shared_ptr<const ObfPoiSectionInfo>& poiSection,
+            const QHash<QString, QStringList>& categoriesFilter,
+            QSet<ObfPoiCategoryId>& outCategoriesFilterById,
+            const std::shared_ptr<const IQueryController>& queryController)
+        {
+            std::shared_ptr<const ObfPoiSectionCategories> categories;
+            OsmAnd::ObfPoiSectionReader::loadCategories(
+                obfReader,
+                poiSection,
+                categories,
+                queryController);
+
+            if (!categories)
+                return false;
+
+            for (const auto& categoriesFilterEntry : rangeOf(constOf(categoriesFilter)))
+            {
+                const auto mainCategoryIndex = categories->mainCategories.indexOf(categoriesFilterEntry.key());
+                if (mainCategoryIndex < 0)
+                    continue;
+
+                const auto& subcategories = categories->subCategories[mainCategoryIndex];
+                if (categoriesFilterEntry.value().isEmpty())
+                {
+                    for (auto subCategoryIndex = 0; subCategoryIndex < subcategories.size(); subCategoryIndex++)
+                        outCategoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
+                }
+                else
+                {
+                    for (const auto& subcategory : constOf(categoriesFilterEntry.value()))
+                    {
+                        const auto subCategoryIndex = subcategories.indexOf(subcategory);
+                        if (subCategoryIndex < 0)
+                            continue;
+
+                        outCategoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
+                    }
+                }
+            }
+
+            return true;
+        }
+    }
+}
 
 OsmAnd::ObfDataInterface::ObfDataInterface(const QList< std::shared_ptr<const ObfReader> >& obfReaders_)
     : obfReaders(obfReaders_)
@@ -446,7 +499,8 @@ bool OsmAnd::ObfDataInterface::loadAmenities(
     const AreaI* const pBbox31 /*= nullptr*/,
     const QHash<QString, QStringList>* const categoriesFilter /*= nullptr*/,
     const ObfPoiSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    ObfPoiSectionReader_Metrics::Metric_loadAmenities* const metric /*= nullptr*/)
 {
     for (const auto& obfReader : constOf(obfReaders))
     {
@@ -471,42 +525,10 @@ bool OsmAnd::ObfDataInterface::loadAmenities(
             }
 
             QSet<ObfPoiCategoryId> categoriesFilterById;
-            if (categoriesFilter)
+            if (categoriesFilter &&
+                !ObfDataInterface_P::resolveCategoriesFilter(obfReader, poiSection, *categoriesFilter, categoriesFilterById, queryController))
             {
-                std::shared_ptr<const ObfPoiSectionCategories> categories;
-                OsmAnd::ObfPoiSectionReader::loadCategories(
-                    obfReader,
-                    poiSection,
-                    categories,
-                    queryController);
-
-                if (!categories)
-                    continue;
-
-                for (const auto& categoriesFilterEntry : rangeOf(constOf(*categoriesFilter)))
-                {
-                    const auto mainCategoryIndex = categories->mainCategories.indexOf(categoriesFilterEntry.key());
-                    if (mainCategoryIndex < 0)
-                        continue;
-
-                    const auto& subcategories = categories->subCategories[mainCategoryIndex];
-                    if (categoriesFilterEntry.value().isEmpty())
-                    {
-                        for (auto subCategoryIndex = 0; subCategoryIndex < subcategories.size(); subCategoryIndex++)
-                            categoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
-                    }
-                    else
-                    {
-                        for (const auto& subcategory : constOf(categoriesFilterEntry.value()))
-                        {
-                            const auto subCategoryIndex = subcategories.indexOf(subcategory);
-                            if (subCategoryIndex < 0)
-                                continue;
-
-                            categoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
-                        }
-                    }
-                }
+                continue;
             }
 
             OsmAnd::ObfPoiSectionReader::loadAmenities(
@@ -518,13 +540,83 @@ bool OsmAnd::ObfDataInterface::loadAmenities(
                 pBbox31,
                 categoriesFilter ? &categoriesFilterById : nullptr,
                 visitor,
-                queryController);
+                queryController,
+                metric);
         }
     }
 
     return true;
 }
 
+bool OsmAnd::ObfDataInterface::loadNearestAmenities(
+    ObfPoiSectionReader::NearestAmenitiesCollector& collector,
+    const ZoomLevel minZoom /*= MinZoomLevel*/,
+    const ZoomLevel maxZoom /*= MaxZoomLevel*/,
+    const AreaI* const pBbox31 /*= nullptr*/,
+    const QHash<QString, QStringList>* const categoriesFilter /*= nullptr*/,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    struct SectionEntry
+    {
+        std::shared_ptr<const ObfReader> obfReader;
+        std::shared_ptr<const ObfPoiSectionInfo> poiSection;
+        double distance;
+    };
+    QList<SectionEntry> sectionEntries;
+    for (const auto& obfReader : constOf(obfReaders))
+    {
+        const auto& obfInfo = obfReader->obtainInfo();
+        for (const auto& poiSection : constOf(obfInfo->poiSections))
+        {
+            if (pBbox31 && !poiSection->area31.intersects(*pBbox31))
+                continue;
+
+            SectionEntry sectionEntry;
+            sectionEntry.obfReader = obfReader;
+            sectionEntry.poiSection = poiSection;
+            sectionEntry.distance = Utilities::distance31(collector.point31, poiSection->area31);
+            sectionEntries.push_back(sectionEntry);
+        }
+    }
+    std::stable_sort(sectionEntries.begin(), sectionEntries.end(),
+        []
+        (const SectionEntry& l, const SectionEntry& r) -> bool
+        {
+            return l.distance < r.distance;
+        });
+
+    for (const auto& sectionEntry : constOf(sectionEntries))
+    {
+        if (queryController && queryController->isAborted())
+            return false;
+
+        if (sectionEntry.distance > collector.getMaxDistance())
+            break;
+
+        const auto& obfReader = sectionEntry.obfReader;
+        const auto& poiSection = sectionEntry.poiSection;
+
+        QSet<ObfPoiCategoryId> categoriesFilterById;
+        if (categoriesFilter &&
+            !ObfDataInterface_P::resolveCategoriesFilter(obfReader, poiSection, *categoriesFilter, categoriesFilterById, queryController))
+        {
+            continue;
+        }
+
+        OsmAnd::ObfPoiSectionReader::loadNearestAmenities(
+            obfReader,
+            poiSection,
+            collector,
+            minZoom,
+            maxZoom,
+            pBbox31,
+            categoriesFilter ? &categoriesFilterById : nullptr,
+            queryController);
+    }
+
+    return true;
+}
+
 bool OsmAnd::ObfDataInterface::scanAmenitiesByName(
     const QString& query,
     QList< std::shared_ptr<const OsmAnd::Amenity> >* outAmenities,
@@ -533,7 +625,8 @@ bool OsmAnd::ObfDataInterface::scanAmenitiesByName(
     const AreaI* const pBbox31 /*= nullptr*/,
     const QHash<QString, QStringList>* const categoriesFilter /*= nullptr*/,
     const ObfPoiSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    const unsigned int maxEditDistance /*= 0*/)
 {
     for (const auto& obfReader : constOf(obfReaders))
     {
@@ -558,42 +651,10 @@ bool OsmAnd::ObfDataInterface::scanAmenitiesByName(
             }
 
             QSet<ObfPoiCategoryId> categoriesFilterById;
-            if (categoriesFilter)
+            if (categoriesFilter &&
+                !ObfDataInterface_P::resolveCategoriesFilter(obfReader, poiSection, *categoriesFilter, categoriesFilterById, queryController))
             {
-                std::shared_ptr<const ObfPoiSectionCategories> categories;
-                OsmAnd::ObfPoiSectionReader::loadCategories(
-                    obfReader,
-                    poiSection,
-                    categories,
-                    queryController);
-
-                if (!categories)
-                    continue;
-
-                for (const auto& categoriesFilterEntry : rangeOf(constOf(*categoriesFilter)))
-                {
-                    const auto mainCategoryIndex = categories->mainCategories.indexOf(categoriesFilterEntry.key());
-                    if (mainCategoryIndex < 0)
-                        continue;
-
-                    const auto& subcategories = categories->subCategories[mainCategoryIndex];
-                    if (categoriesFilterEntry.value().isEmpty())
-                    {
-                        for (auto subCategoryIndex = 0; subCategoryIndex < subcategories.size(); subCategoryIndex++)
-                            categoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
-                    }
-                    else
-                    {
-                        for (const auto& subcategory : constOf(categoriesFilterEntry.value()))
-                        {
-                            const auto subCategoryIndex = subcategories.indexOf(subcategory);
-                            if (subCategoryIndex < 0)
-                                continue;
-
-                            categoriesFilterById.insert(ObfPoiCategoryId::create(mainCategoryIndex, subCategoryIndex));
-                        }
-                    }
-                }
+                continue;
             }
 
             OsmAnd::ObfPoiSectionReader::scanAmenitiesByName(
@@ -606,7 +667,8 @@ bool OsmAnd::ObfDataInterface::scanAmenitiesByName(
                 pBbox31,
                 categoriesFilter ? &categoriesFilterById : nullptr,
                 visitor,
-                queryController);
+                queryController,
+                maxEditDistance);
         }
     }
 
@@ -621,7 +683,8 @@ bool OsmAnd::ObfDataInterface::scanAddressesByName(
     const ObfAddressStreetGroupTypesMask streetGroupTypesFilter /*= fullObfAddressStreetGroupTypesMask()*/,
     const bool includeStreets /*= true*/,
     const ObfAddressSectionReader::VisitorFunction visitor /*= nullptr*/,
-    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/,
+    const unsigned int maxEditDistance /*= 0*/)
 {
     for (const auto& obfReader : constOf(obfReaders))
     {
@@ -654,7 +717,8 @@ bool OsmAnd::ObfDataInterface::scanAddressesByName(
                 streetGroupTypesFilter,
                 includeStreets,
                 visitor,
-                queryController);
+                queryController,
+                maxEditDistance);
         }
     }
 
@@ -859,3 +923,49 @@ bool OsmAnd::ObfDataInterface::loadIntersectionsFromStreets(
 
     return true;
 }
+
+bool OsmAnd::ObfDataInterface::reverseGeocode(
+    const PointI& position31,
+    ObfAddressSectionReader::ReverseGeocodingResult& outResult,
+    const double maxDistance /*= 1000.0*/,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    QVector<ObfAddressSectionReader::ReverseGeocodingResult> results;
+    results.push_back(outResult);
+    const auto success = reverseGeocode(QVector<PointI>() << position31, results, maxDistance, queryController);
+    outResult = results.first();
+    return success;
+}
+
+bool OsmAnd::ObfDataInterface::reverseGeocode(
+    const QVector<PointI>& positions31,
+    QVector<ObfAddressSectionReader::ReverseGeocodingResult>& outResults,
+    const double maxDistance /*= 1000.0*/,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    if (outResults.size() != positions31.size())
+        outResults.resize(positions31.size());
+
+    for (const auto& obfReader : constOf(obfReaders))
+    {
+        if (queryController && queryController->isAborted())
+            return false;
+
+        const auto& obfInfo = obfReader->obtainInfo();
+        for (const auto& addressSection : constOf(obfInfo->addressSections))
+        {
+            if (queryController && queryController->isAborted())
+                return false;
+
+            OsmAnd::ObfAddressSectionReader::reverseGeocode(
+                obfReader,
+                addressSection,
+                positions31,
+                outResults,
+                maxDistance,
+                queryController);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,472 @@
+#include "AddressesBatchSearch.h"
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QThreadPool>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include "restore_internal_warnings.h"
+
+#include "QtCommon.h"
+#include "ObfDataInterface.h"
+#include "ObfReader.h"
+#include "ObfAddressSectionReader.h"
+#include "Address.h"
+#include "StreetGroup.h"
+#include "Street.h"
+#include "Building.h"
+#include "ObfNameNormalizer.h"
+#include "ParallelSearchExecutor.h"
+#include "Stopwatch.h"
+
+namespace OsmAnd
+{
+    namespace AddressesBatchSearch_P
+    {
+        struct Group
+        {
+            // Normalized names of all queries of group start with it
+            QString prefix;
+            QVector<int> queriesIndices;
+        };
+
+        struct Candidate
+        {
+            std::shared_ptr<const ObfReader> obfReader;
+            std::shared_ptr<const Address> address;
+            QStringList normalizedNames;
+        };
+
+        struct StreetBuildings
+        {
+            QList< std::shared_ptr<const Building> > buildings;
+            QVector<QString> normalizedNames;
+        };
+
+        struct State
+        {
+            State(
+                const std::shared_ptr<const IObfsCollection>& obfsCollection_,
+                const QList<AddressesBatchSearch::Criteria>& queries_,
+                const ISearch::NewResultEntryCallback& newResultEntryCallback_)
+                : obfsCollection(obfsCollection_)
+                , queries(queries_)
+                , newResultEntryCallback(newResultEntryCallback_)
+            {
+            }
+
+            const std::shared_ptr<const IObfsCollection> obfsCollection;
+            const QList<AddressesBatchSearch::Criteria> queries;
+            const ISearch::NewResultEntryCallback newResultEntryCallback;
+
+            QVector<QString> normalizedNames;
+            QVector<QString> normalizedHouseNumbers;
+            QList<Group> groups;
+
+            QMutex mutex;
+            AddressesBatchSearch::Statistics statistics;
+        };
+
+        template<typename T>
+        static int compare(const T& l, const T& r)
+        {
+            return (l < r) ? -1 : ((r < l) ? 1 : 0);
+        }
+
+        // Queries of same region are scanned with same readers and same filters
+        static int compareRegions(const AddressesBatchSearch::Criteria& l, const AddressesBatchSearch::Criteria& r)
+        {
+            int result = compare(l.bbox31.isSet(), r.bbox31.isSet());
+            if (result == 0 && l.bbox31.isSet())
+            {
+                result = compare(l.bbox31->top(), r.bbox31->top());
+                if (result == 0)
+                    result = compare(l.bbox31->left(), r.bbox31->left());
+                if (result == 0)
+                    result = compare(l.bbox31->bottom(), r.bbox31->bottom());
+                if (result == 0)
+                    result = compare(l.bbox31->right(), r.bbox31->right());
+            }
+            if (result == 0)
+                result = compare(l.minZoomLevel, r.minZoomLevel);
+            if (result == 0)
+                result = compare(l.maxZoomLevel, r.maxZoomLevel);
+            if (result == 0)
+            {
+                result = compare(
+                    static_cast<uint64_t>(l.streetGroupTypesMask),
+                    static_cast<uint64_t>(r.streetGroupTypesMask));
+            }
+            if (result == 0)
+                result = compare(l.includeStreets, r.includeStreets);
+            return result;
+        }
+
+        static QString computeCommonPrefix(const QString& l, const QString& r)
+        {
+            const auto length = qMin(l.size(), r.size());
+            auto commonLength = 0;
+            while (commonLength < length && l.at(commonLength) == r.at(commonLength))
+                commonLength++;
+            return l.left(commonLength);
+        }
+
+        static QStringList collectNormalizedNames(const Address& address)
+        {
+            const QString* pNativeName = nullptr;
+            const QHash<QString, QString>* pLocalizedNames = nullptr;
+            switch (address.addressType)
+            {
+                case AddressType::StreetGroup:
+                {
+                    const auto& streetGroup = static_cast<const StreetGroup&>(address);
+                    pNativeName = &streetGroup.nativeName;
+                    pLocalizedNames = &streetGroup.localizedNames;
+                    break;
+                }
+                case AddressType::Street:
+                {
+                    const auto& street = static_cast<const Street&>(address);
+                    pNativeName = &street.nativeName;
+                    pLocalizedNames = &street.localizedNames;
+                    break;
+                }
+            }
+
+            QStringList normalizedNames;
+            if (!pNativeName || !pLocalizedNames)
+                return normalizedNames;
+
+            normalizedNames.push_back(ObfNameNormalizer::normalize(*pNativeName));
+            for (const auto& localizedName : constOf(*pLocalizedNames))
+                normalizedNames.push_back(ObfNameNormalizer::normalize(localizedName));
+            return normalizedNames;
+        }
+
+        static bool matches(const Candidate& candidate, const QString& normalizedName)
+        {
+            for (const auto& candidateName : constOf(candidate.normalizedNames))
+            {
+                if (candidateName.contains(normalizedName))
+                    return true;
+            }
+            return false;
+        }
+
+        static void processGroup(
+            const std::shared_ptr<State>& state,
+            const Group& group,
+            const ObfDataInterface& dataInterface,
+            AddressesBatchSearch::Statistics& statistics,
+            const std::shared_ptr<const IQueryController>& queryController)
+        {
+            const auto& regionCriteria = state->queries[group.queriesIndices.first()];
+
+            // Names of all queries of group contain its prefix, so each of their candidates is found by it
+            const Stopwatch nameScansStopwatch(true);
+            QVector<Candidate> candidates;
+            for (const auto& obfReader : constOf(dataInterface.obfReaders))
+            {
+                QList< std::shared_ptr<const Address> > addresses;
+                ObfDataInterface(QList< std::shared_ptr<const ObfReader> >() << obfReader).scanAddressesByName(
+                    group.prefix,
+                    &addresses,
+                    regionCriteria.bbox31.getValuePtrOrNullptr(),
+                    regionCriteria.streetGroupTypesMask,
+                    regionCriteria.includeStreets,
+                    nullptr,
+                    queryController);
+                statistics.nameScansCount++;
+
+                for (const auto& address : constOf(addresses))
+                {
+                    Candidate candidate;
+                    candidate.obfReader = obfReader;
+                    candidate.address = address;
+                    candidates.push_back(candidate);
+                }
+            }
+            statistics.elapsedTimeForNameScans += nameScansStopwatch.elapsed();
+            statistics.candidatesCount += candidates.size();
+            if (queryController && queryController->isAborted())
+                return;
+
+            const Stopwatch matchingStopwatch(true);
+            auto elapsedTimeForBuildings = 0.0f;
+            for (auto& candidate : candidates)
+                candidate.normalizedNames = collectNormalizedNames(*candidate.address);
+
+            QList<AddressesBatchSearch::ResultEntry> results;
+            QHash<const Street*, StreetBuildings> buildingsByStreet;
+            for (const auto queryIndex : constOf(group.queriesIndices))
+            {
+                const auto& normalizedName = state->normalizedNames[queryIndex];
+                const auto& normalizedHouseNumber = state->normalizedHouseNumbers[queryIndex];
+
+                for (const auto& candidate : constOf(candidates))
+                {
+                    if (!matches(candidate, normalizedName))
+                        continue;
+
+                    AddressesBatchSearch::ResultEntry resultEntry;
+                    resultEntry.queryIndex = queryIndex;
+                    resultEntry.address = candidate.address;
+
+                    if (!normalizedHouseNumber.isEmpty() && candidate.address->addressType == AddressType::Street)
+                    {
+                        const Stopwatch buildingsStopwatch(true);
+
+                        const auto street = std::static_pointer_cast<const Street>(candidate.address);
+                        auto itStreetBuildings = buildingsByStreet.find(street.get());
+                        if (itStreetBuildings == buildingsByStreet.end())
+                        {
+                            StreetBuildings streetBuildings;
+                            ObfAddressSectionReader::loadBuildingsFromStreet(
+                                candidate.obfReader,
+                                street,
+                                &streetBuildings.buildings,
+                                nullptr,
+                                nullptr,
+                                queryController);
+                            for (const auto& building : constOf(streetBuildings.buildings))
+                                streetBuildings.normalizedNames.push_back(ObfNameNormalizer::normalize(building->nativeName));
+                            itStreetBuildings = buildingsByStreet.insert(street.get(), streetBuildings);
+                        }
+
+                        bool anyBuildingFound = false;
+                        const auto& streetBuildings = *itStreetBuildings;
+                        for (auto buildingIndex = 0; buildingIndex < streetBuildings.buildings.size(); buildingIndex++)
+                        {
+                            if (streetBuildings.normalizedNames[buildingIndex] != normalizedHouseNumber)
+                                continue;
+
+                            resultEntry.building = streetBuildings.buildings[buildingIndex];
+                            results.push_back(resultEntry);
+                            anyBuildingFound = true;
+                        }
+
+                        elapsedTimeForBuildings += buildingsStopwatch.elapsed();
+                        if (anyBuildingFound)
+                            continue;
+                        resultEntry.building.reset();
+                    }
+
+                    results.push_back(resultEntry);
+                }
+            }
+            statistics.elapsedTimeForMatching += matchingStopwatch.elapsed() - elapsedTimeForBuildings;
+            statistics.elapsedTimeForBuildings += elapsedTimeForBuildings;
+            if (queryController && queryController->isAborted())
+                return;
+
+            QMutexLocker scopedLocker(&state->mutex);
+
+            statistics.resultsCount += results.size();
+            if (state->newResultEntryCallback)
+            {
+                for (const auto& resultEntry : constOf(results))
+                    state->newResultEntryCallback(state->queries[resultEntry.queryIndex], resultEntry);
+            }
+        }
+
+        static void runWorker(
+            const std::shared_ptr<State>& state,
+            const ParallelSearchExecutor<Group>::TakeTaskFunction& takeGroup,
+            const std::shared_ptr<const IQueryController>& queryController)
+        {
+            AddressesBatchSearch::Statistics statistics;
+
+            // Groups are ordered by region, so worker usually takes next group of same region and keeps its readers
+            std::shared_ptr<ObfDataInterface> dataInterface;
+            int dataInterfaceQueryIndex = -1;
+            Group group;
+            while (takeGroup(group))
+            {
+                const auto& regionCriteria = state->queries[group.queriesIndices.first()];
+                if (!dataInterface || compareRegions(state->queries[dataInterfaceQueryIndex], regionCriteria) != 0)
+                {
+                    dataInterface = state->obfsCollection->obtainDataInterface(
+                        regionCriteria.bbox31.getValuePtrOrNullptr(),
+                        regionCriteria.minZoomLevel,
+                        regionCriteria.maxZoomLevel,
+                        ObfDataTypesMask().set(ObfDataType::Address),
+                        regionCriteria.sourceFilter);
+                    dataInterfaceQueryIndex = group.queriesIndices.first();
+                }
+
+                processGroup(state, group, *dataInterface, statistics, queryController);
+            }
+
+            QMutexLocker scopedLocker(&state->mutex);
+
+            state->statistics.nameScansCount += statistics.nameScansCount;
+            state->statistics.candidatesCount += statistics.candidatesCount;
+            state->statistics.resultsCount += statistics.resultsCount;
+            state->statistics.elapsedTimeForNameScans += statistics.elapsedTimeForNameScans;
+            state->statistics.elapsedTimeForMatching += statistics.elapsedTimeForMatching;
+            state->statistics.elapsedTimeForBuildings += statistics.elapsedTimeForBuildings;
+        }
+    }
+}
+
+OsmAnd::AddressesBatchSearch::AddressesBatchSearch(
+    const std::shared_ptr<const IObfsCollection>& obfsCollection_,
+    QThreadPool* const threadPool_ /*= nullptr*/)
+    : BaseSearch(obfsCollection_)
+    , _threadPool(threadPool_ ? threadPool_ : QThreadPool::globalInstance())
+{
+}
+
+OsmAnd::AddressesBatchSearch::~AddressesBatchSearch()
+{
+}
+
+void OsmAnd::AddressesBatchSearch::performSearch(
+    const ISearch::Criteria& criteria_,
+    const NewResultEntryCallback newResultEntryCallback,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/) const
+{
+    performBatchSearch(
+        QList<Criteria>() << *dynamic_cast<const Criteria*>(&criteria_),
+        newResultEntryCallback,
+        queryController);
+}
+
+OsmAnd::AddressesBatchSearch::Statistics OsmAnd::AddressesBatchSearch::performBatchSearch(
+    const QList<Criteria>& queries,
+    const NewResultEntryCallback newResultEntryCallback,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/) const
+{
+    using namespace AddressesBatchSearch_P;
+
+    const Stopwatch totalStopwatch(true);
+    const std::shared_ptr<State> state(new State(obfsCollection, queries, newResultEntryCallback));
+    state->statistics.queriesCount = queries.size();
+
+    // Queries are ordered by region and normalized name, so each group is a run of them
+    const Stopwatch groupingStopwatch(true);
+    QVector<int> queriesIndices;
+    state->normalizedNames.reserve(queries.size());
+    state->normalizedHouseNumbers.reserve(queries.size());
+    for (auto queryIndex = 0; queryIndex < queries.size(); queryIndex++)
+    {
+        const auto& query = queries[queryIndex];
+        state->normalizedNames.push_back(ObfNameNormalizer::normalize(query.name));
+        state->normalizedHouseNumbers.push_back(ObfNameNormalizer::normalize(query.houseNumber));
+
+        if (!state->normalizedNames.last().isEmpty())
+            queriesIndices.push_back(queryIndex);
+    }
+    const auto& normalizedNames = state->normalizedNames;
+    std::stable_sort(queriesIndices.begin(), queriesIndices.end(),
+        [&queries, &normalizedNames]
+        (const int l, const int r) -> bool
+        {
+            const auto regionsOrder = compareRegions(queries[l], queries[r]);
+            if (regionsOrder != 0)
+                return regionsOrder < 0;
+            return normalizedNames[l] < normalizedNames[r];
+        });
+    for (const auto queryIndex : constOf(queriesIndices))
+    {
+        const auto& normalizedName = normalizedNames[queryIndex];
+        if (!state->groups.isEmpty())
+        {
+            auto& group = state->groups.last();
+            const auto previousQueryIndex = group.queriesIndices.last();
+            if (compareRegions(queries[previousQueryIndex], queries[queryIndex]) == 0 &&
+                normalizedNames[previousQueryIndex].left(GroupingPrefixLength) ==
+                    normalizedName.left(GroupingPrefixLength))
+            {
+                group.prefix = computeCommonPrefix(group.prefix, normalizedName);
+                group.queriesIndices.push_back(queryIndex);
+                continue;
+            }
+        }
+
+        Group group;
+        group.prefix = normalizedName;
+        group.queriesIndices.push_back(queryIndex);
+        state->groups.push_back(group);
+    }
+    state->statistics.groupsCount = state->groups.size();
+    state->statistics.elapsedTimeForGrouping = groupingStopwatch.elapsed();
+
+    ParallelSearchExecutor<Group>::runWorkers(
+        _threadPool,
+        state->groups,
+        [state, queryController]
+        (const ParallelSearchExecutor<Group>::TakeTaskFunction& takeGroup)
+        {
+            runWorker(state, takeGroup, queryController);
+        },
+        queryController);
+
+    auto statistics = state->statistics;
+    statistics.elapsedTime = totalStopwatch.elapsed();
+    return statistics;
+}
+
+OsmAnd::AddressesBatchSearch::Criteria::Criteria()
+    : streetGroupTypesMask(fullObfAddressStreetGroupTypesMask())
+    , includeStreets(true)
+{
+}
+
+OsmAnd::AddressesBatchSearch::Criteria::~Criteria()
+{
+}
+
+OsmAnd::AddressesBatchSearch::ResultEntry::ResultEntry()
+    : queryIndex(-1)
+{
+}
+
+OsmAnd::AddressesBatchSearch::ResultEntry::~ResultEntry()
+{
+}
+
+OsmAnd::AddressesBatchSearch::Statistics::Statistics()
+    : queriesCount(0)
+    , groupsCount(0)
+    , nameScansCount(0)
+    , candidatesCount(0)
+    , resultsCount(0)
+    , elapsedTime(0.0f)
+    , elapsedTimeForGrouping(0.0f)
+    , elapsedTimeForNameScans(0.0f)
+    , elapsedTimeForMatching(0.0f)
+    , elapsedTimeForBuildings(0.0f)
+{
+}
+
+OsmAnd::AddressesBatchSearch::Statistics::~Statistics()
+{
+}
+
+float OsmAnd::AddressesBatchSearch::Statistics::getQueriesPerSecond() const
+{
+    return (elapsedTime > 0.0f) ? queriesCount / elapsedTime : 0.0f;
+}
+
+QString OsmAnd::AddressesBatchSearch::Statistics::toString(const QString& prefix /*= QString::null*/) const
+{
+    QString output;
+    output += prefix + QString(QLatin1String("queries = %1 (%2/s)")).arg(queriesCount).arg(getQueriesPerSecond());
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("groups = %1")).arg(groupsCount);
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("nameScans = %1")).arg(nameScansCount);
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("candidates = %1")).arg(candidatesCount);
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("results = %1")).arg(resultsCount);
+    output += QLatin1String("\n") + prefix + QString(QLatin1String("elapsedTime = %1s")).arg(elapsedTime);
+    output += QLatin1String("\n") + prefix +
+        QString(QLatin1String("elapsedTimeForGrouping = %1s")).arg(elapsedTimeForGrouping);
+    output += QLatin1String("\n") + prefix +
+        QString(QLatin1String("elapsedTimeForNameScans = %1s")).arg(elapsedTimeForNameScans);
+    output += QLatin1String("\n") + prefix +
+        QString(QLatin1String("elapsedTimeForMatching = %1s")).arg(elapsedTimeForMatching);
+    output += QLatin1String("\n") + prefix +
+        QString(QLatin1String("elapsedTimeForBuildings = %1s")).arg(elapsedTimeForBuildings);
+    return output;
+}
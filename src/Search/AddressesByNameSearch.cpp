@@ -3,6 +3,10 @@
 #include "ObfDataInterface.h"
 #include "ObfAddressSectionReader.h"
 #include "Address.h"
+#include "StreetGroup.h"
+#include "Street.h"
+#include "ObfNameNormalizer.h"
+#include "QtCommon.h"
 
 OsmAnd::AddressesByNameSearch::AddressesByNameSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection_)
     : BaseSearch(obfsCollection_)
@@ -40,11 +44,95 @@ void OsmAnd::AddressesByNameSearch::performSearch(
         criteria.streetGroupTypesMask,
         criteria.includeStreets,
         visitorFunction,
-        queryController);
+        queryController,
+        criteria.maxEditDistance);
+}
+
+std::shared_ptr<const OsmAnd::ISearch::Criteria> OsmAnd::AddressesByNameSearch::copyCriteria(
+    const ISearch::Criteria& criteria) const
+{
+    return std::shared_ptr<const ISearch::Criteria>(new Criteria(*dynamic_cast<const Criteria*>(&criteria)));
+}
+
+std::shared_ptr<const OsmAnd::ISearch::IResultEntry> OsmAnd::AddressesByNameSearch::copyResultEntry(
+    const IResultEntry& resultEntry) const
+{
+    return std::shared_ptr<const IResultEntry>(new ResultEntry(*dynamic_cast<const ResultEntry*>(&resultEntry)));
+}
+
+bool OsmAnd::AddressesByNameSearch::isNarrowing(
+    const ISearch::Criteria& criteria_,
+    const ISearch::Criteria& previousCriteria_) const
+{
+    const auto& criteria = *dynamic_cast<const Criteria*>(&criteria_);
+    const auto& previousCriteria = *dynamic_cast<const Criteria*>(&previousCriteria_);
+
+    // Addresses are found by prefix of name and then accepted if name contains query, so results for
+    // query that extends previous one are always among results for previous query
+    if (previousCriteria.name.isNull() ||
+        !ObfNameNormalizer::normalize(criteria.name).startsWith(ObfNameNormalizer::normalize(previousCriteria.name)))
+    {
+        return false;
+    }
+
+    // Typo-tolerant candidates of longer query are not guaranteed to be among ones of shorter query
+    if (criteria.maxEditDistance != 0 || previousCriteria.maxEditDistance != 0)
+        return false;
+
+    return
+        criteria.minZoomLevel == previousCriteria.minZoomLevel &&
+        criteria.maxZoomLevel == previousCriteria.maxZoomLevel &&
+        criteria.bbox31 == previousCriteria.bbox31 &&
+        criteria.streetGroupTypesMask == previousCriteria.streetGroupTypesMask &&
+        criteria.includeStreets == previousCriteria.includeStreets;
+}
+
+OsmAnd::BaseSearch::ResultEntryFilter OsmAnd::AddressesByNameSearch::createResultEntryFilter(
+    const ISearch::Criteria& criteria_) const
+{
+    const auto& criteria = *dynamic_cast<const Criteria*>(&criteria_);
+
+    // Remembered addresses carry names normalized when they were found, so only query is normalized here
+    const auto normalization = ObfNameNormalizer::lockNormalization();
+    const auto normalizedName = ObfNameNormalizer::normalize(criteria.name, normalization);
+    return
+        [normalization, normalizedName]
+        (const IResultEntry& resultEntry_) -> bool
+        {
+            const auto& resultEntry = *dynamic_cast<const ResultEntry*>(&resultEntry_);
+
+            switch (resultEntry.address->addressType)
+            {
+                case AddressType::StreetGroup:
+                {
+                    const auto& streetGroup = static_cast<const StreetGroup&>(*resultEntry.address);
+                    return ObfNameNormalizer::anyNameContains(
+                        streetGroup.nativeName,
+                        streetGroup.localizedNames,
+                        streetGroup.normalizedNames,
+                        normalizedName,
+                        normalization,
+                        0);
+                }
+                case AddressType::Street:
+                {
+                    const auto& street = static_cast<const Street&>(*resultEntry.address);
+                    return ObfNameNormalizer::anyNameContains(
+                        street.nativeName,
+                        street.localizedNames,
+                        street.normalizedNames,
+                        normalizedName,
+                        normalization,
+                        0);
+                }
+            }
+            return false;
+        };
 }
 
 OsmAnd::AddressesByNameSearch::Criteria::Criteria()
-    : streetGroupTypesMask(fullObfAddressStreetGroupTypesMask())
+    : maxEditDistance(0)
+    , streetGroupTypesMask(fullObfAddressStreetGroupTypesMask())
     , includeStreets(true)
 {
 }
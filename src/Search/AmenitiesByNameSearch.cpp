@@ -2,6 +2,8 @@
 
 #include "ObfDataInterface.h"
 #include "Amenity.h"
+#include "ObfNameNormalizer.h"
+#include "QtCommon.h"
 
 OsmAnd::AmenitiesByNameSearch::AmenitiesByNameSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection_)
     : BaseSearch(obfsCollection_)
@@ -40,10 +42,74 @@ void OsmAnd::AmenitiesByNameSearch::performSearch(
         criteria.bbox31.getValuePtrOrNullptr(),
         criteria.categoriesFilter.isEmpty() ? nullptr : &criteria.categoriesFilter,
         visitorFunction,
-        queryController);
+        queryController,
+        criteria.maxEditDistance);
+}
+
+std::shared_ptr<const OsmAnd::ISearch::Criteria> OsmAnd::AmenitiesByNameSearch::copyCriteria(
+    const ISearch::Criteria& criteria) const
+{
+    return std::shared_ptr<const ISearch::Criteria>(new Criteria(*dynamic_cast<const Criteria*>(&criteria)));
+}
+
+std::shared_ptr<const OsmAnd::ISearch::IResultEntry> OsmAnd::AmenitiesByNameSearch::copyResultEntry(
+    const IResultEntry& resultEntry) const
+{
+    return std::shared_ptr<const IResultEntry>(new ResultEntry(*dynamic_cast<const ResultEntry*>(&resultEntry)));
+}
+
+bool OsmAnd::AmenitiesByNameSearch::isNarrowing(
+    const ISearch::Criteria& criteria_,
+    const ISearch::Criteria& previousCriteria_) const
+{
+    const auto& criteria = *dynamic_cast<const Criteria*>(&criteria_);
+    const auto& previousCriteria = *dynamic_cast<const Criteria*>(&previousCriteria_);
+
+    // Amenities are found by prefix of name and then accepted if name contains query, so results for
+    // query that extends previous one are always among results for previous query
+    if (previousCriteria.name.isNull() ||
+        !ObfNameNormalizer::normalize(criteria.name).startsWith(ObfNameNormalizer::normalize(previousCriteria.name)))
+    {
+        return false;
+    }
+
+    // Typo-tolerant candidates of longer query are not guaranteed to be among ones of shorter query
+    if (criteria.maxEditDistance != 0 || previousCriteria.maxEditDistance != 0)
+        return false;
+
+    return
+        criteria.minZoomLevel == previousCriteria.minZoomLevel &&
+        criteria.maxZoomLevel == previousCriteria.maxZoomLevel &&
+        criteria.bbox31 == previousCriteria.bbox31 &&
+        criteria.categoriesFilter == previousCriteria.categoriesFilter;
+}
+
+OsmAnd::BaseSearch::ResultEntryFilter OsmAnd::AmenitiesByNameSearch::createResultEntryFilter(
+    const ISearch::Criteria& criteria_) const
+{
+    const auto& criteria = *dynamic_cast<const Criteria*>(&criteria_);
+
+    // Remembered amenities carry names normalized when they were found, so only query is normalized here
+    const auto normalization = ObfNameNormalizer::lockNormalization();
+    const auto normalizedName = ObfNameNormalizer::normalize(criteria.name, normalization);
+    return
+        [normalization, normalizedName]
+        (const IResultEntry& resultEntry_) -> bool
+        {
+            const auto& amenity = *dynamic_cast<const ResultEntry*>(&resultEntry_)->amenity;
+
+            return ObfNameNormalizer::anyNameContains(
+                amenity.nativeName,
+                amenity.localizedNames,
+                amenity.normalizedNames,
+                normalizedName,
+                normalization,
+                0);
+        };
 }
 
 OsmAnd::AmenitiesByNameSearch::Criteria::Criteria()
+    : maxEditDistance(0)
 {
 }
 
@@ -1,10 +1,38 @@
 #include "AmenitiesInAreaSearch.h"
 
+#include <limits>
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QThreadPool>
+#include "restore_internal_warnings.h"
+
+#include "QtCommon.h"
 #include "ObfDataInterface.h"
+#include "ObfReader.h"
+#include "ObfInfo.h"
+#include "ObfPoiSectionInfo.h"
 #include "Amenity.h"
+#include "ParallelSearchExecutor.h"
+#include "Utilities.h"
+
+namespace OsmAnd
+{
+    namespace AmenitiesInAreaSearch_P
+    {
+        struct Task
+        {
+            std::shared_ptr<const ObfReader> obfReader;
+            double distance;
+        };
+    }
+}
 
-OsmAnd::AmenitiesInAreaSearch::AmenitiesInAreaSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection_)
+OsmAnd::AmenitiesInAreaSearch::AmenitiesInAreaSearch(
+    const std::shared_ptr<const IObfsCollection>& obfsCollection_,
+    QThreadPool* const threadPool_ /*= nullptr*/)
     : BaseSearch(obfsCollection_)
+    , _threadPool(threadPool_ ? threadPool_ : QThreadPool::globalInstance())
 {
 }
 
@@ -19,6 +47,12 @@ void OsmAnd::AmenitiesInAreaSearch::performSearch(
 {
     const auto criteria = *dynamic_cast<const Criteria*>(&criteria_);
 
+    if (criteria.referencePoint31.isSet())
+    {
+        performNearestSearch(criteria, newResultEntryCallback, queryController);
+        return;
+    }
+
     const auto dataInterface = obtainDataInterface(criteria, ObfDataTypesMask().set(ObfDataType::POI));
 
     const ObfPoiSectionReader::VisitorFunction visitorFunction =
@@ -42,7 +76,89 @@ void OsmAnd::AmenitiesInAreaSearch::performSearch(
         queryController);
 }
 
+void OsmAnd::AmenitiesInAreaSearch::performNearestSearch(
+    const Criteria& criteria,
+    const NewResultEntryCallback newResultEntryCallback,
+    const std::shared_ptr<const IQueryController>& queryController) const
+{
+    using namespace AmenitiesInAreaSearch_P;
+
+    if (criteria.resultsLimit == 0)
+        return;
+
+    const auto dataInterface = obtainDataInterface(criteria, ObfDataTypesMask().set(ObfDataType::POI));
+
+    // Files are scanned from nearest to farthest one
+    ObfPoiSectionReader::NearestAmenitiesCollector collector(
+        *criteria.referencePoint31,
+        criteria.resultsLimit,
+        criteria.maxDistance);
+    QList<Task> tasks;
+    const auto pBbox31 = criteria.bbox31.getValuePtrOrNullptr();
+    for (const auto& obfReader : constOf(dataInterface->obfReaders))
+    {
+        const auto& obfInfo = obfReader->obtainInfo();
+
+        auto minDistance = std::numeric_limits<double>::max();
+        for (const auto& poiSection : constOf(obfInfo->poiSections))
+        {
+            if (pBbox31 && !poiSection->area31.intersects(*pBbox31))
+                continue;
+            minDistance = qMin(minDistance, Utilities::distance31(collector.point31, poiSection->area31));
+        }
+        if (minDistance == std::numeric_limits<double>::max() || minDistance > criteria.maxDistance)
+            continue;
+
+        Task task;
+        task.obfReader = obfReader;
+        task.distance = minDistance;
+        tasks.push_back(task);
+    }
+    std::stable_sort(tasks.begin(), tasks.end(),
+        []
+        (const Task& l, const Task& r) -> bool
+        {
+            return l.distance < r.distance;
+        });
+
+    ParallelSearchExecutor<Task>::runTasks(
+        _threadPool,
+        tasks,
+        [&criteria, &collector, &queryController]
+        (const Task& task)
+        {
+            ObfDataInterface dataInterface(QList< std::shared_ptr<const ObfReader> >() << task.obfReader);
+            dataInterface.loadNearestAmenities(
+                collector,
+                criteria.minZoomLevel,
+                criteria.maxZoomLevel,
+                criteria.bbox31.getValuePtrOrNullptr(),
+                criteria.categoriesFilter.isEmpty() ? nullptr : &criteria.categoriesFilter,
+                queryController);
+        },
+        queryController,
+        [&collector]
+        (const Task& task) -> bool
+        {
+            return task.distance > collector.getMaxDistance();
+        });
+
+    if (queryController && queryController->isAborted())
+        return;
+
+    const auto entries = collector.getEntries();
+    for (const auto& entry : constOf(entries))
+    {
+        ResultEntry resultEntry;
+        resultEntry.amenity = entry.amenity;
+        resultEntry.distance = entry.distance;
+        newResultEntryCallback(criteria, resultEntry);
+    }
+}
+
 OsmAnd::AmenitiesInAreaSearch::Criteria::Criteria()
+    : resultsLimit(10)
+    , maxDistance(std::numeric_limits<double>::max())
 {
 }
 
@@ -51,6 +167,7 @@ OsmAnd::AmenitiesInAreaSearch::Criteria::~Criteria()
 }
 
 OsmAnd::AmenitiesInAreaSearch::ResultEntry::ResultEntry()
+    : distance(0.0)
 {
 }
 
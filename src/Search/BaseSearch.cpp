@@ -2,8 +2,12 @@
 
 #include "QtExtensions.h"
 #include <QThreadPool>
+#include <QMutexLocker>
 
+#include "QtCommon.h"
 #include "QRunnableFunctor.h"
+#include "SimpleQueryController.h"
+#include "FunctorQueryController.h"
 
 OsmAnd::BaseSearch::BaseSearch(const std::shared_ptr<const IObfsCollection>& obfsCollection_)
     : obfsCollection(obfsCollection_)
@@ -26,6 +30,27 @@ std::shared_ptr<OsmAnd::ObfDataInterface> OsmAnd::BaseSearch::obtainDataInterfac
         criteria.sourceFilter);
 }
 
+std::shared_ptr<const OsmAnd::ISearch::Criteria> OsmAnd::BaseSearch::copyCriteria(const Criteria& criteria) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const OsmAnd::ISearch::IResultEntry> OsmAnd::BaseSearch::copyResultEntry(
+    const IResultEntry& resultEntry) const
+{
+    return nullptr;
+}
+
+bool OsmAnd::BaseSearch::isNarrowing(const Criteria& criteria, const Criteria& previousCriteria) const
+{
+    return false;
+}
+
+OsmAnd::BaseSearch::ResultEntryFilter OsmAnd::BaseSearch::createResultEntryFilter(const Criteria& criteria) const
+{
+    return nullptr;
+}
+
 std::shared_ptr<const OsmAnd::IObfsCollection> OsmAnd::BaseSearch::getObfsCollection() const
 {
     return obfsCollection;
@@ -55,3 +80,177 @@ void OsmAnd::BaseSearch::startSearch(
         });
     threadPool->start(runnable);
 }
+
+std::shared_ptr<OsmAnd::BaseSearch::Session> OsmAnd::BaseSearch::createSession() const
+{
+    return std::shared_ptr<Session>(new Session(this));
+}
+
+OsmAnd::BaseSearch::Session::Session(const BaseSearch* const search_)
+    : _performedSearchesCount(0)
+    , _refinedSearchesCount(0)
+    , search(search_)
+{
+}
+
+OsmAnd::BaseSearch::Session::~Session()
+{
+    abort();
+}
+
+void OsmAnd::BaseSearch::Session::performSearch(
+    const Criteria& criteria,
+    const NewResultEntryCallback newResultEntryCallback,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    const std::shared_ptr<SimpleQueryController> sessionQueryController(new SimpleQueryController());
+    const std::shared_ptr<const IQueryController> effectiveQueryController(new FunctorQueryController(
+        [sessionQueryController, queryController]
+        (const FunctorQueryController* const) -> bool
+        {
+            return sessionQueryController->isAborted() || (queryController && queryController->isAborted());
+        }));
+
+    // Abort previous search and look for remembered results that can be refined
+    bool refine = false;
+    QList< std::shared_ptr<const IResultEntry> > previousResults;
+    {
+        QMutexLocker scopedLocker(&_mutex);
+
+        if (_activeQueryController)
+            _activeQueryController->abort();
+        _activeQueryController = sessionQueryController;
+        _performedSearchesCount++;
+
+        for (const auto& historyEntry : constOf(_history))
+        {
+            if (!search->isNarrowing(criteria, *historyEntry.criteria))
+                continue;
+
+            refine = true;
+            previousResults = historyEntry.results;
+            _refinedSearchesCount++;
+            break;
+        }
+    }
+
+    const auto criteriaCopy = search->copyCriteria(criteria);
+    bool resultsComplete = (criteriaCopy != nullptr);
+    QList< std::shared_ptr<const IResultEntry> > results;
+    if (refine)
+    {
+        const auto resultEntryFilter = search->createResultEntryFilter(criteria);
+        for (const auto& resultEntry : constOf(previousResults))
+        {
+            if (effectiveQueryController->isAborted())
+                break;
+
+            if (resultEntryFilter && !resultEntryFilter(*resultEntry))
+                continue;
+
+            results.push_back(resultEntry);
+            newResultEntryCallback(criteria, *resultEntry);
+        }
+    }
+    else
+    {
+        const NewResultEntryCallback newResultEntryCallbackWrapper =
+            [this, newResultEntryCallback, &results, &resultsComplete]
+            (const Criteria& criteria, const IResultEntry& resultEntry)
+            {
+                if (resultsComplete)
+                {
+                    const auto resultEntryCopy = search->copyResultEntry(resultEntry);
+                    if (resultEntryCopy && results.size() < MaxRememberedResults)
+                        results.push_back(resultEntryCopy);
+                    else
+                        resultsComplete = false;
+                }
+                newResultEntryCallback(criteria, resultEntry);
+            };
+        search->performSearch(criteria, newResultEntryCallbackWrapper, effectiveQueryController);
+    }
+
+    {
+        QMutexLocker scopedLocker(&_mutex);
+
+        if (_activeQueryController == sessionQueryController)
+            _activeQueryController.reset();
+
+        // Only results of search that wasn't aborted contain everything that matches criteria
+        if (resultsComplete && !effectiveQueryController->isAborted())
+        {
+            HistoryEntry historyEntry;
+            historyEntry.criteria = criteriaCopy;
+            historyEntry.results = results;
+            _history.prepend(historyEntry);
+            while (_history.size() > HistoryDepth)
+                _history.removeLast();
+        }
+    }
+}
+
+void OsmAnd::BaseSearch::Session::startSearch(
+    const Criteria& criteria,
+    const NewResultEntryCallback newResultEntryCallback,
+    const SearchCompletedCallback searchCompletedCallback,
+    QThreadPool* const threadPool,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/)
+{
+    // Criteria are copied since search is performed after this call returns
+    const auto criteriaCopy = search->copyCriteria(criteria);
+    if (!criteriaCopy)
+    {
+        search->startSearch(criteria, newResultEntryCallback, searchCompletedCallback, threadPool, queryController);
+        return;
+    }
+
+    const auto session = shared_from_this();
+    const auto runnable = new QRunnableFunctor(
+        [session, criteriaCopy, newResultEntryCallback, searchCompletedCallback, queryController]
+        (const QRunnableFunctor* const runnable)
+        {
+            QList<IResultEntry> results;
+            const NewResultEntryCallback newResultEntryCallbackWrapper =
+                [newResultEntryCallback, &results]
+                (const Criteria& criteria, const IResultEntry& resultEntry)
+                {
+                    results.push_back(resultEntry);
+                    newResultEntryCallback(criteria, resultEntry);
+                };
+            session->performSearch(*criteriaCopy, newResultEntryCallbackWrapper, queryController);
+            searchCompletedCallback(*criteriaCopy, results);
+        });
+    threadPool->start(runnable);
+}
+
+void OsmAnd::BaseSearch::Session::abort()
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    if (_activeQueryController)
+        _activeQueryController->abort();
+}
+
+void OsmAnd::BaseSearch::Session::reset()
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    if (_activeQueryController)
+        _activeQueryController->abort();
+    _history.clear();
+}
+
+unsigned int OsmAnd::BaseSearch::Session::getPerformedSearchesCount() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return _performedSearchesCount;
+}
+
+unsigned int OsmAnd::BaseSearch::Session::getRefinedSearchesCount() const
+{
+    QMutexLocker scopedLocker(&_mutex);
+
+    return _refinedSearchesCount;
+}
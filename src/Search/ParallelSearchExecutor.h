@@ -0,0 +1,155 @@
+#ifndef _OSMAND_CORE_PARALLEL_SEARCH_EXECUTOR_H_
+#define _OSMAND_CORE_PARALLEL_SEARCH_EXECUTOR_H_
+
+#include "stdlib_common.h"
+#include <functional>
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QList>
+#include <QThreadPool>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include "restore_internal_warnings.h"
+
+#include "OsmAndCore.h"
+#include "IQueryController.h"
+#include "QRunnableFunctor.h"
+
+namespace OsmAnd
+{
+    // Runs tasks of search (e.g. one per file, since reader of file is not shared) on calling thread and on
+    // helpers from thread pool. Workers take tasks in order until none is left, so helper that starts after caller
+    // has finished with all tasks does nothing. Caller waits only for helpers that actually started, so it never
+    // deadlocks on saturated thread pool.
+    template<typename TASK>
+    class ParallelSearchExecutor Q_DECL_FINAL
+    {
+    public:
+        typedef std::function<bool (TASK& outTask)> TakeTaskFunction;
+        // Worker takes tasks itself, so it may keep its own state between them
+        typedef std::function<void (const TakeTaskFunction& takeTask)> WorkerFunction;
+        typedef std::function<void (const TASK& task)> TaskFunction;
+        // True if task can't improve results. Tasks are sorted by what they can give, so none after it can either.
+        typedef std::function<bool (const TASK& task)> CutoffPredicate;
+
+    private:
+        struct State
+        {
+            State(const QList<TASK>& tasks_, const CutoffPredicate& isCutoff_)
+                : tasks(tasks_)
+                , isCutoff(isCutoff_)
+                , nextTaskIndex(0)
+                , activeWorkersCount(0)
+                , closed(false)
+            {
+            }
+
+            const QList<TASK> tasks;
+            const CutoffPredicate isCutoff;
+
+            QMutex mutex;
+            QWaitCondition workerFinished;
+            int nextTaskIndex;
+            int activeWorkersCount;
+            bool closed;
+        };
+
+        static void runWorker(
+            const std::shared_ptr<State>& state,
+            const WorkerFunction& worker,
+            const std::shared_ptr<const IQueryController>& queryController)
+        {
+            const TakeTaskFunction takeTask =
+                [&state, &queryController]
+                (TASK& outTask) -> bool
+                {
+                    if (queryController && queryController->isAborted())
+                        return false;
+
+                    QMutexLocker scopedLocker(&state->mutex);
+
+                    if (state->nextTaskIndex >= state->tasks.size())
+                        return false;
+                    const auto& task = state->tasks[state->nextTaskIndex++];
+                    if (state->isCutoff && state->isCutoff(task))
+                    {
+                        state->nextTaskIndex = state->tasks.size();
+                        return false;
+                    }
+
+                    outTask = task;
+                    return true;
+                };
+            worker(takeTask);
+        }
+
+        ParallelSearchExecutor();
+        ~ParallelSearchExecutor();
+    public:
+        static void runWorkers(
+            QThreadPool* const threadPool,
+            const QList<TASK>& tasks,
+            const WorkerFunction& worker,
+            const std::shared_ptr<const IQueryController>& queryController,
+            const CutoffPredicate& isCutoff = nullptr)
+        {
+            const std::shared_ptr<State> state(new State(tasks, isCutoff));
+
+            const auto helpersCount = qMin(tasks.size(), threadPool->maxThreadCount()) - 1;
+            for (auto helperIndex = 0; helperIndex < helpersCount; helperIndex++)
+            {
+                const auto runnable = new QRunnableFunctor(
+                    [state, worker, queryController]
+                    (const QRunnableFunctor* const runnable)
+                    {
+                        {
+                            QMutexLocker scopedLocker(&state->mutex);
+                            if (state->closed)
+                                return;
+                            state->activeWorkersCount++;
+                        }
+
+                        runWorker(state, worker, queryController);
+
+                        {
+                            QMutexLocker scopedLocker(&state->mutex);
+                            state->activeWorkersCount--;
+                            state->workerFinished.wakeAll();
+                        }
+                    });
+                threadPool->start(runnable);
+            }
+
+            runWorker(state, worker, queryController);
+
+            QMutexLocker scopedLocker(&state->mutex);
+
+            state->closed = true;
+            while (state->activeWorkersCount > 0)
+                state->workerFinished.wait(&state->mutex);
+        }
+
+        static void runTasks(
+            QThreadPool* const threadPool,
+            const QList<TASK>& tasks,
+            const TaskFunction& processTask,
+            const std::shared_ptr<const IQueryController>& queryController,
+            const CutoffPredicate& isCutoff = nullptr)
+        {
+            // Helpers that never started don't call worker, so it may reference processTask of caller
+            const WorkerFunction worker =
+                [&processTask]
+                (const TakeTaskFunction& takeTask)
+                {
+                    TASK task;
+                    while (takeTask(task))
+                        processTask(task);
+                };
+            runWorkers(threadPool, tasks, worker, queryController, isCutoff);
+        }
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_PARALLEL_SEARCH_EXECUTOR_H_)
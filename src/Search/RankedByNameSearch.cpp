@@ -0,0 +1,432 @@
+#include "RankedByNameSearch.h"
+
+#include <limits>
+
+#include "QtExtensions.h"
+#include "ignore_warnings_on_external_includes.h"
+#include <QThreadPool>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include "restore_internal_warnings.h"
+
+#include "QtCommon.h"
+#include "ObfDataInterface.h"
+#include "ObfReader.h"
+#include "ObfInfo.h"
+#include "ObfPoiSectionInfo.h"
+#include "ObfAddressSectionInfo.h"
+#include "Amenity.h"
+#include "Address.h"
+#include "StreetGroup.h"
+#include "Street.h"
+#include "ParallelSearchExecutor.h"
+#include "FunctorQueryController.h"
+#include "ObfNameNormalizer.h"
+#include "Utilities.h"
+
+namespace OsmAnd
+{
+    namespace RankedByNameSearch_P
+    {
+        // Scores are compared in fixed point to be able to publish cutoff score atomically
+        enum
+        {
+            ScoreScale = 1000000,
+        };
+
+        struct Task
+        {
+            std::shared_ptr<const ObfReader> obfReader;
+            float scoreBound;
+        };
+
+        struct State
+        {
+            State(const RankedByNameSearch::Criteria& criteria_)
+                : criteria(criteria_)
+                , normalization(ObfNameNormalizer::lockNormalization())
+                , normalizedName(ObfNameNormalizer::normalize(criteria_.name, normalization))
+                , cutoffScore(-1)
+            {
+            }
+
+            const RankedByNameSearch::Criteria criteria;
+            const ObfFile::NameNormalization normalization;
+            const QString normalizedName;
+
+            QMutex mutex;
+
+            // Min-heap of kept results, worst one on top
+            QVector<RankedByNameSearch::ResultEntry> results;
+            QAtomicInt cutoffScore;
+
+            static bool isWorse(const RankedByNameSearch::ResultEntry& l, const RankedByNameSearch::ResultEntry& r)
+            {
+                return l.score > r.score;
+            }
+
+            bool canImprove(const float scoreBound) const
+            {
+                return cutoffScore.loadAcquire() < qRound(scoreBound * ScoreScale);
+            }
+
+            void offer(
+                const RankedByNameSearch::ResultEntry& resultEntry,
+                const ISearch::NewResultEntryCallback& newResultEntryCallback)
+            {
+                QMutexLocker scopedLocker(&mutex);
+
+                const auto resultsLimit = static_cast<int>(criteria.resultsLimit);
+                if (results.size() < resultsLimit)
+                {
+                    results.push_back(resultEntry);
+                    std::push_heap(results.begin(), results.end(), isWorse);
+                }
+                else if (resultsLimit > 0 && resultEntry.score > results.first().score)
+                {
+                    std::pop_heap(results.begin(), results.end(), isWorse);
+                    results.last() = resultEntry;
+                    std::push_heap(results.begin(), results.end(), isWorse);
+                }
+                else
+                {
+                    return;
+                }
+
+                if (results.size() >= resultsLimit)
+                    cutoffScore.storeRelease(qRound(results.first().score * ScoreScale));
+
+                if (newResultEntryCallback)
+                    newResultEntryCallback(criteria, resultEntry);
+            }
+        };
+
+        // Reader returns only names that match query, so name that has no exact match matched with typos
+        static const float ApproximateNameMatchQuality = 0.1f;
+
+        // Name is either normalized or, with case folding only, compared to normalized query case-insensitively
+        static float computeNormalizedNameMatchQuality(
+            const QString& name,
+            const QString& normalizedQuery,
+            const Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive)
+        {
+            if (name.isEmpty())
+                return 0.0f;
+            if (name.compare(normalizedQuery, caseSensitivity) == 0)
+                return 1.0f;
+            if (name.startsWith(normalizedQuery, caseSensitivity))
+                return 0.75f;
+
+            auto index = name.indexOf(normalizedQuery, 0, caseSensitivity);
+            if (index < 0)
+                return 0.0f;
+            while (index >= 0)
+            {
+                if (!name.at(index - 1).isLetterOrNumber())
+                    return 0.5f;
+                index = name.indexOf(normalizedQuery, index + 1, caseSensitivity);
+            }
+            return 0.25f;
+        }
+
+        // Names carried normalized by reader aren't normalized again
+        static float computeNamesMatchQuality(
+            const QString& nativeName,
+            const QHash<QString, QString>& localizedNames,
+            const QStringList& normalizedNames,
+            const State& state)
+        {
+            auto quality = 0.0f;
+            if (ObfNameNormalizer::isCaseFoldingOnly(state.normalization))
+            {
+                quality = computeNormalizedNameMatchQuality(nativeName, state.normalizedName, Qt::CaseInsensitive);
+                for (const auto& localizedName : constOf(localizedNames))
+                {
+                    quality = qMax(quality,
+                        computeNormalizedNameMatchQuality(localizedName, state.normalizedName, Qt::CaseInsensitive));
+                }
+                return quality;
+            }
+
+            const auto& effectiveNormalizedNames = normalizedNames.isEmpty()
+                ? ObfNameNormalizer::normalizeNames(nativeName, localizedNames, state.normalization)
+                : normalizedNames;
+            for (const auto& normalizedName : constOf(effectiveNormalizedNames))
+                quality = qMax(quality, computeNormalizedNameMatchQuality(normalizedName, state.normalizedName));
+            return quality;
+        }
+
+        static float computeAddressNameMatchQuality(
+            const Address& address,
+            const State& state,
+            PointI& outPosition31)
+        {
+            switch (address.addressType)
+            {
+                case AddressType::StreetGroup:
+                {
+                    const auto& streetGroup = static_cast<const StreetGroup&>(address);
+                    outPosition31 = streetGroup.position31;
+                    return computeNamesMatchQuality(
+                        streetGroup.nativeName,
+                        streetGroup.localizedNames,
+                        streetGroup.normalizedNames,
+                        state);
+                }
+                case AddressType::Street:
+                {
+                    const auto& street = static_cast<const Street&>(address);
+                    outPosition31 = street.position31;
+                    return computeNamesMatchQuality(
+                        street.nativeName,
+                        street.localizedNames,
+                        street.normalizedNames,
+                        state);
+                }
+            }
+            return 0.0f;
+        }
+
+        static double computeDistance(const Nullable<PointI>& referencePoint31, const PointI& position31)
+        {
+            if (!referencePoint31.isSet())
+                return 0.0;
+            return Utilities::distance31(*referencePoint31, position31);
+        }
+
+        static double computeDistance(const Nullable<PointI>& referencePoint31, const AreaI& area31)
+        {
+            if (!referencePoint31.isSet())
+                return 0.0;
+            return Utilities::distance31(*referencePoint31, area31);
+        }
+
+        static void processTask(
+            const std::shared_ptr<State>& state,
+            const Task& task,
+            const ISearch::NewResultEntryCallback& newResultEntryCallback,
+            const std::shared_ptr<const IQueryController>& queryController)
+        {
+            const auto& criteria = state->criteria;
+            const std::shared_ptr<const IQueryController> taskQueryController(new FunctorQueryController(
+                [state, task, queryController]
+                (const FunctorQueryController* const) -> bool
+                {
+                    return (queryController && queryController->isAborted()) || !state->canImprove(task.scoreBound);
+                }));
+
+            ObfDataInterface dataInterface(QList< std::shared_ptr<const ObfReader> >() << task.obfReader);
+
+            if (criteria.includeAmenities)
+            {
+                const ObfPoiSectionReader::VisitorFunction visitor =
+                    [state, &criteria, &newResultEntryCallback]
+                    (const std::shared_ptr<const OsmAnd::Amenity>& amenity) -> bool
+                    {
+                        RankedByNameSearch::ResultEntry resultEntry;
+                        resultEntry.amenity = amenity;
+                        resultEntry.nameMatchQuality = computeNamesMatchQuality(
+                            amenity->nativeName,
+                            amenity->localizedNames,
+                            amenity->normalizedNames,
+                            *state);
+                        if (resultEntry.nameMatchQuality == 0.0f && criteria.maxEditDistance > 0)
+                            resultEntry.nameMatchQuality = ApproximateNameMatchQuality;
+                        resultEntry.distance = computeDistance(criteria.referencePoint31, amenity->position31);
+                        resultEntry.score = RankedByNameSearch::computeScore(
+                            resultEntry.nameMatchQuality,
+                            resultEntry.distance);
+                        if (resultEntry.score > 0.0f)
+                            state->offer(resultEntry, newResultEntryCallback);
+
+                        return false;
+                    };
+                dataInterface.scanAmenitiesByName(
+                    criteria.name,
+                    nullptr,
+                    criteria.minZoomLevel,
+                    criteria.maxZoomLevel,
+                    criteria.bbox31.getValuePtrOrNullptr(),
+                    criteria.categoriesFilter.isEmpty() ? nullptr : &criteria.categoriesFilter,
+                    visitor,
+                    taskQueryController,
+                    criteria.maxEditDistance);
+            }
+
+            if (criteria.includeAddresses && !taskQueryController->isAborted())
+            {
+                const ObfAddressSectionReader::VisitorFunction visitor =
+                    [state, &criteria, &newResultEntryCallback]
+                    (const std::shared_ptr<const OsmAnd::Address>& address) -> bool
+                    {
+                        PointI position31;
+                        RankedByNameSearch::ResultEntry resultEntry;
+                        resultEntry.address = address;
+                        resultEntry.nameMatchQuality = computeAddressNameMatchQuality(*address, *state, position31);
+                        if (resultEntry.nameMatchQuality == 0.0f && criteria.maxEditDistance > 0)
+                            resultEntry.nameMatchQuality = ApproximateNameMatchQuality;
+                        resultEntry.distance = computeDistance(criteria.referencePoint31, position31);
+                        resultEntry.score = RankedByNameSearch::computeScore(
+                            resultEntry.nameMatchQuality,
+                            resultEntry.distance);
+                        if (resultEntry.score > 0.0f)
+                            state->offer(resultEntry, newResultEntryCallback);
+
+                        return false;
+                    };
+                dataInterface.scanAddressesByName(
+                    criteria.name,
+                    nullptr,
+                    criteria.bbox31.getValuePtrOrNullptr(),
+                    criteria.streetGroupTypesMask,
+                    criteria.includeStreets,
+                    visitor,
+                    taskQueryController,
+                    criteria.maxEditDistance);
+            }
+        }
+    }
+}
+
+OsmAnd::RankedByNameSearch::RankedByNameSearch(
+    const std::shared_ptr<const IObfsCollection>& obfsCollection_,
+    QThreadPool* const threadPool_ /*= nullptr*/)
+    : BaseSearch(obfsCollection_)
+    , _threadPool(threadPool_ ? threadPool_ : QThreadPool::globalInstance())
+{
+}
+
+OsmAnd::RankedByNameSearch::~RankedByNameSearch()
+{
+}
+
+void OsmAnd::RankedByNameSearch::performSearch(
+    const ISearch::Criteria& criteria,
+    const NewResultEntryCallback newResultEntryCallback,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/) const
+{
+    performRankedSearch(*dynamic_cast<const Criteria*>(&criteria), newResultEntryCallback, queryController);
+}
+
+QList<OsmAnd::RankedByNameSearch::ResultEntry> OsmAnd::RankedByNameSearch::performRankedSearch(
+    const Criteria& criteria,
+    const NewResultEntryCallback newResultEntryCallback /*= nullptr*/,
+    const std::shared_ptr<const IQueryController>& queryController /*= nullptr*/) const
+{
+    using namespace RankedByNameSearch_P;
+
+    if (criteria.resultsLimit == 0 || (!criteria.includeAmenities && !criteria.includeAddresses))
+        return QList<ResultEntry>();
+
+    ObfDataTypesMask dataTypes;
+    if (criteria.includeAmenities)
+        dataTypes.set(ObfDataType::POI);
+    if (criteria.includeAddresses)
+        dataTypes.set(ObfDataType::Address);
+    const auto dataInterface = obtainDataInterface(criteria, dataTypes);
+
+    // Best score that file can give is limited by distance from reference point to its sections
+    const std::shared_ptr<State> state(new State(criteria));
+    QList<Task> tasks;
+    const auto pBbox31 = criteria.bbox31.getValuePtrOrNullptr();
+    for (const auto& obfReader : constOf(dataInterface->obfReaders))
+    {
+        const auto& obfInfo = obfReader->obtainInfo();
+
+        double minDistance = std::numeric_limits<double>::max();
+        if (criteria.includeAmenities)
+        {
+            for (const auto& poiSection : constOf(obfInfo->poiSections))
+            {
+                if (pBbox31 && !poiSection->area31.intersects(*pBbox31))
+                    continue;
+                minDistance = qMin(minDistance, computeDistance(criteria.referencePoint31, poiSection->area31));
+            }
+        }
+        if (criteria.includeAddresses)
+        {
+            for (const auto& addressSection : constOf(obfInfo->addressSections))
+            {
+                if (pBbox31 && !addressSection->area31.intersects(*pBbox31))
+                    continue;
+                minDistance = qMin(minDistance, computeDistance(criteria.referencePoint31, addressSection->area31));
+            }
+        }
+        if (minDistance == std::numeric_limits<double>::max())
+            continue;
+
+        Task task;
+        task.obfReader = obfReader;
+        task.scoreBound = computeScore(1.0f, minDistance);
+        tasks.push_back(task);
+    }
+    std::stable_sort(tasks.begin(), tasks.end(),
+        []
+        (const Task& l, const Task& r) -> bool
+        {
+            return l.scoreBound > r.scoreBound;
+        });
+
+    ParallelSearchExecutor<Task>::runTasks(
+        _threadPool,
+        tasks,
+        [&state, &newResultEntryCallback, &queryController]
+        (const Task& task)
+        {
+            processTask(state, task, newResultEntryCallback, queryController);
+        },
+        queryController,
+        [&state]
+        (const Task& task) -> bool
+        {
+            return !state->canImprove(task.scoreBound);
+        });
+
+    QVector<ResultEntry> results;
+    {
+        QMutexLocker scopedLocker(&state->mutex);
+        results = state->results;
+    }
+
+    std::sort(results.begin(), results.end(), State::isWorse);
+    return results.toList();
+}
+
+float OsmAnd::RankedByNameSearch::computeNameMatchQuality(const QString& name, const QString& query)
+{
+    return RankedByNameSearch_P::computeNormalizedNameMatchQuality(
+        ObfNameNormalizer::normalize(name),
+        ObfNameNormalizer::normalize(query));
+}
+
+float OsmAnd::RankedByNameSearch::computeScore(const float nameMatchQuality, const double distance)
+{
+    return static_cast<float>(nameMatchQuality * DistanceHalfScore / (DistanceHalfScore + distance));
+}
+
+OsmAnd::RankedByNameSearch::Criteria::Criteria()
+    : maxEditDistance(0)
+    , resultsLimit(20)
+    , includeAmenities(true)
+    , includeAddresses(true)
+    , streetGroupTypesMask(fullObfAddressStreetGroupTypesMask())
+    , includeStreets(true)
+{
+}
+
+OsmAnd::RankedByNameSearch::Criteria::~Criteria()
+{
+}
+
+OsmAnd::RankedByNameSearch::ResultEntry::ResultEntry()
+    : nameMatchQuality(0.0f)
+    , distance(0.0)
+    , score(0.0f)
+{
+}
+
+OsmAnd::RankedByNameSearch::ResultEntry::~ResultEntry()
+{
+}
@@ -1,5 +1,7 @@
 #include "SkiaUtilities.h"
 
+#include <cstring>
+
 #include "ignore_warnings_on_external_includes.h"
 #include <SkBitmap.h>
 #include <SkBitmapDevice.h>
@@ -112,3 +114,61 @@ std::shared_ptr<SkBitmap> OsmAnd::SkiaUtilities::mergeBitmaps(const QList< std::
 
     return outputBitmap;
 }
+
+uint64_t OsmAnd::SkiaUtilities::computeContentHash(const SkBitmap& bitmap)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto hashBytes =
+        [&hash]
+        (const uint8_t* const pBytes, const size_t bytesCount)
+        {
+            for (size_t byteIndex = 0; byteIndex < bytesCount; byteIndex++)
+            {
+                hash ^= pBytes[byteIndex];
+                hash *= 1099511628211ull;
+            }
+        };
+
+    const int32_t header[] = {
+        bitmap.width(),
+        bitmap.height(),
+        static_cast<int32_t>(bitmap.colorType()),
+        static_cast<int32_t>(bitmap.alphaType()) };
+    hashBytes(reinterpret_cast<const uint8_t*>(header), sizeof(header));
+
+    const auto pPixels = reinterpret_cast<const uint8_t*>(bitmap.getPixels());
+    if (!pPixels)
+        return hash;
+    const auto rowBytes = static_cast<size_t>(bitmap.width()) * bitmap.bytesPerPixel();
+    for (auto row = 0; row < bitmap.height(); row++)
+        hashBytes(pPixels + row * bitmap.rowBytes(), rowBytes);
+
+    return hash;
+}
+
+bool OsmAnd::SkiaUtilities::haveSameContent(const SkBitmap& bitmap, const SkBitmap& otherBitmap)
+{
+    if (bitmap.width() != otherBitmap.width() ||
+        bitmap.height() != otherBitmap.height() ||
+        bitmap.colorType() != otherBitmap.colorType() ||
+        bitmap.alphaType() != otherBitmap.alphaType())
+    {
+        return false;
+    }
+
+    const auto pPixels = reinterpret_cast<const uint8_t*>(bitmap.getPixels());
+    const auto pOtherPixels = reinterpret_cast<const uint8_t*>(otherBitmap.getPixels());
+    if (!pPixels || !pOtherPixels)
+        return pPixels == pOtherPixels;
+    if (pPixels == pOtherPixels && bitmap.rowBytes() == otherBitmap.rowBytes())
+        return true;
+
+    const auto rowBytes = static_cast<size_t>(bitmap.width()) * bitmap.bytesPerPixel();
+    for (auto row = 0; row < bitmap.height(); row++)
+    {
+        if (memcmp(pPixels + row * bitmap.rowBytes(), pOtherPixels + row * otherBitmap.rowBytes(), rowBytes) != 0)
+            return false;
+    }
+
+    return true;
+}
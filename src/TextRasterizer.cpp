@@ -54,6 +54,52 @@ bool OsmAnd::TextRasterizer::rasterize(
         outLineSpacing);
 }
 
+OsmAnd::TextRasterizer::CachesMetrics OsmAnd::TextRasterizer::getCachesMetrics() const
+{
+    return _p->getCachesMetrics();
+}
+
+void OsmAnd::TextRasterizer::clearCaches() const
+{
+    _p->clearCaches();
+}
+
+OsmAnd::TextRasterizer::CachesMetrics::CachesMetrics()
+    : glyphCoverageHits(0)
+    , glyphCoverageMisses(0)
+    , linePaintsHits(0)
+    , linePaintsMisses(0)
+    , bitmapsHits(0)
+    , bitmapsMisses(0)
+    , bitmapsSizeInBytes(0)
+{
+}
+
+QString OsmAnd::TextRasterizer::CachesMetrics::toString() const
+{
+    const auto hitRate =
+        []
+        (const unsigned int hits, const unsigned int misses) -> float
+        {
+            const auto total = hits + misses;
+            return total > 0 ? 100.0f * hits / total : 0.0f;
+        };
+
+    return QString(QLatin1String("glyph coverage: %1 hits, %2 misses (%3%)\n"
+        "line paints: %4 hits, %5 misses (%6%)\n"
+        "bitmaps: %7 hits, %8 misses (%9%), %10 bytes"))
+        .arg(glyphCoverageHits)
+        .arg(glyphCoverageMisses)
+        .arg(hitRate(glyphCoverageHits, glyphCoverageMisses))
+        .arg(linePaintsHits)
+        .arg(linePaintsMisses)
+        .arg(hitRate(linePaintsHits, linePaintsMisses))
+        .arg(bitmapsHits)
+        .arg(bitmapsMisses)
+        .arg(hitRate(bitmapsHits, bitmapsMisses))
+        .arg(bitmapsSizeInBytes);
+}
+
 static std::shared_ptr<const OsmAnd::TextRasterizer> s_defaultTextRasterizer;
 std::shared_ptr<const OsmAnd::TextRasterizer> OsmAnd::TextRasterizer::getDefault()
 {
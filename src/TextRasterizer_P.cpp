@@ -21,7 +21,15 @@
 #endif // !defined(OSMAND_LOG_CHARACTERS_FONT)
 
 OsmAnd::TextRasterizer_P::TextRasterizer_P(TextRasterizer* const owner_)
-    : owner(owner_)
+    : _glyphCoverageHits(0)
+    , _glyphCoverageMisses(0)
+    , _linePaintsCache(MaxCachedLinePaintsCount)
+    , _linePaintsHits(0)
+    , _linePaintsMisses(0)
+    , _bitmapsCache(MaxCachedBitmapsSizeInBytes)
+    , _bitmapsHits(0)
+    , _bitmapsMisses(0)
+    , owner(owner_)
 {
     _defaultPaint.setAntiAlias(true);
     _defaultPaint.setTextEncoding(SkPaint::kUTF16_TextEncoding);
@@ -32,8 +40,42 @@ OsmAnd::TextRasterizer_P::~TextRasterizer_P()
 {
 }
 
-QVector<OsmAnd::TextRasterizer_P::LinePaint> OsmAnd::TextRasterizer_P::evaluatePaints(
-    const QVector<QStringRef>& lineRefs,
+bool OsmAnd::TextRasterizer_P::typefaceContainsCharacter(SkTypeface* const typeface, const uint32_t characterUCS4) const
+{
+    const auto blockKey = (static_cast<uint64_t>(typeface->uniqueID()) << 32) | (characterUCS4 >> 6);
+    const auto characterMask = static_cast<uint64_t>(1) << (characterUCS4 & 0x3F);
+
+    {
+        QMutexLocker scopedLocker(&_glyphCoverageCacheMutex);
+
+        const auto citBlock = _glyphCoverageCache.constFind(blockKey);
+        if (citBlock != _glyphCoverageCache.cend() && (citBlock->probed & characterMask) != 0)
+        {
+            _glyphCoverageHits++;
+            return (citBlock->covered & characterMask) != 0;
+        }
+    }
+
+    SkPaint paint;
+    paint.setTextEncoding(SkPaint::kUTF32_TextEncoding);
+    paint.setTypeface(typeface);
+    const auto contains = paint.containsText(&characterUCS4, sizeof(uint32_t));
+
+    {
+        QMutexLocker scopedLocker(&_glyphCoverageCacheMutex);
+
+        auto& block = _glyphCoverageCache[blockKey];
+        block.probed |= characterMask;
+        if (contains)
+            block.covered |= characterMask;
+        _glyphCoverageMisses++;
+    }
+
+    return contains;
+}
+
+OsmAnd::TextRasterizer_P::LinePaint OsmAnd::TextRasterizer_P::evaluateLinePaint(
+    const QStringRef& lineRef,
     const Style& style) const
 {
     // Prepare default paint
@@ -47,138 +89,191 @@ QVector<OsmAnd::TextRasterizer_P::LinePaint> OsmAnd::TextRasterizer_P::evaluateP
         SkFontStyle::kNormal_Width,
         style.italic ? SkFontStyle::kItalic_Slant : SkFontStyle::kUpright_Slant);
 
-    const auto pText = lineRefs.first().string()->constData();
+    const auto pText = lineRef.string()->constData();
 
-    QVector<LinePaint> linePaints;
-    linePaints.reserve(lineRefs.count());
-    for (const auto& lineRef : constOf(lineRefs))
+    LinePaint linePaint;
+    linePaint.line = lineRef;
+
+    TextPaint* pTextPaint = nullptr;
+    const auto pLine = lineRef.constData();
+    const auto pEnd = pLine + lineRef.size();
+    auto pNextCharacter = pLine;
+    while (pNextCharacter != pEnd)
     {
-        LinePaint linePaint;
-        linePaint.line = lineRef;
+        const auto pCharacter = pNextCharacter;
+        const auto position = pNextCharacter - pText;
+        const auto characterUCS4 = SkUTF16_NextUnichar(reinterpret_cast<const uint16_t**>(&pNextCharacter));
 
-        TextPaint* pTextPaint = nullptr;
-        const auto pLine = lineRef.constData();
-        const auto pEnd = pLine + lineRef.size();
-        auto pNextCharacter = pLine;
-        while (pNextCharacter != pEnd)
+        // First of all check previous font if it contains this character
+        auto font = pTextPaint ? pTextPaint->paint.getTypeface() : nullptr;
+        if (font)
         {
-            const auto pCharacter = pNextCharacter;
-            const auto position = pNextCharacter - pText;
-            const auto characterUCS4 = SkUTF16_NextUnichar(reinterpret_cast<const uint16_t**>(&pNextCharacter));
-            
-            // First of all check previous font if it contains this character
-            auto font = pTextPaint ? pTextPaint->paint.getTypeface() : nullptr;
-            if (font)
-            {
-                SkPaint paint;
-                paint.setTextEncoding(SkPaint::kUTF32_TextEncoding);
-                paint.setTypeface(font);
-                if (!paint.containsText(&characterUCS4, sizeof(uint32_t)))
-                    font = nullptr;
+            if (!typefaceContainsCharacter(font, characterUCS4))
+                font = nullptr;
 #if OSMAND_LOG_CHARACTERS_FONT
-                else
-                {
-                    SkString fontName;
-                    font->getFamilyName(&fontName);
-
-                    LogPrintf(LogSeverityLevel::Warning,
-                        "UCS4 character 0x%08x (%u) has been found in '%s' font (reused)",
-                        characterUCS4,
-                        characterUCS4,
-                        fontName.c_str());
-                }
-#endif // OSMAND_LOG_CHARACTERS_FONT
-            }
-            if (!font)
+            else
             {
-                font = owner->fontFinder->findFontForCharacterUCS4(characterUCS4, fontStyle);
+                SkString fontName;
+                font->getFamilyName(&fontName);
+
+                LogPrintf(LogSeverityLevel::Warning,
+                    "UCS4 character 0x%08x (%u) has been found in '%s' font (reused)",
+                    characterUCS4,
+                    characterUCS4,
+                    fontName.c_str());
+            }
+#endif // OSMAND_LOG_CHARACTERS_FONT
+        }
+        if (!font)
+        {
+            font = owner->fontFinder->findFontForCharacterUCS4(characterUCS4, fontStyle);
 
 #if OSMAND_LOG_CHARACTERS_WITHOUT_FONT
-                if (!font)
-                {
-                    LogPrintf(LogSeverityLevel::Warning,
-                        "UCS4 character 0x%08x (%u) has not been found in any font",
-                        characterUCS4,
-                        characterUCS4);
-                }
+            if (!font)
+            {
+                LogPrintf(LogSeverityLevel::Warning,
+                    "UCS4 character 0x%08x (%u) has not been found in any font",
+                    characterUCS4,
+                    characterUCS4);
+            }
 #endif // OSMAND_LOG_CHARACTERS_WITHOUT_FONT
 
 #if OSMAND_LOG_CHARACTERS_FONT
-                if (font)
-                {
-                    SkString fontName;
-                    font->getFamilyName(&fontName);
-
-                    LogPrintf(LogSeverityLevel::Warning,
-                        "UCS4 character 0x%08x (%u) has been found in '%s' font",
-                        characterUCS4,
-                        characterUCS4,
-                        fontName.c_str());
-                }
-#endif // OSMAND_LOG_CHARACTERS_FONT
-            }
-
-            if (pTextPaint == nullptr || pTextPaint->paint.getTypeface() != font)
-            {
-                linePaint.textPaints.push_back(qMove(TextPaint()));
-                pTextPaint = &linePaint.textPaints.last();
-
-                pTextPaint->text = QStringRef(lineRef.string(), position, 1);
-                pTextPaint->paint = paint;
-                pTextPaint->paint.setTypeface(font);
-
-                SkPaint::FontMetrics metrics;
-                pTextPaint->height = paint.getFontMetrics(&metrics);
-                linePaint.maxFontHeight = qMax(linePaint.maxFontHeight, pTextPaint->height);
-                linePaint.minFontHeight = qMin(linePaint.minFontHeight, pTextPaint->height);
-                linePaint.maxFontLineSpacing = qMax(linePaint.maxFontLineSpacing, metrics.fLeading);
-                linePaint.minFontLineSpacing = qMin(linePaint.minFontLineSpacing, metrics.fLeading);
-                linePaint.maxFontTop = qMax(linePaint.maxFontTop, -metrics.fTop);
-                linePaint.minFontTop = qMin(linePaint.minFontTop, -metrics.fTop);
-                linePaint.maxFontBottom = qMax(linePaint.maxFontBottom, metrics.fBottom);
-                linePaint.minFontBottom = qMin(linePaint.minFontBottom, metrics.fBottom);
-
-                if (style.bold && (!font || (font && font->fontStyle().weight() <= SkFontStyle::kNormal_Weight)))
-                    pTextPaint->paint.setFakeBoldText(true);
-            }
-            else
+            if (font)
             {
-                pTextPaint->text = QStringRef(lineRef.string(), pTextPaint->text.position(), pTextPaint->text.size() + 1);
+                SkString fontName;
+                font->getFamilyName(&fontName);
+
+                LogPrintf(LogSeverityLevel::Warning,
+                    "UCS4 character 0x%08x (%u) has been found in '%s' font",
+                    characterUCS4,
+                    characterUCS4,
+                    fontName.c_str());
             }
+#endif // OSMAND_LOG_CHARACTERS_FONT
         }
 
-        linePaints.push_back(qMove(linePaint));
+        if (pTextPaint == nullptr || pTextPaint->paint.getTypeface() != font)
+        {
+            linePaint.textPaints.push_back(qMove(TextPaint()));
+            pTextPaint = &linePaint.textPaints.last();
+
+            pTextPaint->text = QStringRef(lineRef.string(), position, 1);
+            pTextPaint->paint = paint;
+            pTextPaint->paint.setTypeface(font);
+
+            SkPaint::FontMetrics metrics;
+            pTextPaint->height = paint.getFontMetrics(&metrics);
+            linePaint.maxFontHeight = qMax(linePaint.maxFontHeight, pTextPaint->height);
+            linePaint.minFontHeight = qMin(linePaint.minFontHeight, pTextPaint->height);
+            linePaint.maxFontLineSpacing = qMax(linePaint.maxFontLineSpacing, metrics.fLeading);
+            linePaint.minFontLineSpacing = qMin(linePaint.minFontLineSpacing, metrics.fLeading);
+            linePaint.maxFontTop = qMax(linePaint.maxFontTop, -metrics.fTop);
+            linePaint.minFontTop = qMin(linePaint.minFontTop, -metrics.fTop);
+            linePaint.maxFontBottom = qMax(linePaint.maxFontBottom, metrics.fBottom);
+            linePaint.minFontBottom = qMin(linePaint.minFontBottom, metrics.fBottom);
+
+            if (style.bold && (!font || (font && font->fontStyle().weight() <= SkFontStyle::kNormal_Weight)))
+                pTextPaint->paint.setFakeBoldText(true);
+        }
+        else
+        {
+            pTextPaint->text = QStringRef(lineRef.string(), pTextPaint->text.position(), pTextPaint->text.size() + 1);
+        }
     }
 
-    return linePaints;
+    return linePaint;
 }
 
-void OsmAnd::TextRasterizer_P::measureText(QVector<LinePaint>& paints, SkScalar& outMaxLineWidth) const
+void OsmAnd::TextRasterizer_P::measureLine(LinePaint& linePaint) const
+{
+    linePaint.maxBoundsTop = 0;
+    linePaint.minBoundsTop = std::numeric_limits<SkScalar>::max();
+    linePaint.width = 0;
+
+    for (auto& textPaint : linePaint.textPaints)
+    {
+        textPaint.paint.measureText(
+            textPaint.text.constData(),
+            textPaint.text.length()*sizeof(QChar),
+            &textPaint.bounds);
+
+        textPaint.width = textPaint.bounds.width();
+
+        linePaint.maxBoundsTop = qMax(linePaint.maxBoundsTop, -textPaint.bounds.top());
+        linePaint.minBoundsTop = qMin(linePaint.minBoundsTop, -textPaint.bounds.top());
+        linePaint.width += textPaint.width;
+    }
+}
+
+QVector<OsmAnd::TextRasterizer_P::LinePaint> OsmAnd::TextRasterizer_P::obtainLinePaints(
+    const QVector<QStringRef>& lineRefs,
+    const Style& style,
+    SkScalar& outMaxLineWidth) const
 {
     outMaxLineWidth = 0;
 
-    for (auto& linePaint : paints)
+    QVector<LinePaint> linePaints;
+    linePaints.reserve(lineRefs.count());
+    for (const auto& lineRef : constOf(lineRefs))
     {
-        linePaint.maxBoundsTop = 0;
-        linePaint.minBoundsTop = std::numeric_limits<SkScalar>::max();
-        linePaint.width = 0;
+        LinePaintsCacheKey cacheKey;
+        cacheKey.line = lineRef.toString();
+        cacheKey.size = style.size;
+        cacheKey.bold = style.bold;
+        cacheKey.italic = style.italic;
 
-        for (auto& textPaint : linePaint.textPaints)
+        bool cached = false;
+        LinePaint linePaint;
         {
-            textPaint.paint.measureText(
-                textPaint.text.constData(),
-                textPaint.text.length()*sizeof(QChar),
-                &textPaint.bounds);
+            QMutexLocker scopedLocker(&_linePaintsCacheMutex);
 
-            textPaint.width = textPaint.bounds.width();
+            if (const auto cachedLinePaint = _linePaintsCache.object(cacheKey))
+            {
+                linePaint = cachedLinePaint->linePaint;
+                for (auto textPaintIdx = 0; textPaintIdx < linePaint.textPaints.size(); textPaintIdx++)
+                {
+                    auto& textPaint = linePaint.textPaints[textPaintIdx];
+                    const auto& textRange = cachedLinePaint->textRanges[textPaintIdx];
 
-            linePaint.maxBoundsTop = qMax(linePaint.maxBoundsTop, -textPaint.bounds.top());
-            linePaint.minBoundsTop = qMin(linePaint.minBoundsTop, -textPaint.bounds.top());
-            linePaint.width += textPaint.width;
+                    textPaint.text = QStringRef(lineRef.string(), lineRef.position() + textRange.first, textRange.second);
+                    textPaint.paint.setColor(style.color.toSkColor());
+                }
+                linePaint.line = lineRef;
+
+                cached = true;
+                _linePaintsHits++;
+            }
+            else
+                _linePaintsMisses++;
+        }
+
+        if (!cached)
+        {
+            linePaint = evaluateLinePaint(lineRef, style);
+            measureLine(linePaint);
+
+            const auto cachedLinePaint = new CachedLinePaint();
+            cachedLinePaint->linePaint = linePaint;
+            cachedLinePaint->linePaint.line = QStringRef();
+            cachedLinePaint->textRanges.reserve(linePaint.textPaints.size());
+            for (auto& textPaint : cachedLinePaint->linePaint.textPaints)
+            {
+                cachedLinePaint->textRanges.push_back(qMakePair(
+                    textPaint.text.position() - lineRef.position(),
+                    textPaint.text.size()));
+                textPaint.text = QStringRef();
+            }
+
+            QMutexLocker scopedLocker(&_linePaintsCacheMutex);
+            _linePaintsCache.insert(cacheKey, cachedLinePaint);
         }
 
         outMaxLineWidth = qMax(outMaxLineWidth, linePaint.width);
+        linePaints.push_back(qMove(linePaint));
     }
+
+    return linePaints;
 }
 
 void OsmAnd::TextRasterizer_P::measureGlyphs(const QVector<LinePaint>& paints, QVector<SkScalar>& outGlyphWidths) const
@@ -392,25 +487,125 @@ std::shared_ptr<SkBitmap> OsmAnd::TextRasterizer_P::rasterize(
 
 bool OsmAnd::TextRasterizer_P::rasterize(
     SkBitmap& targetBitmap,
-    const QString& text_,
+    const QString& text,
     const Style& style,
     QVector<SkScalar>* const outGlyphWidths,
     float* const outExtraTopSpace,
     float* const outExtraBottomSpace,
     float* const outLineSpacing) const
 {
-    // Prepare text and break by lines
-    const auto text = ICU::convertToVisualOrder(text_);
-    const auto lineRefs = style.wrapWidth > 0
-        ? ICU::getTextWrappingRefs(text, style.wrapWidth)
-        : (QVector<QStringRef>() << QStringRef(&text));
+    // Text rasterized onto existing bitmap can not be shared
+    if (!targetBitmap.isNull())
+    {
+        float extraTopSpace;
+        float extraBottomSpace;
+        float lineSpacing;
+        const auto ok = rasterizeText(
+            targetBitmap,
+            text,
+            style,
+            outGlyphWidths,
+            extraTopSpace,
+            extraBottomSpace,
+            lineSpacing);
+        if (outExtraTopSpace)
+            *outExtraTopSpace = extraTopSpace;
+        if (outExtraBottomSpace)
+            *outExtraBottomSpace = extraBottomSpace;
+        if (outLineSpacing)
+            *outLineSpacing = lineSpacing;
+        return ok;
+    }
 
-    // Obtain paints from lines and style
-    auto paints = evaluatePaints(lineRefs, style);
+    BitmapsCacheKey cacheKey;
+    cacheKey.text = text;
+    cacheKey.style = style;
+
+    {
+        QMutexLocker scopedLocker(&_bitmapsCacheMutex);
+
+        const auto cachedBitmap = _bitmapsCache.object(cacheKey);
+        if (cachedBitmap && (!outGlyphWidths || cachedBitmap->hasGlyphWidths))
+        {
+            targetBitmap = cachedBitmap->bitmap;
+            if (outGlyphWidths)
+                *outGlyphWidths += cachedBitmap->glyphWidths;
+            if (outExtraTopSpace)
+                *outExtraTopSpace = cachedBitmap->extraTopSpace;
+            if (outExtraBottomSpace)
+                *outExtraBottomSpace = cachedBitmap->extraBottomSpace;
+            if (outLineSpacing)
+                *outLineSpacing = cachedBitmap->lineSpacing;
+
+            _bitmapsHits++;
+            return true;
+        }
 
-    // Measure text
+        _bitmapsMisses++;
+    }
+
+    const std::unique_ptr<CachedBitmap> newCachedBitmap(new CachedBitmap());
+    newCachedBitmap->hasGlyphWidths = (outGlyphWidths != nullptr);
+    const auto ok = rasterizeText(
+        targetBitmap,
+        text,
+        style,
+        outGlyphWidths ? &newCachedBitmap->glyphWidths : nullptr,
+        newCachedBitmap->extraTopSpace,
+        newCachedBitmap->extraBottomSpace,
+        newCachedBitmap->lineSpacing);
+    if (!ok)
+        return false;
+
+    // Cached bitmap shares pixels with returned one, so they must not be modified
+    targetBitmap.setImmutable();
+    newCachedBitmap->bitmap = targetBitmap;
+
+    if (outGlyphWidths)
+        *outGlyphWidths += newCachedBitmap->glyphWidths;
+    if (outExtraTopSpace)
+        *outExtraTopSpace = newCachedBitmap->extraTopSpace;
+    if (outExtraBottomSpace)
+        *outExtraBottomSpace = newCachedBitmap->extraBottomSpace;
+    if (outLineSpacing)
+        *outLineSpacing = newCachedBitmap->lineSpacing;
+
+    {
+        QMutexLocker scopedLocker(&_bitmapsCacheMutex);
+
+        const auto cost = static_cast<int>(targetBitmap.getSize());
+        _bitmapsCache.insert(cacheKey, newCachedBitmap.release(), cost);
+    }
+
+    return true;
+}
+
+bool OsmAnd::TextRasterizer_P::rasterizeText(
+    SkBitmap& targetBitmap,
+    const QString& text_,
+    const Style& style,
+    QVector<SkScalar>* const outGlyphWidths,
+    float& outExtraTopSpace,
+    float& outExtraBottomSpace,
+    float& outLineSpacing) const
+{
+    // Prepare text and break by lines
+    QVector<int> lineStartIndices;
+    const auto text = ICU::convertToVisualOrderAndWrap(text_, style.wrapWidth, lineStartIndices);
+    QVector<QStringRef> lineRefs;
+    lineRefs.reserve(lineStartIndices.size());
+    for (auto lineIdx = 0, linesCount = lineStartIndices.size(); lineIdx < linesCount; lineIdx++)
+    {
+        const auto lineStartIndex = lineStartIndices[lineIdx];
+        if (lineIdx + 1 < linesCount)
+            lineRefs.push_back(text.midRef(lineStartIndex, lineStartIndices[lineIdx + 1] - lineStartIndex));
+        else
+            lineRefs.push_back(text.midRef(lineStartIndex));
+    }
+
+    // Obtain measured paints from lines and style
     SkScalar maxLineWidthInPixels = 0;
-    measureText(paints, maxLineWidthInPixels);
+    auto paints = obtainLinePaints(lineRefs, style, maxLineWidthInPixels);
 
     // Measure glyphs (if requested and there's no halo)
     if (outGlyphWidths && style.haloRadius == 0)
@@ -426,31 +621,28 @@ bool OsmAnd::TextRasterizer_P::rasterize(
     }
 
     // Set output line spacing
-    if (outLineSpacing)
     {
         float lineSpacing = 0.0f;
         for (const auto& linePaint : constOf(paints))
             lineSpacing = qMax(lineSpacing, linePaint.maxFontLineSpacing);
 
-        *outLineSpacing = lineSpacing;
+        outLineSpacing = lineSpacing;
     }
 
     // Calculate extra top and bottom space
-    if (outExtraTopSpace)
     {
         SkScalar maxTop = 0;
         for (const auto& linePaint : constOf(paints))
             maxTop = qMax(maxTop, linePaint.maxFontTop);
 
-        *outExtraTopSpace = qMax(0.0f, maxTop - paints.first().maxFontTop);
+        outExtraTopSpace = qMax(0.0f, maxTop - paints.first().maxFontTop);
     }
-    if (outExtraBottomSpace)
     {
         SkScalar maxBottom = 0;
         for (const auto& linePaint : constOf(paints))
             maxBottom = qMax(maxBottom, linePaint.maxFontBottom);
 
-        *outExtraBottomSpace = qMax(0.0f, maxBottom - paints.last().maxFontBottom);
+        outExtraBottomSpace = qMax(0.0f, maxBottom - paints.last().maxFontBottom);
     }
 
     // Position text horizontally and vertically
@@ -462,10 +654,8 @@ bool OsmAnd::TextRasterizer_P::rasterize(
     if (style.backgroundBitmap)
     {
         // Clear extra spacing
-        if (outExtraTopSpace)
-            *outExtraTopSpace = 0.0f;
-        if (outExtraBottomSpace)
-            *outExtraBottomSpace = 0.0f;
+        outExtraTopSpace = 0.0f;
+        outExtraBottomSpace = 0.0f;
 
         // Enlarge bitmap if shield is larger than text
         bitmapWidth = qMax(bitmapWidth, style.backgroundBitmap->width());
@@ -553,3 +743,74 @@ bool OsmAnd::TextRasterizer_P::rasterize(
 
     return true;
 }
+
+OsmAnd::TextRasterizer::CachesMetrics OsmAnd::TextRasterizer_P::getCachesMetrics() const
+{
+    TextRasterizer::CachesMetrics metrics;
+
+    {
+        QMutexLocker scopedLocker(&_glyphCoverageCacheMutex);
+
+        metrics.glyphCoverageHits = _glyphCoverageHits;
+        metrics.glyphCoverageMisses = _glyphCoverageMisses;
+    }
+
+    {
+        QMutexLocker scopedLocker(&_linePaintsCacheMutex);
+
+        metrics.linePaintsHits = _linePaintsHits;
+        metrics.linePaintsMisses = _linePaintsMisses;
+    }
+
+    {
+        QMutexLocker scopedLocker(&_bitmapsCacheMutex);
+
+        metrics.bitmapsHits = _bitmapsHits;
+        metrics.bitmapsMisses = _bitmapsMisses;
+        metrics.bitmapsSizeInBytes = _bitmapsCache.totalCost();
+    }
+
+    return metrics;
+}
+
+void OsmAnd::TextRasterizer_P::clearCaches() const
+{
+    {
+        QMutexLocker scopedLocker(&_glyphCoverageCacheMutex);
+
+        _glyphCoverageCache.clear();
+        _glyphCoverageHits = 0;
+        _glyphCoverageMisses = 0;
+    }
+
+    {
+        QMutexLocker scopedLocker(&_linePaintsCacheMutex);
+
+        _linePaintsCache.clear();
+        _linePaintsHits = 0;
+        _linePaintsMisses = 0;
+    }
+
+    {
+        QMutexLocker scopedLocker(&_bitmapsCacheMutex);
+
+        _bitmapsCache.clear();
+        _bitmapsHits = 0;
+        _bitmapsMisses = 0;
+    }
+}
+
+bool OsmAnd::TextRasterizer_P::BitmapsCacheKey::operator==(const BitmapsCacheKey& that) const
+{
+    return
+        style.wrapWidth == that.style.wrapWidth &&
+        style.size == that.style.size &&
+        style.bold == that.style.bold &&
+        style.italic == that.style.italic &&
+        style.color == that.style.color &&
+        style.haloRadius == that.style.haloRadius &&
+        style.haloColor == that.style.haloColor &&
+        style.backgroundBitmap == that.style.backgroundBitmap &&
+        style.textAlignment == that.style.textAlignment &&
+        text == that.text;
+}
@@ -8,6 +8,9 @@
 #include "ignore_warnings_on_external_includes.h"
 #include <QList>
 #include <QVector>
+#include <QHash>
+#include <QCache>
+#include <QMutex>
 #include "restore_internal_warnings.h"
 
 #include "ignore_warnings_on_external_includes.h"
@@ -80,8 +83,12 @@ namespace OsmAnd
             SkScalar minBoundsTop;
             SkScalar width;
         };
-        QVector<LinePaint> evaluatePaints(const QVector<QStringRef>& lineRefs, const Style& style) const;
-        void measureText(QVector<LinePaint>& paints, SkScalar& outMaxLineWidth) const;
+        LinePaint evaluateLinePaint(const QStringRef& lineRef, const Style& style) const;
+        void measureLine(LinePaint& linePaint) const;
+        QVector<LinePaint> obtainLinePaints(
+            const QVector<QStringRef>& lineRefs,
+            const Style& style,
+            SkScalar& outMaxLineWidth) const;
         void measureGlyphs(const QVector<LinePaint>& paints, QVector<SkScalar>& outGlyphWidths) const;
         SkPaint getHaloPaint(const SkPaint& paint, const Style& style) const;
         void measureHalo(const Style& style, QVector<LinePaint>& paints) const;
@@ -90,6 +97,96 @@ namespace OsmAnd
             QVector<LinePaint>& paints,
             const SkScalar maxLineWidth,
             const Style::TextAlignment textAlignment) const;
+
+        bool rasterizeText(
+            SkBitmap& targetBitmap,
+            const QString& text,
+            const Style& style,
+            QVector<SkScalar>* const outGlyphWidths,
+            float& outExtraTopSpace,
+            float& outExtraBottomSpace,
+            float& outLineSpacing) const;
+
+        enum {
+            MaxCachedLinePaintsCount = 4096,
+            MaxCachedBitmapsSizeInBytes = 8 * 1024 * 1024,
+        };
+
+        // Coverage of typeface is stored in blocks of 64 characters
+        struct GlyphCoverageBlock
+        {
+            inline GlyphCoverageBlock()
+                : probed(0)
+                , covered(0)
+            {
+            }
+
+            uint64_t probed;
+            uint64_t covered;
+        };
+        mutable QMutex _glyphCoverageCacheMutex;
+        mutable QHash<uint64_t, GlyphCoverageBlock> _glyphCoverageCache;
+        mutable unsigned int _glyphCoverageHits;
+        mutable unsigned int _glyphCoverageMisses;
+        bool typefaceContainsCharacter(SkTypeface* const typeface, const uint32_t characterUCS4) const;
+
+        // Line paints are cached without text color and with text references relative to line start
+        struct LinePaintsCacheKey
+        {
+            QString line;
+            SkScalar size;
+            bool bold;
+            bool italic;
+
+            inline bool operator==(const LinePaintsCacheKey& that) const
+            {
+                return
+                    size == that.size &&
+                    bold == that.bold &&
+                    italic == that.italic &&
+                    line == that.line;
+            }
+
+            friend inline uint qHash(const LinePaintsCacheKey& key, uint seed = 0) Q_DECL_NOTHROW
+            {
+                return ::qHash(key.line, seed) ^ ::qHash(key.size) ^ (key.bold ? 0x1 : 0x0) ^ (key.italic ? 0x2 : 0x0);
+            }
+        };
+        struct CachedLinePaint
+        {
+            LinePaint linePaint;
+            QVector< QPair<int, int> > textRanges;
+        };
+        mutable QMutex _linePaintsCacheMutex;
+        mutable QCache<LinePaintsCacheKey, CachedLinePaint> _linePaintsCache;
+        mutable unsigned int _linePaintsHits;
+        mutable unsigned int _linePaintsMisses;
+
+        struct BitmapsCacheKey
+        {
+            QString text;
+            Style style;
+
+            bool operator==(const BitmapsCacheKey& that) const;
+
+            friend inline uint qHash(const BitmapsCacheKey& key, uint seed = 0) Q_DECL_NOTHROW
+            {
+                return ::qHash(key.text, seed) ^ ::qHash(key.style.size) ^ ::qHash(key.style.color.argb);
+            }
+        };
+        struct CachedBitmap
+        {
+            SkBitmap bitmap;
+            bool hasGlyphWidths;
+            QVector<SkScalar> glyphWidths;
+            float extraTopSpace;
+            float extraBottomSpace;
+            float lineSpacing;
+        };
+        mutable QMutex _bitmapsCacheMutex;
+        mutable QCache<BitmapsCacheKey, CachedBitmap> _bitmapsCache;
+        mutable unsigned int _bitmapsHits;
+        mutable unsigned int _bitmapsMisses;
     protected:
         TextRasterizer_P(TextRasterizer* const owner);
     public:
@@ -114,6 +211,9 @@ namespace OsmAnd
             float* const outExtraBottomSpace,
             float* const outLineSpacing) const;
 
+        TextRasterizer::CachesMetrics getCachesMetrics() const;
+        void clearCaches() const;
+
     friend class OsmAnd::TextRasterizer;
     };
 }
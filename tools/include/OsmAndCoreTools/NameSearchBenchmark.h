@@ -0,0 +1,64 @@
+#ifndef _OSMAND_CORE_TOOLS_NAME_SEARCH_BENCHMARK_H_
+#define _OSMAND_CORE_TOOLS_NAME_SEARCH_BENCHMARK_H_
+
+#include <OsmAndCore/stdlib_common.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <iostream>
+#include <sstream>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QString>
+#include <QStringList>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+
+#include <OsmAndCoreTools.h>
+
+namespace OsmAndTools
+{
+    // Runs same name queries over set of OBFs using on-disk name index scan, resident name index and
+    // typo-tolerant n-gram index, and reports time spent and amenities/addresses found by each of them.
+    // First run of resident modes includes building of index, so it's reported separately.
+    class OSMAND_CORE_TOOLS_API NameSearchBenchmark Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(NameSearchBenchmark);
+
+    public:
+        struct OSMAND_CORE_TOOLS_API Configuration Q_DECL_FINAL
+        {
+            Configuration();
+
+            QStringList obfsPaths;
+            // Each line of queries file is one query, lines starting with '#' are ignored
+            QStringList queries;
+            unsigned int maxEditDistance;
+            unsigned int iterations;
+
+            static bool parseFromCommandLineArguments(
+                const QStringList& commandLineArgs,
+                Configuration& outConfiguration,
+                QString& outError);
+        };
+
+    private:
+#if defined(_UNICODE) || defined(UNICODE)
+        bool run(std::wostream& output);
+#else
+        bool run(std::ostream& output);
+#endif
+    protected:
+    public:
+        NameSearchBenchmark(const Configuration& configuration);
+        ~NameSearchBenchmark();
+
+        const Configuration configuration;
+
+        bool run(QString *pLog = nullptr);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_TOOLS_NAME_SEARCH_BENCHMARK_H_)
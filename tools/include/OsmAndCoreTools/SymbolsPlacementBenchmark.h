@@ -0,0 +1,92 @@
+#ifndef _OSMAND_CORE_TOOLS_SYMBOLS_PLACEMENT_BENCHMARK_H_
+#define _OSMAND_CORE_TOOLS_SYMBOLS_PLACEMENT_BENCHMARK_H_
+
+#include <OsmAndCore/stdlib_common.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <iostream>
+#include <sstream>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSet>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/CommonTypes.h>
+#include <OsmAndCore/Map/MapSymbol.h>
+#include <OsmAndCore/Map/MapSymbolsPlacement.h>
+
+#include <OsmAndCoreTools.h>
+
+namespace OsmAndTools
+{
+    // Replays camera path over set of symbols (synthetic or recorded) and reports time spent on
+    // placement and accepted symbols for each frame. Does not need GPU.
+    class OSMAND_CORE_TOOLS_API SymbolsPlacementBenchmark Q_DECL_FINAL
+    {
+        Q_DISABLE_COPY_AND_MOVE(SymbolsPlacementBenchmark);
+
+    public:
+        struct OSMAND_CORE_TOOLS_API Symbol Q_DECL_FINAL
+        {
+            Symbol();
+
+            int groupId;
+            int groupInstanceId;
+            OsmAnd::MapSymbol::ContentClass contentClass;
+            QStringList intersectsWithClasses;
+            float minDistance;
+            OsmAnd::AreaI bbox;
+            QString content;
+        };
+
+        struct OSMAND_CORE_TOOLS_API Configuration Q_DECL_FINAL
+        {
+            Configuration();
+
+            // Each line of symbols file describes one symbol in world pixels, most important first:
+            // groupId;groupInstanceId;icon|caption;class1,class2;minDistance;left;top;right;bottom;content
+            // Lines starting with '#' are ignored. If no file is given, symbols are generated.
+            QString symbolsFilename;
+            unsigned int randomSeed;
+            unsigned int symbolsCount;
+            OsmAnd::PointI worldSize;
+            OsmAnd::PointI viewportSize;
+            OsmAnd::PointI cameraStart;
+            OsmAnd::PointI cameraStep;
+            unsigned int framesCount;
+            unsigned int iterationsPerFrame;
+            OsmAnd::MapSymbolsPlacement::IndexType indexType;
+            bool verbose;
+
+            static bool parseFromCommandLineArguments(
+                const QStringList& commandLineArgs,
+                Configuration& outConfiguration,
+                QString& outError);
+        };
+
+    private:
+        bool obtainSymbols(QList<Symbol>& outSymbols, QString& outError) const;
+        void generateSymbols(QList<Symbol>& outSymbols) const;
+
+#if defined(_UNICODE) || defined(UNICODE)
+        bool run(std::wostream& output);
+#else
+        bool run(std::ostream& output);
+#endif
+    protected:
+    public:
+        SymbolsPlacementBenchmark(const Configuration& configuration);
+        ~SymbolsPlacementBenchmark();
+
+        const Configuration configuration;
+
+        bool run(QString *pLog = nullptr);
+    };
+}
+
+#endif // !defined(_OSMAND_CORE_TOOLS_SYMBOLS_PLACEMENT_BENCHMARK_H_)
@@ -0,0 +1,252 @@
+#include "NameSearchBenchmark.h"
+
+#include <OsmAndCore/stdlib_common.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <iomanip>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/Common.h>
+#include <OsmAndCore/Stopwatch.h>
+#include <OsmAndCore/ObfsCollection.h>
+#include <OsmAndCore/ObfDataInterface.h>
+#include <OsmAndCore/Data/ObfFile.h>
+
+#include <OsmAndCoreTools.h>
+#include <OsmAndCoreTools/Utilities.h>
+
+OsmAndTools::NameSearchBenchmark::NameSearchBenchmark(const Configuration& configuration_)
+    : configuration(configuration_)
+{
+}
+
+OsmAndTools::NameSearchBenchmark::~NameSearchBenchmark()
+{
+}
+
+#if defined(_UNICODE) || defined(UNICODE)
+bool OsmAndTools::NameSearchBenchmark::run(std::wostream& output)
+#else
+bool OsmAndTools::NameSearchBenchmark::run(std::ostream& output)
+#endif
+{
+    if (configuration.obfsPaths.isEmpty() || configuration.queries.isEmpty())
+        return false;
+
+    const std::shared_ptr<OsmAnd::ObfsCollection> obfsCollection(new OsmAnd::ObfsCollection());
+    for (const auto& obfsPath : constOf(configuration.obfsPaths))
+    {
+        if (QFileInfo(obfsPath).isDir())
+            obfsCollection->addDirectory(obfsPath);
+        else
+            obfsCollection->addFile(obfsPath);
+    }
+
+    enum class Mode
+    {
+        OnDisk,
+        Resident,
+        NGram,
+    };
+    const QList<Mode> modes = QList<Mode>() << Mode::OnDisk << Mode::Resident << Mode::NGram;
+
+    const auto wasResidentNameIndexEnabled = OsmAnd::ObfFile::isResidentNameIndexEnabled();
+    const auto iterations = qMax(configuration.iterations, 1u);
+    for (const auto mode : constOf(modes))
+    {
+        const auto maxEditDistance = (mode == Mode::NGram) ? configuration.maxEditDistance : 0u;
+        OsmAnd::ObfFile::setResidentNameIndexEnabled(mode != Mode::OnDisk);
+
+        if (mode == Mode::OnDisk)
+            output << xT("On-disk name index");
+        else if (mode == Mode::Resident)
+            output << xT("Resident name index");
+        else
+            output << xT("N-gram index");
+        output << xT(", max edit distance ") << maxEditDistance << xT(":") << std::endl;
+
+        auto totalTime = 0.0f;
+        for (const auto& query : constOf(configuration.queries))
+        {
+            auto firstTime = 0.0f;
+            auto otherTime = 0.0f;
+            auto amenitiesCount = 0;
+            auto addressesCount = 0;
+            for (auto iteration = 0u; iteration < iterations; iteration++)
+            {
+                const auto dataInterface = obfsCollection->obtainDataInterface();
+
+                QList< std::shared_ptr<const OsmAnd::Amenity> > amenities;
+                QList< std::shared_ptr<const OsmAnd::Address> > addresses;
+                const OsmAnd::Stopwatch stopwatch(true);
+                dataInterface->scanAmenitiesByName(
+                    query,
+                    &amenities,
+                    OsmAnd::MinZoomLevel,
+                    OsmAnd::MaxZoomLevel,
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    maxEditDistance);
+                dataInterface->scanAddressesByName(
+                    query,
+                    &addresses,
+                    nullptr,
+                    OsmAnd::fullObfAddressStreetGroupTypesMask(),
+                    true,
+                    nullptr,
+                    nullptr,
+                    maxEditDistance);
+                const auto time = stopwatch.elapsed();
+
+                if (iteration == 0)
+                    firstTime = time;
+                else
+                    otherTime += time;
+                amenitiesCount = amenities.size();
+                addressesCount = addresses.size();
+            }
+            const auto averageTime = (iterations > 1) ? otherTime / (iterations - 1) : firstTime;
+            totalTime += averageTime;
+
+            output
+                << xT("\t'") << QStringToStlString(query) << xT("': ")
+                << amenitiesCount << xT(" amenities, ") << addressesCount << xT(" addresses in ")
+                << std::fixed << std::setprecision(3) << averageTime * 1000.0f << xT("ms (first run ")
+                << firstTime * 1000.0f << xT("ms)") << std::endl;
+        }
+
+        output
+            << xT("\tAverage query: ") << std::fixed << std::setprecision(3)
+            << (totalTime / configuration.queries.size()) * 1000.0f << xT("ms") << std::endl;
+    }
+    OsmAnd::ObfFile::setResidentNameIndexEnabled(wasResidentNameIndexEnabled);
+
+    return true;
+}
+
+bool OsmAndTools::NameSearchBenchmark::run(QString *pLog /*= nullptr*/)
+{
+    if (pLog != nullptr)
+    {
+#if defined(_UNICODE) || defined(UNICODE)
+        std::wostringstream output;
+        const bool success = run(output);
+        *pLog = QString::fromStdWString(output.str());
+        return success;
+#else
+        std::ostringstream output;
+        const bool success = run(output);
+        *pLog = QString::fromStdString(output.str());
+        return success;
+#endif
+    }
+    else
+    {
+#if defined(_UNICODE) || defined(UNICODE)
+        return run(std::wcout);
+#else
+        return run(std::cout);
+#endif
+    }
+}
+
+OsmAndTools::NameSearchBenchmark::Configuration::Configuration()
+    : maxEditDistance(1)
+    , iterations(3)
+{
+}
+
+bool OsmAndTools::NameSearchBenchmark::Configuration::parseFromCommandLineArguments(
+    const QStringList& commandLineArgs,
+    Configuration& outConfiguration,
+    QString& outError)
+{
+    outConfiguration = Configuration();
+
+    for (const auto& arg : commandLineArgs)
+    {
+        if (arg.startsWith(QLatin1String("-obfsDir=")) || arg.startsWith(QLatin1String("-obf=")))
+        {
+            const auto value = Utilities::resolvePath(arg.mid(arg.indexOf(QLatin1Char('=')) + 1));
+            if (!QFileInfo(value).exists())
+            {
+                outError = QString("'%1' does not exist").arg(value);
+                return false;
+            }
+
+            outConfiguration.obfsPaths.push_back(value);
+        }
+        else if (arg.startsWith(QLatin1String("-query=")))
+        {
+            outConfiguration.queries.push_back(Utilities::purifyArgumentValue(arg.mid(strlen("-query="))));
+        }
+        else if (arg.startsWith(QLatin1String("-queriesFile=")))
+        {
+            const auto value = Utilities::resolvePath(arg.mid(strlen("-queriesFile=")));
+            QFile file(value);
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            {
+                outError = QString("Failed to open '%1'").arg(value);
+                return false;
+            }
+
+            QTextStream stream(&file);
+            while (!stream.atEnd())
+            {
+                const auto line = stream.readLine().trimmed();
+                if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+                    continue;
+                outConfiguration.queries.push_back(line);
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-maxEditDistance=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-maxEditDistance=")));
+            bool ok = false;
+            outConfiguration.maxEditDistance = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as max edit distance").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-iterations=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-iterations=")));
+            bool ok = false;
+            outConfiguration.iterations = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as iterations count").arg(value);
+                return false;
+            }
+        }
+        else
+        {
+            outError = QString("Unrecognized argument: '%1'").arg(arg);
+            return false;
+        }
+    }
+
+    if (outConfiguration.obfsPaths.isEmpty())
+    {
+        outError = QLatin1String("No OBFs given");
+        return false;
+    }
+    if (outConfiguration.queries.isEmpty())
+    {
+        outError = QLatin1String("No queries given");
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,474 @@
+#include "SymbolsPlacementBenchmark.h"
+
+#include <OsmAndCore/stdlib_common.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <iomanip>
+#include <random>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore/QtExtensions.h>
+#include <OsmAndCore/ignore_warnings_on_external_includes.h>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <OsmAndCore/restore_internal_warnings.h>
+
+#include <OsmAndCore.h>
+#include <OsmAndCore/Common.h>
+#include <OsmAndCore/Map/MapSymbolIntersectionClassesRegistry.h>
+
+#include <OsmAndCoreTools.h>
+#include <OsmAndCoreTools/Utilities.h>
+
+namespace OsmAndTools
+{
+    static bool parsePoint(const QString& value, OsmAnd::PointI& outPoint)
+    {
+        const auto values = value.split(QLatin1Char(';'));
+        if (values.size() != 2)
+            return false;
+
+        bool ok = false;
+        outPoint.x = values[0].toInt(&ok);
+        if (!ok)
+            return false;
+        outPoint.y = values[1].toInt(&ok);
+        return ok;
+    }
+}
+
+OsmAndTools::SymbolsPlacementBenchmark::SymbolsPlacementBenchmark(const Configuration& configuration_)
+    : configuration(configuration_)
+{
+}
+
+OsmAndTools::SymbolsPlacementBenchmark::~SymbolsPlacementBenchmark()
+{
+}
+
+bool OsmAndTools::SymbolsPlacementBenchmark::obtainSymbols(QList<Symbol>& outSymbols, QString& outError) const
+{
+    if (configuration.symbolsFilename.isEmpty())
+    {
+        generateSymbols(outSymbols);
+        return true;
+    }
+
+    QFile file(configuration.symbolsFilename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        outError = QString("Failed to open '%1'").arg(configuration.symbolsFilename);
+        return false;
+    }
+
+    QTextStream stream(&file);
+    auto lineNumber = 0;
+    while (!stream.atEnd())
+    {
+        const auto line = stream.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+            continue;
+
+        // Content is the last field, so it may contain separators itself
+        const auto fields = line.split(QLatin1Char(';'));
+        if (fields.size() < 10)
+        {
+            outError = QString("Line %1 of '%2' can not be parsed as symbol")
+                .arg(lineNumber)
+                .arg(configuration.symbolsFilename);
+            return false;
+        }
+
+        Symbol symbol;
+        bool ok = true;
+        bool fieldOk = false;
+        symbol.groupId = fields[0].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.groupInstanceId = fields[1].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        if (fields[2] == QLatin1String("icon"))
+            symbol.contentClass = OsmAnd::MapSymbol::ContentClass::Icon;
+        else if (fields[2] == QLatin1String("caption"))
+            symbol.contentClass = OsmAnd::MapSymbol::ContentClass::Caption;
+        symbol.intersectsWithClasses = fields[3].split(QLatin1Char(','), QString::SkipEmptyParts);
+        symbol.minDistance = fields[4].toFloat(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.bbox.left() = fields[5].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.bbox.top() = fields[6].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.bbox.right() = fields[7].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.bbox.bottom() = fields[8].toInt(&fieldOk);
+        ok = ok && fieldOk;
+        symbol.content = QStringList(fields.mid(9)).join(QLatin1Char(';'));
+        if (!ok)
+        {
+            outError = QString("Line %1 of '%2' can not be parsed as symbol")
+                .arg(lineNumber)
+                .arg(configuration.symbolsFilename);
+            return false;
+        }
+
+        outSymbols.push_back(symbol);
+    }
+
+    return true;
+}
+
+void OsmAndTools::SymbolsPlacementBenchmark::generateSymbols(QList<Symbol>& outSymbols) const
+{
+    // Generated set is fully defined by seed, so results of different runs can be compared
+    std::mt19937 generator(configuration.randomSeed);
+    std::uniform_int_distribution<int> xDistribution(0, qMax(configuration.worldSize.x - 1, 0));
+    std::uniform_int_distribution<int> yDistribution(0, qMax(configuration.worldSize.y - 1, 0));
+    std::uniform_int_distribution<int> widthDistribution(16, 160);
+    std::uniform_int_distribution<int> heightDistribution(12, 32);
+    std::uniform_int_distribution<int> classDistribution(0, 9);
+    std::uniform_int_distribution<int> contentDistribution(0, qMax(static_cast<int>(configuration.symbolsCount / 8), 1));
+
+    const QStringList intersectionClasses = QStringList()
+        << QLatin1String("icon")
+        << QLatin1String("caption")
+        << QLatin1String("shield");
+
+    outSymbols.reserve(configuration.symbolsCount);
+    for (auto symbolIndex = 0u; symbolIndex < configuration.symbolsCount; symbolIndex++)
+    {
+        Symbol symbol;
+
+        // Pairs of symbols share group, like icon and its caption do
+        symbol.groupId = static_cast<int>(symbolIndex / 2);
+        symbol.groupInstanceId = 0;
+
+        const auto classIndex = classDistribution(generator);
+        if (classIndex == 0)
+            symbol.intersectsWithClasses.push_back(QLatin1String("any"));
+        else if (classIndex < 9)
+            symbol.intersectsWithClasses.push_back(intersectionClasses[classIndex % intersectionClasses.size()]);
+
+        const auto x = xDistribution(generator);
+        const auto y = yDistribution(generator);
+        const auto width = widthDistribution(generator);
+        const auto height = heightDistribution(generator);
+        symbol.bbox = OsmAnd::AreaI(y, x, y + height, x + width);
+
+        symbol.contentClass = (symbolIndex % 2 == 0)
+            ? OsmAnd::MapSymbol::ContentClass::Icon
+            : OsmAnd::MapSymbol::ContentClass::Caption;
+        if (symbolIndex % 2 == 1)
+        {
+            symbol.content = QString("label %1").arg(contentDistribution(generator));
+            symbol.minDistance = 100.0f;
+        }
+
+        outSymbols.push_back(symbol);
+    }
+}
+
+#if defined(_UNICODE) || defined(UNICODE)
+bool OsmAndTools::SymbolsPlacementBenchmark::run(std::wostream& output)
+#else
+bool OsmAndTools::SymbolsPlacementBenchmark::run(std::ostream& output)
+#endif
+{
+    if (configuration.viewportSize.x <= 0 || configuration.viewportSize.y <= 0)
+        return false;
+
+    QList<Symbol> symbols;
+    QString error;
+    if (!obtainSymbols(symbols, error))
+    {
+        output << QStringToStlString(error) << std::endl;
+        return false;
+    }
+
+    // Resolve intersection classes once, as renderer does when symbols are obtained
+    auto& intersectionClassesRegistry = OsmAnd::MapSymbolIntersectionClassesRegistry::globalInstance();
+    QVector< QSet<OsmAnd::MapSymbolIntersectionClassId> > symbolsClasses;
+    symbolsClasses.reserve(symbols.size());
+    for (const auto& symbol : constOf(symbols))
+    {
+        QSet<OsmAnd::MapSymbolIntersectionClassId> classes;
+        for (const auto& className : constOf(symbol.intersectsWithClasses))
+        {
+            if (className == QLatin1String("any"))
+                classes.insert(intersectionClassesRegistry.anyClass);
+            else
+                classes.insert(intersectionClassesRegistry.getOrRegisterClassIdByName(className));
+        }
+        symbolsClasses.push_back(classes);
+    }
+
+    output << xT("Replaying ") << configuration.framesCount << xT(" frame(s) over ") << symbols.size() << xT(" symbol(s) using ")
+        << (configuration.indexType == OsmAnd::MapSymbolsPlacement::IndexType::Grid ? xT("grid") : xT("quad tree"))
+        << xT(" index") << std::endl;
+
+    // Same presentation mode as map objects symbols provider uses
+    OsmAnd::MapSymbolsGroup::PresentationMode presentationMode;
+    presentationMode |= OsmAnd::MapSymbolsGroup::PresentationModeFlag::ShowNoneIfIconIsNotShown;
+    presentationMode |= OsmAnd::MapSymbolsGroup::PresentationModeFlag::ShowAnythingUntilFirstGap;
+
+    const OsmAnd::AreaI viewport(0, 0, configuration.viewportSize.y, configuration.viewportSize.x);
+    const auto iterationsPerFrame = qMax(configuration.iterationsPerFrame, 1u);
+    auto totalTime = 0.0f;
+    auto maxFrameTime = 0.0f;
+    auto totalAccepted = 0u;
+    for (auto frameIndex = 0u; frameIndex < configuration.framesCount; frameIndex++)
+    {
+        const OsmAnd::PointI camera(
+            configuration.cameraStart.x + static_cast<int>(frameIndex) * configuration.cameraStep.x,
+            configuration.cameraStart.y + static_cast<int>(frameIndex) * configuration.cameraStep.y);
+
+        // Project symbols on screen: with fixed zoom that's just a translation. Invisible symbols are not
+        // filtered out here, since they still take part in presentation modes of their groups.
+        QList<OsmAnd::MapSymbolsPlacement::Candidate> candidates;
+        auto symbolIndex = -1;
+        for (const auto& symbol : constOf(symbols))
+        {
+            symbolIndex++;
+
+            const OsmAnd::AreaI screenBBox(
+                symbol.bbox.top() - camera.y,
+                symbol.bbox.left() - camera.x,
+                symbol.bbox.bottom() - camera.y,
+                symbol.bbox.right() - camera.x);
+
+            OsmAnd::MapSymbolsPlacement::Candidate candidate;
+            candidate.groupPtr = reinterpret_cast<const void*>(static_cast<uintptr_t>(symbol.groupId) + 1);
+            candidate.groupInstancePtr = reinterpret_cast<const void*>(static_cast<uintptr_t>(symbol.groupInstanceId));
+            candidate.presentationMode = presentationMode;
+            candidate.contentClass = symbol.contentClass;
+            candidate.intersectsWithClasses = symbolsClasses[symbolIndex];
+            candidate.content = symbol.content;
+            candidate.minDistance = symbol.minDistance;
+            candidate.visibleBBox = screenBBox;
+            candidate.intersectionBBox = screenBBox;
+            candidates.push_back(candidate);
+        }
+
+        OsmAnd::MapSymbolsPlacement::Result result;
+        auto frameTime = 0.0f;
+        for (auto iteration = 0u; iteration < iterationsPerFrame; iteration++)
+        {
+            result = OsmAnd::MapSymbolsPlacement::place(viewport, candidates, configuration.indexType);
+            frameTime += result.elapsedTime;
+        }
+        frameTime /= iterationsPerFrame;
+
+        totalTime += frameTime;
+        maxFrameTime = qMax(maxFrameTime, frameTime);
+        totalAccepted += result.acceptedCandidates.size();
+
+        // Digest of accepted set makes it easy to spot placement changes between runs
+        uint acceptedDigest = 0;
+        for (const auto candidateIndex : constOf(result.acceptedCandidates))
+            acceptedDigest = acceptedDigest * 31 + qHash(candidateIndex);
+
+        output
+            << xT("Frame ") << frameIndex
+            << xT(" [") << camera.x << xT(";") << camera.y << xT("]: ")
+            << result.acceptedCandidates.size() << xT(" of ") << candidates.size() << xT(" accepted (")
+            << result.rejectedByVisibility << xT(" invisible, ")
+            << result.rejectedByIntersection << xT(" intersect, ")
+            << result.rejectedByMinDistance << xT(" too close to same content, ")
+            << result.rejectedByIndex << xT(" not indexed, ")
+            << result.discardedByPresentationMode << xT(" discarded by presentation mode) in ")
+            << std::fixed << std::setprecision(3) << frameTime * 1000.0f << xT("ms, digest ")
+            << std::hex << acceptedDigest << std::dec << std::endl;
+        if (configuration.verbose)
+        {
+            output << xT("\tAccepted:");
+            for (const auto candidateIndex : constOf(result.acceptedCandidates))
+                output << xT(" ") << candidateIndex;
+            output << std::endl;
+        }
+    }
+
+    if (configuration.framesCount > 0)
+    {
+        output
+            << xT("Average frame: ") << std::fixed << std::setprecision(3)
+            << (totalTime / configuration.framesCount) * 1000.0f << xT("ms, max frame: ")
+            << maxFrameTime * 1000.0f << xT("ms, average accepted: ")
+            << static_cast<float>(totalAccepted) / configuration.framesCount << std::endl;
+    }
+
+    return true;
+}
+
+bool OsmAndTools::SymbolsPlacementBenchmark::run(QString *pLog /*= nullptr*/)
+{
+    if (pLog != nullptr)
+    {
+#if defined(_UNICODE) || defined(UNICODE)
+        std::wostringstream output;
+        const bool success = run(output);
+        *pLog = QString::fromStdWString(output.str());
+        return success;
+#else
+        std::ostringstream output;
+        const bool success = run(output);
+        *pLog = QString::fromStdString(output.str());
+        return success;
+#endif
+    }
+    else
+    {
+#if defined(_UNICODE) || defined(UNICODE)
+        return run(std::wcout);
+#else
+        return run(std::cout);
+#endif
+    }
+}
+
+OsmAndTools::SymbolsPlacementBenchmark::Symbol::Symbol()
+    : groupId(0)
+    , groupInstanceId(0)
+    , contentClass(OsmAnd::MapSymbol::ContentClass::Unknown)
+    , minDistance(0.0f)
+{
+}
+
+OsmAndTools::SymbolsPlacementBenchmark::Configuration::Configuration()
+    : randomSeed(1)
+    , symbolsCount(10000)
+    , worldSize(8192, 8192)
+    , viewportSize(1280, 720)
+    , cameraStart(0, 0)
+    , cameraStep(16, 8)
+    , framesCount(300)
+    , iterationsPerFrame(1)
+    , indexType(OsmAnd::MapSymbolsPlacement::IndexType::QuadTree)
+    , verbose(false)
+{
+}
+
+bool OsmAndTools::SymbolsPlacementBenchmark::Configuration::parseFromCommandLineArguments(
+    const QStringList& commandLineArgs,
+    Configuration& outConfiguration,
+    QString& outError)
+{
+    outConfiguration = Configuration();
+
+    for (const auto& arg : commandLineArgs)
+    {
+        if (arg.startsWith(QLatin1String("-symbolsFile=")))
+        {
+            const auto value = Utilities::resolvePath(arg.mid(strlen("-symbolsFile=")));
+            if (!QFile(value).exists())
+            {
+                outError = QString("'%1' file does not exist").arg(value);
+                return false;
+            }
+
+            outConfiguration.symbolsFilename = value;
+        }
+        else if (arg.startsWith(QLatin1String("-seed=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-seed=")));
+            bool ok = false;
+            outConfiguration.randomSeed = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as seed").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-symbolsCount=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-symbolsCount=")));
+            bool ok = false;
+            outConfiguration.symbolsCount = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as symbols count").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-worldSize=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-worldSize=")));
+            if (!parsePoint(value, outConfiguration.worldSize))
+            {
+                outError = QString("'%1' can not be parsed as world size").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-viewportSize=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-viewportSize=")));
+            if (!parsePoint(value, outConfiguration.viewportSize))
+            {
+                outError = QString("'%1' can not be parsed as viewport size").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-cameraStart=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-cameraStart=")));
+            if (!parsePoint(value, outConfiguration.cameraStart))
+            {
+                outError = QString("'%1' can not be parsed as camera start").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-cameraStep=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-cameraStep=")));
+            if (!parsePoint(value, outConfiguration.cameraStep))
+            {
+                outError = QString("'%1' can not be parsed as camera step").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-frames=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-frames=")));
+            bool ok = false;
+            outConfiguration.framesCount = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as frames count").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-iterations=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-iterations=")));
+            bool ok = false;
+            outConfiguration.iterationsPerFrame = value.toUInt(&ok);
+            if (!ok)
+            {
+                outError = QString("'%1' can not be parsed as iterations count").arg(value);
+                return false;
+            }
+        }
+        else if (arg.startsWith(QLatin1String("-index=")))
+        {
+            const auto value = Utilities::purifyArgumentValue(arg.mid(strlen("-index=")));
+            if (value.compare(QLatin1String("quadtree"), Qt::CaseInsensitive) == 0)
+                outConfiguration.indexType = OsmAnd::MapSymbolsPlacement::IndexType::QuadTree;
+            else if (value.compare(QLatin1String("grid"), Qt::CaseInsensitive) == 0)
+                outConfiguration.indexType = OsmAnd::MapSymbolsPlacement::IndexType::Grid;
+            else
+            {
+                outError = QString("'%1' can not be parsed as index type").arg(value);
+                return false;
+            }
+        }
+        else if (arg == QLatin1String("-verbose"))
+        {
+            outConfiguration.verbose = true;
+        }
+        else
+        {
+            outError = QString("Unrecognized argument: '%1'").arg(arg);
+            return false;
+        }
+    }
+
+    return true;
+}